@@ -31,6 +31,8 @@ typedef struct FiniteField FiniteField;
 typedef struct EcPoint EcPoint;
 typedef struct EcGroup EcGroup;
 typedef struct PairingState PairingState;
+typedef struct PairingG2Precomp PairingG2Precomp;
+typedef struct EcGlvState EcGlvState;
 
 /// Internal representation of Epid2Params
 typedef struct Epid2Params_ {
@@ -54,6 +56,9 @@ typedef struct Epid2Params_ {
   EcGroup* G2;  ///< Elliptic curve group over finite field Fq2
 
   PairingState* pairing_state;  ///< Pairing state
+  PairingG2Precomp* g2_lines;   ///< Pairing lines precomputed for g2
+  EcGlvState* G1_glv;           ///< Endomorphism data for G1
+  EcGlvState* G2_glv;           ///< Endomorphism data for G2
 } Epid2Params_;
 
 /// Constructs the internal representation of Epid2Params
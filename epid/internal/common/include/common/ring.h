@@ -0,0 +1,157 @@
+/*############################################################################
+  # Copyright 2018-2020 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+#ifndef EPID_INTERNAL_COMMON_INCLUDE_COMMON_RING_H_
+#define EPID_INTERNAL_COMMON_INCLUDE_COMMON_RING_H_
+/*!
+ * \file
+ * \brief Ring container interface.
+ * \addtogroup EpidCommon
+ * @{
+ */
+#include <stddef.h>
+#include "epid/stdtypes.h"
+
+/// Fixed capacity ring of equally sized elements
+/*!
+ One producer may add elements while one consumer takes them, each from
+ its own thread, without locks. The producer only writes tail and the
+ slots after it, the consumer only writes head and the slot at it. Slots
+ stay in place, so pointers to them remain valid until the slot is
+ released.
+
+ Free slots are always clear: the heap is cleared when the ring is
+ initialized and a slot is cleared when its element is taken.
+
+ The ring does not own its heap and uses no library functions, so it can
+ be used by the tiny member as well.
+
+ Functions documented as producer or consumer side must only be called
+ by the respective thread. All other functions require that neither side
+ is active.
+ */
+typedef struct Ring {
+  unsigned char* buf;  ///< slots of the ring
+  size_t slot_size;    ///< size of a slot in bytes
+  size_t capacity;     ///< number of slots in buf
+  size_t head;  ///< number of elements ever taken, written by the consumer
+  size_t tail;  ///< number of elements ever added, written by the producer
+} Ring;
+
+/// Initialize a ring
+/*!
+\param[out] ring
+Ring context
+\param[in] slot_size
+Size of an element in bytes
+\param[in] capacity
+Number of elements the ring can hold
+\param[in] heap
+Buffer of capacity elements used as slots, it is cleared. Can be NULL if
+capacity is 0.
+*/
+void InitRing(Ring* ring, size_t slot_size, size_t capacity, void* heap);
+
+/// Get number of elements in the ring
+/*!
+\param[in] ring
+Ring context
+
+\returns Number of elements in the ring or 0 if ring is NULL
+*/
+size_t RingGetSize(Ring const* ring);
+
+/// Get a free slot of the ring, producer side
+/*!
+  The slot can be filled in place and is added to the ring by
+  RingPushN().
+
+  \param[in] ring
+  Ring context
+  \param[in] i
+  Index of the free slot, 0 for the slot right after the last element
+
+  \returns A pointer to the slot or NULL if fewer than i + 1 slots are
+    free.
+
+  \see RingPushN
+*/
+void* RingGetFree(Ring* ring, size_t i);
+
+/// Add the first n free slots to the ring, producer side
+/*!
+\param[in,out] ring
+Ring context
+\param[in] n
+Number of slots filled since the last push
+
+\returns true if operation succeed, false otherwise
+
+\see RingGetFree
+*/
+bool RingPushN(Ring* ring, size_t n);
+
+/// Return a pointer to the oldest element in the ring, consumer side
+/*!
+  \param[in] ring
+  Ring context
+
+  \returns A pointer to the oldest element or NULL if the ring is empty.
+
+  \see RingPop
+*/
+void* RingFront(Ring* ring);
+
+/// Clear the oldest element and remove it from the ring, consumer side
+/*!
+\param[in,out] ring
+Ring context
+
+\returns true if operation succeed, false otherwise
+
+\see RingFront
+*/
+bool RingPop(Ring* ring);
+
+/// Move the elements of a ring to a new heap
+/*!
+ The elements keep their order, the slots they are moved out of are
+ cleared. The old heap is no longer used by the ring afterwards.
+
+\param[in,out] ring
+Ring context
+\param[in] capacity
+Number of elements the new heap can hold
+\param[in] heap
+Buffer of capacity elements used as slots, it is cleared
+
+\returns true if operation succeed, false if the elements do not fit or
+  heap is the current heap of a non-empty ring
+*/
+bool RingMove(Ring* ring, size_t capacity, void* heap);
+
+/// Clear a buffer
+/*!
+ The stores cannot be removed by the compiler.
+
+\param[out] buf
+Buffer to clear
+\param[in] size
+Size of buf in bytes
+*/
+void RingWipe(void* buf, size_t size);
+
+/*! @} */
+#endif  // EPID_INTERNAL_COMMON_INCLUDE_COMMON_RING_H_
@@ -27,6 +27,7 @@
 /// \cond
 typedef struct PrivKey PrivKey;
 typedef struct GroupPubKey GroupPubKey;
+typedef struct Epid2Params_ Epid2Params_;
 /// \endcond
 
 /// Checks if non split private key is in group
@@ -65,6 +66,31 @@ EpidStatus EpidValidateNonSplitPrivateKey(PrivKey const* priv_key,
 EpidStatus EpidValidateSplitPrivateKey(PrivKey const* priv_key,
                                        GroupPubKey const* pub_key);
 
+/// Checks if split private key is in group using existing parameters
+/*!
+* Same as EpidValidateSplitPrivateKey() but uses the given parameters
+* instead of creating them, so that they can be shared when many keys are
+* validated.
+*
+* \param[in] epid_params
+* The field and group parameters.
+*
+* \param[in] priv_key
+* The split private key to validate
+*
+* \param[in] pub_key
+* The public key to validate private key
+*
+*
+* \retval ::kEpidNoErr
+* \retval ::kEpidBadPrivKeyErr
+* \retval ::kEpidBadGroupPubKeyErr
+* \retval ::kEpidKeyNotInGroupErr
+*/
+EpidStatus EpidValidateSplitPrivateKeyWithParams(
+    Epid2Params_ const* epid_params, PrivKey const* priv_key,
+    GroupPubKey const* pub_key);
+
 /// Checks if private key is in group
 /*!
 *
@@ -17,6 +17,7 @@
 /*! \file */
 #include "common/epid2params.h"
 #include "ippmath/bignum.h"
+#include "ippmath/ecglv.h"
 #include "ippmath/ecgroup.h"
 #include "ippmath/finitefield.h"
 #include "ippmath/memory.h"
@@ -177,10 +178,28 @@ EpidStatus CreateEpid2Params(Epid2Params_** params) {
     if (kEpidNoErr != result) {
       break;
     }
+    result = PairingPrecomputeG2(internal_param->pairing_state,
+                                 internal_param->g2, &internal_param->g2_lines);
+    if (kEpidNoErr != result) {
+      break;
+    }
+    result = NewEcGlvState(internal_param->pairing_state, internal_param->G1,
+                           &internal_param->G1_glv);
+    if (kEpidNoErr != result) {
+      break;
+    }
+    result = NewEcGlvState(internal_param->pairing_state, internal_param->G2,
+                           &internal_param->G2_glv);
+    if (kEpidNoErr != result) {
+      break;
+    }
     *params = internal_param;
     result = kEpidNoErr;
   } while (0);
   if (kEpidNoErr != result && internal_param) {
+    DeleteEcGlvState(&internal_param->G2_glv);
+    DeleteEcGlvState(&internal_param->G1_glv);
+    DeletePairingG2Precomp(&internal_param->g2_lines);
     DeletePairingState(&internal_param->pairing_state);
 
     DeleteEcPoint(&internal_param->g2);
@@ -207,6 +226,9 @@ EpidStatus CreateEpid2Params(Epid2Params_** params) {
 
 void DeleteEpid2Params(Epid2Params_** epid_params) {
   if (epid_params && *epid_params) {
+    DeleteEcGlvState(&(*epid_params)->G2_glv);
+    DeleteEcGlvState(&(*epid_params)->G1_glv);
+    DeletePairingG2Precomp(&(*epid_params)->g2_lines);
     DeletePairingState(&(*epid_params)->pairing_state);
 
     DeleteBigNum(&(*epid_params)->p);
@@ -169,6 +169,19 @@ EpidStatus EpidValidateSplitPrivateKey(PrivKey const* priv_key,
                                        GroupPubKey const* pub_key) {
   EpidStatus sts = kEpidNoErr;
   Epid2Params_* epid_params = NULL;
+  sts = CreateEpid2Params(&epid_params);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  sts = EpidValidateSplitPrivateKeyWithParams(epid_params, priv_key, pub_key);
+  DeleteEpid2Params(&epid_params);
+  return sts;
+}
+
+EpidStatus EpidValidateSplitPrivateKeyWithParams(
+    Epid2Params_ const* epid_params, PrivKey const* priv_key,
+    GroupPubKey const* pub_key) {
+  EpidStatus sts = kEpidNoErr;
   EcPoint* t1 = NULL;
   EcPoint* t2 = NULL;
   FfElement* t3 = NULL;
@@ -201,11 +214,12 @@ EpidStatus EpidValidateSplitPrivateKey(PrivKey const* priv_key,
   if (memcmp(&pub_key->gid, &priv_key->gid, sizeof(GroupId))) {
     return kEpidKeyNotInGroupErr;
   }
+  if (!epid_params) {
+    return kEpidBadArgErr;
+  }
   do {
     const FpElemStr r_str = {1};
     BigNumStr tmp_ff_str = {0};
-    sts = CreateEpid2Params(&epid_params);
-    BREAK_ON_EPID_ERROR(sts);
     sts = NewFfElement(epid_params->Fp, &x);
     BREAK_ON_EPID_ERROR(sts);
     sts = ReadFfElement(epid_params->Fp, &priv_key->x, sizeof(priv_key->x), x);
@@ -316,7 +330,8 @@ EpidStatus EpidValidateSplitPrivateKey(PrivKey const* priv_key,
     // 14. The member computes t4 = pairing(t2, g2).
     sts = NewFfElement(epid_params->GT, &t4);
     BREAK_ON_EPID_ERROR(sts);
-    sts = Pairing(epid_params->pairing_state, t2, epid_params->g2, t4);
+    sts = PairingWithPrecomputedG2(epid_params->pairing_state, t2,
+                                   epid_params->g2_lines, t4);
     BREAK_ON_EPID_ERROR(sts);
 
     // 15. If GT.isEqual(t3, t4) = false, reports bad private key.
@@ -329,7 +344,6 @@ EpidStatus EpidValidateSplitPrivateKey(PrivKey const* priv_key,
       BREAK_ON_EPID_ERROR(sts);
     }
   } while (0);
-  DeleteEpid2Params(&epid_params);
   DeleteEcPoint(&t1);
   DeleteEcPoint(&t2);
   DeleteFfElement(&t3);
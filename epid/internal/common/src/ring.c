@@ -0,0 +1,154 @@
+/*############################################################################
+  # Copyright 2018-2020 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+///  Ring container implementation.
+/*! \file */
+#include "common/ring.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#if !defined(_M_IX86) && !defined(_M_X64) && !defined(_M_ARM) && \
+    !defined(_M_ARM64)
+#error "ring.c: no acquire and release operations for this target"
+#endif
+#endif
+
+/// Reads a counter written by the other side
+/*!
+ Later reads of the slots are not moved before this read.
+ */
+static size_t LoadAcquire(size_t const* counter) {
+#if defined(_MSC_VER) && defined(_M_ARM64)
+  size_t value = (size_t)__iso_volatile_load64((__int64 const*)counter);
+  __dmb(_ARM64_BARRIER_ISH);
+  return value;
+#elif defined(_MSC_VER) && defined(_M_ARM)
+  size_t value = (size_t)__iso_volatile_load32((__int32 const*)counter);
+  __dmb(_ARM_BARRIER_ISH);
+  return value;
+#elif defined(_MSC_VER)
+  // x86 and x64 do not move loads before older loads, only the
+  // compiler has to be stopped
+  size_t value = *(size_t const volatile*)counter;
+  _ReadWriteBarrier();
+  return value;
+#else
+  return __atomic_load_n(counter, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/// Writes a counter read by the other side
+/*!
+ Earlier reads and writes of the slots are not moved after this write.
+ */
+static void StoreRelease(size_t* counter, size_t value) {
+#if defined(_MSC_VER) && defined(_M_ARM64)
+  __dmb(_ARM64_BARRIER_ISH);
+  __iso_volatile_store64((__int64*)counter, (__int64)value);
+#elif defined(_MSC_VER) && defined(_M_ARM)
+  __dmb(_ARM_BARRIER_ISH);
+  __iso_volatile_store32((__int32*)counter, (__int32)value);
+#elif defined(_MSC_VER)
+  // x86 and x64 do not move stores before older loads or stores, only
+  // the compiler has to be stopped
+  _ReadWriteBarrier();
+  *(size_t volatile*)counter = value;
+#else
+  __atomic_store_n(counter, value, __ATOMIC_RELEASE);
+#endif
+}
+
+/// Get slot of the element with the given sequence number
+static unsigned char* RingSlot(Ring const* ring, size_t seq) {
+  return ring->buf + (seq % ring->capacity) * ring->slot_size;
+}
+
+void InitRing(Ring* ring, size_t slot_size, size_t capacity, void* heap) {
+  ring->buf = (unsigned char*)heap;
+  ring->slot_size = slot_size;
+  ring->capacity = capacity;
+  ring->head = 0;
+  ring->tail = 0;
+  if (heap) RingWipe(heap, slot_size * capacity);
+}
+
+size_t RingGetSize(Ring const* ring) {
+  size_t head = 0;
+  if (!ring || !ring->buf) return 0;
+  // head never passes tail, so tail read after head is not behind it
+  head = LoadAcquire(&ring->head);
+  return LoadAcquire(&ring->tail) - head;
+}
+
+void* RingGetFree(Ring* ring, size_t i) {
+  size_t used = 0;
+  if (!ring || !ring->buf) return NULL;
+  used = ring->tail - LoadAcquire(&ring->head);
+  if (i >= ring->capacity - used) return NULL;
+  return RingSlot(ring, ring->tail + i);
+}
+
+bool RingPushN(Ring* ring, size_t n) {
+  size_t used = 0;
+  if (!ring || !ring->buf) return false;
+  used = ring->tail - LoadAcquire(&ring->head);
+  if (n > ring->capacity - used) return false;
+  StoreRelease(&ring->tail, ring->tail + n);
+  return true;
+}
+
+void* RingFront(Ring* ring) {
+  if (!ring || !ring->buf) return NULL;
+  if (ring->head == LoadAcquire(&ring->tail)) return NULL;
+  return RingSlot(ring, ring->head);
+}
+
+bool RingPop(Ring* ring) {
+  if (!ring || !ring->buf) return false;
+  if (ring->head == LoadAcquire(&ring->tail)) return false;
+  // the slot is handed back to the producer only once it is clear
+  RingWipe(RingSlot(ring, ring->head), ring->slot_size);
+  StoreRelease(&ring->head, ring->head + 1);
+  return true;
+}
+
+bool RingMove(Ring* ring, size_t capacity, void* heap) {
+  Ring moved;
+  size_t size = RingGetSize(ring);
+  unsigned char* from = NULL;
+  unsigned char* to = NULL;
+  size_t i = 0;
+  if (!ring || (!heap && capacity) || size > capacity) return false;
+  if (size && heap == ring->buf) return false;
+  InitRing(&moved, ring->slot_size, capacity, heap);
+  while (NULL != (from = (unsigned char*)RingFront(ring))) {
+    to = (unsigned char*)RingGetFree(&moved, 0);
+    for (i = 0; i < ring->slot_size; i++) {
+      to[i] = from[i];
+    }
+    (void)RingPushN(&moved, 1);
+    (void)RingPop(ring);
+  }
+  *ring = moved;
+  return true;
+}
+
+void RingWipe(void* buf, size_t size) {
+  unsigned char volatile* p = (unsigned char volatile*)buf;
+  size_t i = 0;
+  for (i = 0; i < size; i++) {
+    p[i] = 0;
+  }
+}
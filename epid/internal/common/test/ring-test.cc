@@ -0,0 +1,238 @@
+/*############################################################################
+  # Copyright 2018-2020 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+/// Ring container unit tests.
+/*! \file */
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "common/ring.h"
+}
+
+namespace {
+
+/// Ring element, larger than a word so that slot offsets are checked
+struct Element {
+  uint32_t mark;
+  uint32_t check;
+  uint8_t payload[40];
+};
+
+bool IsZero(Element const* element) {
+  Element zero;
+  memset(&zero, 0, sizeof(zero));
+  return 0 == memcmp(element, &zero, sizeof(zero));
+}
+
+Element* GetFree(Ring* ring, size_t i) {
+  return static_cast<Element*>(RingGetFree(ring, i));
+}
+
+Element* Front(Ring* ring) { return static_cast<Element*>(RingFront(ring)); }
+
+TEST(RingTest, NewRingIsEmpty) {
+  std::vector<Element> heap(3);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  EXPECT_EQ((size_t)0, RingGetSize(&ring));
+  EXPECT_EQ(nullptr, RingFront(&ring));
+  EXPECT_FALSE(RingPop(&ring));
+}
+
+TEST(RingTest, RingWithoutHeapHasNoFreeSlots) {
+  Ring ring;
+  InitRing(&ring, sizeof(Element), 0, nullptr);
+  EXPECT_EQ((size_t)0, RingGetSize(&ring));
+  EXPECT_EQ(nullptr, RingGetFree(&ring, 0));
+  EXPECT_FALSE(RingPushN(&ring, 1));
+  EXPECT_EQ(nullptr, RingFront(&ring));
+}
+
+TEST(RingTest, FunctionsFailGivenNullPointer) {
+  std::vector<Element> heap(3);
+  EXPECT_EQ((size_t)0, RingGetSize(nullptr));
+  EXPECT_EQ(nullptr, RingGetFree(nullptr, 0));
+  EXPECT_FALSE(RingPushN(nullptr, 1));
+  EXPECT_EQ(nullptr, RingFront(nullptr));
+  EXPECT_FALSE(RingPop(nullptr));
+  EXPECT_FALSE(RingMove(nullptr, heap.size(), heap.data()));
+}
+
+TEST(RingTest, GetFreeFailsBeyondCapacity) {
+  std::vector<Element> heap(3);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  EXPECT_EQ(&heap[2], GetFree(&ring, 2));
+  EXPECT_EQ(nullptr, RingGetFree(&ring, 3));
+  ASSERT_TRUE(RingPushN(&ring, 2));
+  EXPECT_EQ(&heap[2], GetFree(&ring, 0));
+  EXPECT_EQ(nullptr, RingGetFree(&ring, 1));
+}
+
+TEST(RingTest, PushNFailsGivenMoreThanFreeSlots) {
+  std::vector<Element> heap(3);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  EXPECT_FALSE(RingPushN(&ring, 4));
+  ASSERT_TRUE(RingPushN(&ring, 3));
+  EXPECT_FALSE(RingPushN(&ring, 1));
+  EXPECT_EQ((size_t)3, RingGetSize(&ring));
+}
+
+TEST(RingTest, PopReturnsElementsInOrderAcrossWrapAround) {
+  std::vector<Element> heap(3);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  uint32_t next_in = 1;
+  uint32_t next_out = 1;
+  for (int round = 0; round < 4; round++) {
+    while (RingGetFree(&ring, 0)) {
+      GetFree(&ring, 0)->mark = next_in++;
+      ASSERT_TRUE(RingPushN(&ring, 1));
+    }
+    // leave one element behind so that the next round wraps
+    while (RingGetSize(&ring) > 1) {
+      ASSERT_NE(nullptr, RingFront(&ring));
+      EXPECT_EQ(next_out++, Front(&ring)->mark);
+      ASSERT_TRUE(RingPop(&ring));
+    }
+  }
+  EXPECT_EQ(next_out, Front(&ring)->mark);
+}
+
+TEST(RingTest, FrontIsStableWhileElementsArePushed) {
+  std::vector<Element> heap(3);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  GetFree(&ring, 0)->mark = 1;
+  ASSERT_TRUE(RingPushN(&ring, 1));
+  Element* front = Front(&ring);
+  GetFree(&ring, 0)->mark = 2;
+  GetFree(&ring, 1)->mark = 3;
+  ASSERT_TRUE(RingPushN(&ring, 2));
+  EXPECT_EQ(front, Front(&ring));
+  EXPECT_EQ((uint32_t)1, front->mark);
+}
+
+TEST(RingTest, PopClearsSlot) {
+  std::vector<Element> heap(2);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  Element* slot = GetFree(&ring, 0);
+  memset(slot, 0xa5, sizeof(*slot));
+  ASSERT_TRUE(RingPushN(&ring, 1));
+  ASSERT_TRUE(RingPop(&ring));
+  EXPECT_TRUE(IsZero(&heap[0]));
+  EXPECT_TRUE(IsZero(&heap[1]));
+}
+
+TEST(RingTest, InitClearsHeap) {
+  std::vector<Element> heap(2);
+  memset(heap.data(), 0xa5, heap.size() * sizeof(heap[0]));
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  EXPECT_TRUE(IsZero(&heap[0]));
+  EXPECT_TRUE(IsZero(&heap[1]));
+}
+
+TEST(RingTest, MoveKeepsOrderAndClearsOldHeap) {
+  std::vector<Element> heap(3);
+  std::vector<Element> new_heap(4);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  // wrap the elements around the end of the old heap
+  ASSERT_TRUE(RingPushN(&ring, 2));
+  ASSERT_TRUE(RingPop(&ring));
+  ASSERT_TRUE(RingPop(&ring));
+  for (uint32_t i = 1; i <= 3; i++) {
+    memset(GetFree(&ring, 0), 0xa5, sizeof(Element));
+    GetFree(&ring, 0)->mark = i;
+    ASSERT_TRUE(RingPushN(&ring, 1));
+  }
+  ASSERT_TRUE(RingMove(&ring, new_heap.size(), new_heap.data()));
+  for (auto const& element : heap) {
+    EXPECT_TRUE(IsZero(&element));
+  }
+  EXPECT_EQ((size_t)3, RingGetSize(&ring));
+  EXPECT_EQ(&new_heap[3], GetFree(&ring, 0));
+  for (uint32_t i = 1; i <= 3; i++) {
+    ASSERT_NE(nullptr, RingFront(&ring));
+    EXPECT_EQ(i, Front(&ring)->mark);
+    EXPECT_EQ(0xa5, Front(&ring)->payload[sizeof(Element::payload) - 1]);
+    ASSERT_TRUE(RingPop(&ring));
+  }
+}
+
+TEST(RingTest, MoveFailsIfElementsDoNotFit) {
+  std::vector<Element> heap(3);
+  std::vector<Element> new_heap(1);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  GetFree(&ring, 0)->mark = 1;
+  GetFree(&ring, 1)->mark = 2;
+  ASSERT_TRUE(RingPushN(&ring, 2));
+  EXPECT_FALSE(RingMove(&ring, new_heap.size(), new_heap.data()));
+  EXPECT_EQ((size_t)2, RingGetSize(&ring));
+  EXPECT_EQ((uint32_t)1, Front(&ring)->mark);
+}
+
+TEST(RingTest, MoveFailsGivenCurrentHeapOfNonEmptyRing) {
+  std::vector<Element> heap(3);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  GetFree(&ring, 0)->mark = 1;
+  ASSERT_TRUE(RingPushN(&ring, 1));
+  EXPECT_FALSE(RingMove(&ring, heap.size(), heap.data()));
+  EXPECT_EQ((uint32_t)1, Front(&ring)->mark);
+}
+
+TEST(RingTest, ProducerAndConsumerCanRunConcurrently) {
+  const uint32_t kCount = 100000;
+  std::vector<Element> heap(4);
+  Ring ring;
+  InitRing(&ring, sizeof(Element), heap.size(), heap.data());
+  std::thread producer([&ring, kCount]() {
+    for (uint32_t i = 1; i <= kCount;) {
+      Element* slot = GetFree(&ring, 0);
+      if (!slot) {
+        std::this_thread::yield();
+        continue;
+      }
+      slot->mark = i;
+      slot->check = ~i;
+      if (RingPushN(&ring, 1)) i++;
+    }
+  });
+  uint32_t errors = 0;
+  for (uint32_t i = 1; i <= kCount;) {
+    Element* element = Front(&ring);
+    if (!element) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (element->mark != i || element->check != ~i) errors++;
+    if (RingPop(&ring)) i++;
+  }
+  producer.join();
+  EXPECT_EQ((uint32_t)0, errors);
+  EXPECT_EQ((size_t)0, RingGetSize(&ring));
+}
+
+}  // namespace
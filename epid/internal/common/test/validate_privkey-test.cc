@@ -19,6 +19,7 @@
 #include <vector>
 #include "gtest/gtest.h"
 extern "C" {
+#include "common/epid2params.h"
 #include "common/validate_privkey.h"
 #include "epid/types.h"
 }
@@ -187,6 +188,40 @@ TEST(ValidateSplitPrivateKey, RejectsInvalidPublicKey) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+TEST(ValidateSplitPrivateKeyWithParams, ValidatesManyKeysWithSameParams) {
+  Epid2Params_* epid_params = nullptr;
+  ASSERT_EQ(kEpidNoErr, CreateEpid2Params(&epid_params));
+  GroupPubKey const* pub_key =
+      (GroupPubKey const*)group_7fffffee::kPubKey.data();
+  PrivKey const* valid_privkey =
+      (PrivKey const*)group_7fffffee::kValidSplitPrivKey.data();
+  PrivKey const* nonsplit_privkey =
+      (PrivKey const*)group_7fffffee::kValidNonSplitPrivKey.data();
+  PrivKey const* privkey_invalidA =
+      (PrivKey const*)group_7fffffee::kPrivKeyInvalidA.data();
+  EXPECT_EQ(kEpidNoErr, EpidValidateSplitPrivateKeyWithParams(
+                            epid_params, valid_privkey, pub_key));
+  EXPECT_EQ(kEpidKeyNotInGroupErr, EpidValidateSplitPrivateKeyWithParams(
+                                       epid_params, nonsplit_privkey, pub_key));
+  EXPECT_EQ(kEpidBadPrivKeyErr, EpidValidateSplitPrivateKeyWithParams(
+                                    epid_params, privkey_invalidA, pub_key));
+  EXPECT_EQ(kEpidNoErr, EpidValidateSplitPrivateKeyWithParams(
+                            epid_params, valid_privkey, pub_key));
+  DeleteEpid2Params(&epid_params);
+}
+
+TEST(ValidateSplitPrivateKeyWithParams, FailsGivenNullParams) {
+  GroupPubKey const* pub_key =
+      (GroupPubKey const*)group_7fffffee::kPubKey.data();
+  PrivKey const* valid_privkey =
+      (PrivKey const*)group_7fffffee::kValidSplitPrivKey.data();
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidValidateSplitPrivateKeyWithParams(nullptr, valid_privkey,
+                                                  pub_key));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 TEST(ValidatePrivateKey, ConfirmsKeyInGroup) {
   EpidStatus sts = kEpidErr;
   PrivKey const* valid_nonsplit_privkey =
@@ -0,0 +1,197 @@
+/*############################################################################
+  # Copyright 2016-2019 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+
+/*!
+ * \file
+ * \brief Endomorphism accelerated elliptic curve exponentiation interface.
+ */
+
+#ifndef EPID_INTERNAL_IPPMATH_INCLUDE_IPPMATH_ECGLV_H_
+#define EPID_INTERNAL_IPPMATH_INCLUDE_IPPMATH_ECGLV_H_
+
+#include "epid/errors.h"
+#include "epid/stdtypes.h"
+#include "epid/types.h"
+#include "ippmath/ecgroup.h"
+#include "ippmath/pairing.h"
+
+/// Endomorphism accelerated elliptic curve exponentiation
+/*!
+  \defgroup EcGlvPrimitives ecglv
+  Provides exponentiation in the groups of a BN pairing using the efficient
+  endomorphisms of the curves.
+
+  On G1 the map (x, y) -> (beta*x, y) is used to split a power into two
+  half-length powers (GLV). On G2 the Frobenius based map psi is used to
+  split a power into four quarter-length powers (GLS). The shorter powers
+  are then processed together so that only a half (G1) or a quarter (G2)
+  of the point doublings of EcExp() are needed.
+
+  \ingroup EpidMath
+@{
+*/
+
+/// Endomorphism data for an elliptic curve group of a pairing.
+typedef struct EcGlvState EcGlvState;
+
+/// Constructs a new EcGlvState.
+/*!
+ Allocates memory and derives the endomorphism, lattice basis and rounding
+ constants for one of the groups of the pairing from the BN parameter t of
+ the pairing state.
+
+ Use DeleteEcGlvState() to free memory.
+
+ \param[in] ps
+ The pairing state.
+ \param[in] g
+ The elliptic curve group. Must be either ga or gb used to create ps.
+ \param[out] glv
+ Newly constructed endomorphism data.
+
+ \returns ::EpidStatus
+
+ \attention It is the responsibility of the caller to ensure that ps and g
+ exist for the entire lifetime of the new EcGlvState.
+
+ \see DeleteEcGlvState
+*/
+EpidStatus NewEcGlvState(PairingState const* ps, EcGroup* g,
+                         EcGlvState** glv);
+
+/// Frees a previously allocated EcGlvState.
+/*!
+ Frees memory pointed to by glv. Nulls the pointer.
+
+ \param[in] glv
+ The endomorphism data. Can be NULL.
+
+ \see NewEcGlvState
+*/
+void DeleteEcGlvState(EcGlvState** glv);
+
+/// Raises a point to a power using the group endomorphism.
+/*!
+ Gives the same result as EcExp().
+
+ \attention
+ The running time of EcGlvExp depends on the power. It must only be used
+ with public powers. Use EcGlvSscmExp() for secret powers.
+
+ \param[in] glv
+ The endomorphism data of the group of a and r.
+ \param[in] a
+ The base.
+ \param[in] b
+ The power. Power must be less than the order of the elliptic curve
+ group.
+ \param[out] r
+ The result of raising a to the power b.
+
+ \returns ::EpidStatus
+
+ \see NewEcGlvState
+ \see EcExp
+*/
+EpidStatus EcGlvExp(EcGlvState* glv, EcPoint const* a, BigNumStr const* b,
+                    EcPoint* r);
+
+/// Software side-channel mitigated implementation of EcGlvExp.
+/*!
+ Gives the same result as EcSscmExp().
+
+ The power is decomposed, recoded and used to index the precomputed tables
+ without branches or memory accesses that depend on its value, and the same
+ sequence of group operations is performed for every power.
+
+ \param[in] glv
+ The endomorphism data of the group of a and r.
+ \param[in] a
+ The base.
+ \param[in] b
+ The power. Power must be less than the order of the elliptic curve
+ group.
+ \param[out] r
+ The result of raising a to the power b.
+
+ \returns ::EpidStatus
+
+ \see NewEcGlvState
+ \see EcSscmExp
+*/
+EpidStatus EcGlvSscmExp(EcGlvState* glv, EcPoint const* a, BigNumStr const* b,
+                        EcPoint* r);
+
+/// Multi-exponentiates points using the group endomorphism.
+/*!
+ Gives the same result as EcMultiExp(). The doublings are shared between
+ all the bases.
+
+ \attention
+ The running time of EcGlvMultiExp depends on the powers. It must only be
+ used with public powers. Use EcGlvSscmMultiExp() for secret powers.
+
+ \param[in] glv
+ The endomorphism data of the group of a and r.
+ \param[in] a
+ The bases.
+ \param[in] b
+ The powers. Power must be less than the order of the elliptic curve
+ group.
+ \param[in] m
+ Number of entries in a and b.
+ \param[out] r
+ The result of raising each a to the corresponding power b and
+ multiplying the results.
+
+ \returns ::EpidStatus
+
+ \see NewEcGlvState
+ \see EcMultiExp
+*/
+EpidStatus EcGlvMultiExp(EcGlvState* glv, EcPoint const** a,
+                         BigNumStr const** b, size_t m, EcPoint* r);
+
+/// Software side-channel mitigated implementation of EcGlvMultiExp.
+/*!
+ Gives the same result as EcSscmMultiExp().
+
+ \param[in] glv
+ The endomorphism data of the group of a and r.
+ \param[in] a
+ The bases.
+ \param[in] b
+ The powers. Power must be less than the order of the elliptic curve
+ group.
+ \param[in] m
+ Number of entries in a and b.
+ \param[out] r
+ The result of raising each a to the corresponding power b and
+ multiplying the results.
+
+ \returns ::EpidStatus
+
+ \see NewEcGlvState
+ \see EcSscmMultiExp
+*/
+EpidStatus EcGlvSscmMultiExp(EcGlvState* glv, EcPoint const** a,
+                             BigNumStr const** b, size_t m, EcPoint* r);
+
+/*!
+  @}
+*/
+
+#endif  // EPID_INTERNAL_IPPMATH_INCLUDE_IPPMATH_ECGLV_H_
@@ -407,6 +407,42 @@ EpidStatus Epid11EcHash(EcGroup* g, ConstOctStr msg, size_t msg_len,
 EpidStatus EcHash(EcGroup* g, ConstOctStr msg, size_t msg_len, HashAlg hash_alg,
                   EcPoint* r, uint32_t* iterations);
 
+/// Hashes an arbitrary message to an element in an elliptic curve group
+/// with a fixed number of operations.
+/*!
+ The message is hashed to a field element t that is mapped to the curve
+ with the Shallue-van de Woestijne map in the form given by Fouque and
+ Tibouchi for BN curves. Unlike EcHash(), which tries an unknown number of
+ candidates, the same sequence of field operations is performed for every
+ message. The y-coordinate of the result has the parity of t.
+
+ The result is different from EcHash() for the same message, so the two
+ functions cannot be mixed within a deployment.
+
+ This function is only available for groups over a prime field q with
+ q = 3 mod 4 and q = 1 mod 3, of a curve y^2 = x^3 + b and of cofactor
+ 1, such as G1.
+
+ \param[in] g
+ The elliptic curve group.
+ \param[in] msg
+ The message.
+ \param[in] msg_len
+ The size of msg in bytes.
+ \param[in] hash_alg
+ The hash algorithm.
+ \param[out] r
+ The hashed value.
+
+ \returns ::EpidStatus
+
+ \see NewEcGroup
+ \see NewEcPoint
+ \see EcHash
+*/
+EpidStatus EcSscmHash(EcGroup* g, ConstOctStr msg, size_t msg_len,
+                      HashAlg hash_alg, EcPoint* r);
+
 /// Sets an EcPoint variable to a point on a curve.
 /*!
  This function is only available for G1.
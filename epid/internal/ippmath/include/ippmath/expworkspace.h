@@ -0,0 +1,232 @@
+/*############################################################################
+  # Copyright 2016-2019 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+
+
+/*!
+ * \file
+ * \brief Reusable exponentiation workspace interface.
+ */
+
+#ifndef EPID_INTERNAL_IPPMATH_INCLUDE_IPPMATH_EXPWORKSPACE_H_
+#define EPID_INTERNAL_IPPMATH_INCLUDE_IPPMATH_EXPWORKSPACE_H_
+
+#include "epid/errors.h"
+#include "epid/stdtypes.h"
+#include "epid/types.h"
+#include "ippmath/ecglv.h"
+#include "ippmath/ecgroup.h"
+#include "ippmath/finitefield.h"
+
+/// Reusable exponentiation workspace
+/*!
+  \defgroup ExpWorkspacePrimitives expworkspace
+  Provides variants of the exponentiation primitives that keep their
+  temporary big numbers, pointer arrays and scratch memory in a workspace
+  owned by the caller.
+
+  FfMultiExp(), EcExp(), EcMultiExp(), EcGlvMultiExp() and
+  EcGlvSscmMultiExp() allocate and free their temporary state on every
+  call. Callers that exponentiate in a loop can create a
+  workspace once and pass it to the ...WithWorkspace() variants instead.
+
+  A workspace can be used with any finite field and elliptic curve group,
+  but must not be used by more than one call at a time.
+
+  \ingroup EpidMath
+@{
+*/
+
+/// Temporary state shared by exponentiation calls.
+typedef struct ExpWorkspace ExpWorkspace;
+
+/// Constructs a new ExpWorkspace.
+/*!
+ Allocates memory for the temporary state of exponentiations with up to
+ max_m bases.
+
+ Use DeleteExpWorkspace() to free memory.
+
+ \param[in] max_m
+ Maximum number of bases of a multi-exponentiation using the workspace.
+ \param[out] ws
+ Newly constructed workspace.
+
+ \returns ::EpidStatus
+
+ \see DeleteExpWorkspace
+*/
+EpidStatus NewExpWorkspace(size_t max_m, ExpWorkspace** ws);
+
+/// Frees a previously allocated ExpWorkspace.
+/*!
+ Frees memory pointed to by ws. Nulls the pointer.
+
+ \param[in] ws
+ The workspace. Can be NULL.
+
+ \see NewExpWorkspace
+*/
+void DeleteExpWorkspace(ExpWorkspace** ws);
+
+/// Multi-exponentiates finite field elements using a workspace.
+/*!
+ Gives the same result as FfMultiExp().
+
+ \param[in] ff
+ The finite field in which to perform the operation
+ \param[in] a
+ The bases.
+ \param[in] b
+ The powers.
+ \param[in] m
+ Number of entries in a and b. Must not exceed the size the workspace was
+ created with.
+ \param[in,out] ws
+ The workspace.
+ \param[out] r
+ The result of raising each a to the corresponding power b and multiplying
+ the results.
+
+ \returns ::EpidStatus
+
+ \see NewExpWorkspace
+ \see FfMultiExp
+*/
+EpidStatus FfMultiExpWithWorkspace(FiniteField* ff, FfElement const** a,
+                                   BigNumStr const** b, size_t m,
+                                   ExpWorkspace* ws, FfElement* r);
+
+/// Raises a point in an elliptic curve group to a power using a workspace.
+/*!
+ Gives the same result as EcExp().
+
+ \param[in] g
+ The elliptic curve group in which to perform the computation.
+ \param[in] a
+ The base.
+ \param[in] b
+ The power. Power must be less than the order of the elliptic curve
+ group.
+ \param[in,out] ws
+ The workspace.
+ \param[out] r
+ The result of raising a to the power b.
+
+ \returns ::EpidStatus
+
+ \see NewExpWorkspace
+ \see EcExp
+*/
+EpidStatus EcExpWithWorkspace(EcGroup* g, EcPoint const* a, BigNumStr const* b,
+                              ExpWorkspace* ws, EcPoint* r);
+
+/// Multi-exponentiates elliptic curve points using a workspace.
+/*!
+ Gives the same result as EcMultiExp().
+
+ \param[in] g
+ The elliptic curve group in which to perform the computation.
+ \param[in] a
+ The bases.
+ \param[in] b
+ The powers. Power must be less than the order of the elliptic curve
+ group.
+ \param[in] m
+ Number of entries in a and b.
+ \param[in,out] ws
+ The workspace.
+ \param[out] r
+ The result of raising each a to the corresponding power b and
+ multiplying the results.
+
+ \returns ::EpidStatus
+
+ \see NewExpWorkspace
+ \see EcMultiExp
+*/
+EpidStatus EcMultiExpWithWorkspace(EcGroup* g, EcPoint const** a,
+                                   BigNumStr const** b, size_t m,
+                                   ExpWorkspace* ws, EcPoint* r);
+
+/// Multi-exponentiates points using the group endomorphism and a workspace.
+/*!
+ Gives the same result as EcGlvMultiExp(). The tables and recoded powers
+ are kept in the workspace and grow on demand.
+
+ \attention
+ The running time depends on the powers. It must only be used with public
+ powers. Use EcGlvSscmMultiExpWithWorkspace() for secret powers.
+
+ \param[in] glv
+ The endomorphism data of the group of a and r.
+ \param[in] a
+ The bases.
+ \param[in] b
+ The powers. Power must be less than the order of the elliptic curve
+ group.
+ \param[in] m
+ Number of entries in a and b. Must not exceed the size the workspace was
+ created with.
+ \param[in,out] ws
+ The workspace.
+ \param[out] r
+ The result of raising each a to the corresponding power b and
+ multiplying the results.
+
+ \returns ::EpidStatus
+
+ \see NewExpWorkspace
+ \see EcGlvMultiExp
+*/
+EpidStatus EcGlvMultiExpWithWorkspace(EcGlvState* glv, EcPoint const** a,
+                                      BigNumStr const** b, size_t m,
+                                      ExpWorkspace* ws, EcPoint* r);
+
+/// Software side-channel mitigated EcGlvMultiExpWithWorkspace.
+/*!
+ Gives the same result as EcGlvSscmMultiExp(). The recoded powers are
+ cleared from the workspace before returning.
+
+ \param[in] glv
+ The endomorphism data of the group of a and r.
+ \param[in] a
+ The bases.
+ \param[in] b
+ The powers. Power must be less than the order of the elliptic curve
+ group.
+ \param[in] m
+ Number of entries in a and b. Must not exceed the size the workspace was
+ created with.
+ \param[in,out] ws
+ The workspace.
+ \param[out] r
+ The result of raising each a to the corresponding power b and
+ multiplying the results.
+
+ \returns ::EpidStatus
+
+ \see NewExpWorkspace
+ \see EcGlvSscmMultiExp
+*/
+EpidStatus EcGlvSscmMultiExpWithWorkspace(EcGlvState* glv, EcPoint const** a,
+                                          BigNumStr const** b, size_t m,
+                                          ExpWorkspace* ws, EcPoint* r);
+
+/*!
+  @}
+*/
+
+#endif  // EPID_INTERNAL_IPPMATH_INCLUDE_IPPMATH_EXPWORKSPACE_H_
@@ -98,6 +98,68 @@ void DeletePairingState(PairingState** ps);
 EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
                    FfElement* d);
 
+/// Miller loop lines precomputed for a fixed second pairing argument
+typedef struct PairingG2Precomp PairingG2Precomp;
+
+/// Precomputes the Miller loop lines for a fixed second pairing argument.
+/*!
+ The line functions of the Optimal Ate Miller loop depend only on the
+ second argument of the pairing. When the same G2 point is paired many
+ times (e.g. the generator g2), they can be computed once and reused by
+ PairingWithPrecomputedG2().
+
+ Use DeletePairingG2Precomp() to free memory.
+
+ \param[in] ps
+ The pairing state.
+ \param[in] b
+ The second value to pair. Must be in gb used to create ps.
+ \param[out] precomp
+ Newly constructed precomputed lines.
+
+ \returns ::EpidStatus
+
+ \attention It is the responsibility of the caller to ensure that ps exists
+ for the entire lifetime of the new PairingG2Precomp.
+
+ \see DeletePairingG2Precomp
+ \see PairingWithPrecomputedG2
+*/
+EpidStatus PairingPrecomputeG2(PairingState* ps, EcPoint const* b,
+                               PairingG2Precomp** precomp);
+
+/// Frees lines previously allocated by PairingPrecomputeG2.
+/*!
+ Frees memory pointed to by precomp. Nulls the pointer.
+
+ \param[in] precomp
+ The precomputed lines. Can be NULL.
+
+ \see PairingPrecomputeG2
+*/
+void DeletePairingG2Precomp(PairingG2Precomp** precomp);
+
+/// Computes an Optimal Ate Pairing with a precomputed second parameter.
+/*!
+ Gives the same result as Pairing() for the G2 point used to create precomp.
+
+ \param[in] ps
+ The pairing state.
+ \param[in] a
+ The first value to pair. Must be in ga used to create ps.
+ \param[in] precomp
+ The lines precomputed for the second value with the same ps.
+ \param[out] d
+ The result of the pairing. Will be in ff used to create the pairing state.
+
+ \returns ::EpidStatus
+
+ \see PairingPrecomputeG2
+*/
+EpidStatus PairingWithPrecomputedG2(PairingState* ps, EcPoint const* a,
+                                    PairingG2Precomp const* precomp,
+                                    FfElement* d);
+
 /*!
   @}
 */
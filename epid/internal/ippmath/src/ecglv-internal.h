@@ -0,0 +1,116 @@
+/*############################################################################
+  # Copyright 2016-2019 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+
+/*!
+ * \file
+ * \brief Endomorphism accelerated exponentiation private interface.
+ */
+
+#ifndef EPID_INTERNAL_IPPMATH_SRC_ECGLV_INTERNAL_H_
+#define EPID_INTERNAL_IPPMATH_SRC_ECGLV_INTERNAL_H_
+
+#include <ippcp.h>
+#include "ecgroup-internal.h"
+#include "finitefield-internal.h"
+
+/// Maximum number of sub-powers a power is decomposed into
+#define GLV_MAX_DIM 4
+/// Number of 32-bit words of a power
+#define GLV_POWER_WORDS (sizeof(BigNumStr) / sizeof(Ipp32u))
+/// Number of 32-bit words of the signed integers used in the decomposition
+#define GLV_WORDS 12
+/// Number of fraction bits of the rounding constants
+#define GLV_ROUND_BITS 288
+/// Number of 32-bit words of the rounding constants
+#define GLV_ROUND_WORDS (GLV_ROUND_BITS / 32)
+/// Window width of the recoded sub-powers
+#define GLV_WINDOW 5
+/// Number of odd multiples 1, 3, ..., 2^GLV_WINDOW - 1 of a base in a table
+#define GLV_TABLE_SIZE (1 << (GLV_WINDOW - 1))
+
+/// Endomorphism data for an elliptic curve group of a pairing
+struct EcGlvState {
+  /// Elliptic curve group
+  EcGroup* g;
+  /// Number of sub-powers: 2 for G1, 4 for G2
+  size_t dim;
+  /// Number of recoded digits of a sub-power
+  size_t num_digits;
+  /// x-coordinate multiplier of the i-th power of the endomorphism
+  FfElement* cx[GLV_MAX_DIM];
+  /// y-coordinate multiplier of the i-th power of the endomorphism
+  FfElement* cy[GLV_MAX_DIM];
+  /// Whether the i-th power of the endomorphism conjugates the coordinates
+  bool conj[GLV_MAX_DIM];
+  /// Order of the group, least significant word first
+  Ipp32u order[GLV_POWER_WORDS];
+  /// floor(|l[j]| * 2^GLV_ROUND_BITS / order) where l is the first row of
+  /// the inverse lattice basis scaled by order
+  Ipp32u round[GLV_MAX_DIM][GLV_ROUND_WORDS];
+  /// Whether l[j] is negative
+  bool round_neg[GLV_MAX_DIM];
+  /// Lattice basis, two's complement, least significant word first
+  Ipp32u basis[GLV_MAX_DIM][GLV_MAX_DIM][GLV_WORDS];
+};
+
+/// Number of scratch field elements used to build a table
+#define GLV_SCRATCH_SIZE 8
+/// Number of points whose coordinates are computed for a table: the odd
+/// multiples followed by the double of the base
+#define GLV_TABLE_POINTS (GLV_TABLE_SIZE + 1)
+
+/// Field elements used to build the tables of a base
+typedef struct GlvScratch {
+  /// Jacobian X coordinates of the table points
+  FfElement* x[GLV_TABLE_POINTS];
+  /// Jacobian Y coordinates of the table points
+  FfElement* y[GLV_TABLE_POINTS];
+  /// Jacobian Z coordinates of the table points
+  FfElement* z[GLV_TABLE_POINTS];
+  /// Prefix products and inverses of the Z coordinates
+  FfElement* zi[GLV_TABLE_POINTS];
+  /// Temporaries
+  FfElement* t[GLV_SCRATCH_SIZE];
+  /// x-coordinate of a mapped or loaded point
+  FfElement* mx;
+  /// y-coordinate of a mapped or loaded point
+  FfElement* my;
+} GlvScratch;
+
+/// Temporary state of an endomorphism accelerated multi-exponentiation
+typedef struct GlvWorkspace {
+  /// Tables, selection buffer and recoded powers
+  Ipp32u* buffer;
+  /// Size of buffer in bytes
+  size_t buffer_size;
+  /// Group scratch, acc and t were created for (NULL = none)
+  EcGroup const* g;
+  /// Field elements used to build the tables
+  GlvScratch scratch;
+  /// Accumulator
+  EcPoint* acc;
+  /// Loaded table entry
+  EcPoint* t;
+} GlvWorkspace;
+
+/// Frees the memory held by a GLV workspace
+/*!
+ \param[in,out] gw
+ The workspace. Its members are nulled.
+*/
+void DeleteGlvWorkspace(GlvWorkspace* gw);
+
+#endif  // EPID_INTERNAL_IPPMATH_SRC_ECGLV_INTERNAL_H_
@@ -0,0 +1,1198 @@
+/*############################################################################
+  # Copyright 2016-2019 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+
+/*!
+ * \file
+ * \brief Endomorphism accelerated elliptic curve exponentiation
+ * implementation.
+ *
+ * A power k is written as k = k[0] + k[1]*L + ... + k[dim-1]*L^(dim-1)
+ * mod order, where L is the eigenvalue of the endomorphism phi, using
+ * Babai rounding against a short basis of the lattice of such
+ * decompositions of 0. The digits of all sub-powers of all bases are
+ * processed together with shared doublings.
+ *
+ * The side-channel mitigated functions make each sub-power odd and recode
+ * it into signed odd digits of GLV_WINDOW bits, so that every digit is
+ * non-zero and the sequence of point operations does not depend on the
+ * power. The other functions recode the sub-powers into NAFs of width
+ * GLV_WINDOW + 1 and skip the zero digits.
+ *
+ * The tables of odd multiples are computed in Jacobian coordinates with
+ * one field inversion per base and the endomorphism is applied to the
+ * resulting affine points.
+ */
+
+#include "ippmath/ecglv.h"
+#include <ippcp.h>
+#include <string.h>
+#include "ippmath/expworkspace.h"
+#include "ippmath/memory.h"
+#include "ecglv-internal.h"
+#include "ecgroup-internal.h"
+#include "expworkspace-internal.h"
+#include "finitefield-internal.h"
+#include "pairing-internal.h"
+
+/// Handle Ipp Errors with Break
+#define BREAK_ON_IPP_ERROR(sts, ret)           \
+  {                                            \
+    IppStatus temp_sts = (sts);                \
+    if (ippStsNoErr != temp_sts) {             \
+      if (ippStsContextMatchErr == temp_sts) { \
+        (ret) = kEpidBadArgErr;                \
+      } else {                                 \
+        (ret) = kEpidMathErr;                  \
+      }                                        \
+      break;                                   \
+    }                                          \
+  }
+/// Handle SDK Error with Break
+#define BREAK_ON_EPID_ERROR(ret) \
+  if (kEpidNoErr != (ret)) {     \
+    break;                       \
+  }
+
+/// Number of coefficients of the polynomials in the BN parameter u
+#define GLV_POLY_SIZE 5
+/// Number of 32-bit words of a table entry (x, y and -y)
+#define GLV_ENTRY_WORDS(words) (3 * (words))
+/// Number of 32-bit words of the table of one base and endomorphism power.
+/// The odd multiples are followed by the double of the base.
+#define GLV_TABLE_WORDS(words) ((GLV_TABLE_SIZE + 1) * GLV_ENTRY_WORDS(words))
+
+/*
+  The constants below are polynomials in u, lowest degree first, where
+  u = -t if neg is set and u = t otherwise.
+*/
+/// Order of the groups: 36u^4 + 36u^3 + 18u^2 + 6u + 1
+static const int kBnOrder[GLV_POLY_SIZE] = {1, 6, 18, 36, 36};
+/// Cube root of unity in Fq: 18u^3 + 18u^2 + 9u + 1
+static const int kG1Beta[GLV_POLY_SIZE] = {1, 9, 18, 18, 0};
+/// Basis of the G1 lattice; (x, y) -> (beta*x, y) acts as 36u^3+18u^2+6u+1
+static const int kG1Basis[2][2][GLV_POLY_SIZE] = {
+    {{1, 2, 0, 0, 0}, {0, -2, -6, 0, 0}},
+    {{1, 4, 6, 0, 0}, {1, 2, 0, 0, 0}}};
+/// First row of the inverse of kG1Basis multiplied by the order
+static const int kG1Round[2][GLV_POLY_SIZE] = {{1, 2, 0, 0, 0},
+                                              {0, 2, 6, 0, 0}};
+/// Basis of the G2 lattice; psi acts as 6u^2
+static const int kG2Basis[4][4][GLV_POLY_SIZE] = {
+    {{1, 1}, {0, 1}, {0, 1}, {0, -2}},
+    {{1, 2}, {0, -1}, {-1, -1}, {0, -1}},
+    {{0, 2}, {1, 2}, {1, 2}, {1, 2}},
+    {{-1, 1}, {2, 4}, {1, -2}, {-1, 1}}};
+/// First row of the inverse of kG2Basis multiplied by the order
+static const int kG2Round[4][GLV_POLY_SIZE] = {{1, 3, 2, 0, 0},
+                                              {0, 1, 8, 12, 0},
+                                              {0, 1, 4, 6, 0},
+                                              {0, -1, -2, 0, 0}};
+
+/// r = a * b mod 2^(32*rn); r must not overlap a or b
+static void GlvMul(Ipp32u* r, size_t rn, Ipp32u const* a, size_t an,
+                   Ipp32u const* b, size_t bn) {
+  size_t i = 0;
+  size_t j = 0;
+  for (i = 0; i < rn; i++) {
+    r[i] = 0;
+  }
+  for (i = 0; i < an && i < rn; i++) {
+    Ipp64u carry = 0;
+    for (j = 0; j < bn && i + j < rn; j++) {
+      carry += (Ipp64u)a[i] * b[j] + r[i + j];
+      r[i + j] = (Ipp32u)carry;
+      carry >>= 32;
+    }
+    if (i + j < rn) {
+      r[i + j] = (Ipp32u)carry;
+    }
+  }
+}
+
+/// r = r + a mod 2^(32*n)
+static void GlvAdd(Ipp32u* r, Ipp32u const* a, size_t n) {
+  Ipp64u carry = 0;
+  size_t i = 0;
+  for (i = 0; i < n; i++) {
+    carry += (Ipp64u)r[i] + a[i];
+    r[i] = (Ipp32u)carry;
+    carry >>= 32;
+  }
+}
+
+/// r = r - a mod 2^(32*n)
+static void GlvSub(Ipp32u* r, Ipp32u const* a, size_t n) {
+  Ipp64u borrow = 0;
+  size_t i = 0;
+  for (i = 0; i < n; i++) {
+    Ipp64u d = (Ipp64u)r[i] - a[i] - borrow;
+    r[i] = (Ipp32u)d;
+    borrow = (d >> 32) & 1;
+  }
+}
+
+/// r = -r mod 2^(32*n) if mask is all ones; r is unchanged if mask is 0
+static void GlvCondNeg(Ipp32u* r, size_t n, Ipp32u mask) {
+  Ipp64u carry = mask & 1;
+  size_t i = 0;
+  for (i = 0; i < n; i++) {
+    carry += (Ipp64u)(r[i] ^ mask);
+    r[i] = (Ipp32u)carry;
+    carry >>= 32;
+  }
+}
+
+/// Returns all ones if the two's complement integer a is negative, 0 if not
+static Ipp32u GlvSignMask(Ipp32u const* a, size_t n) {
+  return (Ipp32u)0 - (a[n - 1] >> 31);
+}
+
+/// r = v as a two's complement integer
+static void GlvSetInt(Ipp32u* r, size_t n, int v) {
+  Ipp32u ext = (v < 0) ? ~(Ipp32u)0 : 0;
+  size_t i = 0;
+  r[0] = (Ipp32u)v;
+  for (i = 1; i < n; i++) {
+    r[i] = ext;
+  }
+}
+
+/// Compares a and b, returns a positive, zero or negative value
+static int GlvCmp(Ipp32u const* a, Ipp32u const* b, size_t n) {
+  while (n-- > 0) {
+    if (a[n] != b[n]) {
+      return (a[n] > b[n]) ? 1 : -1;
+    }
+  }
+  return 0;
+}
+
+/// Returns the number of significant bits of a
+static size_t GlvBitSize(Ipp32u const* a, size_t n) {
+  while (n-- > 0) {
+    if (a[n]) {
+      size_t bits = n * 32;
+      Ipp32u w = a[n];
+      while (w) {
+        bits++;
+        w >>= 1;
+      }
+      return bits;
+    }
+  }
+  return 0;
+}
+
+/// Returns num_bits (< 32) bits of a starting at bit pos
+static Ipp32u GlvGetBits(Ipp32u const* a, size_t pos, size_t num_bits) {
+  size_t word = pos / 32;
+  size_t shift = pos % 32;
+  Ipp32u bits = a[word] >> shift;
+  if (shift + num_bits > 32) {
+    bits |= a[word + 1] << (32 - shift);
+  }
+  return bits & (((Ipp32u)1 << num_bits) - 1);
+}
+
+/// r = c[0] + c[1]*u + ... + c[GLV_POLY_SIZE-1]*u^(GLV_POLY_SIZE-1)
+static void GlvPoly(Ipp32u* r, Ipp32u const* u, int const* c) {
+  Ipp32u t[GLV_WORDS];
+  Ipp32u ci[GLV_WORDS];
+  size_t i = GLV_POLY_SIZE - 1;
+  size_t j = 0;
+  GlvSetInt(r, GLV_WORDS, c[i]);
+  while (i-- > 0) {
+    GlvMul(t, GLV_WORDS, r, GLV_WORDS, u, GLV_WORDS);
+    GlvSetInt(ci, GLV_WORDS, c[i]);
+    GlvAdd(t, ci, GLV_WORDS);
+    for (j = 0; j < GLV_WORDS; j++) {
+      r[j] = t[j];
+    }
+  }
+}
+
+/// q = floor(a * 2^GLV_ROUND_BITS / d) for a non-negative a < d
+static void GlvRoundConst(Ipp32u* q, Ipp32u const* a, Ipp32u const* d) {
+  Ipp32u rem[GLV_POWER_WORDS + 1] = {0};
+  Ipp32u div[GLV_POWER_WORDS + 1] = {0};
+  size_t i = 0;
+  for (i = 0; i < GLV_POWER_WORDS; i++) {
+    div[i] = d[i];
+  }
+  for (i = 0; i < GLV_ROUND_WORDS; i++) {
+    q[i] = 0;
+  }
+  i = GLV_WORDS * 32 + GLV_ROUND_BITS;
+  while (i-- > 0) {
+    size_t j = GLV_POWER_WORDS + 1;
+    Ipp32u bit = 0;
+    if (i >= GLV_ROUND_BITS) {
+      bit = GlvGetBits(a, i - GLV_ROUND_BITS, 1);
+    }
+    // rem = 2 * rem + bit
+    while (--j > 0) {
+      rem[j] = (rem[j] << 1) | (rem[j - 1] >> 31);
+    }
+    rem[0] = (rem[0] << 1) | bit;
+    if (GlvCmp(rem, div, GLV_POWER_WORDS + 1) >= 0) {
+      GlvSub(rem, div, GLV_POWER_WORDS + 1);
+      if (i < GLV_ROUND_BITS) {
+        q[i / 32] |= (Ipp32u)1 << (i % 32);
+      }
+    }
+  }
+}
+
+/// Reads a big endian power into words, least significant word first
+static void GlvReadPower(Ipp32u* r, BigNumStr const* b) {
+  unsigned char const* s = (unsigned char const*)b;
+  size_t i = 0;
+  for (i = 0; i < GLV_POWER_WORDS; i++) {
+    unsigned char const* w = s + sizeof(BigNumStr) - 4 * (i + 1);
+    r[i] = ((Ipp32u)w[0] << 24) | ((Ipp32u)w[1] << 16) | ((Ipp32u)w[2] << 8) |
+           (Ipp32u)w[3];
+  }
+}
+
+EpidStatus NewEcGlvState(PairingState const* ps, EcGroup* g,
+                         EcGlvState** glv) {
+  EpidStatus result = kEpidErr;
+  EcGlvState* state = NULL;
+
+  if (!ps || !ps->t) {
+    return kEpidBadArgErr;
+  }
+  if (!g || !g->ff || !g->ipp_ec) {
+    return kEpidBadArgErr;
+  }
+  if (g != ps->ga && g != ps->gb) {
+    return kEpidBadArgErr;
+  }
+  if (!glv) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    IppStatus sts = ippStsNoErr;
+    BigNumStr t_str = {0};
+    Ipp32u u[GLV_WORDS] = {0};
+    Ipp32u v[GLV_WORDS] = {0};
+    int const* basis = NULL;
+    int const* round = NULL;
+    size_t bits = 0;
+    size_t i = 0;
+    size_t j = 0;
+
+    state = (EcGlvState*)SAFE_ALLOC(sizeof(EcGlvState));
+    if (!state) {
+      result = kEpidMemAllocErr;
+      break;
+    }
+    state->g = g;
+    // u = -t if neg is set, t otherwise
+    result = WriteBigNum(ps->t, sizeof(t_str), &t_str);
+    BREAK_ON_EPID_ERROR(result);
+    GlvReadPower(u, &t_str);
+    if (ps->neg) {
+      GlvCondNeg(u, GLV_WORDS, ~(Ipp32u)0);
+    }
+    GlvPoly(v, u, kBnOrder);
+    for (i = 0; i < GLV_POWER_WORDS; i++) {
+      state->order[i] = v[i];
+    }
+
+    if (g == ps->ga) {
+      // phi(x, y) = (beta*x, y)
+      Ipp32u sign = 0;
+      state->dim = 2;
+      basis = &kG1Basis[0][0][0];
+      round = &kG1Round[0][0];
+      result = NewFfElement(g->ff, &state->cx[1]);
+      BREAK_ON_EPID_ERROR(result);
+      GlvPoly(v, u, kG1Beta);
+      sign = GlvSignMask(v, GLV_WORDS);
+      GlvCondNeg(v, GLV_WORDS, sign);
+      sts = ippsGFpSetElement(v, (int)GLV_POWER_WORDS,
+                              state->cx[1]->ipp_ff_elem, g->ff->ipp_ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      if (sign) {
+        sts = ippsGFpNeg(state->cx[1]->ipp_ff_elem, state->cx[1]->ipp_ff_elem,
+                         g->ff->ipp_ff);
+        BREAK_ON_IPP_ERROR(sts, result);
+      }
+    } else {
+      // psi^i(x, y) = (conj^i(x) * g[i-1][1], conj^i(y) * g[i-1][2])
+      state->dim = 4;
+      basis = &kG2Basis[0][0][0];
+      round = &kG2Round[0][0];
+      for (i = 1; i < state->dim; i++) {
+        result = NewFfElement(g->ff, &state->cx[i]);
+        BREAK_ON_EPID_ERROR(result);
+        result = NewFfElement(g->ff, &state->cy[i]);
+        BREAK_ON_EPID_ERROR(result);
+        sts = ippsGFpCpyElement(ps->g[i - 1][1]->ipp_ff_elem,
+                                state->cx[i]->ipp_ff_elem, g->ff->ipp_ff);
+        BREAK_ON_IPP_ERROR(sts, result);
+        sts = ippsGFpCpyElement(ps->g[i - 1][2]->ipp_ff_elem,
+                                state->cy[i]->ipp_ff_elem, g->ff->ipp_ff);
+        BREAK_ON_IPP_ERROR(sts, result);
+        state->conj[i] = (1 == i % 2);
+      }
+      BREAK_ON_EPID_ERROR(result);
+    }
+
+    for (j = 0; j < state->dim; j++) {
+      Ipp32u sign = 0;
+      for (i = 0; i < state->dim; i++) {
+        GlvPoly(state->basis[j][i], u,
+                basis + (j * state->dim + i) * GLV_POLY_SIZE);
+      }
+      GlvPoly(v, u, round + j * GLV_POLY_SIZE);
+      sign = GlvSignMask(v, GLV_WORDS);
+      GlvCondNeg(v, GLV_WORDS, sign);
+      GlvRoundConst(state->round[j], v, state->order);
+      state->round_neg[j] = (0 != sign);
+    }
+
+    // Rounding is off by less than 2 per basis vector, so
+    // |k[i]| < 2 * sum_j |basis[j][i]|, plus at most 2 to make it odd
+    for (i = 0; i < state->dim; i++) {
+      Ipp32u bound[GLV_WORDS] = {0};
+      Ipp32u two[GLV_WORDS] = {0};
+      for (j = 0; j < state->dim; j++) {
+        Ipp32u b[GLV_WORDS];
+        size_t w = 0;
+        for (w = 0; w < GLV_WORDS; w++) {
+          b[w] = state->basis[j][i][w];
+        }
+        GlvCondNeg(b, GLV_WORDS, GlvSignMask(b, GLV_WORDS));
+        GlvAdd(bound, b, GLV_WORDS);
+      }
+      GlvAdd(bound, bound, GLV_WORDS);
+      GlvSetInt(two, GLV_WORDS, 2);
+      GlvAdd(bound, two, GLV_WORDS);
+      if (GlvBitSize(bound, GLV_WORDS) > bits) {
+        bits = GlvBitSize(bound, GLV_WORDS);
+      }
+    }
+    state->num_digits = (bits + GLV_WINDOW - 1) / GLV_WINDOW;
+
+    *glv = state;
+    result = kEpidNoErr;
+  } while (0);
+
+  if (kEpidNoErr != result) {
+    DeleteEcGlvState(&state);
+  }
+  return result;
+}
+
+void DeleteEcGlvState(EcGlvState** glv) {
+  if (glv && *glv) {
+    size_t i = 0;
+    for (i = 0; i < GLV_MAX_DIM; i++) {
+      DeleteFfElement(&(*glv)->cx[i]);
+      DeleteFfElement(&(*glv)->cy[i]);
+    }
+    (*glv)->g = NULL;
+    SAFE_FREE(*glv);
+  }
+}
+
+/// Applies the e-th power of the endomorphism to the point (x, y)
+static EpidStatus GlvMap(EcGlvState const* glv, size_t e, FfElement const* x,
+                         FfElement const* y, FfElement* rx, FfElement* ry) {
+  EpidStatus result = kEpidErr;
+  IppsGFpState* ff = glv->g->ff->ipp_ff;
+  do {
+    IppStatus sts = ippStsNoErr;
+    if (glv->conj[e]) {
+      sts = ippsGFpConj(x->ipp_ff_elem, rx->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      sts = ippsGFpConj(y->ipp_ff_elem, ry->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+    } else {
+      sts = ippsGFpCpyElement(x->ipp_ff_elem, rx->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      sts = ippsGFpCpyElement(y->ipp_ff_elem, ry->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    if (glv->cx[e]) {
+      sts = ippsGFpMul(rx->ipp_ff_elem, glv->cx[e]->ipp_ff_elem,
+                       rx->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    if (glv->cy[e]) {
+      sts = ippsGFpMul(ry->ipp_ff_elem, glv->cy[e]->ipp_ff_elem,
+                       ry->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    result = kEpidNoErr;
+  } while (0);
+  return result;
+}
+
+/// Allocates the field elements of scratch
+static EpidStatus NewGlvScratch(FiniteField* ff, GlvScratch* scratch) {
+  EpidStatus result = kEpidNoErr;
+  size_t j = 0;
+  for (j = 0; j < GLV_TABLE_POINTS && kEpidNoErr == result; j++) {
+    result = NewFfElement(ff, &scratch->x[j]);
+    if (kEpidNoErr == result) result = NewFfElement(ff, &scratch->y[j]);
+    if (kEpidNoErr == result) result = NewFfElement(ff, &scratch->z[j]);
+    if (kEpidNoErr == result) result = NewFfElement(ff, &scratch->zi[j]);
+  }
+  for (j = 0; j < GLV_SCRATCH_SIZE && kEpidNoErr == result; j++) {
+    result = NewFfElement(ff, &scratch->t[j]);
+  }
+  if (kEpidNoErr == result) result = NewFfElement(ff, &scratch->mx);
+  if (kEpidNoErr == result) result = NewFfElement(ff, &scratch->my);
+  return result;
+}
+
+/// Frees the field elements of scratch
+static void DeleteGlvScratch(GlvScratch* scratch) {
+  size_t j = 0;
+  for (j = 0; j < GLV_TABLE_POINTS; j++) {
+    DeleteFfElement(&scratch->x[j]);
+    DeleteFfElement(&scratch->y[j]);
+    DeleteFfElement(&scratch->z[j]);
+    DeleteFfElement(&scratch->zi[j]);
+  }
+  for (j = 0; j < GLV_SCRATCH_SIZE; j++) {
+    DeleteFfElement(&scratch->t[j]);
+  }
+  DeleteFfElement(&scratch->mx);
+  DeleteFfElement(&scratch->my);
+}
+
+/// Doubles affine point j of scratch into Jacobian point d
+/*!
+  Uses the a = 0 doubling formulas: 2M + 5S.
+*/
+static EpidStatus GlvJacobianDouble(IppsGFpState* ff, GlvScratch* s,
+                                    size_t j, size_t d) {
+  EpidStatus result = kEpidErr;
+  IppsGFpElement* x = s->x[j]->ipp_ff_elem;
+  IppsGFpElement* y = s->y[j]->ipp_ff_elem;
+  IppsGFpElement* t0 = s->t[0]->ipp_ff_elem;
+  IppsGFpElement* t1 = s->t[1]->ipp_ff_elem;
+  IppsGFpElement* t2 = s->t[2]->ipp_ff_elem;
+  IppsGFpElement* t3 = s->t[3]->ipp_ff_elem;
+  IppsGFpElement* x3 = s->x[d]->ipp_ff_elem;
+  IppsGFpElement* y3 = s->y[d]->ipp_ff_elem;
+  IppsGFpElement* z3 = s->z[d]->ipp_ff_elem;
+  do {
+    IppStatus sts = ippStsNoErr;
+    // t0 = x^2, t1 = y^2, t2 = y^4
+    sts = ippsGFpSqr(x, t0, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSqr(y, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSqr(t1, t2, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // t1 = 2*((x + y^2)^2 - x^2 - y^4) = 4*x*y^2
+    sts = ippsGFpAdd(x, t1, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSqr(t1, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(t1, t0, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(t1, t2, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(t1, t1, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // t3 = 3*x^2
+    sts = ippsGFpAdd(t0, t0, t3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(t3, t0, t3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // x3 = t3^2 - 2*t1
+    sts = ippsGFpSqr(t3, x3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(x3, t1, x3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(x3, t1, x3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // y3 = t3*(t1 - x3) - 8*y^4
+    sts = ippsGFpSub(t1, x3, y3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(t3, y3, y3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(t2, t2, t2, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(t2, t2, t2, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(t2, t2, t2, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(y3, t2, y3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // z3 = 2*y
+    sts = ippsGFpAdd(y, y, z3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = kEpidNoErr;
+  } while (0);
+  return result;
+}
+
+/// Adds Jacobian point d of scratch to Jacobian point j into point j + 1
+/*!
+  The points must be different and not opposite. t[6] and t[7] must hold
+  z[d]^2 and z[d]^3. Uses the general addition formulas: 12M + 4S.
+*/
+static EpidStatus GlvJacobianAdd(IppsGFpState* ff, GlvScratch* s, size_t j,
+                                 size_t d) {
+  EpidStatus result = kEpidErr;
+  IppsGFpElement* x1 = s->x[j]->ipp_ff_elem;
+  IppsGFpElement* y1 = s->y[j]->ipp_ff_elem;
+  IppsGFpElement* z1 = s->z[j]->ipp_ff_elem;
+  IppsGFpElement* x2 = s->x[d]->ipp_ff_elem;
+  IppsGFpElement* y2 = s->y[d]->ipp_ff_elem;
+  IppsGFpElement* z2 = s->z[d]->ipp_ff_elem;
+  IppsGFpElement* x3 = s->x[j + 1]->ipp_ff_elem;
+  IppsGFpElement* y3 = s->y[j + 1]->ipp_ff_elem;
+  IppsGFpElement* z3 = s->z[j + 1]->ipp_ff_elem;
+  IppsGFpElement* t0 = s->t[0]->ipp_ff_elem;
+  IppsGFpElement* t1 = s->t[1]->ipp_ff_elem;
+  IppsGFpElement* t2 = s->t[2]->ipp_ff_elem;
+  IppsGFpElement* t3 = s->t[3]->ipp_ff_elem;
+  IppsGFpElement* t4 = s->t[4]->ipp_ff_elem;
+  IppsGFpElement* t5 = s->t[5]->ipp_ff_elem;
+  IppsGFpElement* z2z2 = s->t[6]->ipp_ff_elem;
+  IppsGFpElement* z2z2z2 = s->t[7]->ipp_ff_elem;
+  do {
+    IppStatus sts = ippStsNoErr;
+    // t0 = z1^2, t1 = u1 = x1*z2^2, t2 = u2 = x2*z1^2
+    sts = ippsGFpSqr(z1, t0, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(x1, z2z2, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(x2, t0, t2, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // t3 = s1 = y1*z2^3, t4 = s2 = y2*z1^3
+    sts = ippsGFpMul(y1, z2z2z2, t3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(z1, t0, t4, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(y2, t4, t4, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // t2 = h = u2 - u1, t4 = r = 2*(s2 - s1), t5 = i = (2*h)^2
+    sts = ippsGFpSub(t2, t1, t2, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(t4, t3, t4, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(t4, t4, t4, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(t2, t2, t5, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSqr(t5, t5, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // z3 = 2*z1*z2*h
+    sts = ippsGFpMul(z1, z2, z3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(z3, t2, z3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(z3, z3, z3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // t2 = j = h*i, t1 = v = u1*i
+    sts = ippsGFpMul(t2, t5, t2, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(t1, t5, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // x3 = r^2 - j - 2*v
+    sts = ippsGFpSqr(t4, x3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(x3, t2, x3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(x3, t1, x3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(x3, t1, x3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // y3 = r*(v - x3) - 2*s1*j
+    sts = ippsGFpSub(t1, x3, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(t4, t1, t1, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(t3, t2, t3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(t3, t3, t3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSub(t1, t3, y3, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = kEpidNoErr;
+  } while (0);
+  return result;
+}
+
+/// Fills the affine tables of all endomorphism powers of base a
+/*!
+  For each power e of the endomorphism the table holds
+  phi^e((2j+1)*a) for j = 0, ..., GLV_TABLE_SIZE - 1 followed by
+  phi^e(2*a).
+
+  The multiples are computed in Jacobian coordinates and converted to
+  affine coordinates with a single field inversion. Since the
+  endomorphism is applied to affine coordinates only one table is
+  computed per base.
+
+  a must not be the point at infinity.
+*/
+static EpidStatus GlvBuildTable(EcGlvState const* glv, EcPoint const* a,
+                                Ipp32u* table, GlvScratch* s) {
+  EpidStatus result = kEpidErr;
+  EcGroup* g = glv->g;
+  IppsGFpState* ff = g->ff->ipp_ff;
+  size_t words = (size_t)g->ff->element_len;
+  size_t const d = GLV_TABLE_SIZE;
+  size_t j = 0;
+  do {
+    IppStatus sts = ippStsNoErr;
+    Ipp32u const one = 1;
+    IppsGFpElement* inv = s->t[0]->ipp_ff_elem;
+    IppsGFpElement* zz = s->t[1]->ipp_ff_elem;
+    sts = ippsGFpECGetPoint(a->ipp_ec_pt, s->x[0]->ipp_ff_elem,
+                            s->y[0]->ipp_ff_elem, g->ipp_ec);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSetElement(&one, 1, s->z[0]->ipp_ff_elem, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = GlvJacobianDouble(ff, s, 0, d);
+    BREAK_ON_EPID_ERROR(result);
+    result = kEpidErr;
+    sts = ippsGFpSqr(s->z[d]->ipp_ff_elem, s->t[6]->ipp_ff_elem, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(s->z[d]->ipp_ff_elem, s->t[6]->ipp_ff_elem,
+                     s->t[7]->ipp_ff_elem, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    for (j = 0; j + 1 < GLV_TABLE_SIZE; j++) {
+      result = GlvJacobianAdd(ff, s, j, d);
+      BREAK_ON_EPID_ERROR(result);
+    }
+    BREAK_ON_EPID_ERROR(result);
+    result = kEpidErr;
+
+    // batch inversion of the z coordinates
+    sts = ippsGFpCpyElement(s->z[0]->ipp_ff_elem, s->zi[0]->ipp_ff_elem, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    for (j = 1; j < GLV_TABLE_POINTS; j++) {
+      sts = ippsGFpMul(s->zi[j - 1]->ipp_ff_elem, s->z[j]->ipp_ff_elem,
+                       s->zi[j]->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    if (j < GLV_TABLE_POINTS) break;
+    sts = ippsGFpInv(s->zi[GLV_TABLE_POINTS - 1]->ipp_ff_elem, inv, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    for (j = GLV_TABLE_POINTS - 1; j > 0; j--) {
+      sts = ippsGFpMul(inv, s->zi[j - 1]->ipp_ff_elem, s->zi[j]->ipp_ff_elem,
+                       ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      sts = ippsGFpMul(inv, s->z[j]->ipp_ff_elem, inv, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    if (j > 0) break;
+    sts = ippsGFpCpyElement(inv, s->zi[0]->ipp_ff_elem, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+
+    for (j = 0; j < GLV_TABLE_POINTS; j++) {
+      size_t e = 0;
+      // (x, y) = (X/Z^2, Y/Z^3)
+      sts = ippsGFpSqr(s->zi[j]->ipp_ff_elem, zz, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      sts = ippsGFpMul(s->x[j]->ipp_ff_elem, zz, s->x[j]->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      sts = ippsGFpMul(zz, s->zi[j]->ipp_ff_elem, zz, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      sts = ippsGFpMul(s->y[j]->ipp_ff_elem, zz, s->y[j]->ipp_ff_elem, ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      for (e = 0; e < glv->dim; e++) {
+        Ipp32u* entry = table + e * GLV_TABLE_WORDS(words) +
+                        j * GLV_ENTRY_WORDS(words);
+        result = GlvMap(glv, e, s->x[j], s->y[j], s->mx, s->my);
+        BREAK_ON_EPID_ERROR(result);
+        result = kEpidErr;
+        sts = ippsGFpGetElement(s->mx->ipp_ff_elem, entry, (int)words, ff);
+        BREAK_ON_IPP_ERROR(sts, result);
+        sts = ippsGFpGetElement(s->my->ipp_ff_elem, entry + words, (int)words,
+                                ff);
+        BREAK_ON_IPP_ERROR(sts, result);
+        sts = ippsGFpNeg(s->my->ipp_ff_elem, s->my->ipp_ff_elem, ff);
+        BREAK_ON_IPP_ERROR(sts, result);
+        sts = ippsGFpGetElement(s->my->ipp_ff_elem, entry + 2 * words,
+                                (int)words, ff);
+        BREAK_ON_IPP_ERROR(sts, result);
+        result = kEpidNoErr;
+      }
+      if (kEpidNoErr != result) break;
+    }
+    if (j < GLV_TABLE_POINTS) break;
+    result = kEpidNoErr;
+  } while (0);
+  return result;
+}
+
+/// Splits power k into sub-powers
+/*!
+  sub[i] receives the absolute value of sub-power i and sign[i] is all
+  ones if it is negative and zero otherwise.
+
+  Runs in time independent of the value of k.
+*/
+static void GlvDecompose(EcGlvState const* glv, Ipp32u const* k,
+                         Ipp32u sub[GLV_MAX_DIM][GLV_WORDS],
+                         Ipp32u sign[GLV_MAX_DIM]) {
+  Ipp32u prod[GLV_POWER_WORDS + GLV_ROUND_WORDS];
+  Ipp32u beta[GLV_MAX_DIM][GLV_WORDS];
+  Ipp32u t[GLV_WORDS];
+  size_t i = 0;
+  size_t j = 0;
+
+  // beta[j] = round(k * l[j] / order)
+  for (j = 0; j < glv->dim; j++) {
+    GlvMul(prod, GLV_POWER_WORDS + GLV_ROUND_WORDS, k, GLV_POWER_WORDS,
+           glv->round[j], GLV_ROUND_WORDS);
+    for (i = 0; i < GLV_WORDS; i++) {
+      beta[j][i] = (i < GLV_POWER_WORDS) ? prod[GLV_ROUND_WORDS + i] : 0;
+    }
+    if (glv->round_neg[j]) {
+      GlvCondNeg(beta[j], GLV_WORDS, ~(Ipp32u)0);
+    }
+  }
+
+  for (i = 0; i < glv->dim; i++) {
+    // k[i] = (i == 0 ? k : 0) - sum_j beta[j] * basis[j][i]
+    for (j = 0; j < GLV_WORDS; j++) {
+      sub[i][j] = (0 == i && j < GLV_POWER_WORDS) ? k[j] : 0;
+    }
+    for (j = 0; j < glv->dim; j++) {
+      GlvMul(t, GLV_WORDS, beta[j], GLV_WORDS, glv->basis[j][i], GLV_WORDS);
+      GlvSub(sub[i], t, GLV_WORDS);
+    }
+    sign[i] = GlvSignMask(sub[i], GLV_WORDS);
+    GlvCondNeg(sub[i], GLV_WORDS, sign[i]);
+  }
+  EpidZeroMemory(prod, sizeof(prod));
+  EpidZeroMemory(beta, sizeof(beta));
+  EpidZeroMemory(t, sizeof(t));
+}
+
+/// Recodes a sub-power into regular signed odd digits
+/*!
+  digits[d] receives the table index of digit d in the low bits and
+  whether it is negative in bit 7. corr receives the index (0: a, 1: 2*a)
+  and sign of the point that has to be added to undo making the
+  sub-power odd.
+
+  sub is modified. Runs in time independent of the value of sub and sign.
+*/
+static void GlvRecodeRegular(EcGlvState const* glv, Ipp32u* sub, Ipp32u sign,
+                             unsigned char* digits, unsigned char* corr) {
+  Ipp32u t[GLV_WORDS];
+  Ipp32u odd = 0;
+  size_t n = glv->num_digits;
+  size_t d = 0;
+  // |k[i]| + 1 if even, |k[i]| + 2 if odd
+  odd = sub[0] & 1;
+  GlvSetInt(t, GLV_WORDS, (int)(1 + odd));
+  GlvAdd(sub, t, GLV_WORDS);
+  *corr = (unsigned char)(odd | (((sign & 1) ^ 1) << 7));
+
+  for (d = 0; d < n; d++) {
+    Ipp32u v = 1 | (GlvGetBits(sub, d * GLV_WINDOW + 1, GLV_WINDOW) << 1);
+    Ipp32u neg = 0;
+    if (d + 1 < n) {
+      // digit v - 2^GLV_WINDOW
+      Ipp32u mask = 0;
+      neg = ((v >> GLV_WINDOW) ^ 1) & 1;
+      mask = (Ipp32u)0 - neg;
+      v = ((v - ((Ipp32u)1 << GLV_WINDOW)) ^ mask) - mask;
+    }
+    digits[d] = (unsigned char)(((v - 1) >> 1) | ((neg ^ (sign & 1)) << 7));
+  }
+  EpidZeroMemory(t, sizeof(t));
+}
+
+/// Recodes a sub-power into its width GLV_WINDOW + 1 NAF
+/*!
+  naf[d] receives digit d: zero or an odd value of magnitude less than
+  2^GLV_WINDOW, negated if sign is set. The NAF of a sub-power has at
+  most glv->num_digits * GLV_WINDOW + 1 digits.
+
+  sub is modified. The running time depends on the value of sub.
+*/
+static void GlvRecodeNaf(Ipp32u* sub, Ipp32u sign, signed char* naf) {
+  Ipp32u t[GLV_WORDS];
+  Ipp32u zero[GLV_WORDS] = {0};
+  size_t d = 0;
+  for (d = 0; 0 != GlvCmp(sub, zero, GLV_WORDS); d++) {
+    int v = 0;
+    size_t w = 0;
+    if (sub[0] & 1) {
+      v = (int)(sub[0] & ((2u << GLV_WINDOW) - 1));
+      if (v >= (1 << GLV_WINDOW)) {
+        v -= 2 << GLV_WINDOW;
+      }
+      // sub - v is divisible by 2^(GLV_WINDOW + 1)
+      GlvSetInt(t, GLV_WORDS, v);
+      GlvSub(sub, t, GLV_WORDS);
+    }
+    naf[d] = (signed char)(sign ? -v : v);
+    for (w = 0; w + 1 < GLV_WORDS; w++) {
+      sub[w] = (sub[w] >> 1) | (sub[w + 1] << 31);
+    }
+    sub[GLV_WORDS - 1] >>= 1;
+  }
+}
+
+/// Loads entry (digit & 0x7f) * stride of table into p, negated if the
+/// high bit of digit is set
+/*!
+  If sscm is set all num entries are read and the entry is selected
+  without branches.
+*/
+static EpidStatus GlvLoadEntry(EcGroup* g, Ipp32u const* table,
+                               size_t stride, size_t num, unsigned char digit,
+                               bool sscm, Ipp32u* sel, FfElement* x,
+                               FfElement* y, EcPoint* p) {
+  EpidStatus result = kEpidErr;
+  size_t words = (size_t)g->ff->element_len;
+  Ipp32u index = digit & 0x7f;
+  Ipp32u neg = (Ipp32u)0 - (Ipp32u)(digit >> 7);
+  size_t j = 0;
+  size_t w = 0;
+  if (sscm) {
+    for (w = 0; w < 2 * words; w++) {
+      sel[w] = 0;
+    }
+    for (j = 0; j < num; j++) {
+      Ipp32u const* entry = table + j * stride * GLV_ENTRY_WORDS(words);
+      Ipp32u diff = (Ipp32u)j ^ index;
+      Ipp32u mask = (Ipp32u)0 - (((diff - 1) & ~diff) >> 31);
+      for (w = 0; w < words; w++) {
+        sel[w] |= entry[w] & mask;
+        sel[words + w] |=
+            ((entry[words + w] & ~neg) | (entry[2 * words + w] & neg)) & mask;
+      }
+    }
+  } else {
+    Ipp32u const* entry = table + index * stride * GLV_ENTRY_WORDS(words);
+    Ipp32u const* ey = entry + (neg ? 2 * words : words);
+    for (w = 0; w < words; w++) {
+      sel[w] = entry[w];
+      sel[words + w] = ey[w];
+    }
+  }
+  do {
+    IppStatus sts = ippStsNoErr;
+    sts = ippsGFpSetElement(sel, (int)words, x->ipp_ff_elem, g->ff->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSetElement(sel + words, (int)words, y->ipp_ff_elem,
+                            g->ff->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpECSetPoint(x->ipp_ff_elem, y->ipp_ff_elem, p->ipp_ec_pt,
+                            g->ipp_ec);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = kEpidNoErr;
+  } while (0);
+  return result;
+}
+
+/// Adds p to acc, or copies it if acc is not set yet
+static EpidStatus GlvAccumulate(EcGroup* g, EcPoint* acc, EcPoint const* p,
+                                bool* first) {
+  IppStatus sts = ippStsNoErr;
+  if (*first) {
+    sts = ippsGFpECCpyPoint(p->ipp_ec_pt, acc->ipp_ec_pt, g->ipp_ec);
+    *first = false;
+  } else {
+    sts = ippsGFpECAddPoint(acc->ipp_ec_pt, p->ipp_ec_pt, acc->ipp_ec_pt,
+                            g->ipp_ec);
+  }
+  if (ippStsNoErr != sts) {
+    if (ippStsContextMatchErr == sts) {
+      return kEpidBadArgErr;
+    } else {
+      return kEpidMathErr;
+    }
+  }
+  return kEpidNoErr;
+}
+
+void DeleteGlvWorkspace(GlvWorkspace* gw) {
+  if (!gw) {
+    return;
+  }
+  SAFE_FREE(gw->buffer);
+  gw->buffer_size = 0;
+  DeleteGlvScratch(&gw->scratch);
+  DeleteEcPoint(&gw->acc);
+  DeleteEcPoint(&gw->t);
+  gw->g = NULL;
+}
+
+/// Makes sure a GLV workspace can be used in g with size bytes of buffer
+static EpidStatus ReserveGlvWorkspace(GlvWorkspace* gw, EcGroup* g,
+                                      size_t size) {
+  EpidStatus result = kEpidNoErr;
+  if (size > gw->buffer_size) {
+    Ipp32u* buffer = (Ipp32u*)SAFE_ALLOC(size);
+    if (!buffer) {
+      return kEpidMemAllocErr;
+    }
+    SAFE_FREE(gw->buffer);
+    gw->buffer = buffer;
+    gw->buffer_size = size;
+  }
+  if (gw->g == g) {
+    return kEpidNoErr;
+  }
+  DeleteGlvScratch(&gw->scratch);
+  DeleteEcPoint(&gw->acc);
+  DeleteEcPoint(&gw->t);
+  gw->g = NULL;
+  result = NewGlvScratch(g->ff, &gw->scratch);
+  if (kEpidNoErr == result) result = NewEcPoint(g, &gw->acc);
+  if (kEpidNoErr == result) result = NewEcPoint(g, &gw->t);
+  if (kEpidNoErr == result) gw->g = g;
+  return result;
+}
+
+/// Multi-exponentiation in the group of glv
+/*!
+  If sscm is set the sub-powers are recoded into regular signed odd
+  digits and the table entries are selected without branches, otherwise
+  the sub-powers are recoded into NAFs and zero digits are skipped.
+
+  The temporary state is taken from gw. If gw is NULL it is allocated for
+  this call only.
+*/
+static EpidStatus GlvMultiExp(EcGlvState* glv, EcPoint const** a,
+                              BigNumStr const** b, size_t m, EcPoint* r,
+                              bool sscm, GlvWorkspace* gw) {
+  EpidStatus result = kEpidErr;
+  EcGroup* g = NULL;
+  size_t words = 0;
+  size_t dim = 0;
+  size_t n = 0;
+  size_t count = 0;
+  size_t i = 0;
+  size_t tables_words = 0;
+  size_t digits_size = 0;
+  Ipp32u* tables = NULL;
+  Ipp32u* sel = NULL;
+  unsigned char* digits = NULL;
+  unsigned char* corr = NULL;
+  signed char* naf = NULL;
+  GlvWorkspace local_gw = {0};
+
+  if (!glv || !glv->g || !glv->g->ff || !glv->g->ipp_ec) {
+    return kEpidBadArgErr;
+  }
+  if (!a || !b) {
+    return kEpidBadArgErr;
+  }
+  if (m <= 0) {
+    return kEpidBadArgErr;
+  }
+  if (!r || !r->ipp_ec_pt) {
+    return kEpidBadArgErr;
+  }
+  g = glv->g;
+  for (i = 0; i < m; i++) {
+    if (!a[i] || !a[i]->ipp_ec_pt || !b[i]) {
+      return kEpidBadArgErr;
+    }
+    if (g->ff->element_len != a[i]->element_len) {
+      return kEpidBadArgErr;
+    }
+  }
+  if (g->ff->element_len != r->element_len) {
+    return kEpidBadArgErr;
+  }
+  words = (size_t)g->ff->element_len;
+  dim = glv->dim;
+  // number of digits of a sub-power: regular digits or NAF digits
+  n = sscm ? glv->num_digits : glv->num_digits * GLV_WINDOW + 1;
+  tables_words = m * dim * GLV_TABLE_WORDS(words);
+  // regular digits are followed by one correction per sub-power
+  digits_size = m * dim * n + (sscm ? m * dim : 0);
+  if (!gw) {
+    gw = &local_gw;
+  }
+
+  do {
+    IppStatus sts = ippStsNoErr;
+    Ipp32u k[GLV_POWER_WORDS];
+    Ipp32u sub[GLV_MAX_DIM][GLV_WORDS];
+    Ipp32u sign[GLV_MAX_DIM];
+    bool first = true;
+    size_t d = 0;
+    size_t s = 0;
+    EcPoint* acc = NULL;
+    EcPoint* t = NULL;
+
+    result = ReserveGlvWorkspace(
+        gw, g, (tables_words + 2 * words) * sizeof(Ipp32u) + digits_size);
+    BREAK_ON_EPID_ERROR(result);
+    tables = gw->buffer;
+    sel = tables + tables_words;
+    if (sscm) {
+      digits = (unsigned char*)(sel + 2 * words);
+      corr = digits + m * dim * n;
+    } else {
+      naf = (signed char*)(sel + 2 * words);
+      // NAF recoding leaves the digits above the top one untouched
+      memset(naf, 0, digits_size);
+    }
+    acc = gw->acc;
+    t = gw->t;
+
+    for (i = 0; i < m; i++) {
+      IppECResult ec_result = ippECValid;
+      GlvReadPower(k, b[i]);
+      if (GlvCmp(k, glv->order, GLV_POWER_WORDS) > 0) {
+        result = kEpidBadArgErr;
+        break;
+      }
+      sts = ippsGFpECTstPoint(a[i]->ipp_ec_pt, &ec_result, g->ipp_ec);
+      BREAK_ON_IPP_ERROR(sts, result);
+      if (ippECPointIsAtInfinite == ec_result) {
+        continue;
+      }
+      result = GlvBuildTable(glv, a[i], tables + count * dim *
+                                                     GLV_TABLE_WORDS(words),
+                             &gw->scratch);
+      BREAK_ON_EPID_ERROR(result);
+      GlvDecompose(glv, k, sub, sign);
+      for (s = 0; s < dim; s++) {
+        if (sscm) {
+          GlvRecodeRegular(glv, sub[s], sign[s],
+                           digits + (count * dim + s) * n,
+                           corr + count * dim + s);
+        } else {
+          GlvRecodeNaf(sub[s], sign[s], naf + (count * dim + s) * n);
+        }
+      }
+      count++;
+    }
+    EpidZeroMemory(k, sizeof(k));
+    EpidZeroMemory(sub, sizeof(sub));
+    EpidZeroMemory(sign, sizeof(sign));
+    if (i < m) break;
+
+    result = kEpidNoErr;
+    for (d = n; d-- > 0 && kEpidNoErr == result;) {
+      size_t w = 0;
+      // a regular digit spans GLV_WINDOW bits, a NAF digit one bit
+      for (w = 0; w < (sscm ? GLV_WINDOW : 1) && !first; w++) {
+        sts = ippsGFpECAddPoint(acc->ipp_ec_pt, acc->ipp_ec_pt,
+                                acc->ipp_ec_pt, g->ipp_ec);
+        BREAK_ON_IPP_ERROR(sts, result);
+      }
+      for (s = 0; s < count * dim && kEpidNoErr == result; s++) {
+        unsigned char digit = 0;
+        if (sscm) {
+          digit = digits[s * n + d];
+        } else {
+          int v = naf[s * n + d];
+          if (0 == v) {
+            continue;
+          }
+          digit = (unsigned char)(((v < 0 ? -v : v) - 1) / 2);
+          digit |= (unsigned char)((v < 0) << 7);
+        }
+        result = GlvLoadEntry(g, tables + s * GLV_TABLE_WORDS(words), 1,
+                              GLV_TABLE_SIZE, digit, sscm, sel,
+                              gw->scratch.mx, gw->scratch.my, t);
+        if (kEpidNoErr == result) {
+          result = GlvAccumulate(g, acc, t, &first);
+        }
+      }
+    }
+    BREAK_ON_EPID_ERROR(result);
+
+    // undo making the sub-powers odd
+    for (s = 0; sscm && s < count * dim; s++) {
+      result = GlvLoadEntry(g, tables + s * GLV_TABLE_WORDS(words),
+                            GLV_TABLE_SIZE, 2, corr[s], sscm, sel,
+                            gw->scratch.mx, gw->scratch.my, t);
+      BREAK_ON_EPID_ERROR(result);
+      result = GlvAccumulate(g, acc, t, &first);
+      BREAK_ON_EPID_ERROR(result);
+    }
+    BREAK_ON_EPID_ERROR(result);
+
+    if (first) {
+      // all bases are the point at infinity or all powers are zero
+      sts = ippsGFpECSetPointAtInfinity(r->ipp_ec_pt, g->ipp_ec);
+    } else {
+      sts = ippsGFpECCpyPoint(acc->ipp_ec_pt, r->ipp_ec_pt, g->ipp_ec);
+    }
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = kEpidNoErr;
+  } while (0);
+
+  if (sel) {
+    // the selection buffer and the recoded powers follow the tables
+    EpidZeroMemory(sel, 2 * words * sizeof(Ipp32u) + digits_size);
+  }
+  if (gw == &local_gw) {
+    DeleteGlvWorkspace(&local_gw);
+  }
+  return result;
+}
+
+EpidStatus EcGlvExp(EcGlvState* glv, EcPoint const* a, BigNumStr const* b,
+                    EcPoint* r) {
+  return GlvMultiExp(glv, &a, &b, 1, r, false, NULL);
+}
+
+EpidStatus EcGlvSscmExp(EcGlvState* glv, EcPoint const* a, BigNumStr const* b,
+                        EcPoint* r) {
+  return GlvMultiExp(glv, &a, &b, 1, r, true, NULL);
+}
+
+EpidStatus EcGlvMultiExp(EcGlvState* glv, EcPoint const** a,
+                         BigNumStr const** b, size_t m, EcPoint* r) {
+  return GlvMultiExp(glv, a, b, m, r, false, NULL);
+}
+
+EpidStatus EcGlvSscmMultiExp(EcGlvState* glv, EcPoint const** a,
+                             BigNumStr const** b, size_t m, EcPoint* r) {
+  return GlvMultiExp(glv, a, b, m, r, true, NULL);
+}
+
+EpidStatus EcGlvMultiExpWithWorkspace(EcGlvState* glv, EcPoint const** a,
+                                      BigNumStr const** b, size_t m,
+                                      ExpWorkspace* ws, EcPoint* r) {
+  if (!ws) {
+    return kEpidBadArgErr;
+  }
+  if (m > ws->max_m) {
+    return kEpidBadArgErr;
+  }
+  return GlvMultiExp(glv, a, b, m, r, false, &ws->glv);
+}
+
+EpidStatus EcGlvSscmMultiExpWithWorkspace(EcGlvState* glv, EcPoint const** a,
+                                          BigNumStr const** b, size_t m,
+                                          ExpWorkspace* ws, EcPoint* r) {
+  if (!ws) {
+    return kEpidBadArgErr;
+  }
+  if (m > ws->max_m) {
+    return kEpidBadArgErr;
+  }
+  return GlvMultiExp(glv, a, b, m, r, true, &ws->glv);
+}
@@ -1173,12 +1173,234 @@ EpidStatus Epid11EcHash(EcGroup* g, ConstOctStr msg, size_t msg_len,
   return result;
 }
 
+/// Maximum number of 32-bit words of a field element checked by EcHash
+#define EPID_ECHASH_MAX_WORDS (sizeof(BigNumStr) / sizeof(Ipp32u))
+
+/*!
+Computes the Jacobi symbol (a/n) for an odd n.
+
+a and n are len words long, least significant word first. Both are
+modified. The running time depends on the values of a and n.
+
+\returns 1, -1 or 0
+*/
+static int JacobiSymbol(Ipp32u* a, Ipp32u* n, size_t len) {
+  int j = 1;
+  size_t i = 0;
+  for (;;) {
+    int cmp = 0;
+    Ipp32u borrow = 0;
+    for (i = 0; i < len && 0 == a[i]; i++) {
+    }
+    if (i == len) {
+      break;
+    }
+    // (2/n) = -1 if n = 3 or 5 mod 8
+    while (0 == (a[0] & 1)) {
+      for (i = 0; i + 1 < len; i++) {
+        a[i] = (a[i] >> 1) | (a[i + 1] << 31);
+      }
+      a[len - 1] >>= 1;
+      if (3 == (n[0] & 7) || 5 == (n[0] & 7)) {
+        j = -j;
+      }
+    }
+    for (i = len; i-- > 0;) {
+      if (a[i] != n[i]) {
+        cmp = (a[i] > n[i]) ? 1 : -1;
+        break;
+      }
+    }
+    // quadratic reciprocity: (a/n) = -(n/a) if a = n = 3 mod 4
+    if (cmp < 0) {
+      Ipp32u* t = a;
+      a = n;
+      n = t;
+      if (3 == (a[0] & 3) && 3 == (n[0] & 3)) {
+        j = -j;
+      }
+    }
+    for (i = 0; i < len; i++) {
+      Ipp64u d = (Ipp64u)a[i] - n[i] - borrow;
+      a[i] = (Ipp32u)d;
+      borrow = (Ipp32u)(d >> 63);
+    }
+  }
+  // n is the gcd of the inputs now
+  for (i = 1; i < len && 0 == n[i]; i++) {
+  }
+  return (1 == n[0] && i == len) ? j : 0;
+}
+
+/// Working state of the try-and-increment loop of EcHash
+typedef struct EcHashState {
+  /// the elliptic curve group
+  EcGroup* g;
+  /// hash of i || msg, initialized again for every attempt
+  IppsHashState* hash;
+  /// the hash algorithm
+  IppHashAlgId hash_id;
+  /// length of a digest in bytes
+  int digest_len;
+  /// the field prime, least significant word first
+  Ipp32u q[EPID_ECHASH_MAX_WORDS];
+  /// digest of i || msg as a number
+  BigNum* digest;
+  /// temporary for reductions modulo the field prime
+  BigNum* rem;
+  /// cofactor of the group, NULL if it is 1
+  BigNum* cofactor;
+  /// coefficient a of the curve
+  FfElement* ec_a;
+  /// coefficient b of the curve
+  FfElement* ec_b;
+  /// R mod q, where R is the Montgomery radix used by IPP for the field
+  FfElement* mont_r;
+  /// x-coordinate of the attempt
+  FfElement* x;
+  /// temporary
+  FfElement* t;
+} EcHashState;
+
+/*!
+Sets a field element to a number reduced modulo the field prime.
+
+\param[in,out] s the EcHash state
+\param[in] bn the number
+\param[out] elem the field element
+
+\returns ::EpidStatus
+*/
+static EpidStatus EcHashReduce(EcHashState* s, BigNum const* bn,
+                               FfElement* elem) {
+  EpidStatus result = kEpidErr;
+  size_t len = (size_t)s->g->ff->element_len;
+  do {
+    IppStatus sts = ippStsNoErr;
+    Ipp32u a[EPID_ECHASH_MAX_WORDS] = {0};
+    int bits = 0;
+    Ipp32u* data = NULL;
+    size_t k = 0;
+    sts = ippsMod_BN(bn->ipp_bn, s->g->ff->modulus_0->ipp_bn, s->rem->ipp_bn);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsRef_BN(NULL, &bits, &data, s->rem->ipp_bn);
+    BREAK_ON_IPP_ERROR(sts, result);
+    for (k = 0; k < (size_t)(bits + 31) / 32 && k < len; k++) {
+      a[k] = data[k];
+    }
+    sts = ippsGFpSetElement(a, (int)len, elem->ipp_ff_elem, s->g->ff->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = kEpidNoErr;
+  } while (0);
+  return result;
+}
+
+/*!
+Attempts to hash i || msg to a point.
+
+Computes the same point as ippsGFpECSetPointHashBackCompatible() but
+hashes i || msg only once, without copying msg. Attempts whose
+x-coordinate x = Hash(i || msg) mod q has no square root are rejected
+with the Jacobi symbol of x^3 + a*x + b. For the others the point is
+made from x directly and y is negated if it is odd in the Montgomery
+representation of IPP, like ippsGFpECSetPointHashBackCompatible() does.
+
+\param[in,out] s the EcHash state
+\param[in] msg the message
+\param[in] msg_len length of msg
+\param[in] i the attempt number
+\param[out] r the point, only set if is_point is true
+\param[out] is_point false if Hash(i || msg) is not an x-coordinate
+
+\returns ::EpidStatus
+*/
+static EpidStatus EcHashTry(EcHashState* s, ConstOctStr msg, int msg_len,
+                            Ipp32u i, EcPoint* r, bool* is_point) {
+  EpidStatus result = kEpidErr;
+  IppsGFpState* ff = s->g->ff->ipp_ff;
+  IppsGFpECState* ec = s->g->ipp_ec;
+  size_t len = (size_t)s->g->ff->element_len;
+  do {
+    IppStatus sts = ippStsNoErr;
+    Ipp8u md[IPP_SHA512_DIGEST_BITSIZE / CHAR_BIT];
+    Ipp8u hdr[sizeof(i)];
+    Ipp32u a[EPID_ECHASH_MAX_WORDS];
+    Ipp32u n[EPID_ECHASH_MAX_WORDS];
+    size_t k = 0;
+    *is_point = false;
+    hdr[0] = (Ipp8u)(i >> 24);
+    hdr[1] = (Ipp8u)(i >> 16);
+    hdr[2] = (Ipp8u)(i >> 8);
+    hdr[3] = (Ipp8u)i;
+    sts = ippsHashInit(s->hash, s->hash_id);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsHashUpdate(hdr, (int)sizeof(hdr), s->hash);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsHashUpdate((Ipp8u const*)msg, msg_len, s->hash);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsHashFinal(md, s->hash);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsSetOctString_BN(md, s->digest_len, s->digest->ipp_bn);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = EcHashReduce(s, s->digest, s->x);
+    BREAK_ON_EPID_ERROR(result);
+    // t = (x^2 + a) * x + b
+    sts = ippsGFpMul(s->x->ipp_ff_elem, s->x->ipp_ff_elem, s->t->ipp_ff_elem,
+                     ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(s->t->ipp_ff_elem, s->ec_a->ipp_ff_elem,
+                     s->t->ipp_ff_elem, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(s->t->ipp_ff_elem, s->x->ipp_ff_elem, s->t->ipp_ff_elem,
+                     ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(s->t->ipp_ff_elem, s->ec_b->ipp_ff_elem,
+                     s->t->ipp_ff_elem, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpGetElement(s->t->ipp_ff_elem, a, (int)len, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    for (k = 0; k < len; k++) {
+      n[k] = s->q[k];
+    }
+    if (-1 == JacobiSymbol(a, n, len)) {
+      result = kEpidNoErr;
+      break;
+    }
+    sts = ippsGFpECMakePoint(s->x->ipp_ff_elem, r->ipp_ec_pt, ec);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // choose the root that is even in Montgomery representation, y * R
+    sts = ippsGFpECGetPoint(r->ipp_ec_pt, NULL, s->t->ipp_ff_elem, ec);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpMul(s->t->ipp_ff_elem, s->mont_r->ipp_ff_elem,
+                     s->t->ipp_ff_elem, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpGetElement(s->t->ipp_ff_elem, a, (int)len, ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    if (a[0] & 1) {
+      sts = ippsGFpECNegPoint(r->ipp_ec_pt, r->ipp_ec_pt, ec);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    if (s->cofactor) {
+      sts = ippsGFpECMulPoint(r->ipp_ec_pt, s->cofactor->ipp_bn, r->ipp_ec_pt,
+                              ec, s->g->scratch_buffer);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    *is_point = true;
+    result = kEpidNoErr;
+  } while (0);
+  return result;
+}
+
 EpidStatus EcHash(EcGroup* g, ConstOctStr msg, size_t msg_len, HashAlg hash_alg,
                   EcPoint* r, uint32_t* iterations) {
+  EpidStatus result = kEpidErr;
   IppStatus sts = ippStsNoErr;
   IppHashAlgId hash_id;
+  int digest_len = 0;
   int ipp_msg_len = 0;
   Ipp32u ipp_i = 0;
+  EcHashState s = {0};
+  BigNum* pow = NULL;
   if (!g || !g->ff || !g->ipp_ec) {
     return kEpidBadArgErr;
   }
@@ -1197,12 +1419,16 @@ EpidStatus EcHash(EcGroup* g, ConstOctStr msg, size_t msg_len, HashAlg hash_alg,
   ipp_msg_len = (int)msg_len;
   if (kSha256 == hash_alg) {
     hash_id = ippHashAlg_SHA256;
+    digest_len = IPP_SHA256_DIGEST_BITSIZE / CHAR_BIT;
   } else if (kSha384 == hash_alg) {
     hash_id = ippHashAlg_SHA384;
+    digest_len = IPP_SHA384_DIGEST_BITSIZE / CHAR_BIT;
   } else if (kSha512 == hash_alg) {
     hash_id = ippHashAlg_SHA512;
+    digest_len = IPP_SHA512_DIGEST_BITSIZE / CHAR_BIT;
   } else if (kSha512_256 == hash_alg) {
     hash_id = ippHashAlg_SHA512_256;
+    digest_len = IPP_SHA256_DIGEST_BITSIZE / CHAR_BIT;
   } else {
     return kEpidHashAlgorithmNotSupported;
   }
@@ -1212,24 +1438,480 @@ EpidStatus EcHash(EcGroup* g, ConstOctStr msg, size_t msg_len, HashAlg hash_alg,
   }
 
   do {
-    sts = ippsGFpECSetPointHashBackCompatible(ipp_i, msg, ipp_msg_len, r->ipp_ec_pt,
-                                g->ipp_ec, hash_id, g->scratch_buffer);
-  } while (ippStsQuadraticNonResidueErr == sts &&
-           ipp_i++ < EPID_ECHASH_WATCHDOG);
+    bool is_point = false;
+    // EcHashTry works over prime fields whose Montgomery radix does not
+    // depend on the word size of IPP, i.e. with an even number of 32-bit
+    // words per element. Other groups take the IPP function, which hashes
+    // every attempt again.
+    if (1 == g->ff->basic_degree && 1 == g->ff->ground_degree &&
+        (size_t)g->ff->element_len <= EPID_ECHASH_MAX_WORDS &&
+        0 == g->ff->element_len % 2) {
+      size_t elem_size = (size_t)g->ff->element_len * sizeof(Ipp32u);
+      int q_bits = 0;
+      Ipp32u* q_data = NULL;
+      int hash_size = 0;
+      size_t k = 0;
+      s.g = g;
+      s.hash_id = hash_id;
+      s.digest_len = digest_len;
+      sts = ippsRef_BN(NULL, &q_bits, &q_data, g->ff->modulus_0->ipp_bn);
+      BREAK_ON_IPP_ERROR(sts, result);
+      for (k = 0; k < (size_t)(q_bits + 31) / 32 && k < EPID_ECHASH_MAX_WORDS;
+           k++) {
+        s.q[k] = q_data[k];
+      }
+      sts = ippsHashGetSize(&hash_size);
+      BREAK_ON_IPP_ERROR(sts, result);
+      s.hash = (IppsHashState*)SAFE_ALLOC(hash_size);
+      if (!s.hash) {
+        result = kEpidMemAllocErr;
+        break;
+      }
+      result = NewBigNum(IPP_SHA512_DIGEST_BITSIZE / CHAR_BIT, &s.digest);
+      BREAK_ON_EPID_ERROR(result);
+      result = NewBigNum(elem_size, &s.rem);
+      BREAK_ON_EPID_ERROR(result);
+      result = NewBigNum(elem_size, &s.cofactor);
+      BREAK_ON_EPID_ERROR(result);
+      result = NewBigNum(elem_size + sizeof(Ipp32u), &pow);
+      BREAK_ON_EPID_ERROR(result);
+      result = NewFfElement(g->ff, &s.ec_a);
+      BREAK_ON_EPID_ERROR(result);
+      result = NewFfElement(g->ff, &s.ec_b);
+      BREAK_ON_EPID_ERROR(result);
+      result = NewFfElement(g->ff, &s.mont_r);
+      BREAK_ON_EPID_ERROR(result);
+      result = NewFfElement(g->ff, &s.x);
+      BREAK_ON_EPID_ERROR(result);
+      result = NewFfElement(g->ff, &s.t);
+      BREAK_ON_EPID_ERROR(result);
+      sts = ippsGFpECGet(NULL, s.ec_a->ipp_ff_elem, s.ec_b->ipp_ff_elem,
+                         g->ipp_ec);
+      BREAK_ON_IPP_ERROR(sts, result);
+      sts = ippsGFpECGetSubgroup(NULL, NULL, NULL, NULL, s.cofactor->ipp_bn,
+                                 g->ipp_ec);
+      BREAK_ON_IPP_ERROR(sts, result);
+      sts = ippsRef_BN(NULL, &q_bits, &q_data, s.cofactor->ipp_bn);
+      BREAK_ON_IPP_ERROR(sts, result);
+      if (1 == q_bits) {
+        DeleteBigNum(&s.cofactor);
+      }
+      result = BigNumPow2N((unsigned int)(elem_size * CHAR_BIT), pow);
+      BREAK_ON_EPID_ERROR(result);
+      result = EcHashReduce(&s, pow, s.mont_r);
+      BREAK_ON_EPID_ERROR(result);
+    }
+
+    result = kEpidNoErr;
+    do {
+      if (s.hash) {
+        result = EcHashTry(&s, msg, ipp_msg_len, ipp_i, r, &is_point);
+        BREAK_ON_EPID_ERROR(result);
+        sts = is_point ? ippStsNoErr : ippStsQuadraticNonResidueErr;
+      } else {
+        sts = ippsGFpECSetPointHashBackCompatible(
+            ipp_i, msg, ipp_msg_len, r->ipp_ec_pt, g->ipp_ec, hash_id,
+            g->scratch_buffer);
+      }
+    } while (ippStsQuadraticNonResidueErr == sts &&
+             ipp_i++ < EPID_ECHASH_WATCHDOG);
+    BREAK_ON_EPID_ERROR(result);
 
-  if (iterations) {
-    *iterations = (uint32_t)ipp_i;
+    if (iterations) {
+      *iterations = (uint32_t)ipp_i;
+    }
+
+    if (ippStsContextMatchErr == sts || ippStsBadArgErr == sts ||
+        ippStsLengthErr == sts) {
+      result = kEpidBadArgErr;
+      break;
+    }
+    if (ippStsNoErr != sts) {
+      result = kEpidMathErr;
+      break;
+    }
+    result = kEpidNoErr;
+  } while (0);
+
+  SAFE_FREE(s.hash);
+  DeleteBigNum(&s.digest);
+  DeleteBigNum(&s.rem);
+  DeleteBigNum(&s.cofactor);
+  DeleteBigNum(&pow);
+  DeleteFfElement(&s.ec_a);
+  DeleteFfElement(&s.ec_b);
+  DeleteFfElement(&s.mont_r);
+  DeleteFfElement(&s.x);
+  DeleteFfElement(&s.t);
+  return result;
+}
+
+/*!
+Gets the words of a field element of a prime field.
+
+\param[in] ff the field
+\param[in] a the element
+\param[out] words receives ff->element_len words, least significant first
+
+\returns ::EpidStatus
+*/
+static EpidStatus GetFfElementWords(FiniteField* ff, FfElement const* a,
+                                    Ipp32u* words) {
+  IppStatus sts =
+      ippsGFpGetElement(a->ipp_ff_elem, words, ff->element_len, ff->ipp_ff);
+  return (ippStsNoErr == sts) ? kEpidNoErr : kEpidMathErr;
+}
+
+/*!
+Sets an element of a prime field to a small integer.
+
+\param[in] ff the field
+\param[in] a the value
+\param[out] r the element
+
+\returns ::EpidStatus
+*/
+static EpidStatus SetFfElementWord(FiniteField* ff, Ipp32u a, FfElement* r) {
+  IppStatus sts = ippsGFpSetElement(&a, 1, r->ipp_ff_elem, ff->ipp_ff);
+  return (ippStsNoErr == sts) ? kEpidNoErr : kEpidMathErr;
+}
+
+/// Returns all ones if the len words of a and b differ and zero otherwise
+static Ipp32u SscmNotEqualMask(Ipp32u const* a, Ipp32u const* b, size_t len) {
+  Ipp32u acc = 0;
+  size_t i = 0;
+  for (i = 0; i < len; i++) {
+    acc |= a[i] ^ b[i];
   }
+  return (Ipp32u)0 - ((acc | ((Ipp32u)0 - acc)) >> 31);
+}
 
-  if (ippStsContextMatchErr == sts || ippStsBadArgErr == sts ||
-      ippStsLengthErr == sts) {
+/// Sets r to a where mask is all ones and keeps r where mask is zero
+static void SscmSelect(Ipp32u* r, Ipp32u const* a, size_t len, Ipp32u mask) {
+  size_t i = 0;
+  for (i = 0; i < len; i++) {
+    r[i] = (a[i] & mask) | (r[i] & ~mask);
+  }
+}
+
+/// Maximum number of 32-bit words of a field element used by EcSscmHash
+#define EPID_SSCMHASH_MAX_WORDS (sizeof(BigNumStr) / sizeof(Ipp32u))
+
+EpidStatus EcSscmHash(EcGroup* g, ConstOctStr msg, size_t msg_len,
+                      HashAlg hash_alg, EcPoint* r) {
+  EpidStatus result = kEpidErr;
+  FiniteField* ff = NULL;
+  IppHashAlgId hash_id;
+  BigNum* e_inv = NULL;
+  BigNum* e_legendre = NULL;
+  BigNum* e_sqrt = NULL;
+  BigNum* c = NULL;
+  BigNum* rem = NULL;
+  FfElement* ec_b = NULL;
+  FfElement* t = NULL;
+  FfElement* s = NULL;
+  FfElement* d = NULL;
+  FfElement* inv = NULL;
+  FfElement* w = NULL;
+  FfElement* x1 = NULL;
+  FfElement* x2 = NULL;
+  FfElement* x3 = NULL;
+  FfElement* y = NULL;
+  FfElement* tmp = NULL;
+  FfElement* one = NULL;
+  Ipp32u x_words[EPID_SSCMHASH_MAX_WORDS] = {0};
+  Ipp32u y_words[EPID_SSCMHASH_MAX_WORDS] = {0};
+  Ipp32u t_words[EPID_SSCMHASH_MAX_WORDS] = {0};
+  Ipp32u tmp_words[EPID_SSCMHASH_MAX_WORDS] = {0};
+  Ipp32u m1_words[EPID_SSCMHASH_MAX_WORDS] = {0};
+  size_t len = 0;
+
+  if (!g || !g->ff || !g->ipp_ec) {
     return kEpidBadArgErr;
   }
-  if (ippStsNoErr != sts) {
-    return kEpidMathErr;
+  if (!msg && msg_len > 0) {
+    return kEpidBadArgErr;
+  }
+  if (!r || !r->ipp_ec_pt) {
+    return kEpidBadArgErr;
+  }
+  if (msg_len > INT_MAX) {
+    return kEpidBadArgErr;
   }
+  if (kSha256 == hash_alg) {
+    hash_id = ippHashAlg_SHA256;
+  } else if (kSha384 == hash_alg) {
+    hash_id = ippHashAlg_SHA384;
+  } else if (kSha512 == hash_alg) {
+    hash_id = ippHashAlg_SHA512;
+  } else if (kSha512_256 == hash_alg) {
+    hash_id = ippHashAlg_SHA512_256;
+  } else {
+    return kEpidHashAlgorithmNotSupported;
+  }
+  if (g->ff->element_len != r->element_len) {
+    return kEpidBadArgErr;
+  }
+  ff = g->ff;
+  if (1 != ff->basic_degree || 1 != ff->ground_degree ||
+      (size_t)ff->element_len > EPID_SSCMHASH_MAX_WORDS) {
+    return kEpidBadArgErr;
+  }
+  len = (size_t)ff->element_len;
 
-  return kEpidNoErr;
+  do {
+    IppStatus sts = ippStsNoErr;
+    Ipp8u const one_str = 1;
+    Ipp8u const two_str = 2;
+    Ipp8u const four_str = 4;
+    bool is_zero = false;
+    Ipp32u m1 = 0;
+    Ipp32u m2 = 0;
+    Ipp32u neg = 0;
+
+    result = NewBigNum(sizeof(BigNumStr), &e_inv);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewBigNum(sizeof(BigNumStr), &e_legendre);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewBigNum(sizeof(BigNumStr), &e_sqrt);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewBigNum(sizeof(BigNumStr), &c);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewBigNum(sizeof(BigNumStr), &rem);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &ec_b);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &t);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &s);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &d);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &inv);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &w);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &x1);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &x2);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &x3);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &y);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &tmp);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ff, &one);
+    BREAK_ON_EPID_ERROR(result);
+
+    // The map needs a curve y^2 = x^3 + b
+    sts = ippsGFpECGet(NULL, tmp->ipp_ff_elem, ec_b->ipp_ff_elem, g->ipp_ec);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = FfIsZero(ff, tmp, &is_zero);
+    BREAK_ON_EPID_ERROR(result);
+    if (!is_zero) {
+      result = kEpidBadArgErr;
+      break;
+    }
+
+    // e_legendre = (q - 1) / 2, e_sqrt = (q + 1) / 4, e_inv = q - 2
+    result = ReadBigNum(&one_str, sizeof(one_str), c);
+    BREAK_ON_EPID_ERROR(result);
+    result = BigNumSub(ff->modulus_0, c, e_inv);
+    BREAK_ON_EPID_ERROR(result);
+    result = ReadBigNum(&two_str, sizeof(two_str), c);
+    BREAK_ON_EPID_ERROR(result);
+    result = BigNumDiv(e_inv, c, e_legendre, rem);
+    BREAK_ON_EPID_ERROR(result);
+    result = ReadBigNum(&one_str, sizeof(one_str), c);
+    BREAK_ON_EPID_ERROR(result);
+    result = BigNumAdd(ff->modulus_0, c, e_inv);
+    BREAK_ON_EPID_ERROR(result);
+    result = ReadBigNum(&four_str, sizeof(four_str), c);
+    BREAK_ON_EPID_ERROR(result);
+    result = BigNumDiv(e_inv, c, e_sqrt, rem);
+    BREAK_ON_EPID_ERROR(result);
+    // square roots are single exponentiations only if q = 3 mod 4
+    result = BigNumIsZero(rem, &is_zero);
+    BREAK_ON_EPID_ERROR(result);
+    if (!is_zero) {
+      result = kEpidBadArgErr;
+      break;
+    }
+    result = ReadBigNum(&two_str, sizeof(two_str), c);
+    BREAK_ON_EPID_ERROR(result);
+    result = BigNumSub(ff->modulus_0, c, e_inv);
+    BREAK_ON_EPID_ERROR(result);
+
+    result = SetFfElementWord(ff, 1, one);
+    BREAK_ON_EPID_ERROR(result);
+    // s = sqrt(-3); exists if q = 1 mod 3
+    result = SetFfElementWord(ff, 3, tmp);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfNeg(ff, tmp, tmp);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfExp(ff, tmp, e_sqrt, s);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, s, s, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfIsEqual(ff, w, tmp, &is_zero);
+    BREAK_ON_EPID_ERROR(result);
+    if (!is_zero) {
+      result = kEpidBadArgErr;
+      break;
+    }
+
+    // t = Hash(msg)
+    sts = ippsGFpSetElementHash(msg, (int)msg_len, t->ipp_ff_elem, ff->ipp_ff,
+                                hash_id);
+    BREAK_ON_IPP_ERROR(sts, result);
+
+    // d = 1 + b + t^2
+    result = FfMul(ff, t, t, d);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfAdd(ff, d, ec_b, d);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfAdd(ff, d, one, d);
+    BREAK_ON_EPID_ERROR(result);
+    // inv = 1 / (3 * d * t), or 0 if d * t = 0
+    result = SetFfElementWord(ff, 3, tmp);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, tmp, d, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, w, t, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfExp(ff, w, e_inv, inv);
+    BREAK_ON_EPID_ERROR(result);
+
+    // w = s * t / d = 3 * s * t^2 * inv
+    result = FfMul(ff, s, t, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, w, t, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, w, tmp, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, w, inv, w);
+    BREAK_ON_EPID_ERROR(result);
+    // x1 = (s - 1) / 2 - t * w
+    result = SetFfElementWord(ff, 2, x1);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfInv(ff, x1, x1);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfSub(ff, s, one, x2);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, x1, x2, x1);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, t, w, x2);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfSub(ff, x1, x2, x1);
+    BREAK_ON_EPID_ERROR(result);
+    // x2 = -1 - x1
+    result = FfAdd(ff, one, x1, x2);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfNeg(ff, x2, x2);
+    BREAK_ON_EPID_ERROR(result);
+    // x3 = 1 + 1 / w^2 = 1 - d^2 / (3 * t^2) = 1 - 3 * d^4 * inv^2
+    result = FfMul(ff, d, d, x3);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, x3, inv, x3);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, x3, x3, x3);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, x3, tmp, x3);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfSub(ff, one, x3, x3);
+    BREAK_ON_EPID_ERROR(result);
+
+    // m1 (m2) is set if x1^3 + b (x2^3 + b) is a square
+    result = FfNeg(ff, one, tmp);
+    BREAK_ON_EPID_ERROR(result);
+    result = GetFfElementWords(ff, tmp, m1_words);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, x1, x1, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, w, x1, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfAdd(ff, w, ec_b, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfExp(ff, w, e_legendre, y);
+    BREAK_ON_EPID_ERROR(result);
+    result = GetFfElementWords(ff, y, tmp_words);
+    BREAK_ON_EPID_ERROR(result);
+    m1 = SscmNotEqualMask(tmp_words, m1_words, len);
+    result = FfMul(ff, x2, x2, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, w, x2, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfAdd(ff, w, ec_b, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfExp(ff, w, e_legendre, y);
+    BREAK_ON_EPID_ERROR(result);
+    result = GetFfElementWords(ff, y, tmp_words);
+    BREAK_ON_EPID_ERROR(result);
+    m2 = SscmNotEqualMask(tmp_words, m1_words, len);
+
+    // x = x1 if m1, else x2 if m2, else x3
+    result = GetFfElementWords(ff, x3, x_words);
+    BREAK_ON_EPID_ERROR(result);
+    result = GetFfElementWords(ff, x2, tmp_words);
+    BREAK_ON_EPID_ERROR(result);
+    SscmSelect(x_words, tmp_words, len, m2);
+    result = GetFfElementWords(ff, x1, tmp_words);
+    BREAK_ON_EPID_ERROR(result);
+    SscmSelect(x_words, tmp_words, len, m1);
+    sts = ippsGFpSetElement(x_words, (int)len, x1->ipp_ff_elem, ff->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+
+    // y = sqrt(x^3 + b) with the parity of t
+    result = FfMul(ff, x1, x1, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfMul(ff, w, x1, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfAdd(ff, w, ec_b, w);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfExp(ff, w, e_sqrt, y);
+    BREAK_ON_EPID_ERROR(result);
+    result = FfNeg(ff, y, tmp);
+    BREAK_ON_EPID_ERROR(result);
+    result = GetFfElementWords(ff, y, y_words);
+    BREAK_ON_EPID_ERROR(result);
+    result = GetFfElementWords(ff, tmp, tmp_words);
+    BREAK_ON_EPID_ERROR(result);
+    result = GetFfElementWords(ff, t, t_words);
+    BREAK_ON_EPID_ERROR(result);
+    neg = (Ipp32u)0 - ((y_words[0] ^ t_words[0]) & 1);
+    SscmSelect(y_words, tmp_words, len, neg);
+    sts = ippsGFpSetElement(y_words, (int)len, y->ipp_ff_elem, ff->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+
+    sts = ippsGFpECSetPoint(x1->ipp_ff_elem, y->ipp_ff_elem, r->ipp_ec_pt,
+                            g->ipp_ec);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = kEpidNoErr;
+  } while (0);
+
+  EpidZeroMemory(x_words, sizeof(x_words));
+  EpidZeroMemory(y_words, sizeof(y_words));
+  EpidZeroMemory(t_words, sizeof(t_words));
+  EpidZeroMemory(tmp_words, sizeof(tmp_words));
+  DeleteBigNum(&e_inv);
+  DeleteBigNum(&e_legendre);
+  DeleteBigNum(&e_sqrt);
+  DeleteBigNum(&c);
+  DeleteBigNum(&rem);
+  DeleteFfElement(&ec_b);
+  DeleteFfElement(&t);
+  DeleteFfElement(&s);
+  DeleteFfElement(&d);
+  DeleteFfElement(&inv);
+  DeleteFfElement(&w);
+  DeleteFfElement(&x1);
+  DeleteFfElement(&x2);
+  DeleteFfElement(&x3);
+  DeleteFfElement(&y);
+  DeleteFfElement(&tmp);
+  DeleteFfElement(&one);
+  return result;
 }
 
 EpidStatus EcMakePoint(EcGroup* g, FfElement const* x, EcPoint* r) {
@@ -0,0 +1,52 @@
+/*############################################################################
+  # Copyright 2016-2019 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+
+
+/*!
+ * \file
+ * \brief Reusable exponentiation workspace private interface.
+ */
+
+#ifndef EPID_INTERNAL_IPPMATH_SRC_EXPWORKSPACE_INTERNAL_H_
+#define EPID_INTERNAL_IPPMATH_SRC_EXPWORKSPACE_INTERNAL_H_
+
+#include <ippcp.h>
+#include "bignum-internal.h"
+#include "ecglv-internal.h"
+#include "ecgroup-internal.h"
+#include "finitefield-internal.h"
+
+/// Temporary state shared by exponentiation calls
+struct ExpWorkspace {
+  /// Maximum number of bases of a multi-exponentiation
+  size_t max_m;
+  /// Powers, each sizeof(BigNumStr) bytes
+  BigNum** bignums;
+  /// IPP states of the powers
+  IppsBigNumState** ipp_b;
+  /// IPP states of the finite field bases
+  IppsGFpElement** ipp_p;
+  /// Scratch buffer for finite field multi-exponentiation
+  OctStr scratch_buffer;
+  /// Size of scratch_buffer in bytes
+  int scratch_buffer_size;
+  /// Temporary point, re-created when used with another field size
+  EcPoint* ec_tmp;
+  /// State of endomorphism accelerated multi-exponentiation
+  GlvWorkspace glv;
+};
+
+#endif  // EPID_INTERNAL_IPPMATH_SRC_EXPWORKSPACE_INTERNAL_H_
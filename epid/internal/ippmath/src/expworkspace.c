@@ -0,0 +1,316 @@
+/*############################################################################
+  # Copyright 2016-2019 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+
+
+/*!
+ * \file
+ * \brief Reusable exponentiation workspace implementation.
+ */
+
+#include "ippmath/expworkspace.h"
+#include <ippcp.h>
+#include <limits.h>
+#include "expworkspace-internal.h"
+#include "ippmath/bignum.h"
+#include "ippmath/memory.h"
+
+EpidStatus NewExpWorkspace(size_t max_m, ExpWorkspace** ws) {
+  EpidStatus result = kEpidErr;
+  ExpWorkspace* workspace = NULL;
+  size_t i = 0;
+
+  if (!ws) {
+    return kEpidBadArgErr;
+  }
+  // because we use ipp functions with number of items parameter
+  // defined as "int" we need to verify that input length
+  // do not exceed INT_MAX to avoid overflow
+  if (max_m <= 0 || max_m > INT_MAX) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    workspace = (ExpWorkspace*)SAFE_ALLOC(sizeof(ExpWorkspace));
+    if (!workspace) {
+      result = kEpidMemAllocErr;
+      break;
+    }
+    workspace->max_m = max_m;
+    workspace->bignums = (BigNum**)SAFE_ALLOC(max_m * sizeof(BigNum*));
+    if (!workspace->bignums) {
+      result = kEpidMemAllocErr;
+      break;
+    }
+    workspace->ipp_b =
+        (IppsBigNumState**)SAFE_ALLOC(max_m * sizeof(IppsBigNumState*));
+    if (!workspace->ipp_b) {
+      result = kEpidMemAllocErr;
+      break;
+    }
+    workspace->ipp_p =
+        (IppsGFpElement**)SAFE_ALLOC(max_m * sizeof(IppsGFpElement*));
+    if (!workspace->ipp_p) {
+      result = kEpidMemAllocErr;
+      break;
+    }
+    result = kEpidNoErr;
+    for (i = 0; i < max_m; i++) {
+      result = NewBigNum(sizeof(BigNumStr), &workspace->bignums[i]);
+      if (kEpidNoErr != result) break;
+      workspace->ipp_b[i] = workspace->bignums[i]->ipp_bn;
+    }
+    if (kEpidNoErr != result) break;
+
+    *ws = workspace;
+    result = kEpidNoErr;
+  } while (0);
+
+  if (kEpidNoErr != result) {
+    DeleteExpWorkspace(&workspace);
+  }
+  return result;
+}
+
+void DeleteExpWorkspace(ExpWorkspace** ws) {
+  size_t i = 0;
+  int bignum_size = 0;
+  if (!ws || !*ws) {
+    return;
+  }
+  if ((*ws)->bignums) {
+    if (ippStsNoErr !=
+        ippsBigNumGetSize(sizeof(BigNumStr) / sizeof(Ipp32u), &bignum_size)) {
+      bignum_size = 0;
+    }
+    for (i = 0; i < (*ws)->max_m; i++) {
+      if ((*ws)->bignums[i] && (*ws)->bignums[i]->ipp_bn) {
+        EpidZeroMemory((*ws)->bignums[i]->ipp_bn, (size_t)bignum_size);
+      }
+      DeleteBigNum(&(*ws)->bignums[i]);
+    }
+  }
+  SAFE_FREE((*ws)->bignums);
+  SAFE_FREE((*ws)->ipp_b);
+  SAFE_FREE((*ws)->ipp_p);
+  if ((*ws)->scratch_buffer) {
+    EpidZeroMemory((*ws)->scratch_buffer, (size_t)(*ws)->scratch_buffer_size);
+  }
+  SAFE_FREE((*ws)->scratch_buffer);
+  DeleteEcPoint(&(*ws)->ec_tmp);
+  DeleteGlvWorkspace(&(*ws)->glv);
+  SAFE_FREE(*ws);
+}
+
+/// Sets the first m powers of a workspace to zero
+/*!
+ The powers may be secret, so they are not left behind for the next call.
+ */
+static void ClearPowers(ExpWorkspace* ws, size_t m) {
+  Ipp32u zero32 = 0;
+  size_t i = 0;
+  for (i = 0; i < m; i++) {
+    (void)ippsSet_BN(IppsBigNumPOS, 1, &zero32, ws->bignums[i]->ipp_bn);
+  }
+}
+
+/// Makes sure the scratch buffer of a workspace has at least size bytes
+static EpidStatus ReserveScratchBuffer(ExpWorkspace* ws, int size) {
+  OctStr scratch_buffer = NULL;
+  if (size <= ws->scratch_buffer_size) {
+    return kEpidNoErr;
+  }
+  scratch_buffer = (OctStr)SAFE_ALLOC(size);
+  if (!scratch_buffer) {
+    return kEpidMemAllocErr;
+  }
+  SAFE_FREE(ws->scratch_buffer);
+  ws->scratch_buffer = scratch_buffer;
+  ws->scratch_buffer_size = size;
+  return kEpidNoErr;
+}
+
+/// Makes sure the temporary point of a workspace can be used with g
+static EpidStatus ReserveEcPoint(ExpWorkspace* ws, EcGroup const* g) {
+  if (ws->ec_tmp && ws->ec_tmp->element_len == g->ff->element_len) {
+    return kEpidNoErr;
+  }
+  DeleteEcPoint(&ws->ec_tmp);
+  return NewEcPoint(g, &ws->ec_tmp);
+}
+
+EpidStatus FfMultiExpWithWorkspace(FiniteField* ff, FfElement const** p,
+                                   BigNumStr const** b, size_t m,
+                                   ExpWorkspace* ws, FfElement* r) {
+  EpidStatus result = kEpidErr;
+  size_t i = 0;
+
+  // Check required parameters
+  if (!ff || !ff->ipp_ff) {
+    return kEpidBadArgErr;
+  }
+  if (!p) {
+    return kEpidBadArgErr;
+  }
+  if (!b) {
+    return kEpidBadArgErr;
+  }
+  if (!ws) {
+    return kEpidBadArgErr;
+  }
+  if (m <= 0 || m > ws->max_m) {
+    return kEpidBadArgErr;
+  }
+  if (!r || !r->ipp_ff_elem) {
+    return kEpidBadArgErr;
+  }
+  for (i = 0; i < m; i++) {
+    if (!p[i]) {
+      return kEpidBadArgErr;
+    }
+    if (!p[i]->ipp_ff_elem) {
+      return kEpidBadArgErr;
+    }
+    if (ff->element_len != p[i]->element_len) {
+      return kEpidBadArgErr;
+    }
+  }
+  if (ff->element_len != r->element_len) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    IppStatus sts = ippStsNoErr;
+    int scratch_buffer_size = 0;
+    const int exp_bit_size = CHAR_BIT * sizeof(BigNumStr);
+
+    result = kEpidNoErr;
+    for (i = 0; i < m; i++) {
+      ws->ipp_p[i] = p[i]->ipp_ff_elem;
+      result = ReadBigNum(b[i], sizeof(BigNumStr), ws->bignums[i]);
+      if (kEpidNoErr != result) break;
+    }
+    if (kEpidNoErr != result) break;
+
+    sts = ippsGFpScratchBufferSize((int)m, exp_bit_size, ff->ipp_ff,
+                                   &scratch_buffer_size);
+    if (sts != ippStsNoErr) {
+      result = kEpidMathErr;
+      break;
+    }
+    result = ReserveScratchBuffer(ws, scratch_buffer_size);
+    if (kEpidNoErr != result) break;
+
+    sts = ippsGFpMultiExp((const IppsGFpElement* const*)ws->ipp_p,
+                          (const IppsBigNumState* const*)ws->ipp_b, (int)m,
+                          r->ipp_ff_elem, ff->ipp_ff, ws->scratch_buffer);
+    if (ippStsNoErr != sts) {
+      if (ippStsContextMatchErr == sts || ippStsRangeErr == sts)
+        result = kEpidBadArgErr;
+      else
+        result = kEpidMathErr;
+      break;
+    }
+    result = kEpidNoErr;
+  } while (0);
+  ClearPowers(ws, m);
+  return result;
+}
+
+EpidStatus EcExpWithWorkspace(EcGroup* g, EcPoint const* a, BigNumStr const* b,
+                              ExpWorkspace* ws, EcPoint* r) {
+  return EcMultiExpWithWorkspace(g, &a, &b, 1, ws, r);
+}
+
+EpidStatus EcMultiExpWithWorkspace(EcGroup* g, EcPoint const** a,
+                                   BigNumStr const** b, size_t m,
+                                   ExpWorkspace* ws, EcPoint* r) {
+  EpidStatus result = kEpidErr;
+  size_t i = 0;
+
+  if (!g || !g->ff || !g->ipp_ec) {
+    return kEpidBadArgErr;
+  }
+  if (!a) {
+    return kEpidBadArgErr;
+  }
+  if (!b) {
+    return kEpidBadArgErr;
+  }
+  if (!ws) {
+    return kEpidBadArgErr;
+  }
+  if (m <= 0) {
+    return kEpidBadArgErr;
+  }
+  if (!r || !r->ipp_ec_pt) {
+    return kEpidBadArgErr;
+  }
+  for (i = 0; i < m; i++) {
+    if (!a[i] || !a[i]->ipp_ec_pt || !b[i]) {
+      return kEpidBadArgErr;
+    }
+    if (g->ff->element_len != a[i]->element_len) {
+      return kEpidBadArgErr;
+    }
+  }
+  if (g->ff->element_len != r->element_len) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    IppStatus sts = ippStsNoErr;
+    BigNum* b_bn = ws->bignums[0];
+
+    result = ReserveEcPoint(ws, g);
+    if (kEpidNoErr != result) break;
+
+    for (i = 0; i < m; i++) {
+      result = ReadBigNum(b[i], sizeof(BigNumStr), b_bn);
+      if (kEpidNoErr != result) break;
+      sts = ippsGFpECMulPoint(a[i]->ipp_ec_pt, b_bn->ipp_bn,
+                              ws->ec_tmp->ipp_ec_pt, g->ipp_ec,
+                              g->scratch_buffer);
+      if (ippStsNoErr != sts) {
+        if (ippStsContextMatchErr == sts || ippStsRangeErr == sts ||
+            ippStsOutOfRangeErr == sts)
+          result = kEpidBadArgErr;
+        else
+          result = kEpidMathErr;
+        break;
+      }
+      if (i == 0) {
+        sts = ippsGFpECCpyPoint(ws->ec_tmp->ipp_ec_pt, r->ipp_ec_pt,
+                                g->ipp_ec);
+      } else {
+        sts = ippsGFpECAddPoint(ws->ec_tmp->ipp_ec_pt, r->ipp_ec_pt,
+                                r->ipp_ec_pt, g->ipp_ec);
+      }
+      if (ippStsNoErr != sts) {
+        result = kEpidMathErr;
+        break;
+      }
+    }
+    if (kEpidNoErr != result) break;
+
+    result = kEpidNoErr;
+  } while (0);
+  ClearPowers(ws, 1);
+  if (ws->ec_tmp) {
+    // holds the last a[i]^b[i]
+    (void)ippsGFpECSetPointAtInfinity(ws->ec_tmp->ipp_ec_pt, g->ipp_ec);
+  }
+  return result;
+}
@@ -36,4 +36,13 @@ struct PairingState {
   FiniteField* Fq6;    ///< Fq6
 };
 
+/// Miller loop lines precomputed for a fixed G2 point
+struct PairingG2Precomp {
+  PairingState* ps;   ///< pairing state the lines were computed with
+  int s_ternary[sizeof(BigNumStr) * CHAR_BIT];  ///< ternary form of 6t+-2
+  int n;              ///< index of the leading digit of s_ternary
+  size_t num_lines;   ///< number of lines in the Miller loop
+  FfElement** lines;  ///< 3 * num_lines line coefficients in Fq2
+};
+
 #endif  // EPID_INTERNAL_IPPMATH_SRC_PAIRING_INTERNAL_H_
@@ -87,19 +87,24 @@ static EpidStatus PiOp(PairingState* ps, FfElement* x_out, FfElement* y_out,
 static EpidStatus FrobeniusOp(PairingState* ps, FfElement* d_out,
                               FfElement const* a, const int e);
 
-static EpidStatus Line(FiniteField* gt, FfElement* f, FfElement* x_out,
+static EpidStatus Line(FiniteField* gt, FfElement* l[3], FfElement* x_out,
                        FfElement* y_out, FfElement* z_out, FfElement* z2_out,
-                       FfElement const* px, FfElement const* py,
                        FfElement const* x, FfElement const* y,
                        FfElement const* z, FfElement const* z2,
                        FfElement const* qx, FfElement const* qy);
 
-static EpidStatus Tangent(FiniteField* gt, FfElement* f, FfElement* x_out,
+static EpidStatus Tangent(FiniteField* gt, FfElement* l[3], FfElement* x_out,
                           FfElement* y_out, FfElement* z_out, FfElement* z2_out,
-                          FfElement const* px, FfElement const* py,
                           FfElement const* x, FfElement const* y,
                           FfElement const* z, FfElement const* z2);
 
+static EpidStatus EvalLine(FiniteField* gt, FfElement* f,
+                           FfElement* const l[3], FfElement const* px,
+                           FfElement const* py);
+
+static EpidStatus MillerLoopTernary(PairingState* ps, int* s, int* n,
+                                    int max_elements);
+
 static EpidStatus Ternary(int* s, int* n, int max_elements, BigNum const* x);
 
 static int Bit(Ipp32u const* num, Ipp32u bit_index);
@@ -338,9 +343,7 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
   FfElement* bx_ = NULL;
   FfElement* by_ = NULL;
   FfElement* f = NULL;
-  BigNum* s = NULL;
-  BigNum* two = NULL;
-  BigNum* six = NULL;
+  FfElement* l[3] = {NULL, NULL, NULL};
   FfElement* neg_qy = NULL;
 
   // check parameters
@@ -361,14 +364,13 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
 
   do {
     IppStatus sts = ippStsNoErr;
-    Ipp32u two_dat[] = {2};
-    Ipp32u six_dat[] = {6};
     Ipp32u one_dat[] = {1};
     G1ElemStr first_val_str = {0};
     G2ElemStr second_val_str = {0};
     bool in_group = true;
     int s_ternary[sizeof(BigNumStr) * CHAR_BIT] = {0};
     int i = 0;
+    int j = 0;
     int n = 0;
 
     // Let ax, ay be elements in Fq. Let bx, by, x, y, z, z2, bx', by'
@@ -397,34 +399,18 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
     BREAK_ON_EPID_ERROR(result);
     result = NewFfElement(ps->Fq2, &neg_qy);
     BREAK_ON_EPID_ERROR(result);
+    // a break inside the loop would only leave the loop
+    for (j = 0; j < 3 && kEpidNoErr == result; j++) {
+      result = NewFfElement(ps->Fq2, &l[j]);
+    }
+    BREAK_ON_EPID_ERROR(result);
 
     // 1. If neg = 0, compute integer s = 6t + 2, otherwise, compute
     // s = 6t - 2
-    result = NewBigNum(sizeof(BigNumStr), &s);
-    BREAK_ON_EPID_ERROR(result);
-    result = NewBigNum(sizeof(BigNumStr), &two);
-    BREAK_ON_EPID_ERROR(result);
-    sts = ippsSet_BN(IppsBigNumPOS, sizeof(two_dat) / sizeof(Ipp32u), two_dat,
-                     two->ipp_bn);
-    BREAK_ON_IPP_ERROR(sts, result);
-    result = NewBigNum(sizeof(BigNumStr), &six);
-    BREAK_ON_EPID_ERROR(result);
-    sts = ippsSet_BN(IppsBigNumPOS, sizeof(six_dat) / sizeof(Ipp32u), six_dat,
-                     six->ipp_bn);
-    BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsMul_BN(six->ipp_bn, ps->t->ipp_bn, s->ipp_bn);
-    BREAK_ON_IPP_ERROR(sts, result);
-    if (ps->neg) {
-      sts = ippsSub_BN(s->ipp_bn, two->ipp_bn, s->ipp_bn);
-      BREAK_ON_IPP_ERROR(sts, result);
-    } else {
-      sts = ippsAdd_BN(s->ipp_bn, two->ipp_bn, s->ipp_bn);
-      BREAK_ON_IPP_ERROR(sts, result);
-    }
     // 2. Let sn...s1s0 be the ternary representation of s, that is s =
     // s0 + 2*s1 + ... + 2^n*sn, where si is in {-1, 0, 1}.
-    result =
-        Ternary(s_ternary, &n, sizeof(s_ternary) / sizeof(s_ternary[0]), s);
+    result = MillerLoopTernary(ps, s_ternary, &n,
+                               sizeof(s_ternary) / sizeof(s_ternary[0]));
     BREAK_ON_EPID_ERROR(result);
     // 3. Set (ax, ay) = E(Fq).outputPoint(a)
     // check if a is in ga that was used to create ps
@@ -472,7 +458,9 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
     // 7. For i = n-1, ..., 0, do the following:
     for (i = n - 1; i >= 0; i--) {
       // a. Set (f, x, y, z, z2) = tangent(ax, ay, x, y, z, z2),
-      result = Tangent(ps->ff, f, x, y, z, z2, ax, ay, x, y, z, z2);
+      result = Tangent(ps->ff, l, x, y, z, z2, x, y, z, z2);
+      BREAK_ON_EPID_ERROR(result);
+      result = EvalLine(ps->ff, f, l, ax, ay);
       BREAK_ON_EPID_ERROR(result);
       // b. Set d = Fq12.square(d),
       sts = ippsGFpMul(d->ipp_ff_elem, d->ipp_ff_elem, d->ipp_ff_elem,
@@ -485,10 +473,11 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
       if (-1 == s_ternary[i]) {
         // i. Set (f, x, y, z, z2) = line(ax, ay, x, y, z, z2, bx,
         // -by),
-        BREAK_ON_EPID_ERROR(result);
         sts = ippsGFpNeg(by->ipp_ff_elem, neg_qy->ipp_ff_elem, ps->Fq2->ipp_ff);
         BREAK_ON_IPP_ERROR(sts, result);
-        result = Line(ps->ff, f, x, y, z, z2, ax, ay, x, y, z, z2, bx, neg_qy);
+        result = Line(ps->ff, l, x, y, z, z2, x, y, z, z2, bx, neg_qy);
+        BREAK_ON_EPID_ERROR(result);
+        result = EvalLine(ps->ff, f, l, ax, ay);
         BREAK_ON_EPID_ERROR(result);
         // ii. Set d = Fq12.mulSpecial(d, f).
         result = MulSpecial(d, d, f, ps);
@@ -498,13 +487,16 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
       if (1 == s_ternary[i]) {
         // i. Set (f, x, y, z, z2) = line(ax, ay, x, y, z, z2, bx,
         // by),
-        result = Line(ps->ff, f, x, y, z, z2, ax, ay, x, y, z, z2, bx, by);
+        result = Line(ps->ff, l, x, y, z, z2, x, y, z, z2, bx, by);
+        BREAK_ON_EPID_ERROR(result);
+        result = EvalLine(ps->ff, f, l, ax, ay);
         BREAK_ON_EPID_ERROR(result);
         // ii. Set d = Fq12.mulSpecial(d, f).
         result = MulSpecial(d, d, f, ps);
         BREAK_ON_EPID_ERROR(result);
       }
     }
+    BREAK_ON_EPID_ERROR(result);
 
     // 8. if neg = true,
     if (ps->neg) {
@@ -519,7 +511,9 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
     result = PiOp(ps, bx_, by_, bx, by, 1);
     BREAK_ON_EPID_ERROR(result);
     // 10. Set (f, x, y, z, z2) = line(ax, ay, x, y, z, z2, bx', by').
-    result = Line(ps->ff, f, x, y, z, z2, ax, ay, x, y, z, z2, bx_, by_);
+    result = Line(ps->ff, l, x, y, z, z2, x, y, z, z2, bx_, by_);
+    BREAK_ON_EPID_ERROR(result);
+    result = EvalLine(ps->ff, f, l, ax, ay);
     BREAK_ON_EPID_ERROR(result);
     // 11. Set d = Fq12.mulSpecial(d, f).
     result = MulSpecial(d, d, f, ps);
@@ -531,7 +525,9 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
     sts = ippsGFpNeg(by_->ipp_ff_elem, by_->ipp_ff_elem, ps->Fq2->ipp_ff);
     BREAK_ON_IPP_ERROR(sts, result);
     // 14. Set (f, x, y, z, z2) = line(ax, ay, x, y, z, z2, bx', by').
-    result = Line(ps->ff, f, x, y, z, z2, ax, ay, x, y, z, z2, bx_, by_);
+    result = Line(ps->ff, l, x, y, z, z2, x, y, z, z2, bx_, by_);
+    BREAK_ON_EPID_ERROR(result);
+    result = EvalLine(ps->ff, f, l, ax, ay);
     BREAK_ON_EPID_ERROR(result);
     // 15. Set d = Fq12.mulSpecial(d, f).
     result = MulSpecial(d, d, f, ps);
@@ -555,10 +551,285 @@ EpidStatus Pairing(PairingState* ps, EcPoint const* a, EcPoint const* b,
   DeleteFfElement(&by_);
   DeleteFfElement(&f);
   DeleteFfElement(&neg_qy);
+  DeleteFfElement(&l[0]);
+  DeleteFfElement(&l[1]);
+  DeleteFfElement(&l[2]);
 
-  DeleteBigNum(&s);
-  DeleteBigNum(&two);
-  DeleteBigNum(&six);
+  return result;
+}
+
+EpidStatus PairingPrecomputeG2(PairingState* ps, EcPoint const* b,
+                               PairingG2Precomp** precomp) {
+  EpidStatus result = kEpidErr;
+  PairingG2Precomp* precomp_ctx = NULL;
+  FfElement* bx = NULL;
+  FfElement* by = NULL;
+  FfElement* x = NULL;
+  FfElement* y = NULL;
+  FfElement* z = NULL;
+  FfElement* z2 = NULL;
+  FfElement* bx_ = NULL;
+  FfElement* by_ = NULL;
+  FfElement* neg_qy = NULL;
+
+  // check parameters
+  if (!ps || !ps->Fq2 || !ps->ff || !ps->ff->ipp_ff || !ps->Fq2->ipp_ff ||
+      !ps->t || !ps->t->ipp_bn || !ps->gb || !ps->gb->ipp_ec) {
+    return kEpidBadArgErr;
+  }
+  if (!b || !b->ipp_ec_pt) {
+    return kEpidBadArgErr;
+  }
+  if (!precomp) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    IppStatus sts = ippStsNoErr;
+    Ipp32u one_dat[] = {1};
+    G2ElemStr b_str = {0};
+    bool in_group = true;
+    size_t num_lines = 0;
+    size_t k = 0;
+    int i = 0;
+
+    precomp_ctx = (PairingG2Precomp*)SAFE_ALLOC(sizeof(PairingG2Precomp));
+    if (!precomp_ctx) {
+      result = kEpidMemAllocErr;
+      break;
+    }
+    precomp_ctx->ps = ps;
+    result = MillerLoopTernary(ps, precomp_ctx->s_ternary, &precomp_ctx->n,
+                               sizeof(precomp_ctx->s_ternary) /
+                                   sizeof(precomp_ctx->s_ternary[0]));
+    BREAK_ON_EPID_ERROR(result);
+
+    // one tangent per iteration, one line per non-zero digit, and the two
+    // Frobenius lines at the end of the loop
+    num_lines = (size_t)precomp_ctx->n + 2;
+    for (i = precomp_ctx->n - 1; i >= 0; i--) {
+      if (0 != precomp_ctx->s_ternary[i]) {
+        num_lines++;
+      }
+    }
+    precomp_ctx->lines =
+        (FfElement**)SAFE_ALLOC(3 * num_lines * sizeof(FfElement*));
+    if (!precomp_ctx->lines) {
+      result = kEpidMemAllocErr;
+      break;
+    }
+    precomp_ctx->num_lines = num_lines;
+    for (k = 0; k < 3 * num_lines; k++) {
+      result = NewFfElement(ps->Fq2, &precomp_ctx->lines[k]);
+      BREAK_ON_EPID_ERROR(result);
+    }
+    BREAK_ON_EPID_ERROR(result);
+
+    result = NewFfElement(ps->Fq2, &bx);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq2, &by);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq2, &x);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq2, &y);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq2, &z);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq2, &z2);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq2, &bx_);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq2, &by_);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq2, &neg_qy);
+    BREAK_ON_EPID_ERROR(result);
+
+    // check if b is in gb that was used to create ps
+    result = WriteEcPoint(ps->gb, b, &b_str, sizeof(b_str));
+    BREAK_ON_EPID_ERROR(result);
+    result = EcInGroup(ps->gb, &b_str, sizeof(b_str), &in_group);
+    BREAK_ON_EPID_ERROR(result);
+    if (false == in_group) {
+      result = kEpidBadArgErr;
+      break;
+    }
+    sts = ippsGFpECGetPoint(b->ipp_ec_pt, bx->ipp_ff_elem, by->ipp_ff_elem,
+                            ps->gb->ipp_ec);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpNeg(by->ipp_ff_elem, neg_qy->ipp_ff_elem, ps->Fq2->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+
+    // Walk the G2 side of the Miller loop in Pairing and record the line
+    // coefficients in the order they are consumed.
+    sts = ippsGFpCpyElement(bx->ipp_ff_elem, x->ipp_ff_elem, ps->Fq2->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpCpyElement(by->ipp_ff_elem, y->ipp_ff_elem, ps->Fq2->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSetElement(one_dat, sizeof(one_dat) / sizeof(Ipp32u),
+                            z->ipp_ff_elem, ps->Fq2->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpSetElement(one_dat, sizeof(one_dat) / sizeof(Ipp32u),
+                            z2->ipp_ff_elem, ps->Fq2->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    k = 0;
+    for (i = precomp_ctx->n - 1; i >= 0; i--) {
+      result = Tangent(ps->ff, &precomp_ctx->lines[3 * k++], x, y, z, z2, x, y,
+                       z, z2);
+      BREAK_ON_EPID_ERROR(result);
+      if (-1 == precomp_ctx->s_ternary[i]) {
+        result = Line(ps->ff, &precomp_ctx->lines[3 * k++], x, y, z, z2, x, y,
+                      z, z2, bx, neg_qy);
+        BREAK_ON_EPID_ERROR(result);
+      }
+      if (1 == precomp_ctx->s_ternary[i]) {
+        result = Line(ps->ff, &precomp_ctx->lines[3 * k++], x, y, z, z2, x, y,
+                      z, z2, bx, by);
+        BREAK_ON_EPID_ERROR(result);
+      }
+    }
+    BREAK_ON_EPID_ERROR(result);
+    if (ps->neg) {
+      sts = ippsGFpNeg(y->ipp_ff_elem, y->ipp_ff_elem, ps->Fq2->ipp_ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    result = PiOp(ps, bx_, by_, bx, by, 1);
+    BREAK_ON_EPID_ERROR(result);
+    result = Line(ps->ff, &precomp_ctx->lines[3 * k++], x, y, z, z2, x, y, z,
+                  z2, bx_, by_);
+    BREAK_ON_EPID_ERROR(result);
+    result = PiOp(ps, bx_, by_, bx, by, 2);
+    BREAK_ON_EPID_ERROR(result);
+    sts = ippsGFpNeg(by_->ipp_ff_elem, by_->ipp_ff_elem, ps->Fq2->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = Line(ps->ff, &precomp_ctx->lines[3 * k++], x, y, z, z2, x, y, z,
+                  z2, bx_, by_);
+    BREAK_ON_EPID_ERROR(result);
+    *precomp = precomp_ctx;
+    result = kEpidNoErr;
+  } while (0);
+
+  DeleteFfElement(&bx);
+  DeleteFfElement(&by);
+  DeleteFfElement(&x);
+  DeleteFfElement(&y);
+  DeleteFfElement(&z);
+  DeleteFfElement(&z2);
+  DeleteFfElement(&bx_);
+  DeleteFfElement(&by_);
+  DeleteFfElement(&neg_qy);
+  if (kEpidNoErr != result) {
+    DeletePairingG2Precomp(&precomp_ctx);
+  }
+  return result;
+}
+
+void DeletePairingG2Precomp(PairingG2Precomp** precomp) {
+  if (precomp && *precomp) {
+    if ((*precomp)->lines) {
+      size_t k = 0;
+      for (k = 0; k < 3 * (*precomp)->num_lines; k++) {
+        DeleteFfElement(&(*precomp)->lines[k]);
+      }
+      SAFE_FREE((*precomp)->lines);
+    }
+    (*precomp)->ps = NULL;
+    SAFE_FREE(*precomp);
+  }
+}
+
+EpidStatus PairingWithPrecomputedG2(PairingState* ps, EcPoint const* a,
+                                    PairingG2Precomp const* precomp,
+                                    FfElement* d) {
+  EpidStatus result = kEpidErr;
+  FfElement* ax = NULL;
+  FfElement* ay = NULL;
+  FfElement* f = NULL;
+
+  // check parameters
+  if (!ps || !ps->Fq || !ps->ff || !ps->ff->ipp_ff || !ps->Fq->ipp_ff ||
+      !ps->ga || !ps->ga->ipp_ec) {
+    return kEpidBadArgErr;
+  }
+  if (!a || !a->ipp_ec_pt) {
+    return kEpidBadArgErr;
+  }
+  if (!precomp || !precomp->lines || ps != precomp->ps) {
+    return kEpidBadArgErr;
+  }
+  if (!d || !d->ipp_ff_elem) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    IppStatus sts = ippStsNoErr;
+    Ipp32u one_dat[] = {1};
+    G1ElemStr a_str = {0};
+    bool in_group = true;
+    FfElement* const* l = precomp->lines;
+    int i = 0;
+
+    result = NewFfElement(ps->Fq, &ax);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->Fq, &ay);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewFfElement(ps->ff, &f);
+    BREAK_ON_EPID_ERROR(result);
+
+    // check if a is in ga that was used to create ps
+    result = WriteEcPoint(ps->ga, a, &a_str, sizeof(a_str));
+    BREAK_ON_EPID_ERROR(result);
+    result = EcInGroup(ps->ga, &a_str, sizeof(a_str), &in_group);
+    BREAK_ON_EPID_ERROR(result);
+    if (false == in_group) {
+      result = kEpidBadArgErr;
+      break;
+    }
+    sts = ippsGFpECGetPoint(a->ipp_ec_pt, ax->ipp_ff_elem, ay->ipp_ff_elem,
+                            ps->ga->ipp_ec);
+    BREAK_ON_IPP_ERROR(sts, result);
+
+    // Same accumulation as Pairing, with the lines replayed from precomp.
+    sts = ippsGFpSetElement(one_dat, sizeof(one_dat) / sizeof(Ipp32u),
+                            d->ipp_ff_elem, ps->ff->ipp_ff);
+    BREAK_ON_IPP_ERROR(sts, result);
+    for (i = precomp->n - 1; i >= 0; i--) {
+      result = EvalLine(ps->ff, f, l, ax, ay);
+      BREAK_ON_EPID_ERROR(result);
+      l += 3;
+      sts = ippsGFpMul(d->ipp_ff_elem, d->ipp_ff_elem, d->ipp_ff_elem,
+                       ps->ff->ipp_ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+      result = MulSpecial(d, d, f, ps);
+      BREAK_ON_EPID_ERROR(result);
+      if (0 != precomp->s_ternary[i]) {
+        result = EvalLine(ps->ff, f, l, ax, ay);
+        BREAK_ON_EPID_ERROR(result);
+        l += 3;
+        result = MulSpecial(d, d, f, ps);
+        BREAK_ON_EPID_ERROR(result);
+      }
+    }
+    BREAK_ON_EPID_ERROR(result);
+    if (ps->neg) {
+      sts = ippsGFpConj(d->ipp_ff_elem, d->ipp_ff_elem, ps->ff->ipp_ff);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    for (i = 0; i < 2; i++) {
+      result = EvalLine(ps->ff, f, l, ax, ay);
+      BREAK_ON_EPID_ERROR(result);
+      l += 3;
+      result = MulSpecial(d, d, f, ps);
+      BREAK_ON_EPID_ERROR(result);
+    }
+    BREAK_ON_EPID_ERROR(result);
+    result = FinalExp(ps, d, d);
+    BREAK_ON_EPID_ERROR(result);
+    result = kEpidNoErr;
+  } while (0);
+
+  DeleteFfElement(&ax);
+  DeleteFfElement(&ay);
+  DeleteFfElement(&f);
 
   return result;
 }
@@ -1003,13 +1274,16 @@ static EpidStatus FrobeniusOp(PairingState* ps, FfElement* d_out,
 }
 
 /*
-(f, X', Y', Z', Z2') = line(Px, Py, X, Y, Z, Z2, Qx, Qy)
-Input: Px, Py (elements in Fq), X, Y, Z, Z2, Qx, Qy (elements in Fq2)
-Output: f (an element in GT), X', Y', Z', Z2' (elements in Fq2)
+(l, X', Y', Z', Z2') = line(X, Y, Z, Z2, Qx, Qy)
+Input: X, Y, Z, Z2, Qx, Qy (elements in Fq2)
+Output: l[0], l[1], l[2] (coefficients of the line function, elements in Fq2),
+        X', Y', Z', Z2' (elements in Fq2)
+
+The line function evaluated at P = (Px, Py) is
+f = ((l[0] * Py, 0, 0), (l[1] * Px, l[2], 0)), see EvalLine.
 */
-static EpidStatus Line(FiniteField* gt, FfElement* f, FfElement* x_out,
+static EpidStatus Line(FiniteField* gt, FfElement* l[3], FfElement* x_out,
                        FfElement* y_out, FfElement* z_out, FfElement* z2_out,
-                       FfElement const* px, FfElement const* py,
                        FfElement const* x, FfElement const* y,
                        FfElement const* z, FfElement const* z2,
                        FfElement const* qx, FfElement const* qy) {
@@ -1026,10 +1300,10 @@ static EpidStatus Line(FiniteField* gt, FfElement* f, FfElement* x_out,
   FfElement* t9 = NULL;
   FfElement* t10 = NULL;
   FfElement* t = NULL;
-  Fq12ElemDat fDat = {0};
 
   // check parameters
-  if (!f || !f->ipp_ff_elem) {
+  if (!l || !l[0] || !l[0]->ipp_ff_elem || !l[1] || !l[1]->ipp_ff_elem ||
+      !l[2] || !l[2]->ipp_ff_elem) {
     return kEpidBadArgErr;
   }
   if (!x_out || !x_out->ipp_ff_elem) {
@@ -1044,12 +1318,6 @@ static EpidStatus Line(FiniteField* gt, FfElement* f, FfElement* x_out,
   if (!z2_out || !z2_out->ipp_ff_elem) {
     return kEpidBadArgErr;
   }
-  if (!px || !px->ipp_ff_elem) {
-    return kEpidBadArgErr;
-  }
-  if (!py || !py->ipp_ff_elem) {
-    return kEpidBadArgErr;
-  }
   if (!x || !x->ipp_ff_elem) {
     return kEpidBadArgErr;
   }
@@ -1242,38 +1510,20 @@ static EpidStatus Line(FiniteField* gt, FfElement* f, FfElement* x_out,
     BREAK_ON_IPP_ERROR(sts, result);
     sts = ippsGFpSub(t9->ipp_ff_elem, t10->ipp_ff_elem, t9->ipp_ff_elem, Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    // 20. Set t10 = Fq2.mul(Z', Py).
-    sts = ippsGFpMul_PE(z_out->ipp_ff_elem, py->ipp_ff_elem, t10->ipp_ff_elem,
-                        Fq2);
-    BREAK_ON_IPP_ERROR(sts, result);
-    // 21. Set t10 = t10 + t10.
-    sts = ippsGFpAdd(t10->ipp_ff_elem, t10->ipp_ff_elem, t10->ipp_ff_elem, Fq2);
-    BREAK_ON_IPP_ERROR(sts, result);
-    // 22. Set t6 = -t6.
-    sts = ippsGFpNeg(t6->ipp_ff_elem, t6->ipp_ff_elem, Fq2);
-    BREAK_ON_IPP_ERROR(sts, result);
-    // 23. Set t1 = Fq2.mul(t6, Px).
-    sts = ippsGFpMul_PE(t6->ipp_ff_elem, px->ipp_ff_elem, t1->ipp_ff_elem, Fq2);
+    // 20. Set l[0] = Z' + Z', so that t10 = Fq2.mul(l[0], Py).
+    sts = ippsGFpAdd(z_out->ipp_ff_elem, z_out->ipp_ff_elem, l[0]->ipp_ff_elem,
+                     Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    // 24. Set t1 = t1 + t1.
-    sts = ippsGFpAdd(t1->ipp_ff_elem, t1->ipp_ff_elem, t1->ipp_ff_elem, Fq2);
+    // 21. Set l[1] = -(t6 + t6), so that t1 = Fq2.mul(l[1], Px).
+    sts = ippsGFpAdd(t6->ipp_ff_elem, t6->ipp_ff_elem, l[1]->ipp_ff_elem, Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    // 25. Set f = ((t10, 0, 0), (t1, t9, 0)).
-    sts = ippsGFpGetElement(t10->ipp_ff_elem, (BNU)&fDat.x[0].x[0],
-                            sizeof(fDat.x[0].x[0]) / sizeof(Ipp32u), Fq2);
+    sts = ippsGFpNeg(l[1]->ipp_ff_elem, l[1]->ipp_ff_elem, Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsGFpGetElement(t1->ipp_ff_elem, (BNU)&fDat.x[1].x[0],
-                            sizeof(fDat.x[1].x[0]) / sizeof(Ipp32u), Fq2);
+    // 22. Set l[2] = t9.
+    sts = ippsGFpCpyElement(t9->ipp_ff_elem, l[2]->ipp_ff_elem, Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsGFpGetElement(t9->ipp_ff_elem, (BNU)&fDat.x[1].x[1],
-                            sizeof(fDat.x[1].x[1]) / sizeof(Ipp32u), Fq2);
-    BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsGFpSetElement((Ipp32u*)&fDat, sizeof(fDat) / sizeof(Ipp32u),
-                            f->ipp_ff_elem, gt->ipp_ff);
-    BREAK_ON_IPP_ERROR(sts, result);
-    // 26. Return (f, X', Y', Z', Z2').
+    // 23. Return (l, X', Y', Z', Z2').
   } while (0);
-  EpidZeroMemory(&fDat, sizeof(fDat));
   DeleteFfElement(&t);
   DeleteFfElement(&t10);
   DeleteFfElement(&t9);
@@ -1291,14 +1541,17 @@ static EpidStatus Line(FiniteField* gt, FfElement* f, FfElement* x_out,
 }
 
 /*
-(f, X', Y', Z', Z2') = tangent(Px, Py, X, Y, Z, Z2)
-Input: Px, Py (elements in Fq), X, Y, Z, Z2 (elements in Fq2)
-Output: f (an element in GT), X', Y', Z', Z2' (elements in Fq2)
+(l, X', Y', Z', Z2') = tangent(X, Y, Z, Z2)
+Input: X, Y, Z, Z2 (elements in Fq2)
+Output: l[0], l[1], l[2] (coefficients of the line function, elements in Fq2),
+        X', Y', Z', Z2' (elements in Fq2)
+
+The line function evaluated at P = (Px, Py) is
+f = ((l[0] * Py, 0, 0), (l[1] * Px, l[2], 0)), see EvalLine.
 Steps:
 */
-static EpidStatus Tangent(FiniteField* gt, FfElement* f, FfElement* x_out,
+static EpidStatus Tangent(FiniteField* gt, FfElement* l[3], FfElement* x_out,
                           FfElement* y_out, FfElement* z_out, FfElement* z2_out,
-                          FfElement const* px, FfElement const* py,
                           FfElement const* x, FfElement const* y,
                           FfElement const* z, FfElement const* z2) {
   EpidStatus result = kEpidErr;
@@ -1309,13 +1562,13 @@ static EpidStatus Tangent(FiniteField* gt, FfElement* f, FfElement* x_out,
   FfElement* t4 = NULL;
   FfElement* t5 = NULL;
   FfElement* t6 = NULL;
-  Fq12ElemDat fDat = {0};
 
   // validate input
   if (!gt || !gt->ipp_ff) {
     return kEpidBadArgErr;
   }
-  if (!f || !f->ipp_ff_elem) {
+  if (!l || !l[0] || !l[0]->ipp_ff_elem || !l[1] || !l[1]->ipp_ff_elem ||
+      !l[2] || !l[2]->ipp_ff_elem) {
     return kEpidBadArgErr;
   }
   if (!x_out || !x_out->ipp_ff_elem) {
@@ -1330,12 +1583,6 @@ static EpidStatus Tangent(FiniteField* gt, FfElement* f, FfElement* x_out,
   if (!z2_out || !z2_out->ipp_ff_elem) {
     return kEpidBadArgErr;
   }
-  if (!px || !px->ipp_ff_elem) {
-    return kEpidBadArgErr;
-  }
-  if (!py || !py->ipp_ff_elem) {
-    return kEpidBadArgErr;
-  }
   if (!x || !x->ipp_ff_elem) {
     return kEpidBadArgErr;
   }
@@ -1446,17 +1693,16 @@ static EpidStatus Tangent(FiniteField* gt, FfElement* f, FfElement* x_out,
                        Fq2);
       BREAK_ON_IPP_ERROR(sts, result);
     }
-    // 12.Set t3 = -2 * (t4 * Z2).
-    sts = ippsGFpMul(t4->ipp_ff_elem, z2->ipp_ff_elem, t3->ipp_ff_elem, Fq2);
+    // 12.Set l[1] = -2 * (t4 * Z2).
+    sts = ippsGFpMul(t4->ipp_ff_elem, z2->ipp_ff_elem, l[1]->ipp_ff_elem, Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsGFpAdd(t3->ipp_ff_elem, t3->ipp_ff_elem, t3->ipp_ff_elem, Fq2);
-    BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsGFpNeg(t3->ipp_ff_elem, t3->ipp_ff_elem, Fq2);
+    sts = ippsGFpAdd(l[1]->ipp_ff_elem, l[1]->ipp_ff_elem, l[1]->ipp_ff_elem,
+                     Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    // 13.Set t3 = Fq2.mul(t3, Px).
-    sts = ippsGFpMul_PE(t3->ipp_ff_elem, px->ipp_ff_elem, t3->ipp_ff_elem, Fq2);
+    sts = ippsGFpNeg(l[1]->ipp_ff_elem, l[1]->ipp_ff_elem, Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    // 14.Set t6 = t6 * t6 - t0 - t5 - 4 * t1.
+    // 13.t3 = Fq2.mul(l[1], Px) is deferred to EvalLine.
+    // 14.Set l[2] = t6 * t6 - t0 - t5 - 4 * t1.
     sts = ippsGFpMul(t6->ipp_ff_elem, t6->ipp_ff_elem, t6->ipp_ff_elem, Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
     sts = ippsGFpSub(t6->ipp_ff_elem, t0->ipp_ff_elem, t6->ipp_ff_elem, Fq2);
@@ -1467,44 +1713,159 @@ static EpidStatus Tangent(FiniteField* gt, FfElement* f, FfElement* x_out,
       sts = ippsGFpSub(t6->ipp_ff_elem, t1->ipp_ff_elem, t6->ipp_ff_elem, Fq2);
       BREAK_ON_IPP_ERROR(sts, result);
     }
-    // 15.Set t0 = 2 * (Z' * Z2).
-    sts = ippsGFpMul(z_out->ipp_ff_elem, z2->ipp_ff_elem, t0->ipp_ff_elem, Fq2);
+    sts = ippsGFpCpyElement(t6->ipp_ff_elem, l[2]->ipp_ff_elem, Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsGFpAdd(t0->ipp_ff_elem, t0->ipp_ff_elem, t0->ipp_ff_elem, Fq2);
+    // 15.Set l[0] = 2 * (Z' * Z2).
+    sts = ippsGFpMul(z_out->ipp_ff_elem, z2->ipp_ff_elem, l[0]->ipp_ff_elem,
+                     Fq2);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpAdd(l[0]->ipp_ff_elem, l[0]->ipp_ff_elem, l[0]->ipp_ff_elem,
+                     Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    // 16.Set t0 = Fq2.mul(t0, Py).
-    sts = ippsGFpMul_PE(t0->ipp_ff_elem, py->ipp_ff_elem, t0->ipp_ff_elem, Fq2);
+    // 16.t0 = Fq2.mul(l[0], Py) is deferred to EvalLine.
+    // 17.Set Z2' = Z' * Z'.
+    sts = ippsGFpMul(z_out->ipp_ff_elem, z_out->ipp_ff_elem,
+                     z2_out->ipp_ff_elem, Fq2);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // 18.Return (l, X', Y', Z', Z2').
+  } while (0);
+  DeleteFfElement(&t6);
+  DeleteFfElement(&t5);
+  DeleteFfElement(&t4);
+  DeleteFfElement(&t3);
+  DeleteFfElement(&t2);
+  DeleteFfElement(&t1);
+  DeleteFfElement(&t0);
+  return result;
+}
+
+/*
+f = evalLine(l, Px, Py)
+Input: l[0], l[1], l[2] (elements in Fq2), Px, Py (elements in Fq)
+Output: f (an element in GT) where f = ((l[0] * Py, 0, 0), (l[1] * Px, l[2], 0))
+*/
+static EpidStatus EvalLine(FiniteField* gt, FfElement* f,
+                           FfElement* const l[3], FfElement const* px,
+                           FfElement const* py) {
+  EpidStatus result = kEpidErr;
+  FfElement* t0 = NULL;
+  Fq12ElemDat fDat = {0};
+
+  // validate input
+  if (!gt || !gt->ipp_ff || !gt->ground_ff || !gt->ground_ff->ground_ff) {
+    return kEpidBadArgErr;
+  }
+  if (!f || !f->ipp_ff_elem) {
+    return kEpidBadArgErr;
+  }
+  if (!l || !l[0] || !l[0]->ipp_ff_elem || !l[1] || !l[1]->ipp_ff_elem ||
+      !l[2] || !l[2]->ipp_ff_elem) {
+    return kEpidBadArgErr;
+  }
+  if (!px || !px->ipp_ff_elem) {
+    return kEpidBadArgErr;
+  }
+  if (!py || !py->ipp_ff_elem) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    IppStatus sts = ippStsNoErr;
+    FiniteField* Ffq2 = gt->ground_ff->ground_ff;
+    IppsGFpState* Fq2 = Ffq2->ipp_ff;
+
+    result = NewFfElement(Ffq2, &t0);
+    BREAK_ON_EPID_ERROR(result);
+    // 1. Set f[0][0] = Fq2.mul(l[0], Py).
+    sts = ippsGFpMul_PE(l[0]->ipp_ff_elem, py->ipp_ff_elem, t0->ipp_ff_elem,
+                        Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    // 17.Set f = ((t0, 0, 0), (t3, t6, 0)).
     sts = ippsGFpGetElement(t0->ipp_ff_elem, (BNU)&fDat.x[0].x[0],
                             sizeof(fDat.x[0].x[0]) / sizeof(Ipp32u), Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsGFpGetElement(t3->ipp_ff_elem, (BNU)&fDat.x[1].x[0],
+    // 2. Set f[1][0] = Fq2.mul(l[1], Px).
+    sts = ippsGFpMul_PE(l[1]->ipp_ff_elem, px->ipp_ff_elem, t0->ipp_ff_elem,
+                        Fq2);
+    BREAK_ON_IPP_ERROR(sts, result);
+    sts = ippsGFpGetElement(t0->ipp_ff_elem, (BNU)&fDat.x[1].x[0],
                             sizeof(fDat.x[1].x[0]) / sizeof(Ipp32u), Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
-    sts = ippsGFpGetElement(t6->ipp_ff_elem, (BNU)&fDat.x[1].x[1],
+    // 3. Set f[1][1] = l[2].
+    sts = ippsGFpGetElement(l[2]->ipp_ff_elem, (BNU)&fDat.x[1].x[1],
                             sizeof(fDat.x[1].x[1]) / sizeof(Ipp32u), Fq2);
     BREAK_ON_IPP_ERROR(sts, result);
+    // 4. Return f = ((f[0][0], 0, 0), (f[1][0], f[1][1], 0)).
     sts = ippsGFpSetElement((Ipp32u*)&fDat, sizeof(fDat) / sizeof(Ipp32u),
                             f->ipp_ff_elem, gt->ipp_ff);
     BREAK_ON_IPP_ERROR(sts, result);
-    // 18.Set Z2' = Z' * Z'.
-    sts = ippsGFpMul(z_out->ipp_ff_elem, z_out->ipp_ff_elem,
-                     z2_out->ipp_ff_elem, Fq2);
-    BREAK_ON_IPP_ERROR(sts, result);
-    // 19.Return (f, X', Y', Z', Z2').
+    result = kEpidNoErr;
   } while (0);
   EpidZeroMemory(&fDat, sizeof(fDat));
-  DeleteFfElement(&t6);
-  DeleteFfElement(&t5);
-  DeleteFfElement(&t4);
-  DeleteFfElement(&t3);
-  DeleteFfElement(&t2);
-  DeleteFfElement(&t1);
   DeleteFfElement(&t0);
   return result;
 }
 
+/*
+(sn...s1s0) = millerLoopTernary(t, neg)
+Input: t (big integer), neg (boolean) from the pairing state
+Output: sn...s1s0 (ternary representation of s = 6t + 2, or s = 6t - 2 if neg)
+*/
+static EpidStatus MillerLoopTernary(PairingState* ps, int* s, int* n,
+                                    int max_elements) {
+  EpidStatus result = kEpidErr;
+  BigNum* x = NULL;
+  BigNum* two = NULL;
+  BigNum* six = NULL;
+
+  // check parameters
+  if (!ps || !ps->t || !ps->t->ipp_bn) {
+    return kEpidBadArgErr;
+  }
+  if (!s || !n) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    IppStatus sts = ippStsNoErr;
+    Ipp32u two_dat[] = {2};
+    Ipp32u six_dat[] = {6};
+
+    result = NewBigNum(sizeof(BigNumStr), &x);
+    BREAK_ON_EPID_ERROR(result);
+    result = NewBigNum(sizeof(BigNumStr), &two);
+    BREAK_ON_EPID_ERROR(result);
+    sts = ippsSet_BN(IppsBigNumPOS, sizeof(two_dat) / sizeof(Ipp32u), two_dat,
+                     two->ipp_bn);
+    BREAK_ON_IPP_ERROR(sts, result);
+    result = NewBigNum(sizeof(BigNumStr), &six);
+    BREAK_ON_EPID_ERROR(result);
+    sts = ippsSet_BN(IppsBigNumPOS, sizeof(six_dat) / sizeof(Ipp32u), six_dat,
+                     six->ipp_bn);
+    BREAK_ON_IPP_ERROR(sts, result);
+    // 1. If neg = 0, compute integer s = 6t + 2, otherwise, compute
+    // s = 6t - 2
+    sts = ippsMul_BN(six->ipp_bn, ps->t->ipp_bn, x->ipp_bn);
+    BREAK_ON_IPP_ERROR(sts, result);
+    if (ps->neg) {
+      sts = ippsSub_BN(x->ipp_bn, two->ipp_bn, x->ipp_bn);
+      BREAK_ON_IPP_ERROR(sts, result);
+    } else {
+      sts = ippsAdd_BN(x->ipp_bn, two->ipp_bn, x->ipp_bn);
+      BREAK_ON_IPP_ERROR(sts, result);
+    }
+    // 2. Let sn...s1s0 be the ternary representation of s
+    result = Ternary(s, n, max_elements, x);
+    BREAK_ON_EPID_ERROR(result);
+    result = kEpidNoErr;
+  } while (0);
+
+  DeleteBigNum(&x);
+  DeleteBigNum(&two);
+  DeleteBigNum(&six);
+
+  return result;
+}
+
 /*
 (sn...s1s0) = ternary(s)
 Input: s (big integer)
@@ -0,0 +1,377 @@
+/*############################################################################
+  # Copyright 2016-2019 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+/// Endomorphism accelerated exponentiation unit tests.
+/*! \file */
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "testhelper/ecgroup_wrapper-testhelper.h"
+#include "testhelper/ecpoint_wrapper-testhelper.h"
+#include "testhelper/epid_gtest-testhelper.h"
+#include "testhelper/epid_params-testhelper.h"
+#include "testhelper/errors-testhelper.h"
+
+extern "C" {
+#include "ippmath/ecglv.h"
+#include "ippmath/expworkspace.h"
+#include "ippmath/pairing.h"
+}
+
+namespace {
+
+class EcGlvTest : public ::testing::Test {
+ public:
+  static const BigNumStr t_str;
+  static const BigNumStr p_str;
+  static const G1ElemStr g1_elem_str;
+  static const G2ElemStr g2_elem_str;
+
+  virtual void SetUp() {
+    params = new Epid20Params();
+    THROW_ON_EPIDERR(NewPairingState(params->G1, params->G2, params->GT,
+                                     &t_str, true, &ps));
+    THROW_ON_EPIDERR(NewEcGlvState(ps, params->G1, &g1_glv));
+    THROW_ON_EPIDERR(NewEcGlvState(ps, params->G2, &g2_glv));
+  }
+  virtual void TearDown() {
+    DeleteEcGlvState(&g1_glv);
+    DeleteEcGlvState(&g2_glv);
+    DeletePairingState(&ps);
+    delete params;
+  }
+
+  /// Powers covering the edge cases and a spread of pseudo-random values
+  static std::vector<BigNumStr> Powers() {
+    std::vector<BigNumStr> powers;
+    BigNumStr b = {0};
+    uint32_t seed = 0x2545F491;
+    powers.push_back(b);
+    b.data.data[sizeof(b) - 1] = 1;
+    powers.push_back(b);
+    b.data.data[sizeof(b) - 1] = 2;
+    powers.push_back(b);
+    powers.push_back(p_str);
+    b = p_str;
+    b.data.data[sizeof(b) - 1]--;
+    powers.push_back(b);
+    for (int i = 0; i < 16; i++) {
+      for (size_t j = 0; j < sizeof(b); j++) {
+        seed = seed * 1103515245 + 12345;
+        b.data.data[j] = (uint8_t)(seed >> 16);
+      }
+      // keep below the order
+      b.data.data[0] &= 0x7f;
+      // vary the length
+      std::memset(&b, 0, (size_t)i);
+      powers.push_back(b);
+    }
+    return powers;
+  }
+
+  Epid20Params* params = nullptr;
+  PairingState* ps = nullptr;
+  EcGlvState* g1_glv = nullptr;
+  EcGlvState* g2_glv = nullptr;
+};
+
+const BigNumStr EcGlvTest::t_str = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x68, 0x82, 0xF5, 0xC0, 0x30, 0xB0, 0xA8, 0x01};
+
+const BigNumStr EcGlvTest::p_str = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFC, 0xF0, 0xCD, 0x46, 0xE5, 0xF2,
+    0x5E, 0xEE, 0x71, 0xA4, 0x9E, 0x0C, 0xDC, 0x65, 0xFB, 0x12, 0x99,
+    0x92, 0x1A, 0xF6, 0x2D, 0x53, 0x6C, 0xD1, 0x0B, 0x50, 0x0D};
+
+const G1ElemStr EcGlvTest::g1_elem_str = {
+    0xd7, 0xe2, 0xf9, 0x37, 0x21, 0x0f, 0x09, 0x97, 0x0f, 0xca, 0xa6,
+    0x03, 0x7d, 0x91, 0xc3, 0x75, 0x8a, 0xc9, 0x44, 0x11, 0xfc, 0xaa,
+    0x55, 0x67, 0xba, 0xce, 0xaf, 0x8d, 0xf6, 0x7c, 0x84, 0x83, 0x04,
+    0xb7, 0xa6, 0xff, 0x9f, 0x0d, 0x26, 0x73, 0xaf, 0x6c, 0xd0, 0x0a,
+    0xf6, 0x13, 0xc9, 0x44, 0x3f, 0xf0, 0x82, 0x58, 0x48, 0x59, 0x03,
+    0x3f, 0x88, 0xe2, 0x46, 0xd6, 0x0f, 0x93, 0x42, 0x4b,
+};
+
+const G2ElemStr EcGlvTest::g2_elem_str = {
+    0x3f, 0x4c, 0xb5, 0x2d, 0xbc, 0x72, 0xb0, 0x9c, 0x6f, 0xb2, 0xb5, 0xc1,
+    0xdc, 0xfb, 0xda, 0x35, 0x91, 0xa6, 0x8d, 0x51, 0x37, 0x70, 0xe2, 0x17,
+    0xad, 0x53, 0x23, 0xdc, 0xa3, 0xc3, 0xfd, 0x4c, 0x90, 0xfa, 0x4f, 0xa2,
+    0xcb, 0x35, 0xf3, 0x50, 0x5e, 0x8e, 0xf4, 0xce, 0x7f, 0xb0, 0x8a, 0x69,
+    0x49, 0xdf, 0xf5, 0x4f, 0xb0, 0xc1, 0xd7, 0xf9, 0xb8, 0xfb, 0x89, 0xd1,
+    0xb6, 0xf8, 0x74, 0x04, 0xef, 0xc6, 0x60, 0x05, 0x62, 0xf3, 0x17, 0x5a,
+    0x80, 0xf4, 0x4b, 0x97, 0x08, 0x3e, 0x43, 0xa1, 0x44, 0x4c, 0x54, 0x86,
+    0x16, 0x20, 0xb9, 0xcc, 0xfb, 0xbd, 0x00, 0x5f, 0xc8, 0x01, 0xfb, 0x5b,
+    0xc1, 0x6e, 0x2b, 0x46, 0xe2, 0x04, 0x70, 0xeb, 0xa2, 0xaa, 0x86, 0x5a,
+    0x35, 0x14, 0x0e, 0xc9, 0xdf, 0xba, 0x9b, 0x6f, 0x3a, 0xca, 0x94, 0x9c,
+    0x44, 0x89, 0x94, 0xa3, 0xeb, 0x61, 0x8b, 0x01,
+};
+
+///////////////////////////////////////////////////////////////////////
+// NewEcGlvState / DeleteEcGlvState
+
+TEST_F(EcGlvTest, DeleteEcGlvStateWorksGivenNullPointer) {
+  EXPECT_NO_THROW(DeleteEcGlvState(nullptr));
+  EcGlvState* glv = nullptr;
+  EXPECT_NO_THROW(DeleteEcGlvState(&glv));
+}
+
+TEST_F(EcGlvTest, NewEcGlvStateFailsGivenNullParameters) {
+  EcGlvState* glv = nullptr;
+  EXPECT_EQ(kEpidBadArgErr, NewEcGlvState(nullptr, this->params->G1, &glv));
+  EXPECT_EQ(kEpidBadArgErr, NewEcGlvState(this->ps, nullptr, &glv));
+  EXPECT_EQ(kEpidBadArgErr,
+            NewEcGlvState(this->ps, this->params->G1, nullptr));
+}
+
+TEST_F(EcGlvTest, NewEcGlvStateFailsGivenGroupNotInPairing) {
+  Epid20Params other;
+  EcGlvState* glv = nullptr;
+  EXPECT_EQ(kEpidBadArgErr, NewEcGlvState(this->ps, other.G1, &glv));
+}
+
+///////////////////////////////////////////////////////////////////////
+// EcGlvExp / EcGlvSscmExp
+
+TEST_F(EcGlvTest, EcGlvExpFailsGivenNullParameters) {
+  EcPointObj a(&this->params->G1, this->g1_elem_str);
+  EcPointObj r(&this->params->G1);
+  EXPECT_EQ(kEpidBadArgErr, EcGlvExp(nullptr, a, &this->p_str, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvExp(this->g1_glv, nullptr, &this->p_str, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvExp(this->g1_glv, a, nullptr, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvExp(this->g1_glv, a, &this->p_str, nullptr));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvSscmExp(nullptr, a, &this->p_str, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcGlvSscmExp(this->g1_glv, nullptr, &this->p_str, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvSscmExp(this->g1_glv, a, nullptr, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcGlvSscmExp(this->g1_glv, a, &this->p_str, nullptr));
+}
+
+TEST_F(EcGlvTest, EcGlvExpFailsGivenArgumentsMismatch) {
+  EcPointObj a(&this->params->G1, this->g1_elem_str);
+  EcPointObj r(&this->params->G1);
+  EXPECT_EQ(kEpidBadArgErr, EcGlvExp(this->g2_glv, a, &this->p_str, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvSscmExp(this->g2_glv, a, &this->p_str, r));
+}
+
+TEST_F(EcGlvTest, EcGlvExpFailsGivenPowerGreaterThanOrder) {
+  EcPointObj a(&this->params->G1, this->g1_elem_str);
+  EcPointObj r(&this->params->G1);
+  BigNumStr b = this->p_str;
+  b.data.data[sizeof(b) - 1]++;
+  EXPECT_EQ(kEpidBadArgErr, EcGlvExp(this->g1_glv, a, &b, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvSscmExp(this->g1_glv, a, &b, r));
+}
+
+TEST_F(EcGlvTest, EcGlvExpMatchesEcExpInG1) {
+  EcPointObj a(&this->params->G1, this->g1_elem_str);
+  EcPointObj expected(&this->params->G1);
+  EcPointObj r(&this->params->G1);
+  for (auto const& b : Powers()) {
+    G1ElemStr expected_str = {0};
+    G1ElemStr r_str = {0};
+    THROW_ON_EPIDERR(EcExp(this->params->G1, a, &b, expected));
+    THROW_ON_EPIDERR(WriteEcPoint(this->params->G1, expected, &expected_str,
+                                  sizeof(expected_str)));
+    EXPECT_EQ(kEpidNoErr, EcGlvExp(this->g1_glv, a, &b, r));
+    THROW_ON_EPIDERR(
+        WriteEcPoint(this->params->G1, r, &r_str, sizeof(r_str)));
+    EXPECT_EQ(0, std::memcmp(&expected_str, &r_str, sizeof(r_str)));
+    EXPECT_EQ(kEpidNoErr, EcGlvSscmExp(this->g1_glv, a, &b, r));
+    THROW_ON_EPIDERR(
+        WriteEcPoint(this->params->G1, r, &r_str, sizeof(r_str)));
+    EXPECT_EQ(0, std::memcmp(&expected_str, &r_str, sizeof(r_str)));
+  }
+}
+
+TEST_F(EcGlvTest, EcGlvExpMatchesEcExpInG2) {
+  EcPointObj a(&this->params->G2, this->g2_elem_str);
+  EcPointObj expected(&this->params->G2);
+  EcPointObj r(&this->params->G2);
+  for (auto const& b : Powers()) {
+    G2ElemStr expected_str = {0};
+    G2ElemStr r_str = {0};
+    THROW_ON_EPIDERR(EcExp(this->params->G2, a, &b, expected));
+    THROW_ON_EPIDERR(WriteEcPoint(this->params->G2, expected, &expected_str,
+                                  sizeof(expected_str)));
+    EXPECT_EQ(kEpidNoErr, EcGlvExp(this->g2_glv, a, &b, r));
+    THROW_ON_EPIDERR(
+        WriteEcPoint(this->params->G2, r, &r_str, sizeof(r_str)));
+    EXPECT_EQ(0, std::memcmp(&expected_str, &r_str, sizeof(r_str)));
+    EXPECT_EQ(kEpidNoErr, EcGlvSscmExp(this->g2_glv, a, &b, r));
+    THROW_ON_EPIDERR(
+        WriteEcPoint(this->params->G2, r, &r_str, sizeof(r_str)));
+    EXPECT_EQ(0, std::memcmp(&expected_str, &r_str, sizeof(r_str)));
+  }
+}
+
+TEST_F(EcGlvTest, EcGlvExpWorksGivenIdentityBase) {
+  EcPointObj a(&this->params->G2);
+  EcPointObj r(&this->params->G2, this->g2_elem_str);
+  G2ElemStr identity_str = {0};
+  G2ElemStr r_str = {0};
+  THROW_ON_EPIDERR(WriteEcPoint(this->params->G2, a, &identity_str,
+                                sizeof(identity_str)));
+  EXPECT_EQ(kEpidNoErr, EcGlvSscmExp(this->g2_glv, a, &this->p_str, r));
+  THROW_ON_EPIDERR(WriteEcPoint(this->params->G2, r, &r_str, sizeof(r_str)));
+  EXPECT_EQ(0, std::memcmp(&identity_str, &r_str, sizeof(r_str)));
+}
+
+///////////////////////////////////////////////////////////////////////
+// EcGlvMultiExp / EcGlvSscmMultiExp
+
+TEST_F(EcGlvTest, EcGlvMultiExpFailsGivenNullParameters) {
+  EcPointObj a(&this->params->G1, this->g1_elem_str);
+  EcPointObj r(&this->params->G1);
+  EcPoint const* pts[] = {a, nullptr};
+  BigNumStr const* b[] = {&this->p_str, &this->p_str};
+  EXPECT_EQ(kEpidBadArgErr, EcGlvMultiExp(nullptr, pts, b, 1, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvMultiExp(this->g1_glv, nullptr, b, 1, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvMultiExp(this->g1_glv, pts, nullptr, 1, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvMultiExp(this->g1_glv, pts, b, 0, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvMultiExp(this->g1_glv, pts, b, 1, nullptr));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvMultiExp(this->g1_glv, pts, b, 2, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvSscmMultiExp(this->g1_glv, pts, b, 2, r));
+}
+
+TEST_F(EcGlvTest, EcGlvMultiExpMatchesEcMultiExpInG1) {
+  std::vector<BigNumStr> powers = Powers();
+  EcPointObj a0(&this->params->G1, this->g1_elem_str);
+  EcPointObj a1(&this->params->G1);
+  EcPointObj a2(&this->params->G1);
+  EcPointObj expected(&this->params->G1);
+  EcPointObj r(&this->params->G1);
+  G1ElemStr expected_str = {0};
+  G1ElemStr r_str = {0};
+  THROW_ON_EPIDERR(EcExp(this->params->G1, a0, &powers.back(), a1));
+  THROW_ON_EPIDERR(EcMul(this->params->G1, a0, a1, a2));
+  EcPoint const* pts[] = {a0, a1, a2};
+  BigNumStr const* b[] = {&powers[powers.size() - 2],
+                          &powers[powers.size() - 3], &powers[3]};
+  THROW_ON_EPIDERR(EcMultiExp(this->params->G1, pts, b, 3, expected));
+  THROW_ON_EPIDERR(WriteEcPoint(this->params->G1, expected, &expected_str,
+                                sizeof(expected_str)));
+  EXPECT_EQ(kEpidNoErr, EcGlvMultiExp(this->g1_glv, pts, b, 3, r));
+  THROW_ON_EPIDERR(WriteEcPoint(this->params->G1, r, &r_str, sizeof(r_str)));
+  EXPECT_EQ(0, std::memcmp(&expected_str, &r_str, sizeof(r_str)));
+  EXPECT_EQ(kEpidNoErr, EcGlvSscmMultiExp(this->g1_glv, pts, b, 3, r));
+  THROW_ON_EPIDERR(WriteEcPoint(this->params->G1, r, &r_str, sizeof(r_str)));
+  EXPECT_EQ(0, std::memcmp(&expected_str, &r_str, sizeof(r_str)));
+}
+
+TEST_F(EcGlvTest, EcGlvMultiExpMatchesEcMultiExpInG2) {
+  std::vector<BigNumStr> powers = Powers();
+  EcPointObj a0(&this->params->G2, this->g2_elem_str);
+  EcPointObj a1(&this->params->G2);
+  EcPointObj expected(&this->params->G2);
+  EcPointObj r(&this->params->G2);
+  G2ElemStr expected_str = {0};
+  G2ElemStr r_str = {0};
+  THROW_ON_EPIDERR(EcExp(this->params->G2, a0, &powers.back(), a1));
+  EcPoint const* pts[] = {a0, a1};
+  BigNumStr const* b[] = {&powers[powers.size() - 2],
+                          &powers[powers.size() - 3]};
+  THROW_ON_EPIDERR(EcMultiExp(this->params->G2, pts, b, 2, expected));
+  THROW_ON_EPIDERR(WriteEcPoint(this->params->G2, expected, &expected_str,
+                                sizeof(expected_str)));
+  EXPECT_EQ(kEpidNoErr, EcGlvMultiExp(this->g2_glv, pts, b, 2, r));
+  THROW_ON_EPIDERR(WriteEcPoint(this->params->G2, r, &r_str, sizeof(r_str)));
+  EXPECT_EQ(0, std::memcmp(&expected_str, &r_str, sizeof(r_str)));
+  EXPECT_EQ(kEpidNoErr, EcGlvSscmMultiExp(this->g2_glv, pts, b, 2, r));
+  THROW_ON_EPIDERR(WriteEcPoint(this->params->G2, r, &r_str, sizeof(r_str)));
+  EXPECT_EQ(0, std::memcmp(&expected_str, &r_str, sizeof(r_str)));
+}
+
+
+TEST_F(EcGlvTest, EcGlvMultiExpWithWorkspaceFailsGivenBadWorkspace) {
+  EcPointObj a(&this->params->G1, this->g1_elem_str);
+  EcPointObj r(&this->params->G1);
+  EcPoint const* pts[] = {a, a};
+  BigNumStr const* b[] = {&this->p_str, &this->p_str};
+  ExpWorkspace* ws = nullptr;
+  THROW_ON_EPIDERR(NewExpWorkspace(1, &ws));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcGlvMultiExpWithWorkspace(this->g1_glv, pts, b, 1, nullptr, r));
+  EXPECT_EQ(kEpidBadArgErr, EcGlvSscmMultiExpWithWorkspace(
+                                this->g1_glv, pts, b, 1, nullptr, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcGlvMultiExpWithWorkspace(this->g1_glv, pts, b, 2, ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcGlvSscmMultiExpWithWorkspace(this->g1_glv, pts, b, 2, ws, r));
+  DeleteExpWorkspace(&ws);
+}
+
+TEST_F(EcGlvTest, EcGlvMultiExpWithWorkspaceMatchesEcGlvMultiExp) {
+  std::vector<BigNumStr> powers = Powers();
+  EcPointObj g1_a0(&this->params->G1, this->g1_elem_str);
+  EcPointObj g1_a1(&this->params->G1);
+  EcPointObj g2_a0(&this->params->G2, this->g2_elem_str);
+  EcPointObj g2_a1(&this->params->G2);
+  EcPointObj g1_r(&this->params->G1);
+  EcPointObj g2_r(&this->params->G2);
+  ExpWorkspace* ws = nullptr;
+  THROW_ON_EPIDERR(EcExp(this->params->G1, g1_a0, &powers.back(), g1_a1));
+  THROW_ON_EPIDERR(EcExp(this->params->G2, g2_a0, &powers.back(), g2_a1));
+  EcPoint const* g1_pts[] = {g1_a0, g1_a1};
+  EcPoint const* g2_pts[] = {g2_a0, g2_a1};
+  THROW_ON_EPIDERR(NewExpWorkspace(2, &ws));
+  // switch groups and sizes so that the workspace is grown and re-created
+  for (size_t i = 0; i + 1 < powers.size(); i++) {
+    BigNumStr const* b[] = {&powers[i], &powers[i + 1]};
+    size_t m = 1 + i % 2;
+    G1ElemStr g1_expected = {0};
+    G1ElemStr g1_str = {0};
+    G2ElemStr g2_expected = {0};
+    G2ElemStr g2_str = {0};
+    THROW_ON_EPIDERR(EcGlvMultiExp(this->g1_glv, g1_pts, b, m, g1_r));
+    THROW_ON_EPIDERR(WriteEcPoint(this->params->G1, g1_r, &g1_expected,
+                                  sizeof(g1_expected)));
+    THROW_ON_EPIDERR(EcGlvMultiExp(this->g2_glv, g2_pts, b, m, g2_r));
+    THROW_ON_EPIDERR(WriteEcPoint(this->params->G2, g2_r, &g2_expected,
+                                  sizeof(g2_expected)));
+
+    EXPECT_EQ(kEpidNoErr, EcGlvSscmMultiExpWithWorkspace(this->g1_glv, g1_pts,
+                                                         b, m, ws, g1_r));
+    THROW_ON_EPIDERR(
+        WriteEcPoint(this->params->G1, g1_r, &g1_str, sizeof(g1_str)));
+    EXPECT_EQ(0, std::memcmp(&g1_expected, &g1_str, sizeof(g1_str)))
+        << "sscm G1 " << i;
+    EXPECT_EQ(kEpidNoErr,
+              EcGlvMultiExpWithWorkspace(this->g2_glv, g2_pts, b, m, ws, g2_r));
+    THROW_ON_EPIDERR(
+        WriteEcPoint(this->params->G2, g2_r, &g2_str, sizeof(g2_str)));
+    EXPECT_EQ(0, std::memcmp(&g2_expected, &g2_str, sizeof(g2_str)))
+        << "G2 " << i;
+    EXPECT_EQ(kEpidNoErr,
+              EcGlvMultiExpWithWorkspace(this->g1_glv, g1_pts, b, m, ws, g1_r));
+    THROW_ON_EPIDERR(
+        WriteEcPoint(this->params->G1, g1_r, &g1_str, sizeof(g1_str)));
+    EXPECT_EQ(0, std::memcmp(&g1_expected, &g1_str, sizeof(g1_str)))
+        << "G1 " << i;
+    EXPECT_EQ(kEpidNoErr, EcGlvSscmMultiExpWithWorkspace(this->g2_glv, g2_pts,
+                                                         b, m, ws, g2_r));
+    THROW_ON_EPIDERR(
+        WriteEcPoint(this->params->G2, g2_r, &g2_str, sizeof(g2_str)));
+    EXPECT_EQ(0, std::memcmp(&g2_expected, &g2_str, sizeof(g2_str)))
+        << "sscm G2 " << i;
+  }
+  DeleteExpWorkspace(&ws);
+}
+
+}  // namespace
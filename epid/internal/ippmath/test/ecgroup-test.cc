@@ -2054,6 +2054,78 @@ TEST_F(EcGroupTest, HashWorksForArbitraryMsg) {
   EXPECT_EQ(exp_102, res_102);
 }
 ///////////////////////////////////////////////////////////////////////
+// EcSscmHash
+TEST_F(EcGroupTest, SscmHashFailsGivenArgumentsMismatch) {
+  uint8_t const msg[] = {0};
+  EXPECT_EQ(kEpidBadArgErr,
+            EcSscmHash(this->efq2, msg, sizeof(msg), kSha256, this->efq_r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcSscmHash(this->efq, msg, sizeof(msg), kSha256, this->efq2_r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcSscmHash(this->efq2, msg, sizeof(msg), kSha256, this->efq2_r));
+}
+TEST_F(EcGroupTest, SscmHashFailsGivenNullPointer) {
+  uint8_t const msg[] = {0};
+  EXPECT_EQ(kEpidBadArgErr,
+            EcSscmHash(nullptr, msg, sizeof(msg), kSha256, this->efq_r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcSscmHash(this->efq, nullptr, sizeof(msg), kSha256, this->efq_r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcSscmHash(this->efq, msg, sizeof(msg), kSha256, nullptr));
+}
+TEST_F(EcGroupTest, SscmHashFailsGivenUnsupportedHashAlg) {
+  uint8_t const msg[] = {0};
+  EXPECT_EQ(kEpidHashAlgorithmNotSupported,
+            EcSscmHash(this->efq, msg, sizeof(msg), kSha3_256, this->efq_r));
+}
+TEST_F(EcGroupTest, SscmHashFailsGivenIncorrectMsgLen) {
+  uint8_t const msg[] = {0};
+  EXPECT_EQ(kEpidBadArgErr,
+            EcSscmHash(this->efq, nullptr, 1, kSha256, this->efq_r));
+  EXPECT_EQ(kEpidBadArgErr, EcSscmHash(this->efq, msg, (size_t)INT_MAX + 1,
+                                       kSha256, this->efq_r));
+}
+TEST_F(EcGroupTest, SscmHashAcceptsZeroLengthMessage) {
+  EXPECT_EQ(kEpidNoErr, EcSscmHash(this->efq, "", 0, kSha256, this->efq_r));
+}
+TEST_F(EcGroupTest, SscmHashReturnsElementOfGroup) {
+  for (HashAlg hash_alg : {kSha256, kSha384, kSha512, kSha512_256}) {
+    for (uint8_t i = 0; i < 16; i++) {
+      G1ElemStr efq_r_str;
+      bool in_group = false;
+      std::vector<uint8_t> msg(sha_msg, sha_msg + sizeof(sha_msg));
+      msg.push_back(i);
+      EXPECT_EQ(kEpidNoErr, EcSscmHash(this->efq, msg.data(), msg.size(),
+                                       hash_alg, this->efq_r));
+      THROW_ON_EPIDERR(
+          WriteEcPoint(this->efq, this->efq_r, &efq_r_str, sizeof(efq_r_str)));
+      THROW_ON_EPIDERR(
+          EcInGroup(this->efq, &efq_r_str, sizeof(efq_r_str), &in_group));
+      EXPECT_TRUE(in_group) << "hash_alg " << hash_alg << " i " << (int)i;
+    }
+  }
+}
+TEST_F(EcGroupTest, SscmHashIsDeterministic) {
+  G1ElemStr r1_str;
+  G1ElemStr r2_str;
+  G1ElemStr r3_str;
+  uint8_t const msg2[] = {'a', 'a', 'd'};
+  EXPECT_EQ(kEpidNoErr, EcSscmHash(this->efq, sha_msg, sizeof(sha_msg),
+                                   kSha256, this->efq_r));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(this->efq, this->efq_r, &r1_str, sizeof(r1_str)));
+  EXPECT_EQ(kEpidNoErr, EcSscmHash(this->efq, sha_msg, sizeof(sha_msg),
+                                   kSha256, this->efq_r));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(this->efq, this->efq_r, &r2_str, sizeof(r2_str)));
+  EXPECT_EQ(r1_str, r2_str);
+  EXPECT_EQ(kEpidNoErr,
+            EcSscmHash(this->efq, msg2, sizeof(msg2), kSha256, this->efq_r));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(this->efq, this->efq_r, &r3_str, sizeof(r3_str)));
+  EXPECT_FALSE(r1_str == r3_str);
+}
+///////////////////////////////////////////////////////////////////////
 // 1.1 EcHash
 TEST_F(EcGroupTest, Epid11HashFailsGivenMismatchedArguments) {
   uint8_t const msg[] = {0};
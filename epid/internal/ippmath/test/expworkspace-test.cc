@@ -0,0 +1,272 @@
+/*############################################################################
+  # Copyright 2016-2019 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+
+/*! \file */
+
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "testhelper/ecgroup_wrapper-testhelper.h"
+#include "testhelper/ecpoint_wrapper-testhelper.h"
+#include "testhelper/epid_gtest-testhelper.h"
+#include "testhelper/epid_params-testhelper.h"
+#include "testhelper/errors-testhelper.h"
+#include "testhelper/ffelement_wrapper-testhelper.h"
+#include "testhelper/prng-testhelper.h"
+
+extern "C" {
+#include "ippmath/expworkspace.h"
+}
+
+namespace {
+
+class ExpWorkspaceTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    params = new Epid20Params();
+    THROW_ON_EPIDERR(NewExpWorkspace(kMaxM, &ws));
+    g2 = EcPointObj(&params->G2, g2_str);
+    for (size_t i = 0; i < kMaxM; i++) {
+      BigNumStr b = {0};
+      Fq12ElemStr gt = {0};
+      for (size_t j = 0; j < sizeof(b); j++) {
+        b.data.data[j] = (uint8_t)(0x5b * (i + 1) + 0x31 * j);
+      }
+      // keep below the order of the groups
+      b.data.data[0] &= 0x7f;
+      powers.push_back(b);
+      uint8_t* gt_bytes = reinterpret_cast<uint8_t*>(&gt);
+      for (size_t j = 0; j < sizeof(gt); j++) {
+        // keep every Fq coefficient below q
+        gt_bytes[j] =
+            (j % sizeof(FqElemStr)) ? (uint8_t)(0x3d * (i + 1) + j) : 0;
+      }
+      gt_elems.push_back(FfElementObj(&params->GT, gt));
+      g1_points.push_back(EcPointObj(&params->G1));
+      THROW_ON_EPIDERR(EcGetRandom(params->G1, &Prng::Generate, &prng,
+                                   g1_points.back()));
+      // G2 does not support EcGetRandom, use multiples of a fixed point
+      g2_points.push_back(EcPointObj(&params->G2));
+      THROW_ON_EPIDERR(
+          EcExp(params->G2, g2, &powers.back(), g2_points.back()));
+    }
+  }
+  virtual void TearDown() {
+    DeleteExpWorkspace(&ws);
+    g2_points.clear();
+    g1_points.clear();
+    gt_elems.clear();
+    g2 = EcPointObj();
+    delete params;
+  }
+
+  static const size_t kMaxM = 4;
+  static const G2ElemStr g2_str;
+
+  Prng prng;
+  Epid20Params* params = nullptr;
+  ExpWorkspace* ws = nullptr;
+  EcPointObj g2;
+  std::vector<BigNumStr> powers;
+  std::vector<FfElementObj> gt_elems;
+  std::vector<EcPointObj> g1_points;
+  std::vector<EcPointObj> g2_points;
+};
+
+const G2ElemStr ExpWorkspaceTest::g2_str = {
+    0x3f, 0x4c, 0xb5, 0x2d, 0xbc, 0x72, 0xb0, 0x9c, 0x6f, 0xb2, 0xb5, 0xc1,
+    0xdc, 0xfb, 0xda, 0x35, 0x91, 0xa6, 0x8d, 0x51, 0x37, 0x70, 0xe2, 0x17,
+    0xad, 0x53, 0x23, 0xdc, 0xa3, 0xc3, 0xfd, 0x4c, 0x90, 0xfa, 0x4f, 0xa2,
+    0xcb, 0x35, 0xf3, 0x50, 0x5e, 0x8e, 0xf4, 0xce, 0x7f, 0xb0, 0x8a, 0x69,
+    0x49, 0xdf, 0xf5, 0x4f, 0xb0, 0xc1, 0xd7, 0xf9, 0xb8, 0xfb, 0x89, 0xd1,
+    0xb6, 0xf8, 0x74, 0x04, 0xef, 0xc6, 0x60, 0x05, 0x62, 0xf3, 0x17, 0x5a,
+    0x80, 0xf4, 0x4b, 0x97, 0x08, 0x3e, 0x43, 0xa1, 0x44, 0x4c, 0x54, 0x86,
+    0x16, 0x20, 0xb9, 0xcc, 0xfb, 0xbd, 0x00, 0x5f, 0xc8, 0x01, 0xfb, 0x5b,
+    0xc1, 0x6e, 0x2b, 0x46, 0xe2, 0x04, 0x70, 0xeb, 0xa2, 0xaa, 0x86, 0x5a,
+    0x35, 0x14, 0x0e, 0xc9, 0xdf, 0xba, 0x9b, 0x6f, 0x3a, 0xca, 0x94, 0x9c,
+    0x44, 0x89, 0x94, 0xa3, 0xeb, 0x61, 0x8b, 0x01,
+};
+
+///////////////////////////////////////////////////////////////////////
+// NewExpWorkspace
+TEST_F(ExpWorkspaceTest, NewFailsGivenNullPointer) {
+  EXPECT_EQ(kEpidBadArgErr, NewExpWorkspace(kMaxM, nullptr));
+}
+
+TEST_F(ExpWorkspaceTest, NewFailsGivenZeroSize) {
+  ExpWorkspace* new_ws = nullptr;
+  EXPECT_EQ(kEpidBadArgErr, NewExpWorkspace(0, &new_ws));
+  EXPECT_EQ(nullptr, new_ws);
+}
+
+///////////////////////////////////////////////////////////////////////
+// DeleteExpWorkspace
+TEST_F(ExpWorkspaceTest, DeleteWorksGivenNullPointer) {
+  ExpWorkspace* null_ws = nullptr;
+  EXPECT_NO_THROW(DeleteExpWorkspace(nullptr));
+  EXPECT_NO_THROW(DeleteExpWorkspace(&null_ws));
+}
+
+TEST_F(ExpWorkspaceTest, DeleteNullsPointer) {
+  ExpWorkspace* new_ws = nullptr;
+  THROW_ON_EPIDERR(NewExpWorkspace(1, &new_ws));
+  EXPECT_NO_THROW(DeleteExpWorkspace(&new_ws));
+  EXPECT_EQ(nullptr, new_ws);
+}
+
+///////////////////////////////////////////////////////////////////////
+// FfMultiExpWithWorkspace
+TEST_F(ExpWorkspaceTest, FfMultiExpWithWorkspaceFailsGivenNullPointer) {
+  FfElement const* p[] = {gt_elems[0], gt_elems[1]};
+  BigNumStr const* b[] = {&powers[0], &powers[1]};
+  FfElementObj r(&params->GT);
+  EXPECT_EQ(kEpidBadArgErr,
+            FfMultiExpWithWorkspace(nullptr, p, b, 2, ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            FfMultiExpWithWorkspace(params->GT, nullptr, b, 2, ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            FfMultiExpWithWorkspace(params->GT, p, nullptr, 2, ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            FfMultiExpWithWorkspace(params->GT, p, b, 2, nullptr, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            FfMultiExpWithWorkspace(params->GT, p, b, 2, ws, nullptr));
+}
+
+TEST_F(ExpWorkspaceTest, FfMultiExpWithWorkspaceFailsGivenTooManyBases) {
+  std::vector<FfElement const*> p;
+  std::vector<BigNumStr const*> b;
+  FfElementObj r(&params->GT);
+  for (size_t i = 0; i < kMaxM + 1; i++) {
+    p.push_back(gt_elems[i % kMaxM]);
+    b.push_back(&powers[i % kMaxM]);
+  }
+  EXPECT_EQ(kEpidBadArgErr, FfMultiExpWithWorkspace(params->GT, p.data(),
+                                                    b.data(), p.size(), ws, r));
+}
+
+TEST_F(ExpWorkspaceTest, FfMultiExpWithWorkspaceMatchesFfMultiExp) {
+  std::vector<FfElement const*> p;
+  std::vector<BigNumStr const*> b;
+  for (size_t i = 0; i < kMaxM; i++) {
+    p.push_back(gt_elems[i]);
+    b.push_back(&powers[i]);
+  }
+  // reuse the same workspace for all sizes
+  for (size_t m = 1; m <= kMaxM; m++) {
+    FfElementObj expected(&params->GT);
+    FfElementObj r(&params->GT);
+    bool is_equal = false;
+    THROW_ON_EPIDERR(FfMultiExp(params->GT, p.data(), b.data(), m, expected));
+    EXPECT_EQ(kEpidNoErr, FfMultiExpWithWorkspace(params->GT, p.data(),
+                                                  b.data(), m, ws, r));
+    THROW_ON_EPIDERR(FfIsEqual(params->GT, expected, r, &is_equal));
+    EXPECT_TRUE(is_equal) << "m " << m;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////
+// EcExpWithWorkspace
+TEST_F(ExpWorkspaceTest, EcExpWithWorkspaceFailsGivenNullPointer) {
+  EcPointObj r(&params->G1);
+  EXPECT_EQ(kEpidBadArgErr,
+            EcExpWithWorkspace(nullptr, g1_points[0], &powers[0], ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcExpWithWorkspace(params->G1, nullptr, &powers[0], ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcExpWithWorkspace(params->G1, g1_points[0], nullptr, ws, r));
+  EXPECT_EQ(kEpidBadArgErr, EcExpWithWorkspace(params->G1, g1_points[0],
+                                               &powers[0], nullptr, r));
+  EXPECT_EQ(kEpidBadArgErr, EcExpWithWorkspace(params->G1, g1_points[0],
+                                               &powers[0], ws, nullptr));
+}
+
+TEST_F(ExpWorkspaceTest, EcExpWithWorkspaceFailsGivenArgumentsMismatch) {
+  EcPointObj r(&params->G1);
+  EXPECT_EQ(kEpidBadArgErr,
+            EcExpWithWorkspace(params->G1, g2_points[0], &powers[0], ws, r));
+}
+
+TEST_F(ExpWorkspaceTest, EcExpWithWorkspaceMatchesEcExpInG1AndG2) {
+  // alternate between the groups to exercise re-creating the temporary point
+  for (size_t i = 0; i < kMaxM; i++) {
+    EcPointObj expected1(&params->G1);
+    EcPointObj r1(&params->G1);
+    EcPointObj expected2(&params->G2);
+    EcPointObj r2(&params->G2);
+    bool is_equal = false;
+    THROW_ON_EPIDERR(EcExp(params->G1, g1_points[i], &powers[i], expected1));
+    EXPECT_EQ(kEpidNoErr,
+              EcExpWithWorkspace(params->G1, g1_points[i], &powers[i], ws, r1));
+    THROW_ON_EPIDERR(EcIsEqual(params->G1, expected1, r1, &is_equal));
+    EXPECT_TRUE(is_equal) << "i " << i;
+    THROW_ON_EPIDERR(EcExp(params->G2, g2_points[i], &powers[i], expected2));
+    EXPECT_EQ(kEpidNoErr,
+              EcExpWithWorkspace(params->G2, g2_points[i], &powers[i], ws, r2));
+    THROW_ON_EPIDERR(EcIsEqual(params->G2, expected2, r2, &is_equal));
+    EXPECT_TRUE(is_equal) << "i " << i;
+  }
+}
+
+TEST_F(ExpWorkspaceTest, EcExpWithWorkspaceWorksInPlace) {
+  EcPointObj expected(&params->G1);
+  EcPointObj r = g1_points[0];
+  bool is_equal = false;
+  THROW_ON_EPIDERR(EcExp(params->G1, g1_points[0], &powers[0], expected));
+  EXPECT_EQ(kEpidNoErr, EcExpWithWorkspace(params->G1, r, &powers[0], ws, r));
+  THROW_ON_EPIDERR(EcIsEqual(params->G1, expected, r, &is_equal));
+  EXPECT_TRUE(is_equal);
+}
+
+///////////////////////////////////////////////////////////////////////
+// EcMultiExpWithWorkspace
+TEST_F(ExpWorkspaceTest, EcMultiExpWithWorkspaceFailsGivenNullPointer) {
+  EcPoint const* a[] = {g1_points[0], g1_points[1]};
+  BigNumStr const* b[] = {&powers[0], &powers[1]};
+  EcPointObj r(&params->G1);
+  EXPECT_EQ(kEpidBadArgErr, EcMultiExpWithWorkspace(nullptr, a, b, 2, ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcMultiExpWithWorkspace(params->G1, nullptr, b, 2, ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcMultiExpWithWorkspace(params->G1, a, nullptr, 2, ws, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcMultiExpWithWorkspace(params->G1, a, b, 2, nullptr, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcMultiExpWithWorkspace(params->G1, a, b, 2, ws, nullptr));
+  EXPECT_EQ(kEpidBadArgErr,
+            EcMultiExpWithWorkspace(params->G1, a, b, 0, ws, r));
+}
+
+TEST_F(ExpWorkspaceTest, EcMultiExpWithWorkspaceMatchesEcMultiExp) {
+  std::vector<EcPoint const*> a;
+  std::vector<BigNumStr const*> b;
+  for (size_t i = 0; i < kMaxM; i++) {
+    a.push_back(g1_points[i]);
+    b.push_back(&powers[i]);
+  }
+  for (size_t m = 1; m <= kMaxM; m++) {
+    EcPointObj expected(&params->G1);
+    EcPointObj r(&params->G1);
+    bool is_equal = false;
+    THROW_ON_EPIDERR(EcMultiExp(params->G1, a.data(), b.data(), m, expected));
+    EXPECT_EQ(kEpidNoErr, EcMultiExpWithWorkspace(params->G1, a.data(),
+                                                  b.data(), m, ws, r));
+    THROW_ON_EPIDERR(EcIsEqual(params->G1, expected, r, &is_equal));
+    EXPECT_TRUE(is_equal) << "m " << m;
+  }
+}
+
+}  // namespace
@@ -257,4 +257,98 @@ TEST_F(PairingTest, PairingFailsGivenInvalidGbElem) {
   EXPECT_EQ(kEpidBadArgErr, Pairing(ps, ga_elem, mismatched_gb_elem, r));
   DeletePairingState(&ps);
 }
+///////////////////////////////////////////////////////////////////////
+// PairingPrecomputeG2 / PairingWithPrecomputedG2
+
+// test that pairing with precomputed lines matches the regular pairing
+TEST_F(PairingTest, PairingWithPrecomputedG2MatchesPairing) {
+  const bool neg = true;
+
+  GtElemStr r_expected_str = {0};
+  GtElemStr r_str = {0};
+
+  FfElementObj r(&this->params->GT);
+  EcPointObj ga_elem(&this->params->G1, this->ga_elem_str);
+  EcPointObj gb_elem(&this->params->G2, this->gb_elem_str);
+
+  PairingState* ps = nullptr;
+  PairingG2Precomp* precomp = nullptr;
+  THROW_ON_EPIDERR(NewPairingState(this->params->G1, this->params->G2,
+                                   this->params->GT, &this->t_str, neg, &ps));
+  THROW_ON_EPIDERR(Pairing(ps, ga_elem, gb_elem, r));
+  THROW_ON_EPIDERR(
+      WriteFfElement(this->params->GT, r, &r_expected_str, sizeof(r_str)));
+  EXPECT_EQ(kEpidNoErr, PairingPrecomputeG2(ps, gb_elem, &precomp));
+  EXPECT_EQ(kEpidNoErr, PairingWithPrecomputedG2(ps, ga_elem, precomp, r));
+  DeletePairingG2Precomp(&precomp);
+  DeletePairingState(&ps);
+
+  THROW_ON_EPIDERR(WriteFfElement(this->params->GT, r, &r_str, sizeof(r_str)));
+  EXPECT_EQ(r_expected_str, r_str);
+}
+
+TEST_F(PairingTest, DeletePairingG2PrecompWorksGivenNullPointer) {
+  EXPECT_NO_THROW(DeletePairingG2Precomp(nullptr));
+  PairingG2Precomp* precomp = nullptr;
+  EXPECT_NO_THROW(DeletePairingG2Precomp(&precomp));
+}
+
+TEST_F(PairingTest, PairingPrecomputeG2FailsGivenNullParameters) {
+  EcPointObj gb_elem(&this->params->G2, this->gb_elem_str);
+  PairingState* ps = nullptr;
+  PairingG2Precomp* precomp = nullptr;
+  THROW_ON_EPIDERR(NewPairingState(this->params->G1, this->params->G2,
+                                   this->params->GT, &this->t_str, true, &ps));
+  EXPECT_EQ(kEpidBadArgErr, PairingPrecomputeG2(nullptr, gb_elem, &precomp));
+  EXPECT_EQ(kEpidBadArgErr, PairingPrecomputeG2(ps, nullptr, &precomp));
+  EXPECT_EQ(kEpidBadArgErr, PairingPrecomputeG2(ps, gb_elem, nullptr));
+  DeletePairingState(&ps);
+}
+
+TEST_F(PairingTest, PairingPrecomputeG2FailsGivenInvalidGbElem) {
+  // put G1 element instead of G2
+  EcPointObj mismatched_gb_elem(&this->params->G1, this->ga_elem_str);
+  PairingState* ps = nullptr;
+  PairingG2Precomp* precomp = nullptr;
+  THROW_ON_EPIDERR(NewPairingState(this->params->G1, this->params->G2,
+                                   this->params->GT, &this->t_str, true, &ps));
+  EXPECT_EQ(kEpidBadArgErr,
+            PairingPrecomputeG2(ps, mismatched_gb_elem, &precomp));
+  DeletePairingState(&ps);
+}
+
+TEST_F(PairingTest, PairingWithPrecomputedG2FailsGivenNullParameters) {
+  FfElementObj r(&this->params->GT);
+  EcPointObj ga_elem(&this->params->G1, this->ga_elem_str);
+  EcPointObj gb_elem(&this->params->G2, this->gb_elem_str);
+  PairingState* ps = nullptr;
+  PairingG2Precomp* precomp = nullptr;
+  THROW_ON_EPIDERR(NewPairingState(this->params->G1, this->params->G2,
+                                   this->params->GT, &this->t_str, true, &ps));
+  THROW_ON_EPIDERR(PairingPrecomputeG2(ps, gb_elem, &precomp));
+  EXPECT_EQ(kEpidBadArgErr,
+            PairingWithPrecomputedG2(nullptr, ga_elem, precomp, r));
+  EXPECT_EQ(kEpidBadArgErr, PairingWithPrecomputedG2(ps, nullptr, precomp, r));
+  EXPECT_EQ(kEpidBadArgErr, PairingWithPrecomputedG2(ps, ga_elem, nullptr, r));
+  EXPECT_EQ(kEpidBadArgErr,
+            PairingWithPrecomputedG2(ps, ga_elem, precomp, nullptr));
+  DeletePairingG2Precomp(&precomp);
+  DeletePairingState(&ps);
+}
+
+TEST_F(PairingTest, PairingWithPrecomputedG2FailsGivenInvalidGaElem) {
+  FfElementObj r(&this->params->GT);
+  // put G2 element instead of G1
+  EcPointObj mismatched_ga_elem(&this->params->G2, this->gb_elem_str);
+  EcPointObj gb_elem(&this->params->G2, this->gb_elem_str);
+  PairingState* ps = nullptr;
+  PairingG2Precomp* precomp = nullptr;
+  THROW_ON_EPIDERR(NewPairingState(this->params->G1, this->params->G2,
+                                   this->params->GT, &this->t_str, true, &ps));
+  THROW_ON_EPIDERR(PairingPrecomputeG2(ps, gb_elem, &precomp));
+  EXPECT_EQ(kEpidBadArgErr,
+            PairingWithPrecomputedG2(ps, mismatched_ga_elem, precomp, r));
+  DeletePairingG2Precomp(&precomp);
+  DeletePairingState(&ps);
+}
 }  // namespace
@@ -35,6 +35,8 @@ void SetMemberParams(BitSupplier rnd_func, void* rnd_param, const FpElemStr* f,
   params->max_sigrl_entries = 5;
   params->max_allowed_basenames = 5;
   params->max_precomp_sig = 1;
+  params->comb_teeth = 0;
+  params->presig_multiexp_table = 0;
 #else
   params->rnd_func = rnd_func;
   params->rnd_param = rnd_param;
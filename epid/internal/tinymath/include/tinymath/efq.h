@@ -73,7 +73,9 @@ void EFqAdd(EccPointJacobiFq* result, EccPointJacobiFq const* left,
 /// Multiply two points in EFq.
 /*!
 This function is mitigated against software side-channel
-attacks.
+attacks. The power is recoded to signed odd digits of a 5-bit window,
+and the multiple of base for each digit is read by scanning a table of
+all of them.
 
 \param[out] result of multiplying left and right.
 \param[in] base The first operand to be multiplied.
@@ -82,6 +84,42 @@ attacks.
 void EFqMulSSCM(EccPointJacobiFq* result, EccPointJacobiFq const* base,
                 FpElem const* exp);
 
+/// Maximum number of teeth of a comb table of a point in EFq.
+#define EFQ_COMB_MAX_TEETH 8
+
+/// Number of points in a comb table with the given number of teeth.
+#define EFQ_COMB_TABLE_SIZE(teeth) ((size_t)1 << ((teeth)-1))
+
+/// Precompute the comb table of a fixed point in EFq.
+/*!
+The power is split into teeth interleaved parts that share their
+doublings. A table with more teeth is larger but needs fewer doublings and
+additions: about 256 / teeth of each.
+
+\param[out] table target. Must hold EFQ_COMB_TABLE_SIZE(teeth) points.
+\param[in] base the fixed point.
+\param[in] teeth the number of teeth, from 1 to EFQ_COMB_MAX_TEETH.
+\returns true on success.
+         false if teeth is out of range or base is of small order.
+*/
+bool EFqCombTableInit(EccPointFq* table, EccPointFq const* base,
+                      uint32_t teeth);
+
+/// Multiply a fixed point in EFq using its comb table.
+/*!
+Gives the same result as EFqMulSSCM(). This function is mitigated against
+software side-channel attacks. The power is recoded to signed digits that
+are never zero, and the table entry for each column is read by scanning
+the whole table.
+
+\param[out] result target.
+\param[in] table the comb table computed by EFqCombTableInit().
+\param[in] teeth the number of teeth the table was computed with.
+\param[in] exp the power.
+*/
+void EFqCombMulSSCM(EccPointJacobiFq* result, EccPointFq const* table,
+                    uint32_t teeth, FpElem const* exp);
+
 /// Exponentiate a point in EFq by an element of Fp.
 /*!
 \param[out] result target.
@@ -108,6 +146,9 @@ bool EFqAffineMultiExp(EccPointFq* result, EccPointFq const* base0,
 
 /// Sum the results of exponentiating two points in EFq by elements of Fp.
 /*!
+The doublings are shared between the two exponents, which are processed
+as in EFqMulSSCM().
+
 \param[out] result target.
 \param[in] base0 the first base.
 \param[in] exp0 the first exponent.
@@ -71,7 +71,7 @@ void EFq2Neg(EccPointJacobiFq2* result, EccPointJacobiFq2 const* in);
 /// Multiply two points in EFq.
 /*!
 This function is mitigated against software side-channel
-attacks.
+attacks. It uses the same window recoding as EFqMulSSCM().
 
 \param[out] result of multiplying left and right.
 \param[in] left The first operand to be multiplied.
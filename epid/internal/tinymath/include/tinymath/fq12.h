@@ -22,11 +22,15 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 #include "epid/stdtypes.h"
 
 /// \cond
 typedef struct Fq12Elem Fq12Elem;
+typedef struct Fq12CompressedElem Fq12CompressedElem;
+typedef struct Fq2Elem Fq2Elem;
+typedef struct Fq12MultiExpTable Fq12MultiExpTable;
 typedef struct VeryLargeInt VeryLargeInt;
 /// \endcond
 
@@ -85,6 +89,8 @@ void Fq12Exp(Fq12Elem* result, Fq12Elem const* base, VeryLargeInt const* exp);
 
 /// Multiply of exponentiation of elements of Fq12 by a large integers.
 /*!
+The four exponentiations share a single chain of squarings.
+
 \param[out] result target.
 \param[in] base0 the base.
 \param[in] exp0 the exponent.
@@ -101,6 +107,40 @@ void Fq12MultiExp(Fq12Elem* result, Fq12Elem const* base0,
                   VeryLargeInt const* exp2, Fq12Elem const* base3,
                   VeryLargeInt const* exp3);
 
+/// Precompute the products of four elements of Fq12.
+/*!
+Fills a table for Fq12MultiExpCyc().
+
+\param[out] table target.
+\param[in] base0 the base.
+\param[in] base1 the base.
+\param[in] base2 the base.
+\param[in] base3 the base.
+*/
+void Fq12MultiExpTableInit(Fq12MultiExpTable* table, Fq12Elem const* base0,
+                           Fq12Elem const* base1, Fq12Elem const* base2,
+                           Fq12Elem const* base3);
+
+/// Multiply of exponentiation of elements of GT by a large integers.
+/*!
+Gives the same result as Fq12MultiExp() for bases in the cyclotomic
+subgroup of Fq12, such as pairing results, using cyclotomic squarings and
+one multiplication by a table entry per bit of the exponents. The table
+entry is selected without branches or memory accesses that depend on the
+exponents.
+
+\param[out] result target.
+\param[in] table the products of the bases computed by
+           Fq12MultiExpTableInit().
+\param[in] exp0 the exponent of base0.
+\param[in] exp1 the exponent of base1.
+\param[in] exp2 the exponent of base2.
+\param[in] exp3 the exponent of base3.
+*/
+void Fq12MultiExpCyc(Fq12Elem* result, Fq12MultiExpTable const* table,
+                     VeryLargeInt const* exp0, VeryLargeInt const* exp1,
+                     VeryLargeInt const* exp2, VeryLargeInt const* exp3);
+
 /// Calculate the conjugate of an element of Fq12.
 /*!
 \param[out] result the conjugate of the element.
@@ -125,6 +165,55 @@ void Fq12ExpCyc(Fq12Elem* result, Fq12Elem const* in, VeryLargeInt const* t);
 */
 void Fq12SqCyc(Fq12Elem* result, Fq12Elem const* in);
 
+/// Calculate the compressed cyclotomic square of an element of fq12.
+/*!
+Uses Karabina's compressed squaring. Only the coefficients z0.y1, z0.y2,
+z1.y0 and z1.y2 of in are read and only those of result are set. The
+remaining coefficients are recovered with Fq12DecompressCyc.
+
+\param[out] result result of the compressed square.
+\param[in] in the base, an element of the cyclotomic subgroup.
+*/
+void Fq12SqCompressedCyc(Fq12Elem* result, Fq12Elem const* in);
+
+/// Decompress elements of the cyclotomic subgroup.
+/*!
+Recovers z0.y0 and z1.y1 of elements produced by Fq12SqCompressedCyc.
+All elements share a single inversion.
+
+\param[in,out] elems the elements to decompress in place.
+\param[in] count number of elements.
+*/
+void Fq12DecompressCyc(Fq12Elem* elems, size_t count);
+
+/// Compress an element of the cyclotomic subgroup.
+/*!
+Keeps the coefficients read by Fq12SqCompressedCyc.
+
+\param[out] result the compressed element.
+\param[in] in an element of the cyclotomic subgroup, or a result of
+           Fq12SqCompressedCyc.
+\param[in] conj if true, result is the compressed conjugate of in, which
+           is its inverse.
+*/
+void Fq12CompressCyc(Fq12CompressedElem* result, Fq12Elem const* in,
+                     bool conj);
+
+/// Multiply by compressed elements of the cyclotomic subgroup.
+/*!
+Decompresses one element at a time into a single temporary, all elements
+share a single inversion.
+
+\param[in,out] result the element to multiply. This will receive the
+               product.
+\param[in] elems the compressed elements.
+\param[out] scratch buffer of count elements of Fq2 receiving
+            intermediate values.
+\param[in] count number of elements.
+*/
+void Fq12MulDecompressCyc(Fq12Elem* result, Fq12CompressedElem const* elems,
+                          Fq2Elem* scratch, size_t count);
+
 /// Multiply two elements of Fq12.
 /*!
 Requires that b[2] = b[4] = b[5] = 0.
@@ -41,6 +41,22 @@ typedef struct VeryLargeIntProduct {
   uint32_t word[2 * NUM_ECC_DIGITS];  ///< Large integer data
 } VeryLargeIntProduct;
 
+/// Modulus with its Montgomery multiplication constants.
+/*!
+The modulus must be odd and greater than 2^255. R is 2^256.
+
+mod64 and r2_64 hold mod and r2 as 64-bit limbs, least significant
+first, so that the 64-bit implementation does not convert them on every
+call.
+*/
+typedef struct VliMontModulus {
+  VeryLargeInt mod;                    ///< The modulus m
+  VeryLargeInt r2;                     ///< R^2 mod m
+  uint64_t inv;                        ///< -m^-1 mod 2^64
+  uint64_t mod64[NUM_ECC_DIGITS / 2];  ///< mod as 64-bit limbs
+  uint64_t r2_64[NUM_ECC_DIGITS / 2];  ///< r2 as 64-bit limbs
+} VliMontModulus;
+
 /// Element of Fp.
 typedef struct FpElem {
   VeryLargeInt limbs;  ///< An integer in [0, p-1]
@@ -82,6 +98,29 @@ typedef struct Fq12Elem {
   Fq6Elem z1;  ///< A coefficient in Fq6
 } Fq12Elem;
 
+/// Element of the cyclotomic subgroup of Fq12 in compressed form.
+/*!
+ Holds the coefficients kept by Karabina's compressed squaring, two
+ thirds of the size of a Fq12Elem.
+ */
+typedef struct Fq12CompressedElem {
+  Fq2Elem g2;  ///< z1.y0 of the element
+  Fq2Elem g3;  ///< z0.y2 of the element
+  Fq2Elem g4;  ///< z0.y1 of the element
+  Fq2Elem g5;  ///< z1.y2 of the element
+} Fq12CompressedElem;
+
+/// Number of entries of a Fq12MultiExpTable.
+#define FQ12_MULTI_EXP_TABLE_SIZE 16
+
+/// Products of all subsets of four elements of Fq12.
+/*!
+ Entry i is the product of the bases whose index is a set bit of i.
+ */
+typedef struct Fq12MultiExpTable {
+  Fq12Elem entry[FQ12_MULTI_EXP_TABLE_SIZE];  ///< subset products
+} Fq12MultiExpTable;
+
 /// Element of EFq in Jacobi format.
 typedef struct EccPointJacobiFq {
   FqElem X;  ///< x coordinate
@@ -96,11 +135,6 @@ typedef struct EccPointJacobiFq2 {
   Fq2Elem Z;  ///< z coordinate
 } EccPointJacobiFq2;
 
-/// A scratch buffer for stateful pairing calls.
-typedef struct PairingState {
-  Fq2Elem g[3][5];  ///< pairing scratch data
-} PairingState;
-
 #ifdef __cplusplus
 }
 #endif
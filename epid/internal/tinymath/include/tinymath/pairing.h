@@ -26,24 +26,18 @@ extern "C" {
 typedef struct Fq12Elem Fq12Elem;
 typedef struct EccPointFq EccPointFq;
 typedef struct EccPointFq2 EccPointFq2;
-typedef struct PairingState PairingState;
 /// \endcond
 
-/// Initializes pairing environment.
-/*!
-\param[out] state pairing state information.
-*/
-void PairingInit(PairingState* state);
-
 /// Computes a pairing according to the Optimal Ate pairing computation
 /*!
+Uses about 11 KB of stack, most of it for the squares of the final
+exponentiation. The unit tests check that it stays below 16 KB.
+
 \param[out] d target, an element in GT.
 \param[in] P an element in G1.
 \param[in] Q an element in G2.
-\param[in,out] state pairing state information.
 */
-void PairingCompute(Fq12Elem* d, EccPointFq const* P, EccPointFq2 const* Q,
-                    PairingState const* state);
+void PairingCompute(Fq12Elem* d, EccPointFq const* P, EccPointFq2 const* Q);
 
 #ifdef __cplusplus
 }
@@ -26,9 +26,20 @@ extern "C" {
 #include "epid/bitsupplier.h"
 #include "epid/stdtypes.h"
 
+#if !defined(TINYMATH_NO_VLI64) && defined(__SIZEOF_INT128__)
+/// Use 64-bit limbs and Montgomery multiplication in the VliMont functions
+/*!
+Selected when the compiler has a 128-bit integer type. Define
+TINYMATH_NO_VLI64, or configure CMake with -DTINYMATH_NO_VLI64=ON, to keep
+the 32-bit limb implementation on such hosts.
+*/
+#define TINYMATH_VLI64
+#endif
+
 /// \cond
 typedef struct VeryLargeInt VeryLargeInt;
 typedef struct VeryLargeIntProduct VeryLargeIntProduct;
+typedef struct VliMontModulus VliMontModulus;
 /// \endcond
 
 /// Add two large integers.
@@ -137,6 +148,61 @@ void VliModInv(VeryLargeInt* result, VeryLargeInt const* input,
 void VliModSquare(VeryLargeInt* result, VeryLargeInt const* input,
                   VeryLargeInt const* mod);
 
+/// Multiply two large integers modulo a value with precomputed constants.
+/*!
+Gives the same result as VliModMul(). With TINYMATH_VLI64 the product is
+computed with 64-bit limbs by Montgomery multiplication, otherwise
+VliModMul() is used.
+
+\param[out] result target.
+\param[in] left The first operand to be multiplied.
+\param[in] right The second operand to be multiplied.
+\param[in] mod The modulo. One of left and right must be less than it.
+*/
+void VliMontModMul(VeryLargeInt* result, VeryLargeInt const* left,
+                   VeryLargeInt const* right, VliMontModulus const* mod);
+
+/// Square a large integer modulo a value with precomputed constants.
+/*!
+Gives the same result as VliModSquare().
+
+\param[out] result target.
+\param[in] input the base. Must be less than the modulo.
+\param[in] mod The modulo.
+
+\see VliMontModMul
+*/
+void VliMontModSquare(VeryLargeInt* result, VeryLargeInt const* input,
+                      VliMontModulus const* mod);
+
+/// Exponentiate a large integer modulo a value with precomputed constants.
+/*!
+Gives the same result as VliModExp(). With TINYMATH_VLI64 the base stays
+in Montgomery representation for the whole exponentiation.
+
+\param[out] result target.
+\param[in] base the base.
+\param[in] exp the exponent.
+\param[in] mod The modulo.
+
+\see VliMontModMul
+*/
+void VliMontModExp(VeryLargeInt* result, VeryLargeInt const* base,
+                   VeryLargeInt const* exp, VliMontModulus const* mod);
+
+/// Invert a large integer modulo a value with precomputed constants.
+/*!
+Gives the same result as VliModInv().
+
+\param[out] result target.
+\param[in] input the value to invert.
+\param[in] mod The modulo.
+
+\see VliMontModExp
+*/
+void VliMontModInv(VeryLargeInt* result, VeryLargeInt const* input,
+                   VliMontModulus const* mod);
+
 /// Reduce a value to a modulo and clear a stack that contains secret value.
 /*!
 This function is used just in cases when value, that contains secrets
@@ -185,6 +251,17 @@ bool VliIsZero(VeryLargeInt const* in);
 */
 uint32_t VliTestBit(VeryLargeInt const* in, uint32_t bit);
 
+/// Get a window of bits of a large integer.
+/*!
+\param[in] in the value.
+\param[in] bit the index of the lowest bit of the window.
+\param[in] width the number of bits in the window, at most 31.
+
+\returns the bits in [bit, bit + width) of in, lowest bit first. Bits past
+the end of in are zero.
+*/
+uint32_t VliWindow(VeryLargeInt const* in, uint32_t bit, uint32_t width);
+
 /// compare two large integers.
 /*!
 \param[in] left the left hand value.
@@ -24,6 +24,10 @@
 #include "tinymath/vli.h"
 #include "tinystdlib/tiny_stdlib.h"
 
+static VeryLargeInt const epid20_p = {{0xD10B500D, 0xF62D536C, 0x1299921A,
+                                       0x0CDC65FB, 0xEE71A49E, 0x46E5F25E,
+                                       0xFFFCF0CD, 0xFFFFFFFF}};
+
 void EFqFromAffine(EccPointJacobiFq* result, EccPointFq const* in) {
   FqCp(&result->X, &in->x);
   FqCp(&result->Y, &in->y);
@@ -132,21 +136,197 @@ static int EFqMakePoint(EccPointFq* output, FqElem* in) {
   return 1;
 }
 
+/// Window width of the signed odd digits of a recoded power
+#define EFQ_WINDOW 5
+/// Number of odd multiples base, 3*base, ..., 15*base in a window table
+#define EFQ_TABLE_SIZE (1 << (EFQ_WINDOW - 2))
+/// Number of digits of a recoded power
+#define EFQ_NUM_DIGITS (32 * NUM_ECC_DIGITS / (EFQ_WINDOW - 1))
+
+/* Sets table to base, 3*base, ..., (2*EFQ_TABLE_SIZE-1)*base */
+static void efqOddMultiples(EccPointJacobiFq* table,
+                            EccPointJacobiFq const* base) {
+  EccPointJacobiFq dbl;
+  uint32_t i;
+  EFqDbl(&dbl, base);
+  EFqJCp(&table[0], base);
+  for (i = 1; i < EFQ_TABLE_SIZE; i++) {
+    EFqAdd(&table[i], &table[i - 1], &dbl);
+  }
+}
+
+/* Sets k to exp or exp + 1, whichever is odd. Returns 1 if exp is even.
+ * An odd k is recoded to the digits 2 * VliWindow(k, 4 * i + 1, 4) - 15
+ * for i < EFQ_NUM_DIGITS - 1 and a top digit (k >> 252) | 1, which are
+ * all odd and never zero. */
+static uint32_t efqRecodePower(VeryLargeInt* k, FpElem const* exp) {
+  VeryLargeInt is_even;
+  VliClear(&is_even);
+  is_even.word[0] = (exp->limbs.word[0] & 1) ^ 1;
+  VliAdd(k, &exp->limbs, &is_even);
+  return is_even.word[0];
+}
+
+/* Returns the window of digit i of a power recoded by efqRecodePower */
+static uint32_t efqDigitWindow(VeryLargeInt const* k, int i) {
+  if (EFQ_NUM_DIGITS - 1 == i) {
+    // top digit t is positive, 2 * ((t + 15) / 2) - 15 = t
+    return ((VliWindow(k, (EFQ_WINDOW - 1) * i, EFQ_WINDOW - 1) | 1) + 15) >>
+           1;
+  }
+  return VliWindow(k, (EFQ_WINDOW - 1) * i + 1, EFQ_WINDOW - 1);
+}
+
+/* Sets result to (2 * window - 15) * base, scanning the whole table */
+static void efqTableSelect(EccPointJacobiFq* result,
+                           EccPointJacobiFq const* table, uint32_t window) {
+  uint32_t neg = ((window >> (EFQ_WINDOW - 2)) & 1) ^ 1;
+  uint32_t idx = (window & (EFQ_TABLE_SIZE - 1)) ^ ((EFQ_TABLE_SIZE - 1) * neg);
+  FqElem neg_y;
+  uint32_t i;
+  EFqJCp(result, &table[0]);
+  for (i = 1; i < EFQ_TABLE_SIZE; i++) {
+    EFqCondSet(result, &table[i], result, (int)(i == idx));
+  }
+  FqNeg(&neg_y, &result->Y);
+  FqCondSet(&result->Y, &neg_y, &result->Y, (int)neg);
+}
+
 void EFqMulSSCM(EccPointJacobiFq* result, EccPointJacobiFq const* base,
                 FpElem const* exp) {
+  EccPointJacobiFq table[EFQ_TABLE_SIZE];
   EccPointJacobiFq efqj_1;
   EccPointJacobiFq efqj_2;
+  VeryLargeInt k;
+  uint32_t is_even;
+  int i, j;
+
+  efqOddMultiples(table, base);
+  is_even = efqRecodePower(&k, exp);
+  efqTableSelect(&efqj_1, table, efqDigitWindow(&k, EFQ_NUM_DIGITS - 1));
+  for (i = EFQ_NUM_DIGITS - 2; i >= 0; i--) {
+    for (j = 0; j < EFQ_WINDOW - 1; j++) {
+      EFqDbl(&efqj_1, &efqj_1);
+    }
+    efqTableSelect(&efqj_2, table, efqDigitWindow(&k, i));
+    EFqAdd(&efqj_1, &efqj_1, &efqj_2);
+  }
+  // subtract base if exp was incremented
+  EFqNeg(&efqj_2, base);
+  EFqAdd(&efqj_2, &efqj_1, &efqj_2);
+  EFqCondSet(&efqj_1, &efqj_2, &efqj_1, (int)is_even);
+  EFqJCp(result, &efqj_1);
+}
+
+/* Number of columns of a comb with the given number of teeth */
+static uint32_t efqCombColumns(uint32_t teeth) {
+  return (32 * NUM_ECC_DIGITS + teeth - 1) / teeth;
+}
+
+bool EFqCombTableInit(EccPointFq* table, EccPointFq const* base,
+                      uint32_t teeth) {
+  EccPointJacobiFq tooth[EFQ_COMB_MAX_TEETH];
+  EccPointJacobiFq acc;
+  EccPointJacobiFq neg;
+  uint32_t columns;
+  uint32_t i, j;
+  if (teeth < 1 || teeth > EFQ_COMB_MAX_TEETH) {
+    return false;
+  }
+  columns = efqCombColumns(teeth);
+  // tooth[i] = 2^(i * columns) * base
+  EFqFromAffine(&tooth[0], base);
+  for (i = 1; i < teeth; i++) {
+    EFqJCp(&tooth[i], &tooth[i - 1]);
+    for (j = 0; j < columns; j++) {
+      EFqDbl(&tooth[i], &tooth[i]);
+    }
+  }
+  // entry 0 has every sign but the top one negative
+  EFqJCp(&acc, &tooth[teeth - 1]);
+  for (i = 0; i + 1 < teeth; i++) {
+    EFqNeg(&neg, &tooth[i]);
+    EFqAdd(&acc, &acc, &neg);
+  }
+  if (!EFqToAffine(&table[0], &acc)) {
+    return false;
+  }
+  // setting bit i of an index flips the sign of tooth i
+  for (i = 0; i + 1 < teeth; i++) {
+    EFqDbl(&tooth[i], &tooth[i]);
+    for (j = 0; j < (1u << i); j++) {
+      EFqFromAffine(&acc, &table[j]);
+      EFqAdd(&acc, &acc, &tooth[i]);
+      if (!EFqToAffine(&table[(1u << i) + j], &acc)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
 
-  uint32_t position;
-  EFqInf(&efqj_1);
-  EFqJCp(&efqj_2, base);
-  for (position = 32 * NUM_ECC_DIGITS; position > 0; --position) {
+/* Sets result to the column of a comb table for the bits
+ * (k >> 1) + 2^(teeth * columns - 1) at column, scanning the whole table.
+ * Bit b of the column stands for the sign 2 * b - 1 of tooth b. */
+static void efqCombSelect(EccPointJacobiFq* result, EccPointFq const* table,
+                          uint32_t teeth, VeryLargeInt const* half_k,
+                          uint32_t column) {
+  uint32_t const size = (uint32_t)EFQ_COMB_TABLE_SIZE(teeth);
+  uint32_t const top = teeth * efqCombColumns(teeth) - 1;
+  uint32_t window = 0;
+  uint32_t neg;
+  uint32_t idx;
+  uint32_t i;
+  EccPointFq point;
+  FqElem neg_y;
+  for (i = 0; i < teeth; i++) {
+    uint32_t bit = i * efqCombColumns(teeth) + column;
+    if (bit < 32 * NUM_ECC_DIGITS - 1) {
+      window |= VliTestBit(half_k, bit) << i;
+    } else {
+      window |= (uint32_t)(bit == top) << i;
+    }
+  }
+  neg = ((window >> (teeth - 1)) & 1) ^ 1;
+  idx = (window & (size - 1)) ^ ((size - 1) * neg);
+  EFqCp(&point, &table[0]);
+  for (i = 1; i < size; i++) {
+    FqCondSet(&point.x, &table[i].x, &point.x, (int)(i == idx));
+    FqCondSet(&point.y, &table[i].y, &point.y, (int)(i == idx));
+  }
+  FqNeg(&neg_y, &point.y);
+  FqCondSet(&point.y, &neg_y, &point.y, (int)neg);
+  EFqFromAffine(result, &point);
+}
+
+void EFqCombMulSSCM(EccPointJacobiFq* result, EccPointFq const* table,
+                    uint32_t teeth, FpElem const* exp) {
+  EccPointJacobiFq efqj_1;
+  EccPointJacobiFq efqj_2;
+  VeryLargeInt k;
+  VeryLargeInt neg_k;
+  FqElem neg_y;
+  uint32_t is_even = (exp->limbs.word[0] & 1) ^ 1;
+  int i;
+
+  // k is exp if exp is odd and p - exp otherwise, so it is always odd
+  // and has the signed digits 2 * bit - 1 of (k >> 1) + 2^(bits - 1)
+  VliSub(&neg_k, &epid20_p, &exp->limbs);
+  VliCondSet(&k, &neg_k, &exp->limbs, (int)is_even);
+  VliRShift(&k, &k, 1);
+  i = (int)efqCombColumns(teeth) - 1;
+  efqCombSelect(&efqj_1, table, teeth, &k, (uint32_t)i);
+  for (i--; i >= 0; i--) {
     EFqDbl(&efqj_1, &efqj_1);
-    EFqAdd(&efqj_2, base, &efqj_1);
-    EFqCondSet(&efqj_1, &efqj_2, &efqj_1,
-               VliTestBit(&(exp->limbs), position - 1));
+    efqCombSelect(&efqj_2, table, teeth, &k, (uint32_t)i);
+    EFqAdd(&efqj_1, &efqj_1, &efqj_2);
   }
+  // (p - exp) * base = -exp * base
+  FqNeg(&neg_y, &efqj_1.Y);
+  FqCondSet(&efqj_1.Y, &neg_y, &efqj_1.Y, (int)is_even);
   EFqJCp(result, &efqj_1);
+  VliClear(&k);
+  VliClear(&neg_k);
 }
 
 bool EFqAffineExp(EccPointFq* result, EccPointFq const* base,
@@ -171,40 +351,46 @@ bool EFqAffineMultiExp(EccPointFq* result, EccPointFq const* base0,
 void EFqMultiExp(EccPointJacobiFq* result, EccPointJacobiFq const* base0,
                  FpElem const* exp0, EccPointJacobiFq const* base1,
                  FpElem const* exp1) {
-  EccPointJacobiFq efqj_base0;
+  EccPointJacobiFq table0[EFQ_TABLE_SIZE];
+  EccPointJacobiFq table1[EFQ_TABLE_SIZE];
   EccPointJacobiFq efqj_a;
   EccPointJacobiFq efqj_b;
+  VeryLargeInt k0;
+  VeryLargeInt k1;
+  uint32_t is_even0;
+  uint32_t is_even1;
   int i, j;
 
-  EFqAdd(&efqj_base0, base0, base1);
-  EFqInf(&efqj_a);
-  for (i = NUM_ECC_DIGITS - 1; i >= 0; i--) {
-    for (j = 31; j >= 0; j--) {
-      EFqAdd(&efqj_a, &efqj_a, &efqj_a);
-      EFqInf(&efqj_b);
-      EFqJCp(&efqj_b, base0);
-
-      EFqCondSet(&efqj_b, base1, &efqj_b,
-                 (int)((exp1->limbs.word[i] >> j) & (0x1)));
-
-      EFqCondSet(&efqj_b, &efqj_base0, &efqj_b,
-                 (int)((exp0->limbs.word[i] >> j) & (exp1->limbs.word[i] >> j) &
-                       (0x1)));
-
-      EFqAdd(&efqj_b, &efqj_a, &efqj_b);
-
-      EFqCondSet(&efqj_a, &efqj_b, &efqj_a, (int)(((exp0->limbs.word[i] >> j) |
-                                                   (exp1->limbs.word[i] >> j)) &
-                                                  (0x1)));
+  efqOddMultiples(table0, base0);
+  efqOddMultiples(table1, base1);
+  is_even0 = efqRecodePower(&k0, exp0);
+  is_even1 = efqRecodePower(&k1, exp1);
+  efqTableSelect(&efqj_a, table0, efqDigitWindow(&k0, EFQ_NUM_DIGITS - 1));
+  efqTableSelect(&efqj_b, table1, efqDigitWindow(&k1, EFQ_NUM_DIGITS - 1));
+  EFqAdd(&efqj_a, &efqj_a, &efqj_b);
+  for (i = EFQ_NUM_DIGITS - 2; i >= 0; i--) {
+    for (j = 0; j < EFQ_WINDOW - 1; j++) {
+      EFqDbl(&efqj_a, &efqj_a);
     }
+    efqTableSelect(&efqj_b, table0, efqDigitWindow(&k0, i));
+    EFqAdd(&efqj_a, &efqj_a, &efqj_b);
+    efqTableSelect(&efqj_b, table1, efqDigitWindow(&k1, i));
+    EFqAdd(&efqj_a, &efqj_a, &efqj_b);
   }
+  // subtract the bases whose exponents were incremented
+  EFqNeg(&efqj_b, base0);
+  EFqAdd(&efqj_b, &efqj_a, &efqj_b);
+  EFqCondSet(&efqj_a, &efqj_b, &efqj_a, (int)is_even0);
+  EFqNeg(&efqj_b, base1);
+  EFqAdd(&efqj_b, &efqj_a, &efqj_b);
+  EFqCondSet(&efqj_a, &efqj_b, &efqj_a, (int)is_even1);
   EFqJCp(result, &efqj_a);
 }
 
 bool EFqAffineDbl(EccPointFq* result, EccPointFq const* in) {
   EccPointJacobiFq efqj_a;
   EFqFromAffine(&efqj_a, in);
-  EFqAdd(&efqj_a, &efqj_a, &efqj_a);
+  EFqDbl(&efqj_a, &efqj_a);
 
   return EFqToAffine(result, &efqj_a);
 }
@@ -171,19 +171,66 @@ void EFq2Neg(EccPointJacobiFq2* result, EccPointJacobiFq2 const* in) {
   Fq2Cp(&result->Z, &in->Z);
 }
 
+/// Window width of the signed odd digits of a recoded power
+#define EFQ2_WINDOW 5
+/// Number of odd multiples base, 3*base, ..., 15*base in a window table
+#define EFQ2_TABLE_SIZE (1 << (EFQ2_WINDOW - 2))
+/// Number of digits of a recoded power
+#define EFQ2_NUM_DIGITS (32 * NUM_ECC_DIGITS / (EFQ2_WINDOW - 1))
+
+/* Sets result to (2 * window - 15) * base, scanning the whole table */
+static void efq2TableSelect(EccPointJacobiFq2* result,
+                            EccPointJacobiFq2 const* table, uint32_t window) {
+  uint32_t neg = ((window >> (EFQ2_WINDOW - 2)) & 1) ^ 1;
+  uint32_t idx =
+      (window & (EFQ2_TABLE_SIZE - 1)) ^ ((EFQ2_TABLE_SIZE - 1) * neg);
+  Fq2Elem neg_y;
+  uint32_t i;
+  EFq2Cp(result, &table[0]);
+  for (i = 1; i < EFQ2_TABLE_SIZE; i++) {
+    EFq2CondSet(result, &table[i], result, (int)(i == idx));
+  }
+  Fq2Neg(&neg_y, &result->Y);
+  Fq2CondSet(&result->Y, &neg_y, &result->Y, (int)neg);
+}
+
 void EFq2MulSSCM(EccPointJacobiFq2* result, EccPointJacobiFq2 const* left,
                  FpElem const* right) {
-  int position;
+  EccPointJacobiFq2 table[EFQ2_TABLE_SIZE];
   EccPointJacobiFq2 nv;
   EccPointJacobiFq2 mv;
-  EFq2Inf(&nv);
-  EFq2Cp(&mv, left);
-  for (position = 32 * NUM_ECC_DIGITS - 1; position >= 0; position--) {
-    EFq2Dbl(&nv, &nv);
-    EFq2Add(&mv, left, &nv);
-    EFq2CondSet(&nv, &mv, &nv,
-                (int)(VliTestBit(&right->limbs, (uint32_t)position)));
+  VeryLargeInt k;
+  VeryLargeInt is_even;
+  uint32_t window;
+  int i, j;
+
+  // table of left, 3*left, ..., 15*left
+  EFq2Dbl(&mv, left);
+  EFq2Cp(&table[0], left);
+  for (i = 1; i < EFQ2_TABLE_SIZE; i++) {
+    EFq2Add(&table[i], &table[i - 1], &mv);
+  }
+  // recode the odd one of right and right + 1 to odd signed digits, see
+  // EFqMulSSCM
+  VliClear(&is_even);
+  is_even.word[0] = (right->limbs.word[0] & 1) ^ 1;
+  VliAdd(&k, &right->limbs, &is_even);
+
+  window = VliWindow(&k, (EFQ2_WINDOW - 1) * (EFQ2_NUM_DIGITS - 1),
+                     EFQ2_WINDOW - 1);
+  efq2TableSelect(&nv, table, ((window | 1) + 15) >> 1);
+  for (i = EFQ2_NUM_DIGITS - 2; i >= 0; i--) {
+    for (j = 0; j < EFQ2_WINDOW - 1; j++) {
+      EFq2Dbl(&nv, &nv);
+    }
+    window = VliWindow(&k, (EFQ2_WINDOW - 1) * i + 1, EFQ2_WINDOW - 1);
+    efq2TableSelect(&mv, table, window);
+    EFq2Add(&nv, &nv, &mv);
   }
+  // subtract left if right was incremented
+  EFq2Neg(&mv, left);
+  EFq2Add(&mv, &nv, &mv);
+  EFq2CondSet(&nv, &mv, &nv, (int)is_even.word[0]);
   EFq2Cp(result, &nv);
 }
 
@@ -31,6 +31,17 @@
 static VeryLargeInt const epid20_p = {{0xD10B500D, 0xF62D536C, 0x1299921A,
                                        0x0CDC65FB, 0xEE71A49E, 0x46E5F25E,
                                        0xFFFCF0CD, 0xFFFFFFFF}};
+// epid20_p with its precomputed Montgomery constants
+static VliMontModulus const epid20_p_mont = {
+    {{0xD10B500D, 0xF62D536C, 0x1299921A, 0x0CDC65FB, 0xEE71A49E, 0x46E5F25E,
+      0xFFFCF0CD, 0xFFFFFFFF}},
+    {{0x8F4C4808, 0xAF948AA3, 0x26123232, 0xBD789EFD, 0xEB526BE7, 0x117FD17C,
+      0xFB8F407A, 0x2BFC4998}},
+    0x09826627C9C6813B,
+    {0xF62D536CD10B500D, 0x0CDC65FB1299921A,
+     0x46E5F25EEE71A49E, 0xFFFFFFFFFFFCF0CD},
+    {0xAF948AA38F4C4808, 0xBD789EFD26123232,
+     0x117FD17CEB526BE7, 0x2BFC4998FB8F407A}};
 static FpElem const one = {{{1, 0, 0, 0, 0, 0, 0, 0}}};
 static VeryLargeInt const p_minus_one = {{0xD10B500C, 0xF62D536C, 0x1299921A,
                                           0x0CDC65FB, 0xEE71A49E, 0x46E5F25E,
@@ -55,11 +66,11 @@ void FpSub(FpElem* result, FpElem const* left, FpElem const* right) {
 }
 
 void FpMul(FpElem* result, FpElem const* left, FpElem const* right) {
-  VliModMul(&result->limbs, &left->limbs, &right->limbs, &epid20_p);
+  VliMontModMul(&result->limbs, &left->limbs, &right->limbs, &epid20_p_mont);
 }
 
 void FpExp(FpElem* result, FpElem const* base, VeryLargeInt const* exp) {
-  VliModExp(&result->limbs, &base->limbs, exp, &epid20_p);
+  VliMontModExp(&result->limbs, &base->limbs, exp, &epid20_p_mont);
 }
 
 void FpNeg(FpElem* result, FpElem const* in) {
@@ -68,7 +79,7 @@ void FpNeg(FpElem* result, FpElem const* in) {
 }
 
 void FpInv(FpElem* result, FpElem const* in) {
-  VliModInv(&result->limbs, &in->limbs, &epid20_p);
+  VliMontModInv(&result->limbs, &in->limbs, &epid20_p_mont);
 }
 
 bool FpRand(FpElem* result, BitSupplier rnd_func, void* rnd_param) {
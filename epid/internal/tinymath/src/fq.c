@@ -31,6 +31,17 @@
 static VeryLargeInt const epid20_q = {{0xAED33013, 0xD3292DDB, 0x12980A82,
                                        0x0CDC65FB, 0xEE71A49F, 0x46E5F25E,
                                        0xFFFCF0CD, 0xFFFFFFFF}};
+// epid20_q with its precomputed Montgomery constants
+static VliMontModulus const epid20_q_mont = {
+    {{0xAED33013, 0xD3292DDB, 0x12980A82, 0x0CDC65FB, 0xEE71A49F, 0x46E5F25E,
+      0xFFFCF0CD, 0xFFFFFFFF}},
+    {{0x1092B98F, 0xFAC8C610, 0xD7F91154, 0xDB90D49C, 0x32BF3141, 0x4F325FC7,
+      0x0E56A005, 0x4DE578EA}},
+    0xAD6C964E0537E5E5,
+    {0xD3292DDBAED33013, 0x0CDC65FB12980A82,
+     0x46E5F25EEE71A49F, 0xFFFFFFFFFFFCF0CD},
+    {0xFAC8C6101092B98F, 0xDB90D49CD7F91154,
+     0x4F325FC732BF3141, 0x4DE578EA0E56A005}};
 // precomputed (epid20_q+1)/4)
 static VeryLargeInt const precomp_exp = {{0xEBB4CC05, 0xB4CA4B76, 0xC4A602A0,
                                           0xC337197E, 0xBB9C6927, 0x51B97C97,
@@ -55,15 +66,15 @@ void FqSub(FqElem* result, FqElem const* left, FqElem const* right) {
 }
 
 void FqMul(FqElem* result, FqElem const* left, FqElem const* right) {
-  VliModMul(&result->limbs, &left->limbs, &right->limbs, &epid20_q);
+  VliMontModMul(&result->limbs, &left->limbs, &right->limbs, &epid20_q_mont);
 }
 
 void FqExp(FqElem* result, FqElem const* base, VeryLargeInt const* exp) {
-  VliModExp(&result->limbs, &base->limbs, exp, &epid20_q);
+  VliMontModExp(&result->limbs, &base->limbs, exp, &epid20_q_mont);
 }
 
 void FqInv(FqElem* result, FqElem const* in) {
-  VliModInv(&result->limbs, &in->limbs, &epid20_q);
+  VliMontModInv(&result->limbs, &in->limbs, &epid20_q_mont);
 }
 
 void FqNeg(FqElem* result, FqElem const* in) {
@@ -72,7 +83,7 @@ void FqNeg(FqElem* result, FqElem const* in) {
 }
 
 void FqSquare(FqElem* result, FqElem const* in) {
-  VliModSquare(&result->limbs, &in->limbs, &epid20_q);
+  VliMontModSquare(&result->limbs, &in->limbs, &epid20_q_mont);
 }
 
 bool FqSqrt(FqElem* result, FqElem const* in) {
@@ -81,7 +92,7 @@ bool FqSqrt(FqElem* result, FqElem const* in) {
   // Square root can be computed as in^((q+1)/4) mod q.
   FqExp(result, in, &precomp_exp);  // result = in^((q+1)/4) mod q
   // validate sqrt exists
-  VliModSquare(&tmp, &result->limbs, &epid20_q);
+  VliMontModSquare(&tmp, &result->limbs, &epid20_q_mont);
   return 0 == VliCmp(&tmp, &in->limbs);
 }
 
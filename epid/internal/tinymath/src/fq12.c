@@ -124,14 +124,62 @@ void Fq12MultiExp(Fq12Elem* result, Fq12Elem const* base0,
                   VeryLargeInt const* exp1, Fq12Elem const* base2,
                   VeryLargeInt const* exp2, Fq12Elem const* base3,
                   VeryLargeInt const* exp3) {
-  Fq12Elem tmp;
-  Fq12Exp(result, base0, exp0);
-  Fq12Exp(&tmp, base1, exp1);
-  Fq12Mul(result, result, &tmp);
-  Fq12Exp(&tmp, base2, exp2);
-  Fq12Mul(result, result, &tmp);
-  Fq12Exp(&tmp, base3, exp3);
-  Fq12Mul(result, result, &tmp);
+  int i;
+  Fq12Elem tmp, tmp2, *const temp = &tmp, *const temp2 = &tmp2;
+  Fq12Set(temp, 1);
+  for (i = NUM_ECC_DIGITS * 32 - 1; i >= 0; i--) {
+    Fq12Square(temp, temp);
+    Fq12Mul(temp2, temp, base0);
+    Fq12CondSet(temp, temp2, temp, VliTestBit(exp0, i));
+    Fq12Mul(temp2, temp, base1);
+    Fq12CondSet(temp, temp2, temp, VliTestBit(exp1, i));
+    Fq12Mul(temp2, temp, base2);
+    Fq12CondSet(temp, temp2, temp, VliTestBit(exp2, i));
+    Fq12Mul(temp2, temp, base3);
+    Fq12CondSet(temp, temp2, temp, VliTestBit(exp3, i));
+  }
+  Fq12Cp(result, temp);
+}
+
+void Fq12MultiExpTableInit(Fq12MultiExpTable* table, Fq12Elem const* base0,
+                           Fq12Elem const* base1, Fq12Elem const* base2,
+                           Fq12Elem const* base3) {
+  Fq12Elem const* bases[4];
+  uint32_t i;
+  uint32_t j;
+  bases[0] = base0;
+  bases[1] = base1;
+  bases[2] = base2;
+  bases[3] = base3;
+  Fq12Set(&table->entry[0], 1);
+  for (j = 0; j < 4; j++) {
+    // entries with highest set bit j extend the entries before them
+    for (i = 0; i < (1u << j); i++) {
+      Fq12Mul(&table->entry[(1u << j) + i], &table->entry[i], bases[j]);
+    }
+  }
+}
+
+void Fq12MultiExpCyc(Fq12Elem* result, Fq12MultiExpTable const* table,
+                     VeryLargeInt const* exp0, VeryLargeInt const* exp1,
+                     VeryLargeInt const* exp2, VeryLargeInt const* exp3) {
+  int i;
+  uint32_t j;
+  uint32_t idx;
+  Fq12Elem tmp, tmp2, *const temp = &tmp, *const temp2 = &tmp2;
+  Fq12Set(temp, 1);
+  for (i = NUM_ECC_DIGITS * 32 - 1; i >= 0; i--) {
+    Fq12SqCyc(temp, temp);
+    idx = VliTestBit(exp0, i) | (VliTestBit(exp1, i) << 1) |
+          (VliTestBit(exp2, i) << 2) | (VliTestBit(exp3, i) << 3);
+    Fq12Cp(temp2, &table->entry[0]);
+    for (j = 1; j < FQ12_MULTI_EXP_TABLE_SIZE; j++) {
+      Fq12CondSet(temp2, &table->entry[j], temp2, (int)(j == idx));
+    }
+    Fq12Mul(temp, temp, temp2);
+  }
+  Fq12Cp(result, temp);
+  Fq12Clear(temp2);
 }
 
 void Fq12Conj(Fq12Elem* result, Fq12Elem const* in) {
@@ -210,6 +258,235 @@ void Fq12SqCyc(Fq12Elem* result, Fq12Elem const* in) {
   Fq2Add(e5, temp4, e5);
 }
 
+void Fq12SqCompressedCyc(Fq12Elem* result, Fq12Elem const* in) {
+  Fq2Elem const* g2 = &in->z1.y0;
+  Fq2Elem const* g3 = &in->z0.y2;
+  Fq2Elem const* g4 = &in->z0.y1;
+  Fq2Elem const* g5 = &in->z1.y2;
+  Fq2Elem t0;
+  Fq2Elem t1;
+  Fq2Elem t2;
+  Fq2Elem t3;
+  Fq2Elem t4;
+  Fq2Elem t5;
+  Fq2Elem t6;
+
+  Fq2Square(&t0, g4);
+  Fq2Square(&t1, g5);
+  Fq2Add(&t5, g4, g5);
+  Fq2Square(&t2, &t5);
+  Fq2Add(&t3, &t0, &t1);
+  Fq2Sub(&t5, &t2, &t3);  // t5 = 2 * g4 * g5
+  Fq2Add(&t6, g2, g3);
+  Fq2Square(&t3, &t6);
+  Fq2Square(&t2, g2);
+
+  // h2 = 2 * (g2 + 3 * xi * g4 * g5)
+  Fq2MulXi(&t6, &t5);
+  Fq2Add(&t5, &t6, g2);
+  Fq2Add(&t5, &t5, &t5);
+  Fq2Add(&result->z1.y0, &t5, &t6);
+
+  // h3 = 3 * (g4^2 + xi * g5^2) - 2 * g3
+  Fq2MulXi(&t4, &t1);
+  Fq2Add(&t5, &t0, &t4);
+  Fq2Sub(&t6, &t5, g3);
+  Fq2Square(&t1, g3);
+  Fq2Add(&t6, &t6, &t6);
+  Fq2Add(&result->z0.y2, &t6, &t5);
+
+  // h4 = 3 * (g2^2 + xi * g3^2) - 2 * g4
+  Fq2MulXi(&t4, &t1);
+  Fq2Add(&t5, &t2, &t4);
+  Fq2Sub(&t6, &t5, g4);
+  Fq2Add(&t6, &t6, &t6);
+  Fq2Add(&result->z0.y1, &t6, &t5);
+
+  // h5 = 2 * (g5 + 3 * g2 * g3)
+  Fq2Add(&t0, &t2, &t1);
+  Fq2Sub(&t5, &t3, &t0);
+  Fq2Add(&t6, &t5, g5);
+  Fq2Add(&t6, &t6, &t6);
+  Fq2Add(&result->z1.y2, &t5, &t6);
+}
+
+/// Computes the numerator of g1 of a compressed element
+static void Fq12CompressedG1Num(Fq2Elem* num, Fq2Elem const* g2,
+                                Fq2Elem const* g3, Fq2Elem const* g4,
+                                Fq2Elem const* g5) {
+  Fq2Elem t0;
+  Fq2Elem t1;
+
+  // g1 = (xi * g5^2 + 3 * g4^2 - 2 * g3) / (4 * g2) if g2 != 0
+  Fq2Square(&t0, g5);
+  Fq2MulXi(&t0, &t0);
+  Fq2Square(&t1, g4);
+  Fq2Add(num, &t1, &t1);
+  Fq2Add(num, num, &t1);
+  Fq2Add(num, num, &t0);
+  Fq2Sub(num, num, g3);
+  Fq2Sub(num, num, g3);
+
+  // g1 = 2 * g4 * g5 / g3 otherwise
+  Fq2Mul(&t0, g4, g5);
+  Fq2Add(&t0, &t0, &t0);
+  Fq2CondSet(num, &t0, num, Fq2IsZero(g2));
+}
+
+/// Computes the denominator of g1 of a compressed element
+static void Fq12CompressedG1Den(Fq2Elem* den, Fq2Elem const* g2,
+                                Fq2Elem const* g3) {
+  Fq2Elem one;
+  Fq2Add(den, g2, g2);
+  Fq2Add(den, den, den);
+  Fq2CondSet(den, g3, den, Fq2IsZero(g2));
+  // keep a degenerate element from zeroing the shared inversion
+  Fq2Set(&one, 1);
+  Fq2CondSet(den, &one, den, Fq2IsZero(den));
+}
+
+/// Computes g0 of a compressed element from its g1
+static void Fq12CompressedG0(Fq2Elem* g0, Fq2Elem const* g1,
+                             Fq2Elem const* g2, Fq2Elem const* g3,
+                             Fq2Elem const* g4, Fq2Elem const* g5) {
+  Fq2Elem t0;
+  Fq2Elem t1;
+
+  // g0 = xi * (2 * g1^2 + g2 * g5 - 3 * g3 * g4) + 1
+  Fq2Square(&t0, g1);
+  Fq2Mul(&t1, g3, g4);
+  Fq2Sub(&t0, &t0, &t1);
+  Fq2Add(&t0, &t0, &t0);
+  Fq2Sub(&t0, &t0, &t1);
+  Fq2Mul(&t1, g2, g5);
+  Fq2Add(&t0, &t0, &t1);
+  Fq2MulXi(g0, &t0);
+  Fq2Set(&t1, 1);
+  Fq2Add(g0, g0, &t1);
+}
+
+void Fq12DecompressCyc(Fq12Elem* elems, size_t count) {
+  Fq2Elem den;
+  Fq2Elem inv;
+  Fq2Elem t0;
+  size_t i;
+
+  if (0 == count) {
+    return;
+  }
+  // z1.y1 receives the numerator of g1 and z0.y0 the running product of
+  // the denominators
+  for (i = 0; i < count; i++) {
+    Fq12Elem* e = &elems[i];
+    Fq12CompressedG1Num(&e->z1.y1, &e->z1.y0, &e->z0.y2, &e->z0.y1,
+                        &e->z1.y2);
+    Fq12CompressedG1Den(&den, &e->z1.y0, &e->z0.y2);
+    if (0 == i) {
+      Fq2Cp(&e->z0.y0, &den);
+    } else {
+      Fq2Mul(&e->z0.y0, &elems[i - 1].z0.y0, &den);
+    }
+  }
+  Fq2Inv(&inv, &elems[count - 1].z0.y0);
+
+  i = count;
+  while (i > 0) {
+    Fq12Elem* e = &elems[--i];
+
+    Fq12CompressedG1Den(&den, &e->z1.y0, &e->z0.y2);
+    if (0 == i) {
+      Fq2Cp(&t0, &inv);
+    } else {
+      Fq2Mul(&t0, &inv, &elems[i - 1].z0.y0);
+      Fq2Mul(&inv, &inv, &den);
+    }
+    Fq2Mul(&e->z1.y1, &e->z1.y1, &t0);
+    Fq12CompressedG0(&e->z0.y0, &e->z1.y1, &e->z1.y0, &e->z0.y2, &e->z0.y1,
+                     &e->z1.y2);
+  }
+  Fq2Clear(&inv);
+}
+
+void Fq12CompressCyc(Fq12CompressedElem* result, Fq12Elem const* in,
+                     bool conj) {
+  Fq2Cp(&result->g2, &in->z1.y0);
+  Fq2Cp(&result->g3, &in->z0.y2);
+  Fq2Cp(&result->g4, &in->z0.y1);
+  Fq2Cp(&result->g5, &in->z1.y2);
+  if (conj) {
+    // the conjugate negates z1, g1 follows and g0 is unchanged
+    Fq2Neg(&result->g2, &result->g2);
+    Fq2Neg(&result->g5, &result->g5);
+  }
+}
+
+void Fq12MulDecompressCyc(Fq12Elem* result, Fq12CompressedElem const* elems,
+                          Fq2Elem* scratch, size_t count) {
+  Fq12Elem e;
+  Fq2Elem den;
+  Fq2Elem inv;
+  Fq2Elem t0;
+  size_t i;
+
+  if (0 == count) {
+    return;
+  }
+  // scratch receives the running product of the denominators of g1
+  for (i = 0; i < count; i++) {
+    Fq12CompressedG1Den(&den, &elems[i].g2, &elems[i].g3);
+    if (0 == i) {
+      Fq2Cp(&scratch[i], &den);
+    } else {
+      Fq2Mul(&scratch[i], &scratch[i - 1], &den);
+    }
+  }
+  Fq2Inv(&inv, &scratch[count - 1]);
+
+  i = count;
+  while (i > 0) {
+    Fq12CompressedElem const* c = &elems[--i];
+
+    Fq12CompressedG1Den(&den, &c->g2, &c->g3);
+    if (0 == i) {
+      Fq2Cp(&t0, &inv);
+    } else {
+      Fq2Mul(&t0, &inv, &scratch[i - 1]);
+      Fq2Mul(&inv, &inv, &den);
+    }
+    Fq12CompressedG1Num(&e.z1.y1, &c->g2, &c->g3, &c->g4, &c->g5);
+    Fq2Mul(&e.z1.y1, &e.z1.y1, &t0);
+    Fq12CompressedG0(&e.z0.y0, &e.z1.y1, &c->g2, &c->g3, &c->g4, &c->g5);
+    Fq2Cp(&e.z1.y0, &c->g2);
+    Fq2Cp(&e.z0.y2, &c->g3);
+    Fq2Cp(&e.z0.y1, &c->g4);
+    Fq2Cp(&e.z1.y2, &c->g5);
+    Fq12Mul(result, result, &e);
+  }
+  Fq2Clear(&inv);
+}
+
+/// Multiplies an Fq6 element by the sparse element c0 + c1 * v
+static void Fq6MulSparse01(Fq6Elem* result, Fq6Elem const* left,
+                           Fq2Elem const* c0, Fq2Elem const* c1) {
+  Fq2Elem t0;
+  Fq2Elem t1;
+  Fq2Elem t2;
+  Fq2Elem t3;
+  Fq2Mul(&t0, &left->y0, c0);
+  Fq2Mul(&t1, &left->y1, c1);
+  Fq2Add(&t2, &left->y0, &left->y1);
+  Fq2Add(&t3, c0, c1);
+  Fq2Mul(&t2, &t2, &t3);
+  Fq2Sub(&t2, &t2, &t0);
+  Fq2Sub(&t2, &t2, &t1);
+  Fq2Mul(&t3, &left->y2, c1);
+  Fq2MulXi(&t3, &t3);
+  Fq2Add(&result->y0, &t0, &t3);
+  Fq2Mul(&t3, &left->y2, c0);
+  Fq2Add(&result->y2, &t3, &t1);
+  Fq2Cp(&result->y1, &t2);
+}
+
 void Fq12MulSpecial(Fq12Elem* result, Fq12Elem const* left,
                     Fq12Elem const* right) {
   Fq2Elem T3;
@@ -237,26 +514,16 @@ void Fq12MulSpecial(Fq12Elem* result, Fq12Elem const* left,
   }
 #endif  // defined(DEBUG)
 
-  Fq6Add(t0, a0, a1);
+  // Karatsuba over Fq6 with right = b0 + (b1 + b3 * v) * w
+  Fq6MulScalar(t0, a0, b0);
+  Fq6MulSparse01(t1, a1, b1, b3);
+  Fq6Add(t2, a0, a1);
   Fq2Add(t3, b0, b1);
-  Fq6MulScalar(t0, t0, t3);
-
-  Fq6MulScalar(t2, a1, b3);
-  Fq6MulV(t2, t2);
-
-  Fq6MulScalar(t1, a1, b1);
-  Fq6Sub(t0, t0, t1);
-  Fq6Add(t2, t2, t1);
-  Fq6MulV(t2, t2);
-
-  Fq6MulScalar(t1, a0, b0);
-  Fq6Add(t2, t2, t1);
-  Fq6Sub(t0, t0, t1);
-
-  Fq6MulScalar(t1, a0, b3);
+  Fq6MulSparse01(t2, t2, t3, b3);
+  Fq6Sub(t2, t2, t0);
+  Fq6Sub(r1, t2, t1);
   Fq6MulV(t1, t1);
-  Fq6Add(r1, t1, t0);
-  Fq6Cp(r0, t2);
+  Fq6Add(r0, t0, t1);
 }
 
 bool Fq12Eq(Fq12Elem const* left, Fq12Elem const* right) {
@@ -25,35 +25,88 @@
 #include "tinymath/fq12.h"
 #include "tinymath/fq2.h"
 #include "tinymath/mathtypes.h"
-#include "tinymath/vli.h"
 
-static const VeryLargeInt epid_e = {{0xf2788803, 0x7886dcf9, 0x2dc401c0,
-                                     0xd77a10ff, 0x27bd9b6f, 0x367ba865,
-                                     0xaaaa2822, 0x2aaaaaaa}};
-static const VeryLargeInt epid_t = {{0x30B0A801, 0x6882F5C0, 0, 0, 0, 0, 0, 0}};
-static const Fq2Elem epid_xi = {
-    {{{0x00000002, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
-       0x00000000, 0x00000000}}},
-    {{{0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
-       0x00000000, 0x00000000}}}};
+#define COUNT_OF(a) (sizeof(a) / sizeof((a)[0]))
 
-void PairingInit(PairingState* state) {
-  int i;
-  Fq2Exp(&state->g[0][0], &epid_xi, &epid_e);
-  for (i = 1; i < 5; i++) {
-    Fq2Mul(&state->g[0][i], &state->g[0][i - 1], &state->g[0][0]);
-  }
-  for (i = 0; i < 5; i++) {
-    FqSquare(&state->g[1][i].x0, &state->g[0][i].x0);
-    FqSquare(&state->g[1][i].x1, &state->g[0][i].x1);
-    FqAdd(&state->g[1][i].x0, &state->g[1][i].x0, &state->g[1][i].x1);
-    FqClear(&state->g[1][i].x1);
-    Fq2Mul(&state->g[2][i], &state->g[0][i], &state->g[1][i]);
-  }
-}
+/// Non-adjacent form of t, least significant digit first
+static const int8_t epid_t_naf[] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 0, 0, -1, 0, -1, 0, 1,
+    0, 0, 0, -1, 0, 1, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, -1, 0, -1, 0, 0, 0, 0, -1,
+    0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, -1, 0, 1};
+/// Number of non-zero digits of epid_t_naf
+#define EPID_T_NAF_WEIGHT 18
 
-static void piOp(EccPointFq2* out, EccPointFq2 const* in, int e,
-                 PairingState const* scratch) {
+/// Non-adjacent form of s = 6t-2 without its leading 1, most significant
+/// digit first
+static const int8_t epid_s_naf[] = {
+    0, 1, 0, 0, -1, 0, 1, 0, -1, 0, 0, 0, 1, 0, 0, 1, 0, 0, -1, 0, 0, 0,
+    0, 1, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1,
+    0, 0, 1, 0, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0};
+
+/// Frobenius coefficients, epid_frob[e - 1][i] = xi^((i + 1)(q^e - 1) / 6)
+static const Fq2Elem epid_frob[3][5] = {
+    {{{{{0xa74cd07c, 0x868a9190, 0x937c99ef, 0x36ec79f8, 0xc7eb8000,
+         0xf6b7922c, 0xc2bb9817, 0x998db53f}}},
+      {{{0x971dea60, 0x633c3491, 0x95990db4, 0x7ef8fbaa, 0xae1f744a,
+         0x742528e0, 0x8f1f390e, 0x5f74a7fa}}}},
+     {{{{0x32b2f5b3, 0xd00848c6, 0xba684f80, 0x73f765f9, 0x5aa5a321,
+         0xa459030a, 0x183615ab, 0x797d9fb2}}},
+      {{{0x5a32a7ff, 0x2bc597a2, 0x522d626b, 0x9b86a847, 0x4dff7480,
+         0xc532097b, 0x8aa02fd3, 0x7c7b75d9}}}},
+     {{{{0xdbb63b09, 0xd3f15d94, 0x7f31e66b, 0x2c4fd159, 0x41886c60,
+         0xd0d57a94, 0xff747392, 0x8dc4b4cb}}},
+      {{{0x089945ff, 0xd4b98d4e, 0xebcbc254, 0x4bc33cb7, 0x949f3421,
+         0x5ac502c9, 0xfeebf658, 0x1b896997}}}},
+     {{{{0x30436ada, 0x1675310b, 0xbf2202e7, 0x36996a6b, 0x2d217214,
+         0x0cef2d14, 0xc59af5d4, 0x2199495c}}},
+      {{{0x63cb5f2f, 0x94ed96c9, 0x3733ef20, 0xc73a1b08, 0x516828dd,
+         0x0d7ee746, 0xcd3018a8, 0x98f47929}}}},
+     {{{{0xd29eb744, 0x92d7b2ab, 0x3571524d, 0xde66b0a8, 0x10f86d9e,
+         0xf9fb3afe, 0x4d39e53b, 0x3843c571}}},
+      {{{0xfbbab3a9, 0x4016f93f, 0x81f3861f, 0x9d4c48d2, 0xb5803a14,
+         0xe99b6d9e, 0x56a7db5b, 0x0c78de0f}}}}},
+    {{{{{0xa3a1b808, 0xdb1c0a24, 0xf1932d1e, 0x9bcdd79d, 0x92101865,
+         0x3988e140, 0x00000001, 0x00000000}}},
+      {{{0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+         0x00000000, 0x00000000, 0x00000000}}}},
+     {{{{0xa3a1b807, 0xdb1c0a24, 0xf1932d1e, 0x9bcdd79d, 0x92101865,
+         0x3988e140, 0x00000001, 0x00000000}}},
+      {{{0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+         0x00000000, 0x00000000, 0x00000000}}}},
+     {{{{0xaed33012, 0xd3292ddb, 0x12980a82, 0x0cdc65fb, 0xee71a49f,
+         0x46e5f25e, 0xfffcf0cd, 0xffffffff}}},
+      {{{0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+         0x00000000, 0x00000000, 0x00000000}}}},
+     {{{{0x0b31780b, 0xf80d23b7, 0x2104dd63, 0x710e8e5d, 0x5c618c39,
+         0x0d5d111e, 0xfffcf0cc, 0xffffffff}}},
+      {{{0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+         0x00000000, 0x00000000, 0x00000000}}}},
+     {{{{0x0b31780c, 0xf80d23b7, 0x2104dd63, 0x710e8e5d, 0x5c618c39,
+         0x0d5d111e, 0xfffcf0cc, 0xffffffff}}},
+      {{{0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+         0x00000000, 0x00000000, 0x00000000}}}}},
+    {{{{{0xdf94df06, 0x40717504, 0x6d8b693f, 0x2a2d54a4, 0x89292ad8,
+         0xcc0dff20, 0xd9b9f751, 0x1b5f56d4}}},
+      {{{0x6003f266, 0x8fcb956d, 0x453dd552, 0x91d82f7b, 0x8b7d0fc2,
+         0x7012fd84, 0x00e4d76b, 0xc72697f8}}}},
+     {{{{0x25a36fff, 0xa8f6d0b7, 0xa78cdcdd, 0xe1be8e2e, 0x8a27bccf,
+         0x3101c33a, 0xaef75e66, 0xb9839537}}},
+      {{{0xa46269d7, 0x8b0c38c9, 0xa635027c, 0xa90193dd, 0x9604620d,
+         0xaafd0391, 0xc1c39a82, 0x93c50d89}}}},
+     {{{{0xd31cf50a, 0xff37d046, 0x93662416, 0xe08c94a1, 0xace9383e,
+         0x761077ca, 0x00887d3a, 0x723b4b34}}},
+      {{{0xa639ea14, 0xfe6fa08d, 0x26cc482d, 0xc1192943, 0x59d2707d,
+         0xec20ef95, 0x0110fa74, 0xe4769668}}}},
+     {{{{0x4fa3f824, 0xed2c25c5, 0xe34884a1, 0xcf9d269c, 0xd75e43c4,
+         0x6f97d5f4, 0xcdf75397, 0x2c4ae84c}}},
+      {{{0xa736aa34, 0xe6a010c1, 0x30445c87, 0x919b2ab5, 0x1ee31496,
+         0x6f0f1b65, 0xffc075b2, 0x7953b3b3}}}},
+     {{{{0xe72228e0, 0x5e4e522f, 0xee3a9a81, 0x23066401, 0x57844aa7,
+         0xc2de03fd, 0xe47bead2, 0x287f4579}}},
+      {{{0xdc3d4d79, 0x80dd26d7, 0x84e63cb1, 0x156ba7cc, 0x244f7fdb,
+         0xf4aafb16, 0x7b83ddaa, 0xc096a0a5}}}}}};
+
+static void piOp(EccPointFq2* out, EccPointFq2 const* in, int e) {
   if (e == 1) {
     Fq2Conj(&out->x, &in->x);
     Fq2Conj(&out->y, &in->y);
@@ -61,15 +114,14 @@ static void piOp(EccPointFq2* out, EccPointFq2 const* in, int e,
     Fq2Cp(&out->x, &in->x);
     Fq2Cp(&out->y, &in->y);
   }
-  Fq2Mul(&out->x, &out->x, &scratch->g[e - 1][1]);
-  Fq2Mul(&out->y, &out->y, &scratch->g[e - 1][2]);
+  Fq2Mul(&out->x, &out->x, &epid_frob[e - 1][1]);
+  Fq2Mul(&out->y, &out->y, &epid_frob[e - 1][2]);
 }
 
 /*
  * Computes the Frobenius endomorphism out = in^(p^e)
  */
-static void frob_op(Fq12Elem* out, Fq12Elem const* in, int e,
-                    PairingState const* state) {
+static void frob_op(Fq12Elem* out, Fq12Elem const* in, int e) {
   if (e == 1 || e == 3) {
     Fq2Conj(&out->z0.y0, &in->z0.y0);
     Fq2Conj(&out->z1.y0, &in->z1.y0);
@@ -85,14 +137,45 @@ static void frob_op(Fq12Elem* out, Fq12Elem const* in, int e,
     Fq2Cp(&out->z0.y2, &in->z0.y2);
     Fq2Cp(&out->z1.y2, &in->z1.y2);
   }
-  Fq2Mul(&out->z1.y0, &out->z1.y0, &state->g[e - 1][0]);
-  Fq2Mul(&out->z0.y1, &out->z0.y1, &state->g[e - 1][1]);
-  Fq2Mul(&out->z1.y1, &out->z1.y1, &state->g[e - 1][2]);
-  Fq2Mul(&out->z0.y2, &out->z0.y2, &state->g[e - 1][3]);
-  Fq2Mul(&out->z1.y2, &out->z1.y2, &state->g[e - 1][4]);
+  Fq2Mul(&out->z1.y0, &out->z1.y0, &epid_frob[e - 1][0]);
+  Fq2Mul(&out->z0.y1, &out->z0.y1, &epid_frob[e - 1][1]);
+  Fq2Mul(&out->z1.y1, &out->z1.y1, &epid_frob[e - 1][2]);
+  Fq2Mul(&out->z0.y2, &out->z0.y2, &epid_frob[e - 1][3]);
+  Fq2Mul(&out->z1.y2, &out->z1.y2, &epid_frob[e - 1][4]);
 }
 
-static void finalExp(Fq12Elem* f, PairingState const* state) {
+/*
+ * Computes result = in^t for an element of the cyclotomic subgroup using
+ * compressed squaring
+ *
+ * The squares at the non-zero digits of t are kept compressed until they
+ * are multiplied in, so the stack holds EPID_T_NAF_WEIGHT - 1 elements of
+ * two thirds of the size of Fq12 plus as many elements of Fq2, about
+ * 5.4 KB, instead of as many full elements of Fq12.
+ */
+static void expT(Fq12Elem* result, Fq12Elem const* in) {
+  Fq12CompressedElem sq[EPID_T_NAF_WEIGHT - 1];
+  Fq2Elem scratch[EPID_T_NAF_WEIGHT - 1];
+  Fq12Elem acc;
+  size_t n = 0;
+  size_t i;
+
+  Fq12Cp(&acc, in);
+  for (i = 1; i < COUNT_OF(epid_t_naf); i++) {
+    Fq12SqCompressedCyc(&acc, &acc);
+    if (epid_t_naf[i]) {
+      // the inverse of an element of the cyclotomic subgroup is its
+      // conjugate
+      Fq12CompressCyc(&sq[n++], &acc, epid_t_naf[i] < 0);
+    }
+  }
+
+  // t is odd, so its least significant digit is 1
+  Fq12Cp(result, in);
+  Fq12MulDecompressCyc(result, sq, scratch, n);
+}
+
+static void finalExp(Fq12Elem* f) {
   Fq12Elem t3;
   Fq12Elem t2;
   Fq12Elem t1;
@@ -101,47 +184,47 @@ static void finalExp(Fq12Elem* f, PairingState const* state) {
   Fq12Conj(&t1, f);
   Fq12Inv(&t2, f);
   Fq12Mul(f, &t1, &t2);
-  frob_op(&t2, f, 2, state);
+  frob_op(&t2, f, 2);
   Fq12Mul(f, f, &t2);
-  Fq12ExpCyc(&t1, f, &epid_t);
+  expT(&t1, f);
   // if (neg) {  // neg == 1
   Fq12Conj(&t1, &t1);
   // }
-  Fq12ExpCyc(&t3, &t1, &epid_t);
+  expT(&t3, &t1);
   // if (neg) {  // neg == 1
   Fq12Conj(&t3, &t3);
   // }
-  Fq12ExpCyc(&t0, &t3, &epid_t);
+  expT(&t0, &t3);
   // if (neg) {  // neg == 1
   Fq12Conj(&t0, &t0);
   // }
 
-  frob_op(&t2, &t0, 1, state);
+  frob_op(&t2, &t0, 1);
   Fq12Mul(&t2, &t2, &t0);
   Fq12Conj(&t2, &t2);
   Fq12SqCyc(&t0, &t2);
-  frob_op(&t2, &t3, 1, state);
+  frob_op(&t2, &t3, 1);
   Fq12Mul(&t2, &t2, &t1);
   Fq12Conj(&t2, &t2);
   Fq12Mul(&t0, &t0, &t2);
   Fq12Conj(&t2, &t3);
   Fq12Mul(&t0, &t0, &t2);
-  frob_op(&t1, &t1, 1, state);
+  frob_op(&t1, &t1, 1);
   Fq12Conj(&t1, &t1);
   Fq12Mul(&t1, &t1, &t2);
   Fq12Mul(&t1, &t1, &t0);
-  frob_op(&t2, &t3, 2, state);
+  frob_op(&t2, &t3, 2);
   Fq12Mul(&t0, &t0, &t2);
   Fq12SqCyc(&t1, &t1);
   Fq12Mul(&t1, &t1, &t0);
   Fq12SqCyc(&t1, &t1);
   Fq12Conj(&t2, f);
   Fq12Mul(&t0, &t1, &t2);
-  frob_op(&t2, f, 1, state);
+  frob_op(&t2, f, 1);
   Fq12Mul(&t1, &t1, &t2);
-  frob_op(&t2, f, 2, state);
+  frob_op(&t2, f, 2);
   Fq12Mul(&t1, &t1, &t2);
-  frob_op(&t2, f, 3, state);
+  frob_op(&t2, f, 3);
   Fq12Mul(&t1, &t1, &t2);
   Fq12SqCyc(&t0, &t0);
   Fq12Mul(f, &t1, &t0);
@@ -241,45 +324,40 @@ static void pair_line(Fq12Elem* f, Fq2Elem* X, Fq2Elem* Y, Fq2Elem* Z,
   Fq2Clear(&f->z1.y2);
 }
 
-void PairingCompute(Fq12Elem* d, EccPointFq const* P, EccPointFq2 const* Q,
-                    PairingState const* state) {
+void PairingCompute(Fq12Elem* d, EccPointFq const* P, EccPointFq2 const* Q) {
   Fq2Elem X;
   Fq2Elem Y;
   Fq2Elem Z;
   Fq2Elem Z2;
   EccPointFq2 Qp;
+  EccPointFq2 negQ;
   Fq12Elem f;
-  VeryLargeInt s;
-  const VeryLargeInt two = {{2}};
-  uint32_t i;
-
-  VliAdd(&s, &epid_t, &epid_t);  // s = 2*t
-  VliAdd(&s, &s, &epid_t);       // s = 3*t
-  VliAdd(&s, &s, &s);            // s = 6*t
-
-  // if (neg) {  // neg == 1
-  VliSub(&s, &s, &two);
-  // } else {
-  //   VliAdd(&s, &s, &two);
-  // }
+  size_t i;
 
   Fq2Cp(&X, &Q->x);
   Fq2Cp(&Y, &Q->y);
   Fq2Set(&Z, 1);
   Fq2Set(&Z2, 1);
-  Fq12Set(d, 1);
+  Fq2Cp(&negQ.x, &Q->x);
+  Fq2Neg(&negQ.y, &Q->y);
 
-  Fq12Clear(&f);
-  // s has 66 bits, 0 through 65, so starting point is bit 64
-  i = 65;
-  while (i > 0) {
-    i -= 1;
+  // the leading digit of s sets T = Q, which the initial X, Y, Z hold
+  for (i = 0; i < COUNT_OF(epid_s_naf); i++) {
     pair_tangent(&f, &X, &Y, &Z, &Z2, P);
-    Fq12Square(d, d);
-    Fq12MulSpecial(d, d, &f);
-    if (VliTestBit(&s, i)) {
+    if (0 == i) {
+      // d is still 1, so d^2 * f is f
+      Fq12Cp(d, &f);
+    } else {
+      Fq12Square(d, d);
+      Fq12MulSpecial(d, d, &f);
+    }
+    // s is public, so branching on its digits leaks nothing
+    if (epid_s_naf[i] > 0) {
       pair_line(&f, &X, &Y, &Z, &Z2, P, Q);
       Fq12MulSpecial(d, d, &f);
+    } else if (epid_s_naf[i] < 0) {
+      pair_line(&f, &X, &Y, &Z, &Z2, P, &negQ);
+      Fq12MulSpecial(d, d, &f);
     }
   }
 
@@ -288,15 +366,14 @@ void PairingCompute(Fq12Elem* d, EccPointFq const* P, EccPointFq2 const* Q,
   Fq12Conj(d, d);
   // }
 
-  piOp(&Qp, Q, 1, state);
+  piOp(&Qp, Q, 1);
   pair_line(&f, &X, &Y, &Z, &Z2, P, &Qp);
   Fq12MulSpecial(d, d, &f);
-  piOp(&Qp, Q, 2, state);
+  piOp(&Qp, Q, 2);
   Fq2Neg(&Qp.y, &Qp.y);
   pair_line(&f, &X, &Y, &Z, &Z2, P, &Qp);
   Fq12MulSpecial(d, d, &f);
-  finalExp(d, state);
-  // s doesn't have secret information; no need to clear it.
+  finalExp(d);
   Fq12Clear(&f);
   Fq2Clear(&X);
   Fq2Clear(&Y);
@@ -304,4 +381,6 @@ void PairingCompute(Fq12Elem* d, EccPointFq const* P, EccPointFq2 const* Q,
   Fq2Clear(&Z2);
   Fq2Clear(&Qp.x);
   Fq2Clear(&Qp.y);
+  Fq2Clear(&negQ.x);
+  Fq2Clear(&negQ.y);
 }
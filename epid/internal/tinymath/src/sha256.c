@@ -50,7 +50,26 @@
 
 #include "tinystdlib/tiny_stdlib.h"
 
-static void sha256_compress(uint32_t* iv, const uint8_t* data);
+/*
+ * x86 SHA-NI backend, detected at run time. Build with TINYMATH_NO_SHA_EXT
+ * to always use the portable implementation.
+ */
+#if !defined(TINYMATH_NO_SHA_EXT)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TINYSHA256_SHANI
+#define TINYSHA256_SHANI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define TINYSHA256_SHANI
+#define TINYSHA256_SHANI_TARGET
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#endif
+
+static void sha256_compress(uint32_t* iv, const uint8_t* data,
+                            size_t num_blocks);
 
 void tc_sha256_init(sha256_state* s) {
   /*
@@ -71,14 +90,27 @@ void tc_sha256_init(sha256_state* s) {
 }
 
 void tc_sha256_update(sha256_state* s, const uint8_t* data, size_t datalen) {
-  while (datalen-- > 0) {
+  size_t num_blocks = 0;
+  while (datalen > 0 && s->leftover_offset > 0) {
+    datalen--;
     s->leftover[s->leftover_offset++] = *(data++);
     if (s->leftover_offset >= SHA256_BLOCK_SIZE) {
-      sha256_compress(s->iv, s->leftover);
+      sha256_compress(s->iv, s->leftover, 1);
       s->leftover_offset = 0;
       s->bits_hashed += (SHA256_BLOCK_SIZE << 3);
     }
   }
+  /* whole blocks are compressed in place */
+  num_blocks = datalen / SHA256_BLOCK_SIZE;
+  if (num_blocks > 0) {
+    sha256_compress(s->iv, data, num_blocks);
+    data += num_blocks * SHA256_BLOCK_SIZE;
+    datalen -= num_blocks * SHA256_BLOCK_SIZE;
+    s->bits_hashed += ((uint64_t)num_blocks * SHA256_BLOCK_SIZE) << 3;
+  }
+  while (datalen-- > 0) {
+    s->leftover[s->leftover_offset++] = *(data++);
+  }
 }
 
 void tc_sha256_final(uint8_t* digest, sha256_state* s) {
@@ -91,7 +123,7 @@ void tc_sha256_final(uint8_t* digest, sha256_state* s) {
     /* there is not room for all the padding in this block */
     (void)memset(s->leftover + s->leftover_offset, 0x00,
                  sizeof(s->leftover) - s->leftover_offset);
-    sha256_compress(s->iv, s->leftover);
+    sha256_compress(s->iv, s->leftover, 1);
     s->leftover_offset = 0;
   }
 
@@ -108,7 +140,7 @@ void tc_sha256_final(uint8_t* digest, sha256_state* s) {
   s->leftover[sizeof(s->leftover) - 8] = (uint8_t)(s->bits_hashed >> 56);
 
   /* hash the padding and length */
-  sha256_compress(s->iv, s->leftover);
+  sha256_compress(s->iv, s->leftover, 1);
 
   /* copy the iv out to digest */
   for (i = 0; i < SHA256_STATE_BLOCKS; ++i) {
@@ -163,7 +195,7 @@ static uint32_t BigEndian(const uint8_t** c) {
   return n;
 }
 
-static void sha256_compress(uint32_t* iv, const uint8_t* data) {
+static void sha256_compress_block(uint32_t* iv, const uint8_t* data) {
   uint32_t a, b, c, d, e, f, g, h;
   uint32_t s0, s1;
   uint32_t t1, t2;
@@ -223,3 +255,95 @@ static void sha256_compress(uint32_t* iv, const uint8_t* data) {
   iv[6] += g;
   iv[7] += h;
 }
+
+#if defined(TINYSHA256_SHANI)
+/* Returns non-zero if the processor supports SHA-NI */
+static int sha256_has_shani(void) {
+  static volatile int has_shani = -1;
+  if (has_shani < 0) {
+    unsigned int ecx1 = 0; /* CPUID leaf 1 feature flags */
+    unsigned int ebx7 = 0; /* CPUID leaf 7 extended feature flags */
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] >= 7) {
+      __cpuid(regs, 1);
+      ecx1 = (unsigned int)regs[2];
+      __cpuidex(regs, 7, 0);
+      ebx7 = (unsigned int)regs[1];
+    }
+#else
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+    if (__get_cpuid_max(0, 0) >= 7) {
+      __cpuid(1, a, b, c, d);
+      ecx1 = c;
+      __cpuid_count(7, 0, a, b, c, d);
+      ebx7 = b;
+    }
+#endif
+    /* SSSE3, SSE4.1 and SHA */
+    has_shani = (ecx1 & (1u << 9)) && (ecx1 & (1u << 19)) &&
+                (ebx7 & (1u << 29));
+  }
+  return has_shani;
+}
+
+TINYSHA256_SHANI_TARGET
+static void sha256_compress_shani(uint32_t* iv, const uint8_t* data,
+                                  size_t num_blocks) {
+  const __m128i kByteSwap =
+      _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i state0, state1, abef, cdgh, msg, tmp;
+  __m128i w[4];
+  int i;
+
+  /* the SHA-NI state is (ABEF, CDGH) */
+  tmp = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)&iv[0]), 0xB1);
+  state1 = _mm_shuffle_epi32(_mm_loadu_si128((__m128i const*)&iv[4]), 0x1B);
+  state0 = _mm_alignr_epi8(tmp, state1, 8);
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+  while (num_blocks-- > 0) {
+    abef = state0;
+    cdgh = state1;
+    for (i = 0; i < 16; i++) {
+      if (i < 4) {
+        w[i] = _mm_shuffle_epi8(
+            _mm_loadu_si128((__m128i const*)(data + 16 * i)), kByteSwap);
+      } else {
+        tmp = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+        tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(w[(i + 3) & 3],
+                                                 w[(i + 2) & 3], 4));
+        w[i & 3] = _mm_sha256msg2_epu32(tmp, w[(i + 3) & 3]);
+      }
+      msg = _mm_add_epi32(w[i & 3],
+                          _mm_loadu_si128((__m128i const*)&k256[4 * i]));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    }
+    state0 = _mm_add_epi32(state0, abef);
+    state1 = _mm_add_epi32(state1, cdgh);
+    data += SHA256_BLOCK_SIZE;
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);
+  state1 = _mm_shuffle_epi32(state1, 0xB1);
+  _mm_storeu_si128((__m128i*)&iv[0], _mm_blend_epi16(tmp, state1, 0xF0));
+  _mm_storeu_si128((__m128i*)&iv[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+#endif
+
+static void sha256_compress(uint32_t* iv, const uint8_t* data,
+                            size_t num_blocks) {
+#if defined(TINYSHA256_SHANI)
+  if (sha256_has_shani()) {
+    sha256_compress_shani(iv, data, num_blocks);
+    return;
+  }
+#endif
+  while (num_blocks-- > 0) {
+    sha256_compress_block(iv, data);
+    data += SHA256_BLOCK_SIZE;
+  }
+}
@@ -21,7 +21,8 @@
 #include "tinymath/sha512_base.h"
 #include "tinystdlib/tiny_stdlib.h"
 
-static void sha512_base_compress(uint64_t* iv, void const* in);
+static void sha512_base_compress(uint64_t* iv, void const* in,
+                                 size_t num_blocks);
 
 void tinysha512_base_init(sha512_base_state* s, uint64_t const* iv) {
   volatile int j;
@@ -37,15 +38,28 @@ void tinysha512_base_init(sha512_base_state* s, uint64_t const* iv) {
 void tinysha512_base_update(sha512_base_state* s, void const* data,
                             size_t data_length) {
   unsigned char const* tmp_data = (unsigned char const*)data;
+  size_t num_blocks = 0;
 
-  while (data_length-- > 0) {
+  while (data_length > 0 && s->leftover_offset > 0) {
+    data_length--;
     s->leftover[s->leftover_offset++] = *(tmp_data++);
     if (s->leftover_offset >= SHA512_BASE_BLOCK_SIZE) {
-      sha512_base_compress(s->iv, s->leftover);
+      sha512_base_compress(s->iv, s->leftover, 1);
       s->leftover_offset = 0;
       s->bits_hashed += (SHA512_BASE_BLOCK_SIZE << 3);
     }
   }
+  // whole blocks are compressed in place
+  num_blocks = data_length / SHA512_BASE_BLOCK_SIZE;
+  if (num_blocks > 0) {
+    sha512_base_compress(s->iv, tmp_data, num_blocks);
+    tmp_data += num_blocks * SHA512_BASE_BLOCK_SIZE;
+    data_length -= num_blocks * SHA512_BASE_BLOCK_SIZE;
+    s->bits_hashed += ((uint64_t)num_blocks * SHA512_BASE_BLOCK_SIZE) << 3;
+  }
+  while (data_length-- > 0) {
+    s->leftover[s->leftover_offset++] = *(tmp_data++);
+  }
 }
 
 void tinysha512_base_final(unsigned char* digest, size_t digest_size,
@@ -60,7 +74,7 @@ void tinysha512_base_final(unsigned char* digest, size_t digest_size,
     /* the data's bit length cannot be encoded in the last block */
     (void)memset(s->leftover + s->leftover_offset, 0x00,
                  sizeof(s->leftover) - s->leftover_offset);
-    sha512_base_compress(s->iv, s->leftover);
+    sha512_base_compress(s->iv, s->leftover, 1);
     s->leftover_offset = 0;
   }
 
@@ -71,7 +85,7 @@ void tinysha512_base_final(unsigned char* digest, size_t digest_size,
         (unsigned char)(s->bits_hashed >> (8 * i));
     s->leftover[sizeof(s->leftover) - (i + 1) - 8] = 0;
   }
-  sha512_base_compress(s->iv, s->leftover);
+  sha512_base_compress(s->iv, s->leftover, 1);
 
   for (i = 0; i < digest_size / 8; ++i) {
     uint64_t w = s->iv[i];
@@ -81,10 +95,10 @@ void tinysha512_base_final(unsigned char* digest, size_t digest_size,
     digest += 8;
   }
 }
-#define B(x, j) \
-  (((uint64_t)(*(((unsigned char const*)(&x)) + j))) << ((7 - j) * 8))
+#define B(x, j) (((uint64_t)(*((x) + j))) << ((7 - j) * 8))
 
-static uint64_t pull64(const uint64_t x) {
+// input blocks need not be aligned, so they are read byte by byte
+static uint64_t pull64(unsigned char const* x) {
   int16_t i;
   uint64_t result = 0;
   for (i = 0; i < 8; i++) result |= B(x, i);
@@ -132,8 +146,8 @@ static const uint64_t k512[80] = {
     0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
     0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL};
 
-static void sha512_base_compress(uint64_t* iv, void const* in) {
-  const uint64_t* w = (const uint64_t*)in;
+static void sha512_base_compress_block(uint64_t* iv,
+                                       unsigned char const* w) {
   uint64_t a, e, t;
   uint64_t work_space[80 + 9];
   uint64_t* work_ptr;
@@ -147,7 +161,7 @@ static void sha512_base_compress(uint64_t* iv, void const* in) {
 
   for (i = 0; i < 80; i++, work_ptr--) {
     if (i < 16) {
-      t = pull64(w[i]);
+      t = pull64(w + 8 * i);
     } else {
       t = sigma0(work_ptr[8 + 16 - 1]);
       t += sigma1(work_ptr[8 + 16 - 14]);
@@ -164,3 +178,12 @@ static void sha512_base_compress(uint64_t* iv, void const* in) {
 
   for (i = 0; i < SHA512_BASE_DIGEST_WORDS; i++) iv[i] += work_ptr[i];
 }
+
+static void sha512_base_compress(uint64_t* iv, void const* in,
+                                 size_t num_blocks) {
+  unsigned char const* data = (unsigned char const*)in;
+  while (num_blocks-- > 0) {
+    sha512_base_compress_block(iv, data);
+    data += SHA512_BASE_BLOCK_SIZE;
+  }
+}
@@ -195,6 +195,138 @@ void VliModSquare(VeryLargeInt* result, VeryLargeInt const* input,
   VliModBarrett(result, &product, mod);
 }
 
+#ifdef TINYMATH_VLI64
+/// number of 64bit limbs in a very large integer
+#define NUM_VLI64_LIMBS (NUM_ECC_DIGITS / 2)
+
+/// Holds the product of two 64bit limbs
+typedef unsigned __int128 vliDoubleLimb;
+
+static void vliToLimbs(uint64_t* limbs, VeryLargeInt const* in) {
+  uint32_t i;
+  for (i = 0; i < NUM_VLI64_LIMBS; i++) {
+    limbs[i] = in->word[2 * i] | ((uint64_t)in->word[2 * i + 1] << 32);
+  }
+}
+
+static void vliFromLimbs(VeryLargeInt* result, uint64_t const* limbs) {
+  uint32_t i;
+  for (i = 0; i < NUM_VLI64_LIMBS; i++) {
+    result->word[2 * i] = (uint32_t)limbs[i];
+    result->word[2 * i + 1] = (uint32_t)(limbs[i] >> 32);
+  }
+}
+
+/* Computes result = left * right * 2^-256 mod mod using coarsely integrated
+ * operand scanning. left * right must be less than mod * 2^256. Runs the
+ * same instructions for every input. result can alias left or right. */
+static void vliMontMul(uint64_t* result, uint64_t const* left,
+                       uint64_t const* right, uint64_t const* mod,
+                       uint64_t inv) {
+  uint64_t t[NUM_VLI64_LIMBS + 2] = {0};
+  uint64_t diff[NUM_VLI64_LIMBS];
+  uint64_t borrow = 0;
+  uint64_t keep = 0;
+  uint64_t factor = 0;
+  vliDoubleLimb acc;
+  uint32_t i, j;
+  for (i = 0; i < NUM_VLI64_LIMBS; i++) {
+    // t = t + left * right[i]
+    acc = 0;
+    for (j = 0; j < NUM_VLI64_LIMBS; j++) {
+      acc = (vliDoubleLimb)left[j] * right[i] + t[j] + (uint64_t)(acc >> 64);
+      t[j] = (uint64_t)acc;
+    }
+    acc = (vliDoubleLimb)t[NUM_VLI64_LIMBS] + (uint64_t)(acc >> 64);
+    t[NUM_VLI64_LIMBS] = (uint64_t)acc;
+    t[NUM_VLI64_LIMBS + 1] = (uint64_t)(acc >> 64);
+    // t = (t + factor * mod) / 2^64, where the division is exact
+    factor = t[0] * inv;
+    acc = (vliDoubleLimb)factor * mod[0] + t[0];
+    for (j = 1; j < NUM_VLI64_LIMBS; j++) {
+      acc = (vliDoubleLimb)factor * mod[j] + t[j] + (uint64_t)(acc >> 64);
+      t[j - 1] = (uint64_t)acc;
+    }
+    acc = (vliDoubleLimb)t[NUM_VLI64_LIMBS] + (uint64_t)(acc >> 64);
+    t[NUM_VLI64_LIMBS - 1] = (uint64_t)acc;
+    t[NUM_VLI64_LIMBS] = t[NUM_VLI64_LIMBS + 1] + (uint64_t)(acc >> 64);
+  }
+  // t is less than 2 * mod, subtract mod unless t is already less than it
+  for (j = 0; j < NUM_VLI64_LIMBS; j++) {
+    acc = (vliDoubleLimb)t[j] - mod[j] - borrow;
+    diff[j] = (uint64_t)acc;
+    borrow = (uint64_t)(acc >> 64) & 1;
+  }
+  keep = 0 - (borrow & (t[NUM_VLI64_LIMBS] ^ 1));
+  for (j = 0; j < NUM_VLI64_LIMBS; j++) {
+    result[j] = (t[j] & keep) | (diff[j] & ~keep);
+  }
+}
+#endif
+
+void VliMontModMul(VeryLargeInt* result, VeryLargeInt const* left,
+                   VeryLargeInt const* right, VliMontModulus const* mod) {
+#ifdef TINYMATH_VLI64
+  uint64_t a[NUM_VLI64_LIMBS], b[NUM_VLI64_LIMBS];
+  vliToLimbs(a, left);
+  vliToLimbs(b, right);
+  // (left * right / R) * R^2 / R = left * right
+  vliMontMul(a, a, b, mod->mod64, mod->inv);
+  vliMontMul(a, a, mod->r2_64, mod->mod64, mod->inv);
+  vliFromLimbs(result, a);
+#else
+  VliModMul(result, left, right, &mod->mod);
+#endif
+}
+
+void VliMontModSquare(VeryLargeInt* result, VeryLargeInt const* input,
+                      VliMontModulus const* mod) {
+#ifdef TINYMATH_VLI64
+  VliMontModMul(result, input, input, mod);
+#else
+  VliModSquare(result, input, &mod->mod);
+#endif
+}
+
+void VliMontModExp(VeryLargeInt* result, VeryLargeInt const* base,
+                   VeryLargeInt const* exp, VliMontModulus const* mod) {
+#ifdef TINYMATH_VLI64
+  uint64_t acc[NUM_VLI64_LIMBS], tmp[NUM_VLI64_LIMBS];
+  uint64_t b[NUM_VLI64_LIMBS];
+  uint64_t one[NUM_VLI64_LIMBS] = {1};
+  uint64_t const* m = mod->mod64;
+  uint64_t mask = 0;
+  uint32_t j, k;
+  int i;
+  vliToLimbs(b, base);
+  // move base and 1 to Montgomery representation
+  vliMontMul(b, b, mod->r2_64, m, mod->inv);
+  vliMontMul(acc, one, mod->r2_64, m, mod->inv);
+  for (i = NUM_ECC_DIGITS - 1; i >= 0; i--) {
+    for (j = 1U << 31; j > 0; j = j >> 1) {
+      vliMontMul(acc, acc, acc, m, mod->inv);
+      vliMontMul(tmp, acc, b, m, mod->inv);
+      mask = 0 - (uint64_t)((exp->word[i] & j) != 0);
+      for (k = 0; k < NUM_VLI64_LIMBS; k++) {
+        acc[k] = (tmp[k] & mask) | (acc[k] & ~mask);
+      }
+    }
+  }
+  vliMontMul(acc, acc, one, m, mod->inv);
+  vliFromLimbs(result, acc);
+#else
+  VliModExp(result, base, exp, &mod->mod);
+#endif
+}
+
+void VliMontModInv(VeryLargeInt* result, VeryLargeInt const* input,
+                   VliMontModulus const* mod) {
+  VeryLargeInt power;
+  VliSet(&power, &mod->mod);
+  power.word[0] -= 2;
+  VliMontModExp(result, input, &power, mod);
+}
+
 /* Computes p_result = p_in << c, returning carry.
  * Can modify in place (if p_result == p_in). 0 < p_shift < 32. */
 static uint32_t vliLShift(VeryLargeIntProduct* p_result,
@@ -306,6 +438,19 @@ uint32_t VliTestBit(VeryLargeInt const* in, uint32_t bit) {
       1);  // p_bit % 32 = p_bit & 0x0000001F = 31
 }
 
+uint32_t VliWindow(VeryLargeInt const* in, uint32_t bit, uint32_t width) {
+  uint32_t idx = bit >> 5;
+  uint32_t shift = bit & 31;
+  uint32_t bits = 0;
+  if (idx < NUM_ECC_DIGITS) {
+    bits = in->word[idx] >> shift;
+    if (shift + width > 32 && idx + 1 < NUM_ECC_DIGITS) {
+      bits |= in->word[idx + 1] << (32 - shift);
+    }
+  }
+  return bits & ((1u << width) - 1);
+}
+
 int VliCmp(VeryLargeInt const* left, VeryLargeInt const* right) {
   int i, cmp = 0;
   for (i = NUM_ECC_DIGITS - 1; i >= 0; --i) {
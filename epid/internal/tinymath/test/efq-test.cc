@@ -74,6 +74,95 @@ TEST(TinyEFqTest, EFqMulSSCMWorksInPlace) {
   EFqMulSSCM(&left, &left, &power);
   EXPECT_EQ(expected, left);
 }
+TEST(TinyEFqTest, EFqMulSSCMWorksGivenSmallPowers) {
+  const EccPointJacobiFq left = {
+      {0x22cfd6a2, 0x23e82f1e, 0xd50e1450, 0xe853e88c, 0xafa65357, 0x4780716c,
+       0xffd94b0f, 0x5e643124},
+      {0x5e9cb480, 0x6d4aaf9c, 0x99f1f606, 0x222d89b0, 0x30b79eab, 0x88844bd6,
+       0xc65e7c30, 0x4830c4ec},
+      {0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+       0x00000000, 0x00000000}};
+  EccPointJacobiFq expected = {0};
+  EccPointJacobiFq actual = {0};
+  FpElem power = {0};
+  EFqInf(&expected);
+  for (uint32_t i = 0; i < 40; i++) {
+    power.limbs.word[0] = i;
+    EFqMulSSCM(&actual, &left, &power);
+    EXPECT_EQ(expected, actual) << "power " << i;
+    EFqAdd(&expected, &expected, &left);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
+// EFqCombMulSSCM
+
+TEST(TinyEFqTest, EFqCombMulSSCMWorks) {
+  const EccPointJacobiFq expected = {
+      {0xacd848b1, 0xe3d60553, 0x69271cd1, 0x7cf6090e, 0x16c63bcd, 0xdb0c6cf0,
+       0x2ab60283, 0x38fc72a8},
+      {0xf7e0f7d1, 0x6b0cf194, 0x5cf18c77, 0x82a4b960, 0xa6c40a30, 0xf0b3b20f,
+       0x5f1a477b, 0x7e2a6668},
+      {0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+       0x00000000, 0x00000000}};
+  const EccPointFq base = {
+      {0x22cfd6a2, 0x23e82f1e, 0xd50e1450, 0xe853e88c, 0xafa65357, 0x4780716c,
+       0xffd94b0f, 0x5e643124},
+      {0x5e9cb480, 0x6d4aaf9c, 0x99f1f606, 0x222d89b0, 0x30b79eab, 0x88844bd6,
+       0xc65e7c30, 0x4830c4ec}};
+  const FpElem power = {0x0adf9a12, 0x5cbc9ef4, 0x91762984, 0xa08a22fb,
+                        0x52a6fddf, 0xf51e743e, 0x7b47b24b, 0x389f865f};
+  const FpElem even_power = {0x0adf9a13, 0x5cbc9ef4, 0x91762984, 0xa08a22fb,
+                             0x52a6fddf, 0xf51e743e, 0x7b47b24b, 0x389f865f};
+  EccPointFq table[EFQ_COMB_TABLE_SIZE(EFQ_COMB_MAX_TEETH)];
+  EccPointJacobiFq base_j = {0};
+  EccPointJacobiFq expected_even = {0};
+  EccPointJacobiFq actual = {0};
+  EFqFromAffine(&base_j, &base);
+  EFqAdd(&expected_even, &expected, &base_j);
+  for (uint32_t teeth = 1; teeth <= EFQ_COMB_MAX_TEETH; teeth++) {
+    ASSERT_TRUE(EFqCombTableInit(table, &base, teeth)) << "teeth " << teeth;
+    EFqCombMulSSCM(&actual, table, teeth, &power);
+    EXPECT_EQ(expected, actual) << "teeth " << teeth;
+    EFqCombMulSSCM(&actual, table, teeth, &even_power);
+    EXPECT_EQ(expected_even, actual) << "teeth " << teeth;
+  }
+}
+
+TEST(TinyEFqTest, EFqCombMulSSCMWorksGivenSmallPowers) {
+  const EccPointFq base = {
+      {0x22cfd6a2, 0x23e82f1e, 0xd50e1450, 0xe853e88c, 0xafa65357, 0x4780716c,
+       0xffd94b0f, 0x5e643124},
+      {0x5e9cb480, 0x6d4aaf9c, 0x99f1f606, 0x222d89b0, 0x30b79eab, 0x88844bd6,
+       0xc65e7c30, 0x4830c4ec}};
+  const uint32_t teeth = 5;
+  EccPointFq table[EFQ_COMB_TABLE_SIZE(5)];
+  EccPointJacobiFq base_j = {0};
+  EccPointJacobiFq expected = {0};
+  EccPointJacobiFq actual = {0};
+  FpElem power = {0};
+  ASSERT_TRUE(EFqCombTableInit(table, &base, teeth));
+  EFqFromAffine(&base_j, &base);
+  EFqInf(&expected);
+  for (uint32_t i = 0; i < 40; i++) {
+    power.limbs.word[0] = i;
+    EFqCombMulSSCM(&actual, table, teeth, &power);
+    EXPECT_EQ(expected, actual) << "power " << i;
+    EFqAdd(&expected, &expected, &base_j);
+  }
+}
+
+TEST(TinyEFqTest, EFqCombTableInitFailsGivenBadTeeth) {
+  const EccPointFq base = {
+      {0x22cfd6a2, 0x23e82f1e, 0xd50e1450, 0xe853e88c, 0xafa65357, 0x4780716c,
+       0xffd94b0f, 0x5e643124},
+      {0x5e9cb480, 0x6d4aaf9c, 0x99f1f606, 0x222d89b0, 0x30b79eab, 0x88844bd6,
+       0xc65e7c30, 0x4830c4ec}};
+  EccPointFq table[EFQ_COMB_TABLE_SIZE(EFQ_COMB_MAX_TEETH)];
+  EXPECT_FALSE(EFqCombTableInit(table, &base, 0));
+  EXPECT_FALSE(EFqCombTableInit(table, &base, EFQ_COMB_MAX_TEETH + 1));
+}
+
 ////////////////////////////////////////////////////////////////////////
 // EFqMultiExp
 
@@ -158,6 +247,35 @@ TEST(TinyEFqTest, EFqMultiExpWorks) {
 
   EXPECT_EQ(efq_expect, efq_left);
 }
+
+TEST(TinyEFqTest, EFqMultiExpWorksGivenEvenAndZeroPowers) {
+  const EccPointJacobiFq base0 = {
+      {0x22cfd6a2, 0x23e82f1e, 0xd50e1450, 0xe853e88c, 0xafa65357, 0x4780716c,
+       0xffd94b0f, 0x5e643124},
+      {0x5e9cb480, 0x6d4aaf9c, 0x99f1f606, 0x222d89b0, 0x30b79eab, 0x88844bd6,
+       0xc65e7c30, 0x4830c4ec},
+      {0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+       0x00000000, 0x00000000}};
+  EccPointJacobiFq base1 = {0};
+  EccPointJacobiFq expected = {0};
+  EccPointJacobiFq actual = {0};
+  EccPointJacobiFq tmp = {0};
+  const FpElem exps[] = {{0}, {1}, {2}, {0x10}, {0x2a}};
+  EFqDbl(&base1, &base0);
+  EFqDbl(&base1, &base1);
+  EFqAdd(&base1, &base1, &base0);
+  for (auto const& exp0 : exps) {
+    for (auto const& exp1 : exps) {
+      EFqMulSSCM(&expected, &base0, &exp0);
+      EFqMulSSCM(&tmp, &base1, &exp1);
+      EFqAdd(&expected, &expected, &tmp);
+      EFqMultiExp(&actual, &base0, &exp0, &base1, &exp1);
+      EXPECT_EQ(expected, actual) << "powers " << exp0.limbs.word[0] << ", "
+                                  << exp1.limbs.word[0];
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////
 // EFqAffineAdd
 TEST(TinyEFqTest, EFqAffineAddWorks) {
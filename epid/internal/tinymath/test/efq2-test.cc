@@ -21,6 +21,7 @@
 #include "cmp-testhelper.h"
 
 #include "tinymath/efq2.h"
+#include "tinymath/fq2.h"
 #include "tinymath/mathtypes.h"
 
 namespace {
@@ -310,6 +311,32 @@ TEST(TinyEFq2Test, EFq2MultSSCMWorksInPlace) {
   EFq2MulSSCM(&left, &left, &power);
   EXPECT_EQ(expected, left);
 }
+
+TEST(TinyEFq2Test, EFq2MultSSCMWorksGivenSmallPowers) {
+  const EccPointJacobiFq2 left = {
+      {{0xbf501131, 0x84025734, 0xe72a81d4, 0x0a3da790, 0x5303da83, 0x693bbb16,
+        0x679b2a8a, 0x06f54dd4},
+       {0xa15aebed, 0x5eabe073, 0x5585c8aa, 0xc27f168c, 0xa7b61e37, 0x209517cf,
+        0x534cd776, 0x4759d7f6}},
+      {{0x27665549, 0xb5aeb631, 0x9f88583f, 0xf4c4a3f0, 0x877b0357, 0xcc62ffad,
+        0x47c18e76, 0xf769c987},
+       {0xd7ed2a14, 0x9da3ad7f, 0x73cc6868, 0x7abf5a23, 0xeb35917a, 0xbb7689b7,
+        0x4631956d, 0x477f610f}},
+      {{0x00000001, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000},
+       {0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+        0x00000000, 0x00000000}}};
+  EccPointJacobiFq2 expected = {0};
+  EccPointJacobiFq2 actual = {0};
+  FpElem power = {0};
+  Fq2Set(&expected.Y, 1);
+  for (uint32_t i = 0; i < 40; i++) {
+    power.limbs.word[0] = i;
+    EFq2MulSSCM(&actual, &left, &power);
+    EXPECT_EQ(expected, actual) << "power " << i;
+    EFq2Add(&expected, &expected, &left);
+  }
+}
 ////////////////////////////////////////////////////////////////////////
 // EFq2Eq
 
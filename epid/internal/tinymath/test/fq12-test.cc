@@ -624,6 +624,137 @@ TEST(TinyFq12Test, Fq12MultiExpWorks) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST(TinyFq12Test, Fq12MultiExpWorksGivenDistinctBases) {
+  Fq12Elem pairing_out = {{{{0x50ab7bc6, 0xd28d33ca, 0xa7de4ce1, 0x162996ed,
+                             0xad5ee231, 0x4fc0a501, 0x468be932, 0xba101ff6},
+                            {0x14d36207, 0x34c44c84, 0xdfa22b9e, 0x1f4d1fc0,
+                             0xcb0454f2, 0xc4077c42, 0xebde30b6, 0x15eb79f4}},
+                           {{0xf91d7519, 0xc456caad, 0xb908d0d3, 0x31b0be8c,
+                             0x1c0def81, 0x80e14649, 0x4657b6e7, 0xf18b84d1},
+                            {0xec73b557, 0xf8acbc05, 0x2e5f0a7e, 0xf485e0eb,
+                             0x6fd516b6, 0xb7190100, 0xc1fa4e50, 0x3fee7c43}},
+                           {{0xb3ebe0e5, 0xc572866a, 0xa10be392, 0x2d6f653d,
+                             0x138bb1b6, 0x87cf70ba, 0xbbef8650, 0xe3b31829},
+                            {0x4ba31303, 0x8d1afe6e, 0xe7138780, 0x36a08173,
+                             0xcdc3182a, 0x1ecb0486, 0xd5a961a5, 0xda0e5787}}},
+                          {{{0x0b13b454, 0xa62f5fbf, 0xa4bed641, 0xd3632805,
+                             0xe8010941, 0x72cebb51, 0x8aaa0095, 0x669e804d},
+                            {0xe49b7149, 0x8fc69d31, 0x956d88ab, 0x265c926b,
+                             0x3bb2f1d4, 0xbfc206ea, 0x6f29d6da, 0x5b5065dc}},
+                           {{0x0ff0848e, 0x1f3fdf5c, 0xb3533098, 0x1a434003,
+                             0xc80d2a60, 0x4ac6aa4a, 0xc99fbca8, 0xe0ce978f},
+                            {0x3357d172, 0xf5f8a018, 0x5908b3da, 0xe540395c,
+                             0xb654a226, 0x89cef58e, 0x47786d9f, 0x5a5d41d2}},
+                           {{0x788a3989, 0x49a5f719, 0x5a0042e3, 0x92f94303,
+                             0x1bd0e6c8, 0x81c5ac15, 0xe8a05ec8, 0xbbba6ced},
+                            {0x6d17dc8e, 0xaf351b75, 0xba6e2c36, 0x2a04ea26,
+                             0x421e1737, 0x16fd0bfe, 0x4bb33376, 0x32aebf4d}}}};
+  VeryLargeInt e0 = {0x76abb18a, 0x92c0f7b9, 0x2c1a37e0, 0x7fdf6ca1,
+                     0xe3401760, 0x66eb7d52, 0x918d50a7, 0x12a65bd6};
+  VeryLargeInt e1 = {0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                     0x00000000, 0x00000000, 0x00000000, 0x80000000};
+  VeryLargeInt e2 = {0x00000001};
+  VeryLargeInt e3 = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                     0xffffffff, 0xffffffff, 0xffffffff, 0x0fffffff};
+  Fq12Elem b1, b2, b3, tmp;
+  Fq12Square(&b1, &pairing_out);
+  Fq12Mul(&b2, &b1, &pairing_out);
+  Fq12Conj(&b3, &pairing_out);
+  Fq12Elem expected, actual;
+  Fq12Exp(&expected, &pairing_out, &e0);
+  Fq12Exp(&tmp, &b1, &e1);
+  Fq12Mul(&expected, &expected, &tmp);
+  Fq12Exp(&tmp, &b2, &e2);
+  Fq12Mul(&expected, &expected, &tmp);
+  Fq12Exp(&tmp, &b3, &e3);
+  Fq12Mul(&expected, &expected, &tmp);
+  Fq12MultiExp(&actual, &pairing_out, &e0, &b1, &e1, &b2, &e2, &b3, &e3);
+  EXPECT_EQ(expected, actual);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Fq12MultiExpCyc
+
+TEST(TinyFq12Test, Fq12MultiExpCycMatchesFq12MultiExp) {
+  Fq12Elem pairing_out = {{{{0x50ab7bc6, 0xd28d33ca, 0xa7de4ce1, 0x162996ed,
+                             0xad5ee231, 0x4fc0a501, 0x468be932, 0xba101ff6},
+                            {0x14d36207, 0x34c44c84, 0xdfa22b9e, 0x1f4d1fc0,
+                             0xcb0454f2, 0xc4077c42, 0xebde30b6, 0x15eb79f4}},
+                           {{0xf91d7519, 0xc456caad, 0xb908d0d3, 0x31b0be8c,
+                             0x1c0def81, 0x80e14649, 0x4657b6e7, 0xf18b84d1},
+                            {0xec73b557, 0xf8acbc05, 0x2e5f0a7e, 0xf485e0eb,
+                             0x6fd516b6, 0xb7190100, 0xc1fa4e50, 0x3fee7c43}},
+                           {{0xb3ebe0e5, 0xc572866a, 0xa10be392, 0x2d6f653d,
+                             0x138bb1b6, 0x87cf70ba, 0xbbef8650, 0xe3b31829},
+                            {0x4ba31303, 0x8d1afe6e, 0xe7138780, 0x36a08173,
+                             0xcdc3182a, 0x1ecb0486, 0xd5a961a5, 0xda0e5787}}},
+                          {{{0x0b13b454, 0xa62f5fbf, 0xa4bed641, 0xd3632805,
+                             0xe8010941, 0x72cebb51, 0x8aaa0095, 0x669e804d},
+                            {0xe49b7149, 0x8fc69d31, 0x956d88ab, 0x265c926b,
+                             0x3bb2f1d4, 0xbfc206ea, 0x6f29d6da, 0x5b5065dc}},
+                           {{0x0ff0848e, 0x1f3fdf5c, 0xb3533098, 0x1a434003,
+                             0xc80d2a60, 0x4ac6aa4a, 0xc99fbca8, 0xe0ce978f},
+                            {0x3357d172, 0xf5f8a018, 0x5908b3da, 0xe540395c,
+                             0xb654a226, 0x89cef58e, 0x47786d9f, 0x5a5d41d2}},
+                           {{0x788a3989, 0x49a5f719, 0x5a0042e3, 0x92f94303,
+                             0x1bd0e6c8, 0x81c5ac15, 0xe8a05ec8, 0xbbba6ced},
+                            {0x6d17dc8e, 0xaf351b75, 0xba6e2c36, 0x2a04ea26,
+                             0x421e1737, 0x16fd0bfe, 0x4bb33376, 0x32aebf4d}}}};
+  VeryLargeInt e0 = {0x76abb18a, 0x92c0f7b9, 0x2c1a37e0, 0x7fdf6ca1,
+                     0xe3401760, 0x66eb7d52, 0x918d50a7, 0x12a65bd6};
+  VeryLargeInt e1 = {0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                     0x00000000, 0x00000000, 0x00000000, 0x80000000};
+  VeryLargeInt e2 = {0x00000001};
+  VeryLargeInt e3 = {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+                     0xffffffff, 0xffffffff, 0xffffffff, 0x0fffffff};
+  Fq12Elem b1, b2, b3;
+  Fq12Square(&b1, &pairing_out);
+  Fq12Mul(&b2, &b1, &pairing_out);
+  Fq12Conj(&b3, &pairing_out);
+  Fq12MultiExpTable table;
+  Fq12MultiExpTableInit(&table, &pairing_out, &b1, &b2, &b3);
+  Fq12Elem expected, actual;
+  Fq12MultiExp(&expected, &pairing_out, &e0, &b1, &e1, &b2, &e2, &b3, &e3);
+  Fq12MultiExpCyc(&actual, &table, &e0, &e1, &e2, &e3);
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(TinyFq12Test, Fq12MultiExpCycWorksGivenZeroPowers) {
+  Fq12Elem pairing_out = {{{{0x50ab7bc6, 0xd28d33ca, 0xa7de4ce1, 0x162996ed,
+                             0xad5ee231, 0x4fc0a501, 0x468be932, 0xba101ff6},
+                            {0x14d36207, 0x34c44c84, 0xdfa22b9e, 0x1f4d1fc0,
+                             0xcb0454f2, 0xc4077c42, 0xebde30b6, 0x15eb79f4}},
+                           {{0xf91d7519, 0xc456caad, 0xb908d0d3, 0x31b0be8c,
+                             0x1c0def81, 0x80e14649, 0x4657b6e7, 0xf18b84d1},
+                            {0xec73b557, 0xf8acbc05, 0x2e5f0a7e, 0xf485e0eb,
+                             0x6fd516b6, 0xb7190100, 0xc1fa4e50, 0x3fee7c43}},
+                           {{0xb3ebe0e5, 0xc572866a, 0xa10be392, 0x2d6f653d,
+                             0x138bb1b6, 0x87cf70ba, 0xbbef8650, 0xe3b31829},
+                            {0x4ba31303, 0x8d1afe6e, 0xe7138780, 0x36a08173,
+                             0xcdc3182a, 0x1ecb0486, 0xd5a961a5, 0xda0e5787}}},
+                          {{{0x0b13b454, 0xa62f5fbf, 0xa4bed641, 0xd3632805,
+                             0xe8010941, 0x72cebb51, 0x8aaa0095, 0x669e804d},
+                            {0xe49b7149, 0x8fc69d31, 0x956d88ab, 0x265c926b,
+                             0x3bb2f1d4, 0xbfc206ea, 0x6f29d6da, 0x5b5065dc}},
+                           {{0x0ff0848e, 0x1f3fdf5c, 0xb3533098, 0x1a434003,
+                             0xc80d2a60, 0x4ac6aa4a, 0xc99fbca8, 0xe0ce978f},
+                            {0x3357d172, 0xf5f8a018, 0x5908b3da, 0xe540395c,
+                             0xb654a226, 0x89cef58e, 0x47786d9f, 0x5a5d41d2}},
+                           {{0x788a3989, 0x49a5f719, 0x5a0042e3, 0x92f94303,
+                             0x1bd0e6c8, 0x81c5ac15, 0xe8a05ec8, 0xbbba6ced},
+                            {0x6d17dc8e, 0xaf351b75, 0xba6e2c36, 0x2a04ea26,
+                             0x421e1737, 0x16fd0bfe, 0x4bb33376, 0x32aebf4d}}}};
+  VeryLargeInt zero = {0};
+  Fq12Elem one;
+  Fq12Set(&one, 1);
+  Fq12MultiExpTable table;
+  Fq12MultiExpTableInit(&table, &pairing_out, &pairing_out, &pairing_out,
+                        &pairing_out);
+  Fq12Elem actual;
+  Fq12MultiExpCyc(&actual, &table, &zero, &zero, &zero, &zero);
+  EXPECT_EQ(one, actual);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Fq12Eq
 
@@ -957,6 +1088,129 @@ TEST(TinyFq12Test, Fq12SqCycWorks) {
   EXPECT_EQ(expected, res);
 }
 
+////////////////////////////////////////////////////////////////////////
+// Fq12SqCompressedCyc / Fq12DecompressCyc
+
+TEST(TinyFq12Test, Fq12SqCompressedCycMatchesFq12SqCyc) {
+  // an element of GT, the output of a pairing
+  const Fq12Elem gt = {
+      {{{0x50ab7bc6, 0xd28d33ca, 0xa7de4ce1, 0x162996ed, 0xad5ee231, 0x4fc0a501,
+         0x468be932, 0xba101ff6},
+        {0x14d36207, 0x34c44c84, 0xdfa22b9e, 0x1f4d1fc0, 0xcb0454f2, 0xc4077c42,
+         0xebde30b6, 0x15eb79f4}},
+       {{0xf91d7519, 0xc456caad, 0xb908d0d3, 0x31b0be8c, 0x1c0def81, 0x80e14649,
+         0x4657b6e7, 0xf18b84d1},
+        {0xec73b557, 0xf8acbc05, 0x2e5f0a7e, 0xf485e0eb, 0x6fd516b6, 0xb7190100,
+         0xc1fa4e50, 0x3fee7c43}},
+       {{0xb3ebe0e5, 0xc572866a, 0xa10be392, 0x2d6f653d, 0x138bb1b6, 0x87cf70ba,
+         0xbbef8650, 0xe3b31829},
+        {0x4ba31303, 0x8d1afe6e, 0xe7138780, 0x36a08173, 0xcdc3182a, 0x1ecb0486,
+         0xd5a961a5, 0xda0e5787}}},
+      {{{0x0b13b454, 0xa62f5fbf, 0xa4bed641, 0xd3632805, 0xe8010941, 0x72cebb51,
+         0x8aaa0095, 0x669e804d},
+        {0xe49b7149, 0x8fc69d31, 0x956d88ab, 0x265c926b, 0x3bb2f1d4, 0xbfc206ea,
+         0x6f29d6da, 0x5b5065dc}},
+       {{0x0ff0848e, 0x1f3fdf5c, 0xb3533098, 0x1a434003, 0xc80d2a60, 0x4ac6aa4a,
+         0xc99fbca8, 0xe0ce978f},
+        {0x3357d172, 0xf5f8a018, 0x5908b3da, 0xe540395c, 0xb654a226, 0x89cef58e,
+         0x47786d9f, 0x5a5d41d2}},
+       {{0x788a3989, 0x49a5f719, 0x5a0042e3, 0x92f94303, 0x1bd0e6c8, 0x81c5ac15,
+         0xe8a05ec8, 0xbbba6ced},
+        {0x6d17dc8e, 0xaf351b75, 0xba6e2c36, 0x2a04ea26, 0x421e1737, 0x16fd0bfe,
+         0x4bb33376, 0x32aebf4d}}}};
+  Fq12Elem expected[3];
+  Fq12Elem actual[3];
+  size_t i;
+  Fq12SqCyc(&expected[0], &gt);
+  Fq12SqCompressedCyc(&actual[0], &gt);
+  for (i = 1; i < 3; i++) {
+    Fq12SqCyc(&expected[i], &expected[i - 1]);
+    Fq12SqCompressedCyc(&actual[i], &actual[i - 1]);
+  }
+  Fq12DecompressCyc(actual, 3);
+  for (i = 0; i < 3; i++) {
+    EXPECT_EQ(expected[i], actual[i]);
+  }
+}
+
+TEST(TinyFq12Test, Fq12DecompressCycWorksGivenOne) {
+  Fq12Elem one;
+  Fq12Elem res;
+  Fq12Set(&one, 1);
+  Fq12Clear(&res);
+  Fq12SqCompressedCyc(&res, &one);
+  Fq12DecompressCyc(&res, 1);
+  EXPECT_EQ(one, res);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Fq12CompressCyc / Fq12MulDecompressCyc
+
+TEST(TinyFq12Test, Fq12MulDecompressCycMultipliesBySquares) {
+  // an element of GT, the output of a pairing
+  const Fq12Elem gt = {
+      {{{0x50ab7bc6, 0xd28d33ca, 0xa7de4ce1, 0x162996ed, 0xad5ee231, 0x4fc0a501,
+         0x468be932, 0xba101ff6},
+        {0x14d36207, 0x34c44c84, 0xdfa22b9e, 0x1f4d1fc0, 0xcb0454f2, 0xc4077c42,
+         0xebde30b6, 0x15eb79f4}},
+       {{0xf91d7519, 0xc456caad, 0xb908d0d3, 0x31b0be8c, 0x1c0def81, 0x80e14649,
+         0x4657b6e7, 0xf18b84d1},
+        {0xec73b557, 0xf8acbc05, 0x2e5f0a7e, 0xf485e0eb, 0x6fd516b6, 0xb7190100,
+         0xc1fa4e50, 0x3fee7c43}},
+       {{0xb3ebe0e5, 0xc572866a, 0xa10be392, 0x2d6f653d, 0x138bb1b6, 0x87cf70ba,
+         0xbbef8650, 0xe3b31829},
+        {0x4ba31303, 0x8d1afe6e, 0xe7138780, 0x36a08173, 0xcdc3182a, 0x1ecb0486,
+         0xd5a961a5, 0xda0e5787}}},
+      {{{0x0b13b454, 0xa62f5fbf, 0xa4bed641, 0xd3632805, 0xe8010941, 0x72cebb51,
+         0x8aaa0095, 0x669e804d},
+        {0xe49b7149, 0x8fc69d31, 0x956d88ab, 0x265c926b, 0x3bb2f1d4, 0xbfc206ea,
+         0x6f29d6da, 0x5b5065dc}},
+       {{0x0ff0848e, 0x1f3fdf5c, 0xb3533098, 0x1a434003, 0xc80d2a60, 0x4ac6aa4a,
+         0xc99fbca8, 0xe0ce978f},
+        {0x3357d172, 0xf5f8a018, 0x5908b3da, 0xe540395c, 0xb654a226, 0x89cef58e,
+         0x47786d9f, 0x5a5d41d2}},
+       {{0x788a3989, 0x49a5f719, 0x5a0042e3, 0x92f94303, 0x1bd0e6c8, 0x81c5ac15,
+         0xe8a05ec8, 0xbbba6ced},
+        {0x6d17dc8e, 0xaf351b75, 0xba6e2c36, 0x2a04ea26, 0x421e1737, 0x16fd0bfe,
+         0x4bb33376, 0x32aebf4d}}}};
+  Fq12Elem sq;
+  Fq12Elem expected;
+  Fq12Elem actual;
+  Fq12CompressedElem compressed[3];
+  Fq2Elem scratch[3];
+  size_t i;
+  // gt * gt^2 * gt^-4 * gt^8
+  Fq12Cp(&expected, &gt);
+  Fq12Cp(&sq, &gt);
+  for (i = 0; i < 3; i++) {
+    Fq12SqCyc(&sq, &sq);
+    if (1 == i) {
+      Fq12Conj(&sq, &sq);
+      Fq12Mul(&expected, &expected, &sq);
+      Fq12Conj(&sq, &sq);
+    } else {
+      Fq12Mul(&expected, &expected, &sq);
+    }
+  }
+  Fq12Cp(&sq, &gt);
+  for (i = 0; i < 3; i++) {
+    Fq12SqCompressedCyc(&sq, &sq);
+    Fq12CompressCyc(&compressed[i], &sq, 1 == i);
+  }
+  Fq12Cp(&actual, &gt);
+  Fq12MulDecompressCyc(&actual, compressed, scratch, 3);
+  EXPECT_EQ(expected, actual);
+}
+
+TEST(TinyFq12Test, Fq12MulDecompressCycDoesNothingGivenNoElements) {
+  Fq12Elem one;
+  Fq12Elem res;
+  Fq12Set(&one, 1);
+  Fq12Set(&res, 1);
+  Fq12MulDecompressCyc(&res, nullptr, nullptr, 0);
+  EXPECT_EQ(one, res);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Fq12MulSpecial
 
@@ -1039,6 +1293,62 @@ TEST(TinyFq12Test, Fq12MulSpecialWorks) {
   EXPECT_EQ(expected, res);
 }
 
+TEST(TinyFq12Test, Fq12MulSpecialMatchesFq12MulInPlace) {
+  const Fq12Elem left = {{{{0xbee28a1d, 0x57d6402c, 0x61cd0458, 0x194e2452,
+                            0x1c223de9, 0x6546ced9, 0xdcd0878f, 0xc55048e3},
+                           {0x6a8d5fe2, 0xfcf17083, 0xb608693b, 0x981bd9fe,
+                            0x54a9e8fa, 0x0e8250f4, 0x93430f47, 0xf862d9af}},
+                          {{0x57975e42, 0xf57416a0, 0x08a35031, 0x9d28f11c,
+                            0xa9467df1, 0x58159cfa, 0x48cb43f1, 0x7f6f1e63},
+                           {0xb6199d76, 0xf0ee74eb, 0xc2413051, 0x5ee7af00,
+                            0xed646e81, 0xa34adbc8, 0xb30cb947, 0xc256758a}},
+                          {{0xd2100f2c, 0x34bef28c, 0xe6ffd998, 0x3f8de361,
+                            0x711229db, 0x143ccdbf, 0x4fad6107, 0x35365f92},
+                           {0xea2fbf36, 0x14a160b2, 0x5051bd0f, 0x6f056434,
+                            0x2d53ef9f, 0x00d84656, 0xc8535c97, 0x23aaa4e4}}},
+                         {{{0xfa291b36, 0xdff94440, 0xc016a92d, 0xe44a0e69,
+                            0xdb2d97f6, 0xb1747475, 0x1cbc7fc4, 0x0e94ef53},
+                           {0x0ea6037c, 0x9a639210, 0xd84404c5, 0x4b8c16ef,
+                            0xfc9e6161, 0x3914ae4c, 0xd1b76423, 0x63ef638b}},
+                          {{0xfbe030a1, 0x2a114147, 0x6639fbac, 0x0349a4a5,
+                            0x5c7d47de, 0x63888f75, 0x7224cc85, 0x4c1bfeb3},
+                           {0xb214f453, 0x403afc2f, 0xa61d5e45, 0x4392c48a,
+                            0xc4f5aec3, 0xce77b85a, 0xc8d59c7e, 0xd0060196}},
+                          {{0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                            0x00000000, 0x00000000, 0x00000000, 0x00000000},
+                           {0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                            0x00000000, 0x00000000, 0x00000000, 0x00000000}}}};
+  const Fq12Elem right = {{{{0xd878f624, 0xb6e07457, 0x64c79fdf, 0x0b8cebe9,
+                             0x97be762b, 0xbc4aea64, 0xf72d75cc, 0xdc8ed85d},
+                            {0x65847e3a, 0x2a2ff0f3, 0x87af7204, 0xfb4cba91,
+                             0x0df3d736, 0x77e1a4e0, 0x138efcca, 0xc427f6ab}},
+                           {{0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                             0x00000000, 0x00000000, 0x00000000, 0x00000000},
+                            {0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                             0x00000000, 0x00000000, 0x00000000, 0x00000000}},
+                           {{0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                             0x00000000, 0x00000000, 0x00000000, 0x00000000},
+                            {0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                             0x00000000, 0x00000000, 0x00000000, 0x00000000}}},
+                          {{{0x163784b5, 0x2a7d4fd5, 0x1f5a1a18, 0xe89cba68,
+                             0xc233b435, 0xa20456c0, 0x6397ae08, 0x7b76d157},
+                            {0xb68f8337, 0x079302c1, 0x99e4326a, 0xc14686de,
+                             0x866e7108, 0x685e797e, 0x3a4b03e5, 0x9aab4042}},
+                           {{0x2cd4fe4d, 0xb4660e9a, 0xf99f415d, 0x627f9703,
+                             0x902301e4, 0xcf3c4224, 0xaca9779d, 0x917a2609},
+                            {0x9da1e8ac, 0xadb15382, 0x6d31577a, 0xcfd95901,
+                             0xf4fdf69b, 0x8ebf8ef3, 0xc15f4a65, 0x0d6458ec}},
+                           {{0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                             0x00000000, 0x00000000, 0x00000000, 0x00000000},
+                            {0x00000000, 0x00000000, 0x00000000, 0x00000000,
+                             0x00000000, 0x00000000, 0x00000000, 0x00000000}}}};
+  Fq12Elem expected;
+  Fq12Elem res = left;
+  Fq12Mul(&expected, &left, &right);
+  Fq12MulSpecial(&res, &res, &right);
+  EXPECT_EQ(expected, res);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Fq12Cp
 
@@ -16,6 +16,11 @@
 /// Unit tests of pairing implementation.
 /*! \file */
 
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "cmp-testhelper.h"
@@ -67,11 +72,73 @@ TEST(TinyPairingTest, PairingComputeWorks) {
         {0x6d17dc8e, 0xaf351b75, 0xba6e2c36, 0x2a04ea26, 0x421e1737, 0x16fd0bfe,
          0x4bb33376, 0x32aebf4d}}}};
 
-  PairingState ps;
-  PairingInit(&ps);
   Fq12Elem res = {0};
-  PairingCompute(&res, &a, &b, &ps);
+  PairingCompute(&res, &a, &b);
   EXPECT_EQ(expected, res);
 }
 
+#if defined(__linux__)
+/// Upper bound of the stack used by PairingCompute
+const size_t kPairingStackBound = 16 * 1024;
+
+/// Arguments of a pairing run on a thread of its own
+struct PairingRun {
+  EccPointFq const* a;
+  EccPointFq2 const* b;
+  Fq12Elem res;
+};
+
+void* RunPairing(void* arg) {
+  PairingRun* run = static_cast<PairingRun*>(arg);
+  PairingCompute(&run->res, run->a, run->b);
+  return nullptr;
+}
+
+void* RunNothing(void* arg) { return arg; }
+
+/// Runs a function on a thread and returns the bytes of stack it touched
+size_t GetStackUsed(void* (*fn)(void*), void* arg) {
+  const unsigned char kPaint = 0xa5;
+  std::vector<unsigned char> stack(256 * 1024, kPaint);
+  pthread_attr_t attr;
+  pthread_t thread;
+  size_t untouched = 0;
+  if (0 != pthread_attr_init(&attr)) return (size_t)-1;
+  if (0 != pthread_attr_setstack(&attr, stack.data(), stack.size()) ||
+      0 != pthread_create(&thread, &attr, fn, arg)) {
+    pthread_attr_destroy(&attr);
+    return (size_t)-1;
+  }
+  pthread_join(thread, nullptr);
+  pthread_attr_destroy(&attr);
+  // the stack grows down from the end of the buffer
+  while (untouched < stack.size() && kPaint == stack[untouched]) {
+    untouched++;
+  }
+  return stack.size() - untouched;
+}
+
+TEST(TinyPairingTest, PairingComputeStaysWithinStackBound) {
+  const EccPointFq a = {{0xf67c8483, 0xbaceaf8d, 0xfcaa5567, 0x8ac94411,
+                         0x7d91c375, 0x0fcaa603, 0x210f0997, 0xd7e2f937},
+                        {0x0f93424b, 0x88e246d6, 0x4859033f, 0x3ff08258,
+                         0xf613c944, 0xaf6cd00a, 0x9f0d2673, 0x04b7a6ff}};
+  const EccPointFq2 b = {{{0xa3c3fd4c, 0xad5323dc, 0x3770e217, 0x91a68d51,
+                           0xdcfbda35, 0x6fb2b5c1, 0xbc72b09c, 0x3f4cb52d},
+                          {0xb6f87404, 0xb8fb89d1, 0xb0c1d7f9, 0x49dff54f,
+                           0x7fb08a69, 0x5e8ef4ce, 0xcb35f350, 0x90fa4fa2}},
+                         {{0xc801fb5b, 0xfbbd005f, 0x1620b9cc, 0x444c5486,
+                           0x083e43a1, 0x80f44b97, 0x62f3175a, 0xefc66005},
+                          {0xeb618b01, 0x448994a3, 0x3aca949c, 0xdfba9b6f,
+                           0x35140ec9, 0xa2aa865a, 0xe20470eb, 0xc16e2b46}}};
+  PairingRun run = {&a, &b, {}};
+  // the thread itself keeps its control block on the stack
+  size_t overhead = GetStackUsed(RunNothing, nullptr);
+  size_t used = GetStackUsed(RunPairing, &run);
+  ASSERT_NE((size_t)-1, overhead);
+  ASSERT_NE((size_t)-1, used);
+  EXPECT_LT(used - overhead, kPairingStackBound);
+}
+#endif
+
 }  // namespace
@@ -343,4 +343,29 @@ TEST(TinySha256Test,tc_sha256_WorksGiven32768NonZeroCharsUpdated33280Times) {
       << digest << std::endl
       << expected;
 }
+
+TEST(TinySha256Test, tc_sha256_WorksGivenUnalignedSplitUpdates) {
+  const uint8_t expected[32] = {0xc2, 0xe6, 0x86, 0x82, 0x34, 0x89, 0xce, 0xd2,
+                                0x01, 0x7f, 0x60, 0x59, 0xb8, 0xb2, 0x39, 0x31,
+                                0x8b, 0x63, 0x64, 0xf6, 0xdc, 0xd8, 0x35, 0xd0,
+                                0xa5, 0x19, 0x10, 0x5a, 0x1e, 0xad, 0xd6, 0xe4};
+  // 1000 chars starting at an odd address, hashed in pieces that leave
+  // partial blocks before and after whole blocks
+  uint8_t buf[1001];
+  uint8_t* m = buf + 1;
+  uint8_t digest[32];
+  sha256_state s;
+
+  (void)memset(buf, 0x41, sizeof(buf));
+
+  tc_sha256_init(&s);
+  tc_sha256_update(&s, m, 3);
+  tc_sha256_update(&s, m + 3, 200);
+  tc_sha256_update(&s, m + 203, 128);
+  tc_sha256_update(&s, m + 331, 669);
+  tc_sha256_final(digest, &s);
+  EXPECT_TRUE(0 == memcmp(expected, digest, sizeof(digest)))
+      << digest << std::endl
+      << expected;
+}
 }  // namespace
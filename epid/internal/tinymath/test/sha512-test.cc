@@ -103,4 +103,32 @@ TEST(TinySha512Test, WorksGivenNistTestVector4) {
       << expected;
 }
 
+TEST(TinySha512Test, WorksGivenUnalignedSplitUpdates) {
+  const uint8_t expected[SHA512_DIGEST_SIZE] = {
+      0x32, 0x9c, 0x52, 0xac, 0x62, 0xd1, 0xfe, 0x73, 0x11, 0x51, 0xf2,
+      0xb8, 0x95, 0xa0, 0x04, 0x75, 0x44, 0x5e, 0xf7, 0x4f, 0x50, 0xb9,
+      0x79, 0xc6, 0xf7, 0xbb, 0x7c, 0xae, 0x34, 0x93, 0x28, 0xc1, 0xd4,
+      0xcb, 0x4f, 0x72, 0x61, 0xa0, 0xab, 0x43, 0xf9, 0x36, 0xa2, 0x4b,
+      0x00, 0x06, 0x51, 0xd4, 0xa8, 0x24, 0xfc, 0xdd, 0x57, 0x7f, 0x21,
+      0x1a, 0xef, 0x8f, 0x80, 0x6b, 0x16, 0xaf, 0xe8, 0xaf};
+  // 1000 chars starting at an odd address, hashed in pieces that leave
+  // partial blocks before and after whole blocks
+  uint8_t buf[1001];
+  uint8_t* m = buf + 1;
+  uint8_t digest[SHA512_DIGEST_SIZE];
+  sha512_state s;
+
+  (void)memset(buf, 0x41, sizeof(buf));
+
+  tinysha512_init(&s);
+  tinysha512_update(&s, m, 5);
+  tinysha512_update(&s, m + 5, 400);
+  tinysha512_update(&s, m + 405, 256);
+  tinysha512_update(&s, m + 661, 339);
+  tinysha512_final(digest, &s);
+  EXPECT_TRUE(0 == memcmp(expected, digest, sizeof(digest)))
+      << digest << std::endl
+      << expected;
+}
+
 }  // namespace
@@ -212,6 +212,19 @@ TEST(TinyVliTest, VliTestBitWorksGivenBitNumberBiggerThanVliSize) {
   EXPECT_EQ((uint32_t)1, bit_set);
 }
 
+////////////////////////////////////////////////////////////////////////
+// VliWindow
+
+TEST(TinyVliTest, VliWindowWorks) {
+  VeryLargeInt in = {0x87654321, 0x0fedcba9, 0, 0, 0, 0, 0, 0xa0000000};
+  EXPECT_EQ((uint32_t)0x1, VliWindow(&in, 0, 4));
+  EXPECT_EQ((uint32_t)0x10, VliWindow(&in, 1, 5));
+  EXPECT_EQ((uint32_t)0x98, VliWindow(&in, 28, 8));
+  EXPECT_EQ((uint32_t)0xa, VliWindow(&in, 252, 4));
+  EXPECT_EQ((uint32_t)0x5, VliWindow(&in, 253, 4));
+  EXPECT_EQ((uint32_t)0x0, VliWindow(&in, 256, 4));
+}
+
 ////////////////////////////////////////////////////////////////////////
 // VliRand
 
@@ -365,6 +378,97 @@ TEST(TinyVliTest, VliModSquareWorks) {
   EXPECT_EQ(expected, result);
 }
 
+////////////////////////////////////////////////////////////////////////
+// VliMontModMul
+
+/// q with its Montgomery constants
+const VliMontModulus kQMont = {
+    {0xAED33013, 0xD3292DDB, 0x12980A82, 0x0CDC65FB, 0xEE71A49F, 0x46E5F25E,
+     0xFFFCF0CD, 0xFFFFFFFF},
+    {0x1092B98F, 0xFAC8C610, 0xD7F91154, 0xDB90D49C, 0x32BF3141, 0x4F325FC7,
+     0x0E56A005, 0x4DE578EA},
+    0xAD6C964E0537E5E5,
+    {0xD3292DDBAED33013, 0x0CDC65FB12980A82,
+     0x46E5F25EEE71A49F, 0xFFFFFFFFFFFCF0CD},
+    {0xFAC8C6101092B98F, 0xDB90D49CD7F91154,
+     0x4F325FC732BF3141, 0x4DE578EA0E56A005}};
+
+TEST(TinyVliTest, VliMontModMulWorks) {
+  VeryLargeInt result = {0};
+  VeryLargeInt left = {0};
+  VeryLargeInt right = {0};
+  VeryLargeInt expected = {0};
+  left.word[0] = 0x10;
+  right.word[0] = 0x2;
+  expected.word[0] = 0x20;
+  VliMontModMul(&result, &left, &right, &kQMont);
+  EXPECT_EQ(expected, result);
+}
+
+TEST(TinyVliTest, VliMontModMulGivesSameResultAsVliModMul) {
+  VeryLargeInt left = {0x22cfd6a2, 0x23e82f1e, 0xd50e1450, 0xe853e88c,
+                       0xafa65357, 0x4780716c, 0xffd94b0f, 0x5e643124};
+  VeryLargeInt right = {0x848cdb73, 0x6399829e, 0xcaa20cc0, 0x1b02bff6,
+                        0x2b477bd2, 0xf9d48534, 0xff7929a0, 0xd4745161};
+  VeryLargeInt q_minus_one = kQMont.mod;
+  q_minus_one.word[0]--;
+  VeryLargeInt result = {0};
+  VeryLargeInt expected = {0};
+
+  VliModMul(&expected, &left, &right, &kQMont.mod);
+  VliMontModMul(&result, &left, &right, &kQMont);
+  EXPECT_EQ(expected, result);
+
+  VliModMul(&expected, &q_minus_one, &q_minus_one, &kQMont.mod);
+  VliMontModMul(&result, &q_minus_one, &q_minus_one, &kQMont);
+  EXPECT_EQ(expected, result);
+
+  VliModMul(&expected, &left, &q_minus_one, &kQMont.mod);
+  VliMontModMul(&left, &left, &q_minus_one, &kQMont);
+  EXPECT_EQ(expected, left);
+}
+
+////////////////////////////////////////////////////////////////////////
+// VliMontModExp
+
+TEST(TinyVliTest, VliMontModExpWorks) {
+  VeryLargeInt result = {0};
+  VeryLargeInt base = {0};
+  VeryLargeInt exp = {0};
+  VeryLargeInt expected = {0};
+  base.word[0] = 0x4;
+  exp.word[0] = 0x2;
+  expected.word[0] = 0x10;
+  VliMontModExp(&result, &base, &exp, &kQMont);
+  EXPECT_EQ(expected, result);
+}
+
+////////////////////////////////////////////////////////////////////////
+// VliMontModInv
+
+TEST(TinyVliTest, VliMontModInvWorks) {
+  VeryLargeInt a = {0x76abb18a, 0x92c0f7b9, 0x2c1a37e0, 0x7fdf6ca1,
+                    0xe3401760, 0x66eb7d52, 0x918d50a7, 0x12a65bd6};
+  VeryLargeInt expected = {0x5a686df6, 0x56b6ab63, 0xdf907c6f, 0x44ad8d51,
+                           0xa5513462, 0xc597ef78, 0x93711b39, 0x15171a1e};
+  VeryLargeInt result;
+  VliMontModInv(&result, &a, &kQMont);
+  EXPECT_EQ(result, expected);
+}
+
+////////////////////////////////////////////////////////////////////////
+// VliMontModSquare
+
+TEST(TinyVliTest, VliMontModSquareWorks) {
+  VeryLargeInt result = {0};
+  VeryLargeInt input = {0};
+  VeryLargeInt expected = {0};
+  input.word[0] = 0x4;
+  expected.word[0] = 0x10;
+  VliMontModSquare(&result, &input, &kQMont);
+  EXPECT_EQ(expected, result);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // VliModBarrettSecure
 
@@ -63,11 +63,60 @@ typedef struct MemberParams {
   size_t max_sigrl_entries;  ///< Maximum number of possible entries in SigRl
   size_t max_allowed_basenames;  ///< Maximum number of allowed base names
   size_t max_precomp_sig;        ///< Maximum number of precomputed signatures
+  size_t comb_teeth;  ///< Teeth of the comb tables of fixed points, 0 if none
+  int presig_multiexp_table;  ///< Non-zero to keep products of the
+                              ///  precomputed pairings
 } MemberParams;
 
 /// definition of join request.
 typedef void JoinRequest;
 
+/// One iteration of a loop run by a ::ParallelFor.
+/*!
+ \param[in] task_param
+ Pass through data given to the ::ParallelFor.
+ \param[in] index
+ Index of the iteration.
+
+ \returns ::EpidStatus
+ */
+typedef EpidStatus(__STDCALL* ParallelTask)(void* task_param, size_t index);
+
+/// Runs the iterations of a loop, possibly in parallel.
+/*!
+ Must call task(task_param, i) exactly once for each i from 0 to count-1
+ and return only after all calls have returned. The calls may run
+ concurrently on any threads.
+
+ \param[in] task
+ The loop body.
+ \param[in] task_param
+ Pass through data for task.
+ \param[in] count
+ Number of iterations.
+ \param[in] user_data
+ User data registered together with the function.
+
+ \returns kEpidNoErr if every call of task returned kEpidNoErr, otherwise
+ the status of one of the failed calls.
+ */
+typedef EpidStatus(__STDCALL* ParallelFor)(ParallelTask task, void* task_param,
+                                            size_t count, void* user_data);
+
+/// Receives the next piece of a signature written by EpidSignStream().
+/*!
+ \param[in] data
+ The piece of the signature. Only valid for the duration of the call.
+ \param[in] data_len
+ Size of data in bytes.
+ \param[in] user_data
+ User data registered together with the function.
+
+ \returns ::kEpidNoErr to continue signing, any other status to abort it.
+ */
+typedef EpidStatus(__STDCALL* SigSink)(void const* data, size_t data_len,
+                                       void* user_data);
+
 /// Member functionality
 /*!
   \defgroup EpidMemberModule member
@@ -189,6 +238,52 @@ EpidMemberSetMaxAllowedBasenames(size_t n, MemberParams* config);
 EpidStatus EPID_MEMBER_API
 EpidMemberSetMaxPrecomputedSigs(size_t n, MemberParams* config);
 
+/// Configures the comb tables of fixed points
+/*!
+ * Precomputed comb tables speed up exponentiations of points that are fixed
+ * once the member is provisioned, such as h2 of the group public key. A
+ * table with n teeth takes 2^(n-1) points of 64 bytes in the member context
+ * and cuts the point doublings and additions of an exponentiation to
+ * about 256/n each.
+ *
+ * \param[in] teeth
+ * The number of teeth of each table, or 0 to use no tables.
+ *
+ * \param[out] config
+ * Implementation specific configuration parameters.
+ *
+ * \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+ *
+ * \retval ::kEpidBadArgErr
+ *
+ * \retval ::kEpidBadConfigErr
+ *
+ */
+EpidStatus EPID_MEMBER_API
+EpidMemberSetFixedBaseCombTeeth(size_t teeth, MemberParams* config);
+
+/// Configures the table of products of the precomputed pairings
+/*!
+ * Each pre-computed signature raises four precomputed pairing values to
+ * random exponents. A table of the products of all subsets of the four
+ * values shares the squarings between them and makes EpidAddPreSigs()
+ * faster, but takes 16 elements of Fq12 (about 6 KB) in the member
+ * context. It is not kept unless enabled.
+ *
+ * \param[in] enable
+ * Non-zero to keep the table, 0 to use no table.
+ *
+ * \param[out] config
+ * Implementation specific configuration parameters.
+ *
+ * \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+ *
+ * \retval ::kEpidBadConfigErr
+ *
+ */
+EpidStatus EPID_MEMBER_API
+EpidMemberSetPreSigMultiExpTable(int enable, MemberParams* config);
+
 /// Computes the size in bytes required for a member context
 /*!
  \param[in] config
@@ -196,6 +291,12 @@ EpidMemberSetMaxPrecomputedSigs(size_t n, MemberParams* config);
  \param[out] context_size
  Number of bytes required for a ::MemberCtx buffer
 
+ \note
+ Storage for the SigRl, registered basenames and pre-computed signatures
+ can also be supplied later with EpidMemberSetSigRlBuffer(),
+ EpidMemberSetBasenameBuffer() and EpidMemberSetPreSigBuffer(), which
+ keeps the context small when those limits are set low.
+
  \returns ::EpidStatus
   \see EpidMemberInit
  */
@@ -326,6 +427,53 @@ EpidStatus EPID_MEMBER_API EpidProvisionKey(MemberCtx* ctx,
                                             PrivKey const* priv_key,
                                             MemberPrecomp const* precomp_str);
 
+/// Validates and pre-computes many private keys of a group at once
+/*!
+Prepares the input of EpidProvisionKey() for a batch of members of the same
+group, as done on a manufacturing line. Each private key is validated as
+EpidProvisionKey() does and its pre-computed state is written, so that
+provisioning and startup of the member do not repeat this work.
+
+The group parameters, the group public key and the part of the
+pre-computation that depends only on the group are computed once for the
+whole batch.
+
+A failure of one key does not stop the others.
+
+\note
+Calls do not share any state. A large run can be split into one batch per
+thread.
+
+\param[in] pub_key
+The group certificate of the group of the keys.
+\param[in] priv_keys
+Private keys to validate.
+\param[in] count
+Number of entries in priv_keys, precomps and results.
+\param[out] precomps
+Pre-computed state for each key, to be passed as precomp_str to
+EpidProvisionKey(). Zeroed for keys that failed.
+\param[out] results
+Status of each key.
+
+\returns ::EpidStatus
+
+\retval ::kEpidNoErr
+Every key was validated and pre-computed.
+\retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+\note
+If a failure is not specific to a key no key is processed and results are
+undefined. Otherwise the status of one of the failed keys is returned.
+
+\see EpidProvisionKey
+*/
+EpidStatus EPID_MEMBER_API EpidPrepareProvisionKeys(GroupPubKey const* pub_key,
+                                                    PrivKey const* priv_keys,
+                                                    size_t count,
+                                                    MemberPrecomp* precomps,
+                                                    EpidStatus* results);
+
 /// Change member from setup state to normal operation
 /*!
 \param[in,out] ctx
@@ -455,6 +603,116 @@ EpidStatus EPID_MEMBER_API EpidMemberSetSigRl(MemberCtx* ctx,
                                               SigRl const* sig_rl,
                                               size_t sig_rl_size);
 
+/// Appends new entries to the signature based revocation list of a member.
+/*!
+ Revocation lists only grow: a newer version keeps all the entries of the
+ previous one and appends new ones. Instead of setting the whole new list
+ with EpidMemberSetSigRl(), only the difference can be passed.
+
+ sig_rl_delta has the layout of a ::SigRl. Its gid must be the gid of the
+ group, its version the version of the updated list, which must be newer
+ than the version currently set, and its n2 and bk the entries added by
+ that version.
+
+ The caller is responsible for ensuring the update is authorized and that
+ it applies to the list currently set.
+
+ Unlike EpidMemberSetSigRl() the memory pointed to by sig_rl_delta is not
+ accessed after the call returns. The updated list is kept by the member.
+
+ \param[in] ctx
+ The member context. A signature based revocation list must already be
+ set.
+ \param[in] sig_rl_delta
+ The entries to append and the new version.
+ \param[in] sig_rl_delta_size
+ The size of sig_rl_delta in bytes.
+
+ \returns ::EpidStatus
+
+ \retval ::kEpidOutOfSequenceError
+ No signature based revocation list is set.
+ \retval ::kEpidVersionMismatchErr
+ The version of sig_rl_delta is not newer than the one set.
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \note
+ If the result is not ::kEpidNoErr the signature based revocation list used
+ by the member is not changed.
+
+ \see EpidMemberSetSigRl
+ */
+EpidStatus EPID_MEMBER_API EpidMemberUpdateSigRl(MemberCtx* ctx,
+                                                 SigRl const* sig_rl_delta,
+                                                 size_t sig_rl_delta_size);
+
+/// Sets the signature based revocation list without copying it.
+/*!
+ Behaves like EpidMemberSetSigRl() but the member keeps using the memory
+ pointed to by sig_rl instead of a copy, whatever storage was configured.
+ The list is not limited by the maximum number of SigRl entries of the
+ member, so a large list can be used in place, e.g. from a memory mapped
+ file or flash.
+
+ \attention
+ The memory pointed to by sig_rl is accessed directly by the member
+ until a new list is set or the member is destroyed. Do not modify the
+ contents of this memory.
+
+ \param[in] ctx
+ The member context.
+ \param[in] sig_rl
+ The signature based revocation list.
+ \param[in] sig_rl_size
+ The size of the signature based revocation list in bytes.
+
+ \returns ::EpidStatus
+
+ \note
+ Implementations that keep a bounded copy of the list, such as the tiny
+ member, do not extend a list set by reference with
+ EpidMemberUpdateSigRl(); it returns ::kEpidOperationNotSupportedErr.
+
+ \see EpidMemberSetSigRl
+ */
+EpidStatus EPID_MEMBER_API EpidMemberSetSigRlByReference(MemberCtx* ctx,
+                                                         SigRl const* sig_rl,
+                                                         size_t sig_rl_size);
+
+/// Moves the storage of the member's copy of the SigRl to a caller buffer.
+/*!
+ By default EpidMemberSetSigRl() and EpidMemberUpdateSigRl() keep the list
+ in the member context, sized for the maximum number of SigRl entries the
+ member was initialized with. Afterwards they use buffer instead, which
+ can hold as many entries as fit into buffer_size, i.e. a buffer of
+ sizeof(SigRl) - sizeof(SigRlEntry) + n * sizeof(SigRlEntry) bytes holds
+ n entries. A list already copied by the member is moved to buffer.
+
+ Call again with a larger buffer to let the list grow. The previous buffer
+ is no longer accessed once the call returns.
+
+ \param[in,out] ctx
+ The member context.
+ \param[in] buffer
+ Storage for the list. It must be aligned for any type, e.g. allocated
+ with malloc(), and remain valid until another buffer is set or the
+ member is destroyed.
+ \param[in] buffer_size
+ Size of buffer in bytes.
+
+ \returns ::EpidStatus
+
+ \retval ::kEpidBadArgErr
+ buffer cannot hold the list currently held by the member.
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see EpidMemberSetSigRl
+ \see EpidMemberUpdateSigRl
+ */
+EpidStatus EPID_MEMBER_API EpidMemberSetSigRlBuffer(MemberCtx* ctx,
+                                                    void* buffer,
+                                                    size_t buffer_size);
+
 /// Computes the size in bytes required for an Intel(R) EPID signature.
 /*!
  The caller is responsible for ensuring the revocation list is authorized,
@@ -516,6 +774,50 @@ EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
                                     size_t basename_len, EpidSignature* sig,
                                     size_t sig_len);
 
+/// Writes an Intel(R) EPID signature piece by piece.
+/*!
+ Produces the same signature as EpidSign() but, instead of filling a
+ buffer of EpidGetSigSize() bytes, hands it to sink as it is computed:
+ first the part preceding the non-revoked proofs, then each non-revoked
+ proof in SigRl order. The pieces concatenated in the order received form
+ the signature. Memory use does not depend on the size of the SigRl.
+
+ \param[in] ctx
+ The member context.
+ \param[in] msg
+ The message to sign.
+ \param[in] msg_len
+ The length in bytes of message.
+ \param[in] basename
+ Optional basename. If basename is NULL a random basename is used. If a
+ basename is provided, it must already be registered, or
+ ::kEpidBadArgErr is returned.
+ \param[in] basename_len
+ The size of basename in bytes. Must be 0 if basename is NULL.
+ \param[in] sink
+ The function receiving the pieces of the signature.
+ \param[in] user_data
+ Pass through data for sink.
+
+ \returns ::EpidStatus
+
+ \retval ::kEpidSigRevokedInSigRl
+ A non-revoked proof failed. All pieces were still passed to sink.
+
+ \note
+ If sink returns a status other than ::kEpidNoErr signing stops and that
+ status is returned. In this case, or if the result is not ::kEpidNoErr, the
+ pieces already received do not form a valid signature.
+
+ \see EpidSign
+ \see EpidMemberSetSigRl
+ */
+EpidStatus EPID_MEMBER_API EpidSignStream(MemberCtx const* ctx,
+                                          void const* msg, size_t msg_len,
+                                          void const* basename,
+                                          size_t basename_len, SigSink sink,
+                                          void* user_data);
+
 /// Registers a basename with a member.
 /*!
 
@@ -568,6 +870,58 @@ EpidStatus EPID_MEMBER_API EpidRegisterBasename(MemberCtx* ctx,
  */
 EpidStatus EPID_MEMBER_API EpidClearRegisteredBasenames(MemberCtx* ctx);
 
+/// Computes the size of a buffer for registered basenames.
+/*!
+ \param[in] ctx
+ The member context.
+ \param[in] number_basenames
+ Number of basenames the buffer must hold.
+ \param[out] buffer_size
+ Number of bytes required for the buffer.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidMemberSetBasenameBuffer
+ */
+EpidStatus EPID_MEMBER_API EpidGetBasenameBufferSize(MemberCtx const* ctx,
+                                                     size_t number_basenames,
+                                                     size_t* buffer_size);
+
+/// Moves the registered basenames to a caller buffer.
+/*!
+ By default basenames are registered in the member context, up to the
+ maximum number of allowed basenames the member was initialized with.
+ Afterwards EpidRegisterBasename() uses buffer instead, which holds as
+ many basenames as fit into buffer_size. Basenames already registered are
+ moved to buffer.
+
+ Call again with a larger buffer to register more basenames. The previous
+ buffer is no longer accessed once the call returns.
+
+ \param[in,out] ctx
+ The member context.
+ \param[in] buffer
+ Storage for the basenames. It must be aligned for any type, e.g.
+ allocated with malloc(), and remain valid until another buffer is set or
+ the member is destroyed.
+ \param[in] buffer_size
+ Size of buffer in bytes.
+
+ \returns ::EpidStatus
+
+ \retval ::kEpidBadArgErr
+ buffer cannot hold the basenames already registered.
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidGetBasenameBufferSize
+ \see ::EpidRegisterBasename
+ */
+EpidStatus EPID_MEMBER_API EpidMemberSetBasenameBuffer(MemberCtx* ctx,
+                                                       void* buffer,
+                                                       size_t buffer_size);
+
 /// Extends the member's pool of pre-computed signatures.
 /*!
   Generate new pre-computed signatures and add them to the internal pool.
@@ -579,6 +933,11 @@ EpidStatus EPID_MEMBER_API EpidClearRegisteredBasenames(MemberCtx* ctx);
 
  \returns ::EpidStatus
 
+ \note
+ The tiny member lets one thread call EpidAddPreSigs() while another
+ thread calls EpidSign() or EpidGetNumPreSigs(), e.g. to refill the pool
+ in the background. See EpidRefillPreSigs() for the details.
+
  \see ::EpidMemberInit
  */
 EpidStatus EPID_MEMBER_API EpidAddPreSigs(MemberCtx* ctx,
@@ -596,6 +955,277 @@ EpidStatus EPID_MEMBER_API EpidAddPreSigs(MemberCtx* ctx,
 */
 size_t EPID_MEMBER_API EpidGetNumPreSigs(MemberCtx const* ctx);
 
+/// Configures automatic refilling of the member's pre-computed signature pool.
+/*!
+ Once the number of pre-computed signatures in the pool drops to
+ low_watermark or below, EpidRefillPreSigs() adds new ones until the pool
+ holds high_watermark of them.
+
+ Pass 0 for both watermarks to disable refilling. A pool with a fixed
+ capacity, like the one of the tiny member, is refilled at most until it
+ is full.
+
+ \param[in,out] ctx
+ The member context.
+ \param[in] low_watermark
+ Pool size at or below which refilling starts.
+ \param[in] high_watermark
+ Pool size at which refilling stops. Must be greater than low_watermark
+ unless both are 0.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidRefillPreSigs
+ */
+EpidStatus EPID_MEMBER_API EpidSetPreSigWatermarks(MemberCtx* ctx,
+                                                   size_t low_watermark,
+                                                   size_t high_watermark);
+
+/// Tops up the member's pre-computed signature pool.
+/*!
+ Adds pre-computed signatures according to the watermarks configured with
+ EpidSetPreSigWatermarks(). Does nothing if refilling is disabled or the
+ pool has not yet dropped to the low watermark.
+
+ Computing a pre-computed signature takes about as long as signing. Calling
+ this function while the member is otherwise idle moves that work out of
+ EpidSign(). The work can be split into short steps by limiting the number
+ of pre-computed signatures added per call.
+
+ The tiny member keeps its pool in a ring with one producer and one
+ consumer. One thread can call this function, e.g. in a loop on a worker
+ thread, while another thread calls EpidSign(), EpidGetNumPreSigs() and
+ EpidGetPreSigStats(). EpidSign() then takes pre-computed signatures
+ without waiting for new ones to be computed. The random number generator
+ of the member is called from both threads and must be thread safe. No
+ other calls may overlap with either thread.
+
+ \warning
+ The split member makes a TPM commit for every pre-computed signature
+ and EpidSign() uses the same TPM, and its pool grows by moving to a new
+ buffer. For the split member this function must be serialized with all
+ other calls using the same member context, e.g. called while the member
+ is otherwise idle.
+
+ \param[in,out] ctx
+ The member context.
+ \param[in] max_number_presigs
+ Maximum number of pre-computed signatures to add in this call. Pass 0 to
+ refill up to the high watermark.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidSetPreSigWatermarks
+ \see ::EpidAddPreSigs
+ */
+EpidStatus EPID_MEMBER_API EpidRefillPreSigs(MemberCtx* ctx,
+                                             size_t max_number_presigs);
+
+/// Gets the usage counters of the member's pre-computed signature pool.
+/*!
+ \param[in] ctx
+ The member context.
+ \param[out] hits
+ Number of signatures that used a pre-computed signature from the pool.
+ \param[out] misses
+ Number of signatures that had to compute a pre-computed signature
+ because the pool was empty.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidRefillPreSigs
+ */
+EpidStatus EPID_MEMBER_API EpidGetPreSigStats(MemberCtx const* ctx,
+                                              size_t* hits, size_t* misses);
+
+/// Computes the size of a store for pre-computed signatures.
+/*!
+ \param[in] ctx
+ The member context.
+ \param[in] number_presigs
+ Number of pre-computed signatures the store must hold. Use
+ EpidGetNumPreSigs() to size a store for EpidExportPreSigs().
+ \param[out] store_size
+ Number of bytes required for the store.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidExportPreSigs
+ */
+EpidStatus EPID_MEMBER_API EpidGetPreSigStoreSize(MemberCtx const* ctx,
+                                                  size_t number_presigs,
+                                                  size_t* store_size);
+
+/// Moves the member's pre-computed signatures into a store.
+/*!
+ Writes all pre-computed signatures of the pool to store and removes them
+ from the pool, so that a restarted member can take them back with
+ EpidImportPreSigs() instead of computing new ones. The store can be a
+ memory mapped file.
+
+ The store begins with a header bound to the group and the member key,
+ followed by a bitmap of used entries and the entries. Every entry is
+ encrypted, and the header and every encrypted entry are authenticated,
+ with keys derived from the member private key.
+
+ \warning
+ The store does not
+ protect against being replaced with an earlier copy of itself. A
+ pre-computed signature used twice exposes the member private key.
+
+ \param[in,out] ctx
+ The member context.
+ \param[out] store
+ Buffer receiving the store.
+ \param[in] store_size
+ Size of store in bytes. Must be at least the size computed by
+ EpidGetPreSigStoreSize() for EpidGetNumPreSigs() entries.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidGetPreSigStoreSize
+ \see ::EpidImportPreSigs
+ */
+EpidStatus EPID_MEMBER_API EpidExportPreSigs(MemberCtx* ctx, void* store,
+                                             size_t store_size);
+
+/// Moves unused pre-computed signatures from a store into the member's pool.
+/*!
+ Checks the header of a store written by EpidExportPreSigs() and adds its
+ unused entries to the pool until the pool is full. Each entry is marked
+ used in the store before it is added, so no entry is ever added twice,
+ even if the member stops before the store is written back. Entries that
+ fail authentication are marked used and skipped.
+
+ \param[in,out] ctx
+ The member context.
+ \param[in,out] store
+ The store. The used bitmap is updated in place.
+ \param[in] store_size
+ Size of store in bytes.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidExportPreSigs
+ */
+EpidStatus EPID_MEMBER_API EpidImportPreSigs(MemberCtx* ctx, void* store,
+                                             size_t store_size);
+
+/// Computes the size of a buffer for the pre-computed signature pool.
+/*!
+ \param[in] ctx
+ The member context.
+ \param[in] number_presigs
+ Number of pre-computed signatures the buffer must hold.
+ \param[out] buffer_size
+ Number of bytes required for the buffer.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidMemberSetPreSigBuffer
+ */
+EpidStatus EPID_MEMBER_API EpidGetPreSigBufferSize(MemberCtx const* ctx,
+                                                   size_t number_presigs,
+                                                   size_t* buffer_size);
+
+/// Moves the pre-computed signature pool to a caller buffer.
+/*!
+ By default the pool is kept in the member context and holds the maximum
+ number of pre-computed signatures the member was initialized with.
+ Afterwards the pool uses buffer instead, which holds as many
+ pre-computed signatures as fit into buffer_size. Pre-computed signatures
+ already in the pool are moved to buffer and cleared from the previous
+ storage.
+
+ Call again with a larger buffer to let the pool grow. The previous
+ buffer is no longer accessed once the call returns.
+
+ \warning
+ The buffer receives the secret values of the pre-computed signatures and
+ must be protected like the member private key.
+
+ \param[in,out] ctx
+ The member context.
+ \param[in] buffer
+ Storage for the pool. It must be aligned for any type, e.g. allocated
+ with malloc(), and remain valid until another buffer is set or the
+ member is destroyed. It can only be the storage already in use if the
+ pool is empty.
+ \param[in] buffer_size
+ Size of buffer in bytes. Must hold at least one pre-computed signature.
+
+ \returns ::EpidStatus
+
+ \retval ::kEpidBadArgErr
+ buffer cannot hold the pre-computed signatures already in the pool, or
+ it is the storage in use and the pool is not empty.
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidGetPreSigBufferSize
+ \see ::EpidAddPreSigs
+ */
+EpidStatus EPID_MEMBER_API EpidMemberSetPreSigBuffer(MemberCtx* ctx,
+                                                     void* buffer,
+                                                     size_t buffer_size);
+
+/// Lets the member run independent computations in parallel.
+/*!
+ Once a ::ParallelFor is set, the member hands loops of independent
+ computations to it instead of running them one after another. Which
+ loops depend on the implementation:
+
+ - A member that computes the non-revoked proofs of EpidSign() on its own
+   hands over the proofs, one per SigRl entry. Each proof is still written
+   to its own slot of the signature and EpidSign() still returns
+   kEpidSigRevokedInSigRl if any of them fails. If a proof cannot be
+   computed, the error of the first such entry in SigRl order is returned
+   instead, as without a ::ParallelFor.
+ - A member that computes the non-revoked proofs with a TPM, which runs
+   one command at a time, still computes them in sequence. EpidAddPreSigs()
+   makes the TPM commits of the new pre-computed signatures in sequence and
+   hands over the rest of their computation in up to eight iterations. The
+   member keeps the state set up by each iteration for later calls.
+
+ The library does not create threads itself. The function supplied is
+ expected to run the iterations on threads owned by the caller.
+
+ \warning
+ While the loop runs the random number generator of the member is called
+ concurrently and must be thread safe.
+
+ \param[in,out] ctx
+ The member context.
+ \param[in] parallel_for
+ The function running the iterations. Pass NULL to compute everything
+ sequentially.
+ \param[in] user_data
+ Pass through data for parallel_for.
+
+ \returns ::EpidStatus
+
+ \retval kEpidOperationNotSupportedErr  Not supported by this implementation
+
+ \see ::EpidSign
+ \see ::EpidAddPreSigs
+ */
+EpidStatus EPID_MEMBER_API EpidMemberSetParallelFor(MemberCtx* ctx,
+                                                    ParallelFor parallel_for,
+                                                    void* user_data);
+
 /// Decompresses compressed member private key.
 /*!
 
@@ -619,6 +1249,49 @@ EpidStatus EPID_MEMBER_API EpidDecompressPrivKey(
     GroupPubKey const* pub_key, CompressedPrivKey const* compressed_privkey,
     PrivKey* priv_key);
 
+/// Decompresses many compressed member private keys of a group at once.
+/*!
+
+  Gives the same keys as calling EpidDecompressPrivKey() for each
+  compressed key, as done when processing a key file. The group
+  parameters, the group public key and the pairing lines of g2 are
+  computed once for the whole batch.
+
+  A failure of one key does not stop the others.
+
+  \note
+  Each key still costs two pairings, so batching mostly saves the group
+  setup. No random source is used: slices of a key file give the same
+  keys whether they are decompressed by one call or by several calls in
+  any order.
+
+  \param[in] pub_key
+  The public key of the group of the keys.
+  \param[in] compressed_privkeys
+  The compressed member private keys to be decompressed.
+  \param[in] count
+  Number of entries in compressed_privkeys, priv_keys and results.
+  \param[out] priv_keys
+  The member private keys. Zeroed for keys that failed.
+  \param[out] results
+  Status of each key.
+
+  \returns ::EpidStatus
+
+  \retval ::kEpidNoErr
+  Every key was decompressed.
+
+  \note
+  If a failure is not specific to a key no key is processed and results
+  are undefined. Otherwise the status of one of the failed keys is
+  returned.
+
+  \see EpidDecompressPrivKey
+ */
+EpidStatus EPID_MEMBER_API EpidDecompressPrivKeys(
+    GroupPubKey const* pub_key, CompressedPrivKey const* compressed_privkeys,
+    size_t count, PrivKey* priv_keys, EpidStatus* results);
+
 /*! @} */
 
 #ifdef __cplusplus
@@ -23,6 +23,7 @@
 #include <epid/member/api.h>
 
 #include <stddef.h>
+#include "common/ring.h"
 #include "epid/bitsupplier.h"
 #include "epid/errors.h"
 #include "epid/stdtypes.h"
@@ -33,11 +34,14 @@ typedef struct Tpm2Ctx Tpm2Ctx;
 typedef struct Tpm2Key Tpm2Key;
 typedef struct Epid2Params_ Epid2Params_;
 typedef struct AllowedBasenames AllowedBasenames;
-typedef struct Stack Stack;
+typedef struct PreSigWorker PreSigWorker;
 typedef struct EcPoint EcPoint;
 typedef struct FfElement FfElement;
 /// \endcond
 
+/// Maximum number of tasks a parallel EpidAddPreSigs is split into
+#define MAX_PRESIG_TASKS 8
+
 /// Member context definition
 struct MemberCtx {
   Epid2Params_* epid2_params;  ///< Intel(R) EPID 2.0 params
@@ -47,6 +51,8 @@ struct MemberCtx {
   BitSupplier rnd_func;        ///< Pseudo random number generation function
   void* rnd_param;             ///< Pointer to user context for rnd_func
   SigRl const* sig_rl;         ///< Signature based revocation list - not owned
+  SigRl* updated_sig_rl;       ///< Signature based revocation list grown by
+                               ///  EpidMemberUpdateSigRl - owned
   AllowedBasenames* allowed_basenames;  ///< Base name list
   MembershipCredential credential;      ///< Membership credential
   Tpm2Key* f_handle;      ///< Handle to private f used for signing
@@ -62,7 +68,16 @@ struct MemberCtx {
   FfElement const* e22;   ///< an element in GT, = pairing (h2, g2)
   FfElement const* e2w;   ///< an element in GT, = pairing (h2, w)
   FfElement const* ea2;   ///< an element in GT, = pairing (g1, g2)
-  Stack* presigs;         ///< Pre-computed signature pool
+  Ring presigs;           ///< Pre-computed signature pool
+  size_t presig_low_watermark;   ///< Pool size at which refilling starts
+  size_t presig_high_watermark;  ///< Pool size at which refilling stops
+  bool is_presig_refilling;      ///< Pool is being refilled
+  size_t presig_hits;    ///< Number of presigs taken from the pool
+  size_t presig_misses;  ///< Number of presigs computed on an empty pool
+  ParallelFor parallel_for;  ///< Runs presig computations, can be NULL
+  void* parallel_for_param;  ///< Pointer to user context for parallel_for
+  PreSigWorker* presig_workers[MAX_PRESIG_TASKS];  ///< State of each task
+                                                   ///  of EpidAddPreSigs
 };
 
 /// Pre-computed signature.
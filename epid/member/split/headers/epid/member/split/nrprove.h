@@ -26,6 +26,7 @@ typedef struct MemberCtx MemberCtx;
 typedef struct BasicSignature BasicSignature;
 typedef struct SigRlEntry SigRlEntry;
 typedef struct SplitNrProof SplitNrProof;
+typedef struct NrProveState NrProveState;
 /// \endcond
 
 /// Calculates a non-revoked proof for a single signature based revocation
@@ -68,4 +69,110 @@ EpidStatus EpidNrProve(MemberCtx const* ctx, void const* msg, size_t msg_len,
                        BasicSignature const* sig, SigRlEntry const* sigrl_entry,
                        SplitNrProof* proof);
 
+/// Calculates non-revoked proofs for several signature based revocation
+/// list entries.
+/*!
+ Gives the same proofs as calling EpidNrProve() for each entry, but hashes
+ the basename, reads K and prepares the commitment hash input only once.
+
+ A proof is produced for every entry even if some of them fail.
+
+ \param[in] ctx
+ The member context.
+ \param[in] msg
+ The message.
+ \param[in] msg_len
+ The length of message in bytes.
+ \param[in] basename
+ The basename used in EpidSplitSignBasic.
+ \param[in] basename_len
+ The length of the basename.
+ \param[in] sig
+ The basic signature.
+ \param[in] sigrl_entries
+ The signature based revocation list entries.
+ \param[in] num_entries
+ The number of entries in sigrl_entries and proofs.
+ \param[out] proofs
+ The generated non-revoked proofs, one per entry.
+
+ \returns ::EpidStatus
+
+ \retval ::kEpidSigRevokedInSigRl
+ One of the proofs shows that the member is revoked.
+
+ \see EpidNrProve
+ */
+EpidStatus EpidNrProveBatch(MemberCtx const* ctx, void const* msg,
+                            size_t msg_len, void const* basename,
+                            size_t basename_len, BasicSignature const* sig,
+                            SigRlEntry const* sigrl_entries, size_t num_entries,
+                            SplitNrProof* proofs);
+
+/// Prepares the non-revoked proofs of a signature.
+/*!
+ Hashes the basename, reads K and prepares the commitment hash input once,
+ so that the proofs of a SigRl can be computed one entry at a time with
+ EpidNrProveEntry() without holding the whole SigRl.
+
+ \param[in] ctx
+ The member context.
+ \param[in] msg
+ The message.
+ \param[in] msg_len
+ The length of message in bytes.
+ \param[in] basename
+ The basename used in EpidSplitSignBasic.
+ \param[in] basename_len
+ The length of the basename.
+ \param[in] sig
+ The basic signature.
+ \param[out] state
+ Newly constructed state. It refers to ctx, msg and sig, which must stay
+ valid until the state is deleted.
+
+ \returns ::EpidStatus
+
+ \see EpidNrProveEntry
+ \see DeleteNrProveState
+ */
+EpidStatus NewNrProveState(MemberCtx const* ctx, void const* msg,
+                           size_t msg_len, void const* basename,
+                           size_t basename_len, BasicSignature const* sig,
+                           NrProveState** state);
+
+/// Calculates the non-revoked proof for the next SigRl entry.
+/*!
+ Gives the same proof as EpidNrProve() for the message, basename and
+ signature the state was created with.
+
+ \param[in] ctx
+ The member context the state was created with.
+ \param[in,out] state
+ The state created by NewNrProveState().
+ \param[in] sigrl_entry
+ The signature based revocation list entry.
+ \param[out] proof
+ The generated non-revoked proof.
+
+ \returns ::EpidStatus
+
+ \retval ::kEpidSigRevokedInSigRl
+ The proof shows that the member is revoked.
+
+ \see NewNrProveState
+ */
+EpidStatus EpidNrProveEntry(MemberCtx const* ctx, NrProveState* state,
+                            SigRlEntry const* sigrl_entry,
+                            SplitNrProof* proof);
+
+/// Deletes a state created by NewNrProveState().
+/*!
+ \param[in,out] state
+ The state. Set to NULL on return.
+
+ \see NewNrProveState
+ */
+void DeleteNrProveState(NrProveState** state);
+
 #endif  // EPID_MEMBER_SPLIT_SRC_NRPROVE_H_
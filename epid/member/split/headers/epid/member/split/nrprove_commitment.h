@@ -29,6 +29,9 @@ typedef struct SigRlEntry SigRlEntry;
 typedef struct NrProveCommitOutput NrProveCommitOutput;
 /// \endcond
 
+/// Commitment values shared by all non-revoked proofs of a signature
+typedef struct NrProveCommitment NrProveCommitment;
+
 #pragma pack(1)
 /// Result of NrProve Commit
 typedef struct NrProveCommitOutput {
@@ -79,4 +82,75 @@ EpidStatus HashNrProveCommitment(FiniteField* Fp, HashAlg hash_alg,
                                  void const* msg, size_t msg_len,
                                  FpElemStr* c_str);
 
+/// Prepares the commitment values shared by the proofs of a signature
+/*!
+
+  Fills in p, g1, B, K and the message once, so that computing the
+  commitment hash of each proof only sets the values of its SigRl entry.
+
+  \param[in] B_str
+  The B value from the ::BasicSignature.
+
+  \param[in] K_str
+  The K value from the ::BasicSignature.
+
+  \param[in] msg
+  The message.
+
+  \param[in] msg_len
+  The size of message in bytes.
+
+  \param[out] commitment
+  Newly constructed commitment values.
+
+  \returns ::EpidStatus
+
+  \see DeleteNrProveCommitment
+  \see HashNrProveCommitmentEntry
+ */
+EpidStatus NewNrProveCommitment(G1ElemStr const* B_str, G1ElemStr const* K_str,
+                                void const* msg, size_t msg_len,
+                                NrProveCommitment** commitment);
+
+/// Frees commitment values created by NewNrProveCommitment
+/*!
+  \param[in,out] commitment
+  The commitment values. Can be NULL. Nulls the pointer.
+ */
+void DeleteNrProveCommitment(NrProveCommitment** commitment);
+
+/// Calculates commitment hash of NrProve commit using prepared values
+/*!
+
+  Gives the same result as HashNrProveCommitment().
+
+  \param[in] Fp
+  The finite field.
+
+  \param[in] hash_alg
+  The hash algorithm.
+
+  \param[in,out] commitment
+  The commitment values of the signature.
+
+  \param[in] sigrl_entry
+  The signature based revocation list entry corresponding to this
+  proof.
+
+  \param[in] commit_out
+  The output from the NrProve commit.
+
+  \param[out] c_str
+  The resulting commitment hash.
+
+  \returns ::EpidStatus
+
+  \see NewNrProveCommitment
+ */
+EpidStatus HashNrProveCommitmentEntry(FiniteField* Fp, HashAlg hash_alg,
+                                      NrProveCommitment* commitment,
+                                      SigRlEntry const* sigrl_entry,
+                                      NrProveCommitOutput const* commit_out,
+                                      FpElemStr* c_str);
+
 #endif  // EPID_MEMBER_SPLIT_SRC_NRPROVE_COMMITMENT_H_
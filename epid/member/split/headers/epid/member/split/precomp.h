@@ -56,4 +56,53 @@ EpidStatus PrecomputeMemberPairing(Epid2Params_ const* epid2_params,
                                    G1ElemStr const* A_str,
                                    MemberPrecomp* precomp);
 
+/// Precomputes the pairing values shared by all members of a group
+/*!
+
+  Of the values computed by PrecomputeMemberPairing() only ea2 depends on
+  the member private key. When several members of the same group are
+  precomputed, e12, e22 and e2w can be computed once by this function and
+  ea2 by PrecomputeMemberPairingA() for each member.
+
+  \param[in] epid2_params
+  The field and group parameters.
+
+  \param[in] pub_key
+  The public key of the group.
+
+  \param[in,out] precomp
+  The member pre-computed data. ea2 is not written.
+
+  \returns ::EpidStatus
+
+  \see PrecomputeMemberPairing
+  \see PrecomputeMemberPairingA
+
+ */
+EpidStatus PrecomputeGroupPairing(Epid2Params_ const* epid2_params,
+                                  GroupPubKey const* pub_key,
+                                  MemberPrecomp* precomp);
+
+/// Precomputes the pairing value of a member that depends on A
+/*!
+
+  \param[in] epid2_params
+  The field and group parameters.
+
+  \param[in] A_str
+  The A value of the member private key.
+
+  \param[in,out] precomp
+  The member pre-computed data. Only ea2 is written.
+
+  \returns ::EpidStatus
+
+  \see PrecomputeMemberPairing
+  \see PrecomputeGroupPairing
+
+ */
+EpidStatus PrecomputeMemberPairingA(Epid2Params_ const* epid2_params,
+                                    G1ElemStr const* A_str,
+                                    MemberPrecomp* precomp);
+
 #endif  // EPID_MEMBER_SPLIT_SRC_PRECOMP_H_
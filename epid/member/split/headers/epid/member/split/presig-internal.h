@@ -24,29 +24,63 @@
 /// \cond
 typedef struct MemberCtx MemberCtx;
 typedef struct PreComputedSignature PreComputedSignature;
+typedef struct PreSigWorker PreSigWorker;
 /// \endcond
 
 /// Provides a precomputed signature
 /*!
 
-  Provides and removes a pre-computed signatures from members's pool if
-  available, otherwise provides a newly calculated a precomputed
-  signature.
+  Provides the oldest pre-computed signature of the member's pool in
+  place if available, otherwise computes a new one into scratch.
 
   \warning
   Pre-computed signatures must not be accessed outside of the secure
   boundary.
 
+  \warning
+  You must call MemberPopPreSig() immediately after using the pre-
+  computed signature provided by this function or you risk exposing
+  the member private key.
+
   \param[in,out] ctx
   The member context.
 
+  \param[out] scratch
+  Storage for a pre-computed signature computed because the pool is
+  empty.
+
   \param[out] presig
-  The pre-computed signature removed from members's pool
+  The oldest pre-computed signature in members's pool, or scratch
 
   \returns ::EpidStatus
 
+  \see MemberPopPreSig
+ */
+EpidStatus MemberTopPreSig(MemberCtx* ctx, PreComputedSignature* scratch,
+                           PreComputedSignature** presig);
+
+/// Consumes a precomputed signature
+/*!
+
+  Removes a pre-computed signature from the member's pool and clears it.
+
+  \param[in,out] ctx
+  The member context.
+
+  \param[in,out] presig
+  The pre-computed signature provided by MemberTopPreSig()
+
+  \returns ::EpidStatus
+
+ */
+EpidStatus MemberPopPreSig(MemberCtx* ctx, PreComputedSignature* presig);
+
+/// Frees the state of a task of a parallel EpidAddPreSigs
+/*!
+  \param[in,out] worker
+  The state to free. Set to NULL.
  */
-EpidStatus MemberGetPreSig(MemberCtx* ctx, PreComputedSignature* presig);
+void DeletePreSigWorker(PreSigWorker** worker);
 
 ///@}
 /*! @} */
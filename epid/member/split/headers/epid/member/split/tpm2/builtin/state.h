@@ -33,13 +33,19 @@ typedef struct FfElement FfElement;
 #define MAX_NV_NUMBER 10
 /// Minimal possible NV index in TPM
 #define MIN_NV_INDEX 0x01000000
+/// Number of Tpm2Commit random values that can exist in memory
+/// simultaneously in addition to the configured precomputed signatures
+#define DEFAULT_COMMIT_COUNT 100
 /// Maximum number of Tpm2Commit random values that can exist in memory
 /// simultaneously
-#define MAX_COMMIT_COUNT 100
+#define MAX_COMMIT_COUNT UINT16_MAX
 
-#if (MAX_COMMIT_COUNT >= UINT16_MAX)
+#if (MAX_COMMIT_COUNT > UINT16_MAX)
 #error "MAX_COMMIT_COUNT maximum commit count is restricted by uint16_t"
 #endif
+#if (DEFAULT_COMMIT_COUNT > MAX_COMMIT_COUNT)
+#error "DEFAULT_COMMIT_COUNT must not exceed MAX_COMMIT_COUNT"
+#endif
 
 /// One NV entry
 typedef struct NvEntry {
@@ -60,11 +66,15 @@ typedef struct Tpm2Ctx {
   BitSupplier rnd_func;  ///< Pseudo random number generation function
   void* rnd_param;       ///< Pointer to user context for rnd_func
   FfElement* seed;       ///< Seed for member private key f value
-  FfElement* commit_data[MAX_COMMIT_COUNT];  ///< Tpm2Commit random value
-                                             ///< corresponding to counter
-  NvEntry nv[MAX_NV_NUMBER];                 ///< NV memory
-  Tpm2Key** keys;                            ///< Handles to all managed keys
-  size_t max_keys;                           ///< Size of array of handles
+  FfElement** commit_data;  ///< Tpm2Commit random value corresponding to
+                            ///< counter
+  uint16_t* free_commits;   ///< Stack of unused indexes of commit_data
+  size_t num_free_commits;  ///< Number of entries in free_commits
+  size_t commit_capacity;   ///< Number of allocated entries in commit_data
+  size_t max_commits;       ///< Limit commit_capacity can grow to
+  NvEntry nv[MAX_NV_NUMBER];  ///< NV memory
+  Tpm2Key** keys;             ///< Handles to all managed keys
+  size_t max_keys;            ///< Size of array of handles
 } Tpm2Ctx;
 
 #endif  // EPID_MEMBER_SPLIT_TPM2_BUILTIN_STATE_H_
@@ -50,6 +50,8 @@ typedef struct MemberParams MemberParams;
 
  \param[in] params
  member parameters to initialize rnd_func, rnd_param, ff_elem, ctx.
+ For the builtin TPM max_precomp_sig also raises the number of
+ commits that can be outstanding at the same time.
 
  \param[in] epid2_params
  The field and group parameters.
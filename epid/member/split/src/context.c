@@ -24,11 +24,12 @@
 #include <string.h>
 #include "common/endian_convert.h"
 #include "common/epid2params.h"
+#include "common/ring.h"
 #include "common/sigrlvalid.h"
-#include "common/stack.h"
 #include "epid/member/split/allowed_basenames.h"
 #include "epid/member/split/context.h"
 #include "epid/member/split/precomp.h"
+#include "epid/member/split/presig-internal.h"
 #include "epid/member/split/tpm2/context.h"
 #include "epid/member/split/tpm2/createprimary.h"
 #include "epid/member/split/tpm2/flushcontext.h"
@@ -96,10 +97,8 @@ EpidStatus EPID_MEMBER_API EpidMemberInit(MemberParams const* params,
       *(ctx->external_f) = *(params->f);
     }
 
-    if (!CreateStack(sizeof(PreComputedSignature), &ctx->presigs)) {
-      sts = kEpidMemAllocErr;
-      BREAK_ON_EPID_ERROR(sts);
-    }
+    // the pool gets its heap when pre-computed signatures are added
+    InitRing(&ctx->presigs, sizeof(PreComputedSignature), 0, NULL);
 
     sts = NewEcPoint(ctx->epid2_params->G1, (EcPoint**)&ctx->A);
     BREAK_ON_EPID_ERROR(sts);
@@ -133,22 +132,24 @@ EpidStatus EPID_MEMBER_API EpidMemberInit(MemberParams const* params,
 }
 
 void EPID_MEMBER_API EpidMemberDeinit(MemberCtx* ctx) {
+  PreComputedSignature* presig = NULL;
   size_t i = 0;
-  size_t presig_size = 0;
-  PreComputedSignature* buf = NULL;
   if (!ctx) {
     return;
   }
-  presig_size = StackGetSize(ctx->presigs);
-  buf = StackGetBuf(ctx->presigs);
-  for (i = 0; i < presig_size; ++i) {
-    if (buf->is_rf_ctr_set == true) {
-      (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, (buf++)->rf_ctr, ctx->f_handle);
+  for (i = 0; i < MAX_PRESIG_TASKS; i++) {
+    DeletePreSigWorker(&ctx->presig_workers[i]);
+  }
+  while (NULL != (presig = RingFront(&ctx->presigs))) {
+    if (presig->is_rf_ctr_set == true) {
+      (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, presig->rf_ctr, ctx->f_handle);
     }
+    (void)RingPop(&ctx->presigs);
   }
   Tpm2FlushContext(ctx->tpm2_ctx, &ctx->f_handle);
   ctx->f_handle = NULL;
-  DeleteStack(&ctx->presigs);
+  SAFE_FREE(ctx->presigs.buf);
+  InitRing(&ctx->presigs, sizeof(PreComputedSignature), 0, NULL);
   ctx->rnd_param = NULL;
   DeleteEcPoint((EcPoint**)&(ctx->h1));
   DeleteEcPoint((EcPoint**)&(ctx->h2));
@@ -163,6 +164,8 @@ void EPID_MEMBER_API EpidMemberDeinit(MemberCtx* ctx) {
   SAFE_FREE(ctx->external_f);
   DeleteEpid2Params(&ctx->epid2_params);
   DeleteBasenames(&ctx->allowed_basenames);
+  SAFE_FREE(ctx->updated_sig_rl);
+  ctx->sig_rl = NULL;
 }
 
 EpidStatus EPID_MEMBER_API EpidMemberCreate(MemberParams const* params,
@@ -257,10 +260,99 @@ EpidStatus EPID_MEMBER_API EpidMemberSetSigRl(MemberCtx* ctx,
     }
   }
   ctx->sig_rl = sig_rl;
+  // a list grown by EpidMemberUpdateSigRl is superseded
+  SAFE_FREE(ctx->updated_sig_rl);
+
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidMemberUpdateSigRl(MemberCtx* ctx,
+                                                 SigRl const* sig_rl_delta,
+                                                 size_t sig_rl_delta_size) {
+  const size_t kMinSigRlSize = sizeof(SigRl) - sizeof(SigRlEntry);
+  SigRl* sig_rl = NULL;
+  uint32_t current_n2 = 0;
+  uint32_t delta_n2 = 0;
+  size_t sig_rl_size = 0;
+  if (!ctx || !sig_rl_delta) {
+    return kEpidBadArgErr;
+  }
+  if (!ctx->is_provisioned || !ctx->sig_rl) {
+    return kEpidOutOfSequenceError;
+  }
+  if (!IsSigRlValid(&ctx->pub_key.gid, sig_rl_delta, sig_rl_delta_size)) {
+    return kEpidBadArgErr;
+  }
+  if (ntohl(sig_rl_delta->version) <= ntohl(ctx->sig_rl->version)) {
+    return kEpidVersionMismatchErr;
+  }
+  current_n2 = ntohl(ctx->sig_rl->n2);
+  delta_n2 = ntohl(sig_rl_delta->n2);
+  if (delta_n2 > UINT32_MAX - current_n2 ||
+      (size_t)current_n2 + delta_n2 >
+          (SIZE_MAX - kMinSigRlSize) / sizeof(SigRlEntry)) {
+    return kEpidBadArgErr;
+  }
+  sig_rl_size = kMinSigRlSize + ((size_t)current_n2 + delta_n2) *
+                                    sizeof(SigRlEntry);
+
+  if (ctx->sig_rl == ctx->updated_sig_rl) {
+    // entries already held by the member stay in place
+    sig_rl = SAFE_REALLOC(ctx->updated_sig_rl, sig_rl_size);
+    if (!sig_rl) {
+      return kEpidMemAllocErr;
+    }
+    // the reallocated list still holds the current entries
+    ctx->updated_sig_rl = sig_rl;
+    ctx->sig_rl = sig_rl;
+  } else {
+    sig_rl = SAFE_ALLOC(sig_rl_size);
+    if (!sig_rl) {
+      return kEpidMemAllocErr;
+    }
+    if (0 != memcpy_S(
+                 sig_rl, sig_rl_size, ctx->sig_rl,
+                 kMinSigRlSize + (size_t)current_n2 * sizeof(SigRlEntry))) {
+      SAFE_FREE(sig_rl);
+      return kEpidErr;
+    }
+  }
+  if (delta_n2 > 0) {
+    if (0 != memcpy_S(&sig_rl->bk[current_n2],
+                      (size_t)delta_n2 * sizeof(SigRlEntry), sig_rl_delta->bk,
+                      (size_t)delta_n2 * sizeof(SigRlEntry))) {
+      if (sig_rl != ctx->sig_rl) {
+        SAFE_FREE(sig_rl);
+      }
+      return kEpidErr;
+    }
+  }
+  sig_rl->version = sig_rl_delta->version;
+  *((uint32_t*)(&sig_rl->n2)) = htonl(current_n2 + delta_n2);
+  ctx->updated_sig_rl = sig_rl;
+  ctx->sig_rl = sig_rl;
 
   return kEpidNoErr;
 }
 
+EpidStatus EPID_MEMBER_API EpidMemberSetSigRlByReference(MemberCtx* ctx,
+                                                         SigRl const* sig_rl,
+                                                         size_t sig_rl_size) {
+  // the split member never copies a list it is given
+  return EpidMemberSetSigRl(ctx, sig_rl, sig_rl_size);
+}
+
+// Lists grown by EpidMemberUpdateSigRl and registered basenames are
+// allocated on the heap as needed.
+EpidStatus EPID_MEMBER_API EpidMemberSetSigRlBuffer(MemberCtx* ctx,
+                                                    void* buffer,
+                                                    size_t buffer_size) {
+  (void)ctx;
+  (void)buffer;
+  (void)buffer_size;
+  return kEpidOperationNotSupportedErr;
+}
+
 EpidStatus EPID_MEMBER_API EpidRegisterBasename(MemberCtx* ctx,
                                                 void const* basename,
                                                 size_t basename_len) {
@@ -290,3 +382,21 @@ EpidStatus EPID_MEMBER_API EpidClearRegisteredBasenames(MemberCtx* ctx) {
   sts = CreateBasenames(&ctx->allowed_basenames);
   return sts;
 }
+
+EpidStatus EPID_MEMBER_API EpidGetBasenameBufferSize(MemberCtx const* ctx,
+                                                     size_t number_basenames,
+                                                     size_t* buffer_size) {
+  (void)ctx;
+  (void)number_basenames;
+  (void)buffer_size;
+  return kEpidOperationNotSupportedErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidMemberSetBasenameBuffer(MemberCtx* ctx,
+                                                       void* buffer,
+                                                       size_t buffer_size) {
+  (void)ctx;
+  (void)buffer;
+  (void)buffer_size;
+  return kEpidOperationNotSupportedErr;
+}
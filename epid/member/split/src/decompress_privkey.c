@@ -21,6 +21,7 @@
 #define EXPORT_EPID_APIS
 #include "epid/member/api.h"
 
+#include <string.h>
 #include "common/epid2params.h"
 #include "epid/errors.h"
 #include "epid/types.h"
@@ -35,119 +36,140 @@
     break;                       \
   }
 
-/*!
- * \brief
- * Internal implementation of PrivKey
- */
-typedef struct PrivKey_ {
-  GroupId gid;   ///< group ID
-  EcPoint* A;    ///< an element in G1
-  FfElement* x;  ///< an integer between [0, p-1]
-  FfElement* f;  ///< an integer between [0, p-1]
-} PrivKey_;
-
 /// Implements the derivation method used by private key decompression
 /// Derives two integers x, f between [1, p-1] from the seed value
 static EpidStatus DeriveXF(FpElemStr* x, FpElemStr* f, Seed const* seed,
-                           FpElemStr const* p);
+                           BigNum const* p);
+
+/// State shared by the decompression of the keys of one group
+typedef struct DecompressState {
+  Epid2Params_* epid2_params;  ///< Intel(R) EPID 2.0 parameters
+  EcPoint* h1;                 ///< h1 of the group public key
+  EcPoint* w;                  ///< w of the group public key
+  BigNum* bn_pminus1;          ///< p-1
+  EcPoint* A;                  ///< A of the key being decompressed
+  FfElement* Ax;               ///< A.x of the key being decompressed
+  EcPoint* t1;                 ///< temporary element of G2
+  EcPoint* t2;                 ///< temporary element of G1
+  FfElement* t3;               ///< temporary element of GT
+  FfElement* t4;               ///< temporary element of GT
+} DecompressState;
+
+static void DeleteDecompressState(DecompressState* state) {
+  DeleteEcPoint(&state->h1);
+  DeleteEcPoint(&state->w);
+  DeleteBigNum(&state->bn_pminus1);
+  DeleteEcPoint(&state->A);
+  DeleteFfElement(&state->Ax);
+  DeleteEcPoint(&state->t1);
+  DeleteEcPoint(&state->t2);
+  DeleteFfElement(&state->t3);
+  DeleteFfElement(&state->t4);
+  DeleteEpid2Params(&state->epid2_params);
+}
 
-EpidStatus EPID_MEMBER_API EpidDecompressPrivKey(
-    GroupPubKey const* pub_key, CompressedPrivKey const* compressed_privkey,
-    PrivKey* priv_key) {
+/// Sets up the work that depends only on the group public key
+static EpidStatus NewDecompressState(GroupPubKey const* pub_key,
+                                     DecompressState* state) {
   EpidStatus result = kEpidErr;
-  Epid2Params_* epid2_params = 0;
-  PrivKey_ priv_key_ = {{{0}}, 0, 0, 0};
-  FfElement* Ax = 0;
-  EcPoint* t1 = 0;
-  EcPoint* t2 = 0;
-  FfElement* t3 = 0;
-  FfElement* t4 = 0;
-  BigNum* bn_pminus1 = 0;
   BigNum* bn_one = 0;
-  EcPoint* h1 = 0;
-  EcPoint* w = 0;
 
-  // check parameters
-  if (!pub_key || !compressed_privkey || !priv_key) {
-    return kEpidBadArgErr;
-  }
-
-  // Internal representation of Epid2Params
-  result = CreateEpid2Params(&epid2_params);
-  if (kEpidNoErr != result) {
-    return result;
-  }
+  memset(state, 0, sizeof(*state));
 
   do {
     uint8_t bn_one_str = 1;
-    FpElemStr p_str = {0};
-    bool is_valid = false;
-    // shortcuts
-    EcGroup* G1 = epid2_params->G1;
-    EcGroup* G2 = epid2_params->G2;
-    FiniteField* GT = epid2_params->GT;
-    EcPoint* g1 = epid2_params->g1;
-    EcPoint* g2 = epid2_params->g2;
-    PairingState* ps_ctx = epid2_params->pairing_state;
-    FiniteField* Fp = epid2_params->Fp;
-    FiniteField* Fq = epid2_params->Fq;
-    BigNum* p = epid2_params->p;
+    EcGroup* G1 = 0;
+    EcGroup* G2 = 0;
+    FiniteField* GT = 0;
 
-    // In the following process, temporary variables t1 (an element of
-    // G2), t2 (an element of G1), t3, t4 (elements of GT) are used.
-    // Let the compressed private key be (gid, A.x, seed). Let the
-    // Intel(R) EPID public key be (gid, h1, h2, w).
+    // Internal representation of Epid2Params
+    result = CreateEpid2Params(&state->epid2_params);
+    BREAK_ON_EPID_ERROR(result);
+    G1 = state->epid2_params->G1;
+    G2 = state->epid2_params->G2;
+    GT = state->epid2_params->GT;
 
-    // Create a new Priv Key
-    result = NewEcPoint(G1, &priv_key_.A);
+    result = NewEcPoint(G1, &state->h1);
+    BREAK_ON_EPID_ERROR(result);
+    result = ReadEcPoint(G1, &(pub_key->h1), sizeof(pub_key->h1), state->h1);
     BREAK_ON_EPID_ERROR(result);
-    result = NewFfElement(Fp, &priv_key_.x);
+    result = NewEcPoint(G2, &state->w);
     BREAK_ON_EPID_ERROR(result);
-    result = NewFfElement(Fp, &priv_key_.f);
+    result = ReadEcPoint(G2, &(pub_key->w), sizeof(pub_key->w), state->w);
     BREAK_ON_EPID_ERROR(result);
 
-    result = NewFfElement(Fq, &Ax);
+    result = NewBigNum(sizeof(BigNumStr), &state->bn_pminus1);
     BREAK_ON_EPID_ERROR(result);
-    result = NewEcPoint(G2, &t1);
+    result = NewBigNum(sizeof(bn_one_str), &bn_one);
     BREAK_ON_EPID_ERROR(result);
-    result = NewEcPoint(G1, &t2);
+    result = ReadBigNum(&bn_one_str, sizeof(bn_one_str), bn_one);
     BREAK_ON_EPID_ERROR(result);
-    result = NewFfElement(GT, &t3);
+    result = BigNumSub(state->epid2_params->p, bn_one, state->bn_pminus1);
     BREAK_ON_EPID_ERROR(result);
-    result = NewFfElement(GT, &t4);
+
+    result = NewEcPoint(G1, &state->A);
     BREAK_ON_EPID_ERROR(result);
-    result = NewBigNum(sizeof(BigNumStr), &bn_pminus1);
+    result = NewFfElement(state->epid2_params->Fq, &state->Ax);
     BREAK_ON_EPID_ERROR(result);
-    result = NewBigNum(sizeof(bn_one_str), &bn_one);
+    result = NewEcPoint(G2, &state->t1);
     BREAK_ON_EPID_ERROR(result);
-
-    result = NewEcPoint(G1, &h1);
-    BREAK_ON_EPID_ERROR(result);
-    result = ReadEcPoint(G1, &(pub_key->h1), sizeof(pub_key->h1), h1);
+    result = NewEcPoint(G1, &state->t2);
     BREAK_ON_EPID_ERROR(result);
-    result = NewEcPoint(G2, &w);
+    result = NewFfElement(GT, &state->t3);
     BREAK_ON_EPID_ERROR(result);
-    result = ReadEcPoint(G2, &(pub_key->w), sizeof(pub_key->w), w);
+    result = NewFfElement(GT, &state->t4);
     BREAK_ON_EPID_ERROR(result);
 
-    result = WriteBigNum(p, sizeof(p_str), &p_str);
-    BREAK_ON_EPID_ERROR(result);
+    result = kEpidNoErr;
+  } while (0);
 
-    result = ReadBigNum(&bn_one_str, sizeof(bn_one_str), bn_one);
-    BREAK_ON_EPID_ERROR(result);
+  DeleteBigNum(&bn_one);
+  if (kEpidNoErr != result) {
+    DeleteDecompressState(state);
+  }
+  return result;
+}
+
+/// Decompresses one private key of the group of state
+static EpidStatus DecompressOne(DecompressState* state,
+                                GroupPubKey const* pub_key,
+                                CompressedPrivKey const* compressed_privkey,
+                                PrivKey* priv_key) {
+  EpidStatus result = kEpidErr;
+  do {
+    bool is_valid = false;
+    // shortcuts
+    EcGroup* G1 = state->epid2_params->G1;
+    EcGroup* G2 = state->epid2_params->G2;
+    FiniteField* GT = state->epid2_params->GT;
+    EcPoint* g1 = state->epid2_params->g1;
+    EcPoint* g2 = state->epid2_params->g2;
+    PairingState* ps_ctx = state->epid2_params->pairing_state;
+    PairingG2Precomp const* g2_lines = state->epid2_params->g2_lines;
+    FiniteField* Fq = state->epid2_params->Fq;
+    EcPoint* A = state->A;
+    EcPoint* t1 = state->t1;
+    EcPoint* t2 = state->t2;
+    FfElement* t3 = state->t3;
+    FfElement* t4 = state->t4;
+
+    // In the following process, temporary variables t1 (an element of
+    // G2), t2 (an element of G1), t3, t4 (elements of GT) are used.
+    // Let the compressed private key be (gid, A.x, seed). Let the
+    // Intel(R) EPID public key be (gid, h1, h2, w).
 
     // 1. The member derives x and f from seed. The derivation
     //    function must be the same as the one used in the key
     //    generation above. This step is out of scope of this
     //    specification.
-    result =
-        DeriveXF(&priv_key->x, &priv_key->f, &compressed_privkey->seed, &p_str);
+    result = DeriveXF(&priv_key->x, &priv_key->f, &compressed_privkey->seed,
+                      state->epid2_params->p);
     BREAK_ON_EPID_ERROR(result);
     // 2. The member computes A = G1.makePoint(A.x).
     result = ReadFfElement(Fq, &compressed_privkey->ax,
-                           sizeof(compressed_privkey->ax), Ax);
+                           sizeof(compressed_privkey->ax), state->Ax);
     BREAK_ON_EPID_ERROR(result);
-    result = EcMakePoint(G1, Ax, priv_key_.A);
+    result = EcMakePoint(G1, state->Ax, A);
     BREAK_ON_EPID_ERROR(result);
     // 3. The member tests whether (A, x, f) is a valid Intel(R) EPID
     //    private key as follows:
@@ -155,28 +177,26 @@ EpidStatus EPID_MEMBER_API EpidDecompressPrivKey(
     result = EcSscmExp(G2, g2, (BigNumStr const*)&priv_key->x, t1);
     BREAK_ON_EPID_ERROR(result);
     //   b. It computes t1 = G2.mul(t1, w).
-    result = EcMul(G2, t1, w, t1);
+    result = EcMul(G2, t1, state->w, t1);
     BREAK_ON_EPID_ERROR(result);
     //   c. It computes t3 = pairing(A, t1).
-    result = Pairing(ps_ctx, priv_key_.A, t1, t3);
+    result = Pairing(ps_ctx, A, t1, t3);
     BREAK_ON_EPID_ERROR(result);
     //   d. It computes t2 = G1.sscmExp(h1, f).
-    result = EcSscmExp(G1, h1, (BigNumStr const*)&priv_key->f, t2);
+    result = EcSscmExp(G1, state->h1, (BigNumStr const*)&priv_key->f, t2);
     BREAK_ON_EPID_ERROR(result);
     //   e. It computes t2 = G1.mul(t2, g1).
     result = EcMul(G1, t2, g1, t2);
     BREAK_ON_EPID_ERROR(result);
     //   f. It computes t4 = pairing(t2, g2).
-    result = Pairing(ps_ctx, t2, g2, t4);
+    result = PairingWithPrecomputedG2(ps_ctx, t2, g2_lines, t4);
     BREAK_ON_EPID_ERROR(result);
     //   g. If GT.isEqual(t3, t4) = false
     result = FfIsEqual(GT, t3, t4, &is_valid);
     BREAK_ON_EPID_ERROR(result);
     if (!is_valid) {
       //   i.   It computes t3 = GT.exp(t3, p-1).
-      result = BigNumSub(p, bn_one, bn_pminus1);
-      BREAK_ON_EPID_ERROR(result);
-      result = FfExp(GT, t3, bn_pminus1, t3);
+      result = FfExp(GT, t3, state->bn_pminus1, t3);
       BREAK_ON_EPID_ERROR(result);
       //   ii.  If GT.isEqual(t3, t4) = false again, it reports bad
       //        Intel(R) EPID private key and exits.
@@ -187,36 +207,73 @@ EpidStatus EPID_MEMBER_API EpidDecompressPrivKey(
         break;
       }
       //   iii. It sets A = G1.inverse(A).
-      result = EcInverse(G1, priv_key_.A, priv_key_.A);
+      result = EcInverse(G1, A, A);
       BREAK_ON_EPID_ERROR(result);
       //   NOTE A is modified here in this step.
     }
     // 4. The decompressed Intel(R) EPID private key is (gid, A, x, f).
     // x, f already filled in.
     priv_key->gid = pub_key->gid;
-    result = WriteEcPoint(G1, priv_key_.A, &priv_key->A, sizeof(priv_key->A));
+    result = WriteEcPoint(G1, A, &priv_key->A, sizeof(priv_key->A));
     BREAK_ON_EPID_ERROR(result);
 
     result = kEpidNoErr;
   } while (0);
 
-  DeleteEcPoint(&priv_key_.A);
-  DeleteFfElement(&priv_key_.x);
-  DeleteFfElement(&priv_key_.f);
-  DeleteFfElement(&Ax);
-  DeleteEcPoint(&t1);
-  DeleteEcPoint(&t2);
-  DeleteFfElement(&t3);
-  DeleteFfElement(&t4);
-  DeleteBigNum(&bn_pminus1);
-  DeleteBigNum(&bn_one);
-  DeleteEcPoint(&h1);
-  DeleteEcPoint(&w);
-  DeleteEpid2Params(&epid2_params);
+  return result;
+}
+
+EpidStatus EPID_MEMBER_API EpidDecompressPrivKey(
+    GroupPubKey const* pub_key, CompressedPrivKey const* compressed_privkey,
+    PrivKey* priv_key) {
+  EpidStatus result = kEpidErr;
+  DecompressState state;
+
+  // check parameters
+  if (!pub_key || !compressed_privkey || !priv_key) {
+    return kEpidBadArgErr;
+  }
+
+  result = NewDecompressState(pub_key, &state);
+  if (kEpidNoErr != result) {
+    return result;
+  }
+  result = DecompressOne(&state, pub_key, compressed_privkey, priv_key);
+  DeleteDecompressState(&state);
 
   return result;
 }
 
+EpidStatus EPID_MEMBER_API EpidDecompressPrivKeys(
+    GroupPubKey const* pub_key, CompressedPrivKey const* compressed_privkeys,
+    size_t count, PrivKey* priv_keys, EpidStatus* results) {
+  EpidStatus result = kEpidErr;
+  EpidStatus batch_result = kEpidNoErr;
+  DecompressState state;
+  size_t i = 0;
+
+  // check parameters
+  if (!pub_key || !compressed_privkeys || !priv_keys || !results) {
+    return kEpidBadArgErr;
+  }
+
+  result = NewDecompressState(pub_key, &state);
+  if (kEpidNoErr != result) {
+    return result;
+  }
+  for (i = 0; i < count; i++) {
+    results[i] =
+        DecompressOne(&state, pub_key, &compressed_privkeys[i], &priv_keys[i]);
+    if (kEpidNoErr != results[i]) {
+      EpidZeroMemory(&priv_keys[i], sizeof(priv_keys[i]));
+      batch_result = results[i];
+    }
+  }
+  DeleteDecompressState(&state);
+
+  return batch_result;
+}
+
 /// Hash message buffer
 typedef struct HashMsg {
   /// Message to be hashed
@@ -224,12 +281,11 @@ typedef struct HashMsg {
 } HashMsg;
 
 static EpidStatus DeriveXF(FpElemStr* x, FpElemStr* f, Seed const* seed,
-                           FpElemStr const* p) {
+                           BigNum const* p) {
   EpidStatus result = kEpidErr;
 
   BigNum* bn_x = 0;
   BigNum* bn_f = 0;
-  BigNum* bn_p = 0;
 
   do {
     HashMsg msgstr = {{
@@ -247,11 +303,6 @@ static EpidStatus DeriveXF(FpElemStr* x, FpElemStr* f, Seed const* seed,
     Sha256Digest digest[2];
     unsigned char str512[512 / 8];
 
-    result = NewBigNum(sizeof(*p), &bn_p);
-    BREAK_ON_EPID_ERROR(result);
-    result = ReadBigNum(p, sizeof(*p), bn_p);
-    BREAK_ON_EPID_ERROR(result);
-
     result = NewBigNum(sizeof(digest), &bn_x);
     BREAK_ON_EPID_ERROR(result);
     result = NewBigNum(sizeof(digest), &bn_f);
@@ -270,7 +321,7 @@ static EpidStatus DeriveXF(FpElemStr* x, FpElemStr* f, Seed const* seed,
     result = ReadBigNum(&digest, sizeof(digest), bn_x);
     BREAK_ON_EPID_ERROR(result);
 
-    result = BigNumMod(bn_x, bn_p, bn_x);
+    result = BigNumMod(bn_x, p, bn_x);
     BREAK_ON_EPID_ERROR(result);
 
     result = WriteBigNum(bn_x, sizeof(str512), str512);
@@ -291,7 +342,7 @@ static EpidStatus DeriveXF(FpElemStr* x, FpElemStr* f, Seed const* seed,
     result = ReadBigNum(&digest, sizeof(digest), bn_f);
     BREAK_ON_EPID_ERROR(result);
 
-    result = BigNumMod(bn_f, bn_p, bn_f);
+    result = BigNumMod(bn_f, p, bn_f);
     BREAK_ON_EPID_ERROR(result);
 
     result = WriteBigNum(bn_f, sizeof(str512), str512);
@@ -304,7 +355,6 @@ static EpidStatus DeriveXF(FpElemStr* x, FpElemStr* f, Seed const* seed,
 
   DeleteBigNum(&bn_x);
   DeleteBigNum(&bn_f);
-  DeleteBigNum(&bn_p);
 
   return result;
 }
@@ -31,7 +31,9 @@
 #include "epid/member/split/tpm2/sign.h"
 #include "epid/stdtypes.h"
 #include "epid/types.h"
+#include "ippmath/ecglv.h"
 #include "ippmath/ecgroup.h"
+#include "ippmath/expworkspace.h"
 #include "ippmath/finitefield.h"
 #include "ippmath/memory.h"
 
@@ -70,189 +72,250 @@ typedef struct EpidNrProveCommitValues {
   sha_digest digest;
 } EpidNrProveCommitValues;
 #pragma pack()
-EpidStatus EpidNrProve(MemberCtx const* ctx, void const* msg, size_t msg_len,
-                       void const* basename, size_t basename_len,
-                       BasicSignature const* sig, SigRlEntry const* sigrl_entry,
-                       SplitNrProof* proof) {
-  EpidStatus sts = kEpidErr;
-
-  EcPoint* B = NULL;
-  EcPoint* K = NULL;
-  EcPoint* rlB = NULL;
-  EcPoint* rlK = NULL;
-  EcPoint* t = NULL;  // temp value in G1 either T, R1, R2
-  EcPoint* k_tpm = NULL;
-  EcPoint* l_tpm = NULL;
-  EcPoint* e_tpm = NULL;
-  EcPoint* D = NULL;
-  FfElement* y2 = NULL;
-  uint8_t* s2 = NULL;
-  FfElement* mu = NULL;
-  FfElement* nu = NULL;
-  FfElement* rmu = NULL;
-  EpidNrProveCommitValues commit_values = {0};
-  FfElement* noncek = NULL;
 
-  FfElement* t2 = NULL;  // temporary for multiplication
+/// Values and temporaries shared by all non-revoked proofs of a signature
+struct NrProveState {
+  HashAlg hash_alg;               ///< hash algorithm of the member key
+  size_t digest_len;              ///< digest size of hash_alg
+  EcPoint* K;                     ///< K of the basic signature
+  FfElement* y2;                  ///< y coordinate of the hashed basename
+  uint8_t* s2;                    ///< i || basename for Tpm2Commit
+  size_t s2_len;                  ///< size of s2 in bytes
+  NrProveCommitment* commitment;  ///< values hashed into c
+  EcPoint* rlB;                   ///< B of the SigRl entry
+  EcPoint* rlK;                   ///< K of the SigRl entry
+  EcPoint* t;                     ///< temp value in G1 either T, R1, R2
+  EcPoint* k_tpm;                 ///< k output of Tpm2Commit
+  EcPoint* l_tpm;                 ///< l output of Tpm2Commit
+  EcPoint* e_tpm;                 ///< e output of Tpm2Commit
+  EcPoint* D;                     ///< f * rlB
+  FfElement* mu;                  ///< random mu
+  FfElement* nu;                  ///< -mu
+  FfElement* rmu;                 ///< random rmu
+  FfElement* noncek;              ///< nonce output of Tpm2Sign
+  FfElement* t2;                  ///< temporary for multiplication
+  ExpWorkspace* ws;               ///< workspace of the multi-exponentiations
+};
 
-  BigNumStr mu_str = {0};
-  BigNumStr nu_str = {0};
-  BigNumStr rmu_str = {0};
-  uint16_t counter =
-      0;  ///< TPM counter pointing to Nr Proof related random value
-  bool is_counter_set = false;
-
-  if (!ctx || (0 != msg_len && !msg) || !sig || !sigrl_entry || !proof)
-    return kEpidBadArgErr;
-  if (!basename || 0 == basename_len) {
-    // basename should not be empty
-    return kEpidBadArgErr;
-  }
-  if (!ctx->epid2_params) return kEpidBadArgErr;
+/// Releases the values held by a state
+static void ClearNrProveState(NrProveState* state) {
+  SAFE_FREE(state->s2);
+  DeleteNrProveCommitment(&state->commitment);
+  DeleteFfElement(&state->y2);
+  DeleteEcPoint(&state->K);
+  DeleteEcPoint(&state->rlB);
+  DeleteEcPoint(&state->rlK);
+  DeleteEcPoint(&state->D);
+  DeleteEcPoint(&state->t);
+  DeleteEcPoint(&state->e_tpm);
+  DeleteEcPoint(&state->l_tpm);
+  DeleteEcPoint(&state->k_tpm);
+  DeleteFfElement(&state->mu);
+  DeleteFfElement(&state->nu);
+  DeleteFfElement(&state->rmu);
+  DeleteFfElement(&state->t2);
+  DeleteFfElement(&state->noncek);
+  DeleteExpWorkspace(&state->ws);
+}
 
+/// Computes the values that do not depend on the SigRl entry once
+static EpidStatus InitNrProveState(MemberCtx const* ctx, void const* msg,
+                                   size_t msg_len, void const* basename,
+                                   size_t basename_len,
+                                   BasicSignature const* sig,
+                                   NrProveState* state) {
+  EpidStatus sts = kEpidErr;
   do {
-    NrProveCommitOutput commit_out = {0};
     FiniteField* Fp = ctx->epid2_params->Fp;
     FiniteField* Fq = ctx->epid2_params->Fq;
     EcGroup* G1 = ctx->epid2_params->G1;
-    BitSupplier rnd_func = ctx->rnd_func;
-    void* rnd_param = ctx->rnd_param;
+    EcPoint* B = NULL;
     uint32_t i = 0;
     G1ElemStr B_str = {0};
-    const BigNumStr kOne = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
-    FpElemStr c_str = {0};
-
-    HashAlg hash_alg = Tpm2KeyHashAlg(ctx->f_handle);
-    size_t digest_len = EpidGetHashSize(hash_alg);
-    size_t commit_len = 0;
 
-    if (sizeof(commit_values.digest) < digest_len) {
+    state->hash_alg = Tpm2KeyHashAlg(ctx->f_handle);
+    state->digest_len = EpidGetHashSize(state->hash_alg);
+    if (sizeof(((EpidNrProveCommitValues*)0)->digest) < state->digest_len) {
       return kEpidBadArgErr;
     }
-    sts = NewEcPoint(G1, &B);
+    sts = NewEcPoint(G1, &state->K);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &K);
+    sts = NewEcPoint(G1, &state->rlB);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &rlB);
+    sts = NewEcPoint(G1, &state->rlK);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &rlK);
+    sts = NewEcPoint(G1, &state->D);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &D);
-    BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &t);
+    sts = NewEcPoint(G1, &state->t);
     BREAK_ON_EPID_ERROR(sts);
 
-    sts = NewFfElement(Fp, &y2);
+    sts = NewFfElement(Fp, &state->y2);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &k_tpm);
+    sts = NewEcPoint(G1, &state->k_tpm);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &l_tpm);
+    sts = NewEcPoint(G1, &state->l_tpm);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &e_tpm);
+    sts = NewEcPoint(G1, &state->e_tpm);
     BREAK_ON_EPID_ERROR(sts);
 
-    sts = NewFfElement(Fp, &mu);
+    sts = NewFfElement(Fp, &state->mu);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewFfElement(Fp, &state->nu);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(Fp, &nu);
+    sts = NewFfElement(Fp, &state->rmu);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(Fp, &rmu);
+    sts = NewFfElement(Fp, &state->noncek);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(Fp, &noncek);
+    sts = NewFfElement(Fp, &state->t2);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewExpWorkspace(2, &state->ws);
     BREAK_ON_EPID_ERROR(sts);
 
-    s2 = SAFE_ALLOC(basename_len + sizeof(i));
-    if (!s2) {
+    state->s2_len = basename_len + sizeof(i);
+    state->s2 = SAFE_ALLOC(state->s2_len);
+    if (!state->s2) {
       sts = kEpidMemAllocErr;
       break;
     }
-    sts = ReadEcPoint(G1, &sig->K, sizeof(sig->K), K);
+    sts = ReadEcPoint(G1, &sig->K, sizeof(sig->K), state->K);
     BREAK_ON_EPID_ERROR(sts);
 
-    sts = ReadEcPoint(G1, &(sigrl_entry->b), sizeof(sigrl_entry->b), rlB);
+    // s2 = (i || basename) and y2 = By of the hashed basename are the same
+    // for every SigRl entry
+    sts = NewEcPoint(G1, &B);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = EcHash(G1, basename, basename_len, state->hash_alg, B, &i);
+    if (kEpidNoErr == sts) {
+      sts = WriteEcPoint(G1, B, &B_str, sizeof(B_str));
+    }
+    DeleteEcPoint(&B);
     BREAK_ON_EPID_ERROR(sts);
-    sts = ReadEcPoint(G1, &(sigrl_entry->k), sizeof(sigrl_entry->k), rlK);
+    *(uint32_t*)state->s2 = ntohl(i);
+    sts = ReadFfElement(Fq, &B_str.y, sizeof(B_str.y), state->y2);
+    BREAK_ON_EPID_ERROR(sts);
+    if (0 != memcpy_S(state->s2 + sizeof(i), basename_len, basename,
+                      basename_len)) {
+      sts = kEpidErr;
+      break;
+    }
+
+    sts = NewNrProveCommitment(&sig->B, &sig->K, msg, msg_len,
+                               &state->commitment);
+    BREAK_ON_EPID_ERROR(sts);
+
+    sts = kEpidNoErr;
+  } while (0);
+  return sts;
+}
+
+/// Computes the non-revoked proof for one SigRl entry
+static EpidStatus ComputeNrProof(MemberCtx const* ctx, NrProveState* state,
+                                 SigRlEntry const* sigrl_entry,
+                                 SplitNrProof* proof) {
+  EpidStatus sts = kEpidErr;
+  EpidNrProveCommitValues commit_values = {0};
+  BigNumStr mu_str = {0};
+  BigNumStr nu_str = {0};
+  BigNumStr rmu_str = {0};
+  uint16_t counter =
+      0;  ///< TPM counter pointing to Nr Proof related random value
+  bool is_counter_set = false;
+
+  do {
+    NrProveCommitOutput commit_out = {0};
+    FiniteField* Fp = ctx->epid2_params->Fp;
+    EcGroup* G1 = ctx->epid2_params->G1;
+    EcGlvState* G1_glv = ctx->epid2_params->G1_glv;
+    BitSupplier rnd_func = ctx->rnd_func;
+    void* rnd_param = ctx->rnd_param;
+    const BigNumStr kOne = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+    FpElemStr c_str = {0};
+    size_t digest_len = state->digest_len;
+    size_t commit_len = 0;
+
+    sts = ReadEcPoint(G1, &(sigrl_entry->b), sizeof(sigrl_entry->b),
+                      state->rlB);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = ReadEcPoint(G1, &(sigrl_entry->k), sizeof(sigrl_entry->k),
+                      state->rlK);
     BREAK_ON_EPID_ERROR(sts);
 
     // 1.  The member chooses random mu from [1, p-1].
-    sts = FfGetRandom(Fp, &kOne, rnd_func, rnd_param, mu);
+    sts = FfGetRandom(Fp, &kOne, rnd_func, rnd_param, state->mu);
     BREAK_ON_EPID_ERROR(sts);
     // 2.  The member computes nu = -mu mod p.
-    sts = FfNeg(Fp, mu, nu);
+    sts = FfNeg(Fp, state->mu, state->nu);
     BREAK_ON_EPID_ERROR(sts);
     // 3.1. The member computes D = G1.privateExp(B', f): calculate f * B'
-    sts = EpidPrivateExp((MemberCtx*)ctx, rlB, ctx->f_handle, D);
+    sts = EpidPrivateExp((MemberCtx*)ctx, state->rlB, ctx->f_handle,
+                         state->D);
     BREAK_ON_EPID_ERROR(sts);
     // 3.2.The member computes T = G1.sscmMultiExp(K', mu, D, nu):
     // T = mu * K' + (-mu * f * B')
-    sts = WriteFfElement(Fp, mu, &mu_str, sizeof(mu_str));
+    sts = WriteFfElement(Fp, state->mu, &mu_str, sizeof(mu_str));
     BREAK_ON_EPID_ERROR(sts);
-    sts = WriteFfElement(Fp, nu, &nu_str, sizeof(nu_str));
+    sts = WriteFfElement(Fp, state->nu, &nu_str, sizeof(nu_str));
     BREAK_ON_EPID_ERROR(sts);
     {
       EcPoint const* points[2];
       BigNumStr const* exponents[2];
-      points[0] = rlK;
-      points[1] = D;
+      points[0] = state->rlK;
+      points[1] = state->D;
       exponents[0] = &mu_str;
       exponents[1] = &nu_str;
-      sts = EcSscmMultiExp(G1, points, exponents, COUNT_OF(points), t);
+      sts = EcGlvSscmMultiExpWithWorkspace(G1_glv, points, exponents,
+                                           COUNT_OF(points), state->ws,
+                                           state->t);
       BREAK_ON_EPID_ERROR(sts);
-      sts = WriteEcPoint(G1, t, &commit_out.T, sizeof(commit_out.T));
+      sts = WriteEcPoint(G1, state->t, &commit_out.T, sizeof(commit_out.T));
       BREAK_ON_EPID_ERROR(sts);
     }
     // 4.1. The member chooses rmu randomly from[1, p - 1].
-    sts = FfGetRandom(Fp, &kOne, rnd_func, rnd_param, rmu);
+    sts = FfGetRandom(Fp, &kOne, rnd_func, rnd_param, state->rmu);
     BREAK_ON_EPID_ERROR(sts);
     // (rf * B = L, rf * B' = E) = TPM2_Commit(P1 = B', s2 = (i || basename),
     // y2 = By)
-    sts = EcHash(G1, basename, basename_len, hash_alg, B, &i);
-    BREAK_ON_EPID_ERROR(sts);
-    *(uint32_t*)s2 = ntohl(i);
-    sts = WriteEcPoint(G1, B, &B_str, sizeof(B_str));
-    BREAK_ON_EPID_ERROR(sts);
-    sts = ReadFfElement(Fq, &B_str.y, sizeof(B_str.y), y2);
-    BREAK_ON_EPID_ERROR(sts);
-    if (0 != memcpy_S(s2 + sizeof(i), basename_len, basename, basename_len)) {
-      sts = kEpidErr;
-      break;
-    }
-    sts =
-        Tpm2Commit(ctx->tpm2_ctx, ctx->f_handle, rlB, s2,
-                   basename_len + sizeof(i), y2, k_tpm, l_tpm, e_tpm, &counter);
+    sts = Tpm2Commit(ctx->tpm2_ctx, ctx->f_handle, state->rlB, state->s2,
+                     state->s2_len, state->y2, state->k_tpm, state->l_tpm,
+                     state->e_tpm, &counter);
     BREAK_ON_EPID_ERROR(sts);
     is_counter_set = true;
     // R1 = rmu * K + (-mu * L)
-    sts = WriteFfElement(Fp, rmu, &rmu_str, sizeof(rmu_str));
+    sts = WriteFfElement(Fp, state->rmu, &rmu_str, sizeof(rmu_str));
     BREAK_ON_EPID_ERROR(sts);
     {
       EcPoint const* points[2];
       BigNumStr const* exponents[2];
-      points[0] = K;
-      points[1] = l_tpm;
+      points[0] = state->K;
+      points[1] = state->l_tpm;
       exponents[0] = &rmu_str;
       exponents[1] = &nu_str;
-      sts = EcSscmMultiExp(G1, points, exponents, COUNT_OF(points), t);
+      sts = EcGlvSscmMultiExpWithWorkspace(G1_glv, points, exponents,
+                                           COUNT_OF(points), state->ws,
+                                           state->t);
       BREAK_ON_EPID_ERROR(sts);
-      sts = WriteEcPoint(G1, t, &commit_out.R1, sizeof(commit_out.R1));
+      sts = WriteEcPoint(G1, state->t, &commit_out.R1, sizeof(commit_out.R1));
       BREAK_ON_EPID_ERROR(sts);
     }
     // R2 = rmu * K' + (-mu * E)
     {
       EcPoint const* points[2];
       BigNumStr const* exponents[2];
-      points[0] = rlK;
-      points[1] = e_tpm;
+      points[0] = state->rlK;
+      points[1] = state->e_tpm;
       exponents[0] = &rmu_str;
       exponents[1] = &nu_str;
-      sts = EcSscmMultiExp(G1, points, exponents, COUNT_OF(points), t);
+      sts = EcGlvSscmMultiExpWithWorkspace(G1_glv, points, exponents,
+                                           COUNT_OF(points), state->ws,
+                                           state->t);
       BREAK_ON_EPID_ERROR(sts);
-      sts = WriteEcPoint(G1, t, &commit_out.R2, sizeof(commit_out.R2));
+      sts = WriteEcPoint(G1, state->t, &commit_out.R2, sizeof(commit_out.R2));
       BREAK_ON_EPID_ERROR(sts);
     }
     // c = hashFp(p || g1 || B | K || B' || K' || T || R1 || R2 || m)
-    sts = HashNrProveCommitment(Fp, hash_alg, &sig->B, &sig->K, sigrl_entry,
-                                &commit_out, msg, msg_len, &c_str);
+    sts = HashNrProveCommitmentEntry(Fp, state->hash_alg, state->commitment,
+                                     sigrl_entry, &commit_out, &c_str);
     BREAK_ON_EPID_ERROR(sts);
     // TPM2_Sign(digest = c)
     commit_len = sizeof(commit_values.noncek) + digest_len;
@@ -262,29 +325,27 @@ EpidStatus EpidNrProve(MemberCtx const* ctx, void const* msg, size_t msg_len,
       BREAK_ON_EPID_ERROR(sts);
     }
 
-    sts = NewFfElement(Fp, &t2);
-    BREAK_ON_EPID_ERROR(sts);
     sts = Tpm2Sign(ctx->tpm2_ctx, ctx->f_handle, &commit_values.digest,
-                   digest_len, counter, noncek, t2);
+                   digest_len, counter, state->noncek, state->t2);
     BREAK_ON_EPID_ERROR(sts);
     is_counter_set = false;
     // snu = -mu * s
-    sts = FfMul(Fp, nu, t2, t2);
+    sts = FfMul(Fp, state->nu, state->t2, state->t2);
     BREAK_ON_EPID_ERROR(sts);
-    sts = WriteFfElement(Fp, t2, &proof->snu, sizeof(proof->snu));
+    sts = WriteFfElement(Fp, state->t2, &proof->snu, sizeof(proof->snu));
     BREAK_ON_EPID_ERROR(sts);
     // t = hashFp(k || c)
-    sts = WriteFfElement(Fp, noncek, &commit_values.noncek,
+    sts = WriteFfElement(Fp, state->noncek, &commit_values.noncek,
                          sizeof(commit_values.noncek));
     BREAK_ON_EPID_ERROR(sts);
-    sts = FfHash(Fp, &commit_values, commit_len, hash_alg, t2);
+    sts = FfHash(Fp, &commit_values, commit_len, state->hash_alg, state->t2);
     BREAK_ON_EPID_ERROR(sts);
     // smu = rmu + t * mu mod p
-    sts = FfMul(Fp, t2, mu, t2);
+    sts = FfMul(Fp, state->t2, state->mu, state->t2);
     BREAK_ON_EPID_ERROR(sts);
-    sts = FfAdd(Fp, rmu, t2, t2);
+    sts = FfAdd(Fp, state->rmu, state->t2, state->t2);
     BREAK_ON_EPID_ERROR(sts);
-    sts = WriteFfElement(Fp, t2, &proof->smu, sizeof(proof->smu));
+    sts = WriteFfElement(Fp, state->t2, &proof->smu, sizeof(proof->smu));
     BREAK_ON_EPID_ERROR(sts);
 
     // 10. The member outputs sigma = (T, c, smu, snu, k), a non-revoked
@@ -292,7 +353,8 @@ EpidStatus EpidNrProve(MemberCtx const* ctx, void const* msg, size_t msg_len,
     //     "failed".
     proof->T = commit_out.T;
     proof->c = c_str;
-    sts = WriteFfElement(Fp, noncek, &proof->noncek, sizeof(proof->noncek));
+    sts = WriteFfElement(Fp, state->noncek, &proof->noncek,
+                         sizeof(proof->noncek));
 
     if (IsIdentity(&proof->T)) {
       sts = kEpidSigRevokedInSigRl;
@@ -305,25 +367,92 @@ EpidStatus EpidNrProve(MemberCtx const* ctx, void const* msg, size_t msg_len,
   if (is_counter_set == true) {
     (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, counter, ctx->f_handle);
   }
-  SAFE_FREE(s2);
   EpidZeroMemory(&mu_str, sizeof(mu_str));
   EpidZeroMemory(&nu_str, sizeof(nu_str));
   EpidZeroMemory(&rmu_str, sizeof(rmu_str));
-  DeleteFfElement(&y2);
-  DeleteEcPoint(&B);
-  DeleteEcPoint(&K);
-  DeleteEcPoint(&rlB);
-  DeleteEcPoint(&rlK);
-  DeleteEcPoint(&D);
-  DeleteEcPoint(&t);
-  DeleteEcPoint(&e_tpm);
-  DeleteEcPoint(&l_tpm);
-  DeleteEcPoint(&k_tpm);
-  DeleteFfElement(&mu);
-  DeleteFfElement(&nu);
-  DeleteFfElement(&rmu);
-  DeleteFfElement(&t2);
-  DeleteFfElement(&noncek);
 
   return sts;
 }
+
+EpidStatus EpidNrProveBatch(MemberCtx const* ctx, void const* msg,
+                            size_t msg_len, void const* basename,
+                            size_t basename_len, BasicSignature const* sig,
+                            SigRlEntry const* sigrl_entries, size_t num_entries,
+                            SplitNrProof* proofs) {
+  EpidStatus sts = kEpidErr;
+  NrProveState state = {0};
+
+  if (!ctx || (0 != msg_len && !msg) || !sig || !sigrl_entries || !proofs)
+    return kEpidBadArgErr;
+  if (!basename || 0 == basename_len) {
+    // basename should not be empty
+    return kEpidBadArgErr;
+  }
+  if (!ctx->epid2_params) return kEpidBadArgErr;
+
+  sts = InitNrProveState(ctx, msg, msg_len, basename, basename_len, sig,
+                         &state);
+  if (kEpidNoErr == sts) {
+    size_t i = 0;
+    for (i = 0; i < num_entries; i++) {
+      EpidStatus proof_sts =
+          ComputeNrProof(ctx, &state, &sigrl_entries[i], &proofs[i]);
+      if (kEpidNoErr != proof_sts) {
+        // keep going so that every proof is produced
+        sts = proof_sts;
+      }
+    }
+  }
+  ClearNrProveState(&state);
+
+  return sts;
+}
+
+EpidStatus NewNrProveState(MemberCtx const* ctx, void const* msg,
+                           size_t msg_len, void const* basename,
+                           size_t basename_len, BasicSignature const* sig,
+                           NrProveState** state) {
+  EpidStatus sts = kEpidErr;
+  NrProveState* new_state = NULL;
+
+  if (!ctx || (0 != msg_len && !msg) || !sig || !state) return kEpidBadArgErr;
+  if (!basename || 0 == basename_len) {
+    // basename should not be empty
+    return kEpidBadArgErr;
+  }
+  if (!ctx->epid2_params) return kEpidBadArgErr;
+
+  new_state = SAFE_ALLOC(sizeof(*new_state));
+  if (!new_state) return kEpidMemAllocErr;
+  sts = InitNrProveState(ctx, msg, msg_len, basename, basename_len, sig,
+                         new_state);
+  if (kEpidNoErr != sts) {
+    ClearNrProveState(new_state);
+    SAFE_FREE(new_state);
+    return sts;
+  }
+  *state = new_state;
+  return kEpidNoErr;
+}
+
+EpidStatus EpidNrProveEntry(MemberCtx const* ctx, NrProveState* state,
+                            SigRlEntry const* sigrl_entry,
+                            SplitNrProof* proof) {
+  if (!ctx || !state || !sigrl_entry || !proof) return kEpidBadArgErr;
+  return ComputeNrProof(ctx, state, sigrl_entry, proof);
+}
+
+void DeleteNrProveState(NrProveState** state) {
+  if (state && *state) {
+    ClearNrProveState(*state);
+    SAFE_FREE(*state);
+  }
+}
+
+EpidStatus EpidNrProve(MemberCtx const* ctx, void const* msg, size_t msg_len,
+                       void const* basename, size_t basename_len,
+                       BasicSignature const* sig, SigRlEntry const* sigrl_entry,
+                       SplitNrProof* proof) {
+  return EpidNrProveBatch(ctx, msg, msg_len, basename, basename_len, sig,
+                          sigrl_entry, 1, proof);
+}
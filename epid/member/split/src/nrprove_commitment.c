@@ -42,45 +42,51 @@ typedef struct NrProveCommitValues {
 } NrProveCommitValues;
 #pragma pack()
 
-EpidStatus HashNrProveCommitment(FiniteField* Fp, HashAlg hash_alg,
-                                 G1ElemStr const* B_str, G1ElemStr const* K_str,
-                                 SigRlEntry const* sigrl_entry,
-                                 NrProveCommitOutput const* commit_out,
-                                 void const* msg, size_t msg_len,
-                                 FpElemStr* c_str) {
+/// Commitment values of all non-revoked proofs of a signature
+struct NrProveCommitment {
+  size_t commit_len;                   ///< Number of bytes to hash
+  NrProveCommitValues* commit_values;  ///< Values to hash
+};
+
+EpidStatus NewNrProveCommitment(G1ElemStr const* B_str, G1ElemStr const* K_str,
+                                void const* msg, size_t msg_len,
+                                NrProveCommitment** commitment) {
   EpidStatus sts = kEpidErr;
-  FfElement* c = NULL;
-  NrProveCommitValues* commit_values = NULL;
+  NrProveCommitment* new_commitment = NULL;
 
-  if (!Fp || !B_str || !K_str || !sigrl_entry || !commit_out ||
-      (0 != msg_len && !msg) || !c_str) {
+  if (!B_str || !K_str || (0 != msg_len && !msg) || !commitment) {
     return kEpidBadArgErr;
   }
 
-  if (msg_len >
-      ((SIZE_MAX - sizeof(*commit_values)) + sizeof(*commit_values->msg)))
+  if (msg_len > ((SIZE_MAX - sizeof(*new_commitment->commit_values)) +
+                 sizeof(*new_commitment->commit_values->msg)))
     return kEpidBadArgErr;
 
   do {
+    NrProveCommitValues* commit_values = NULL;
     size_t const commit_len =
         sizeof(*commit_values) - sizeof(*commit_values->msg) + msg_len;
     Epid2Params params = {
 #include "common/epid2params_ate.inc"
     };
 
+    new_commitment = SAFE_ALLOC(sizeof(*new_commitment));
+    if (!new_commitment) {
+      sts = kEpidMemAllocErr;
+      BREAK_ON_EPID_ERROR(sts);
+    }
     commit_values = SAFE_ALLOC(commit_len);
     if (!commit_values) {
       sts = kEpidMemAllocErr;
       BREAK_ON_EPID_ERROR(sts);
     }
+    new_commitment->commit_values = commit_values;
+    new_commitment->commit_len = commit_len;
 
     commit_values->p = params.p;
     commit_values->g1 = params.g1;
     commit_values->B = *B_str;
     commit_values->K = *K_str;
-    commit_values->rlB = sigrl_entry->b;
-    commit_values->rlK = sigrl_entry->k;
-    commit_values->commit_out = *commit_out;
 
     // commit_values is allocated such that there are msg_len bytes available
     // starting at commit_values->msg
@@ -92,12 +98,47 @@ EpidStatus HashNrProveCommitment(FiniteField* Fp, HashAlg hash_alg,
       }
     }
 
+    *commitment = new_commitment;
+    sts = kEpidNoErr;
+  } while (0);
+
+  if (kEpidNoErr != sts) {
+    DeleteNrProveCommitment(&new_commitment);
+  }
+  return sts;
+}
+
+void DeleteNrProveCommitment(NrProveCommitment** commitment) {
+  if (commitment && *commitment) {
+    SAFE_FREE((*commitment)->commit_values);
+    SAFE_FREE(*commitment);
+  }
+}
+
+EpidStatus HashNrProveCommitmentEntry(FiniteField* Fp, HashAlg hash_alg,
+                                      NrProveCommitment* commitment,
+                                      SigRlEntry const* sigrl_entry,
+                                      NrProveCommitOutput const* commit_out,
+                                      FpElemStr* c_str) {
+  EpidStatus sts = kEpidErr;
+  FfElement* c = NULL;
+
+  if (!Fp || !commitment || !sigrl_entry || !commit_out || !c_str) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    NrProveCommitValues* commit_values = commitment->commit_values;
+    commit_values->rlB = sigrl_entry->b;
+    commit_values->rlK = sigrl_entry->k;
+    commit_values->commit_out = *commit_out;
+
     sts = NewFfElement(Fp, &c);
     BREAK_ON_EPID_ERROR(sts);
 
     // 7.  The member computes c = Fp.hash(p || g1 || B || K || B' ||
     //     K' || T || R1 || R2 || m).
-    sts = FfHash(Fp, commit_values, commit_len, hash_alg, c);
+    sts = FfHash(Fp, commit_values, commitment->commit_len, hash_alg, c);
     BREAK_ON_EPID_ERROR(sts);
 
     sts = WriteFfElement(Fp, c, c_str, sizeof(*c_str));
@@ -106,8 +147,31 @@ EpidStatus HashNrProveCommitment(FiniteField* Fp, HashAlg hash_alg,
     sts = kEpidNoErr;
   } while (0);
 
-  SAFE_FREE(commit_values);
   DeleteFfElement(&c);
 
   return sts;
 }
+
+EpidStatus HashNrProveCommitment(FiniteField* Fp, HashAlg hash_alg,
+                                 G1ElemStr const* B_str, G1ElemStr const* K_str,
+                                 SigRlEntry const* sigrl_entry,
+                                 NrProveCommitOutput const* commit_out,
+                                 void const* msg, size_t msg_len,
+                                 FpElemStr* c_str) {
+  EpidStatus sts = kEpidErr;
+  NrProveCommitment* commitment = NULL;
+
+  if (!Fp || !B_str || !K_str || !sigrl_entry || !commit_out ||
+      (0 != msg_len && !msg) || !c_str) {
+    return kEpidBadArgErr;
+  }
+
+  sts = NewNrProveCommitment(B_str, K_str, msg, msg_len, &commitment);
+  if (kEpidNoErr == sts) {
+    sts = HashNrProveCommitmentEntry(Fp, hash_alg, commitment, sigrl_entry,
+                                     commit_out, c_str);
+  }
+  DeleteNrProveCommitment(&commitment);
+
+  return sts;
+}
@@ -34,18 +34,32 @@ EpidStatus PrecomputeMemberPairing(Epid2Params_ const* epid2_params,
                                    MemberPrecomp* precomp) {
   EpidStatus sts = kEpidErr;
 
+  if (!epid2_params || !pub_key || !A_str || !precomp) return kEpidBadArgErr;
+
+  // steps 1 to 3
+  sts = PrecomputeGroupPairing(epid2_params, pub_key, precomp);
+  if (kEpidNoErr != sts) return sts;
+
+  // step 4
+  return PrecomputeMemberPairingA(epid2_params, A_str, precomp);
+}
+
+EpidStatus PrecomputeGroupPairing(Epid2Params_ const* epid2_params,
+                                  GroupPubKey const* pub_key,
+                                  MemberPrecomp* precomp) {
+  EpidStatus sts = kEpidErr;
+
   GroupPubKey_* pub_key_ = NULL;
-  EcPoint* A = NULL;
   FfElement* e = NULL;
 
-  if (!epid2_params || !pub_key || !A_str || !precomp) return kEpidBadArgErr;
+  if (!epid2_params || !pub_key || !precomp) return kEpidBadArgErr;
 
   do {
     EcGroup* G1 = epid2_params->G1;
     EcGroup* G2 = epid2_params->G2;
     FiniteField* GT = epid2_params->GT;
     PairingState* ps_ctx = epid2_params->pairing_state;
-    EcPoint* g2 = epid2_params->g2;
+    PairingG2Precomp const* g2_lines = epid2_params->g2_lines;
 
     sts = CreateGroupPubKey(pub_key, G1, G2, &pub_key_);
     BREAK_ON_EPID_ERROR(sts);
@@ -54,13 +68,13 @@ EpidStatus PrecomputeMemberPairing(Epid2Params_ const* epid2_params,
     BREAK_ON_EPID_ERROR(sts);
 
     // 1. The member computes e12 = pairing(h1, g2).
-    sts = Pairing(ps_ctx, pub_key_->h1, g2, e);
+    sts = PairingWithPrecomputedG2(ps_ctx, pub_key_->h1, g2_lines, e);
     BREAK_ON_EPID_ERROR(sts);
     sts = WriteFfElement(GT, e, &precomp->e12, sizeof(precomp->e12));
     BREAK_ON_EPID_ERROR(sts);
 
     // 2.  The member computes e22 = pairing(h2, g2).
-    sts = Pairing(ps_ctx, pub_key_->h2, g2, e);
+    sts = PairingWithPrecomputedG2(ps_ctx, pub_key_->h2, g2_lines, e);
     BREAK_ON_EPID_ERROR(sts);
     sts = WriteFfElement(GT, e, &precomp->e22, sizeof(precomp->e22));
     BREAK_ON_EPID_ERROR(sts);
@@ -71,12 +85,40 @@ EpidStatus PrecomputeMemberPairing(Epid2Params_ const* epid2_params,
     sts = WriteFfElement(GT, e, &precomp->e2w, sizeof(precomp->e2w));
     BREAK_ON_EPID_ERROR(sts);
 
+    sts = kEpidNoErr;
+  } while (0);
+
+  DeleteGroupPubKey(&pub_key_);
+  DeleteFfElement(&e);
+
+  return sts;
+}
+
+EpidStatus PrecomputeMemberPairingA(Epid2Params_ const* epid2_params,
+                                    G1ElemStr const* A_str,
+                                    MemberPrecomp* precomp) {
+  EpidStatus sts = kEpidErr;
+
+  EcPoint* A = NULL;
+  FfElement* e = NULL;
+
+  if (!epid2_params || !A_str || !precomp) return kEpidBadArgErr;
+
+  do {
+    EcGroup* G1 = epid2_params->G1;
+    FiniteField* GT = epid2_params->GT;
+    PairingState* ps_ctx = epid2_params->pairing_state;
+    PairingG2Precomp const* g2_lines = epid2_params->g2_lines;
+
+    sts = NewFfElement(GT, &e);
+    BREAK_ON_EPID_ERROR(sts);
+
     // 4.  The member computes ea2 = pairing(A, g2).
     sts = NewEcPoint(G1, &A);
     BREAK_ON_EPID_ERROR(sts);
     sts = ReadEcPoint(G1, A_str, sizeof(*A_str), A);
     BREAK_ON_EPID_ERROR(sts);
-    sts = Pairing(ps_ctx, A, g2, e);
+    sts = PairingWithPrecomputedG2(ps_ctx, A, g2_lines, e);
     BREAK_ON_EPID_ERROR(sts);
     sts = WriteFfElement(GT, e, &precomp->ea2, sizeof(precomp->ea2));
     BREAK_ON_EPID_ERROR(sts);
@@ -84,7 +126,6 @@ EpidStatus PrecomputeMemberPairing(Epid2Params_ const* epid2_params,
     sts = kEpidNoErr;
   } while (0);
 
-  DeleteGroupPubKey(&pub_key_);
   DeleteEcPoint(&A);
   DeleteFfElement(&e);
 
@@ -18,18 +18,22 @@
 #define EXPORT_EPID_APIS
 #include <epid/member/api.h>
 
+#include <stdint.h>
 #include <string.h>
 
 #include "common/endian_convert.h"
 #include "common/epid2params.h"
-#include "common/stack.h"
+#include "common/ring.h"
 #include "epid/member/split/context.h"
+#include "epid/member/split/presig-internal.h"
 #include "epid/member/split/tpm2/commit.h"
 #include "epid/member/split/tpm2/context.h"
 #include "epid/member/split/tpm2/getrandom.h"
 #include "epid/member/split/tpm2/keyinfo.h"
 #include "epid/member/split/tpm2/sign.h"
+#include "ippmath/ecglv.h"
 #include "ippmath/ecgroup.h"
+#include "ippmath/expworkspace.h"
 #include "ippmath/finitefield.h"
 #include "ippmath/memory.h"
 #include "ippmath/pairing.h"
@@ -43,127 +47,398 @@
 /// Count of elements in array
 #define COUNT_OF(A) (sizeof(A) / sizeof((A)[0]))
 
+/// Temporary values used to compute pre-computed signatures
+typedef struct PreSigScratch {
+  FfElement* p2y;     ///< y-coordinate of B
+  EcPoint* B;         ///< an element in G1
+  EcPoint* k;         ///< an element in G1
+  EcPoint* t;         ///< temporary, used for K, T, R1
+  EcPoint* e;         ///< an element in G1
+  FfElement* R2;      ///< an element in GT
+  FfElement* a;       ///< an integer between [1, p-1]
+  FfElement* rx;      ///< reused for rf
+  FfElement* rb;      ///< reused for ra
+  FfElement* t1;      ///< an integer between [0, p-1]
+  FfElement* t2;      ///< an integer between [0, p-1]
+  ExpWorkspace* ws;  ///< workspace of the GT multi-exponentiation
+} PreSigScratch;
+
+/// Member values a pre-computed signature is computed from
+typedef struct PreSigValues {
+  Epid2Params_ const* params;  ///< parameters the values below belong to
+  EcPoint const* h2;           ///< group public key h2 value
+  EcPoint const* A;            ///< membership credential A value
+  FfElement const* x;          ///< membership credential x value
+  FfElement const* ea2;        ///< an element in GT, = pairing (g1, g2)
+  FfElement const* e22;        ///< an element in GT, = pairing (h2, g2)
+  FfElement const* e2w;        ///< an element in GT, = pairing (h2, w)
+} PreSigValues;
+
+/// State kept by one task of a parallel EpidAddPreSigs
+/*!
+ The finite fields and groups keep temporaries of their own, so every task
+ works with its own parameters and its own copies of the member values.
+ Setting up the parameters costs about as much as one pre-computed
+ signature, so the state is kept in the member context for later calls.
+ */
+struct PreSigWorker {
+  Epid2Params_* params;   ///< parameters owned by the task
+  PreSigScratch scratch;  ///< temporary values in params
+  EcPoint* h2;            ///< copy of the member h2 in params
+  EcPoint* A;             ///< copy of the member A in params
+  FfElement* x;           ///< copy of the member x in params
+  FfElement* ea2;         ///< copy of the member ea2 in params
+  FfElement* e22;         ///< copy of the member e22 in params
+  FfElement* e2w;         ///< copy of the member e2w in params
+};
+
+/// Data shared by the tasks of a parallel EpidAddPreSigs
+typedef struct AddPreSigsTaskParam {
+  MemberCtx const* ctx;    ///< member context
+  G1ElemStr const* e;      ///< ETPM of each pre-computed signature
+  Ring* presigs;           ///< pool holding them in its free slots
+  size_t number_presigs;   ///< number of entries in e and free slots used
+  size_t number_tasks;     ///< number of tasks sharing the entries
+  PreSigWorker** workers;  ///< state of each task, created on demand
+} AddPreSigsTaskParam;
+
+static EpidStatus NewPreSigScratch(Epid2Params_ const* params,
+                                   PreSigScratch* scratch);
+
+static void DeletePreSigScratch(PreSigScratch* scratch);
+
+static EpidStatus CommitPreSig(MemberCtx const* ctx, PreSigScratch* scratch,
+                               G1ElemStr* e_str,
+                               PreComputedSignature* precompsig);
+
+static EpidStatus FinishPreSig(MemberCtx const* ctx,
+                               PreSigValues const* values,
+                               PreSigScratch* scratch, G1ElemStr const* e_str,
+                               PreComputedSignature* precompsig);
+
+static EpidStatus ComputePreSig(MemberCtx const* ctx, PreSigScratch* scratch,
+                                PreComputedSignature* precompsig);
+
+static EpidStatus AddPreSigsInParallel(MemberCtx* ctx,
+                                       size_t number_presigs);
+
+static EpidStatus GrowPreSigPool(MemberCtx* ctx, size_t number_presigs);
+
 static EpidStatus MemberComputePreSig(MemberCtx const* ctx,
                                       PreComputedSignature* precompsig);
 
 EpidStatus EPID_MEMBER_API EpidAddPreSigs(MemberCtx* ctx,
                                           size_t number_presigs) {
-  PreComputedSignature* new_presigs = NULL;
+  EpidStatus sts = kEpidErr;
+  PreComputedSignature* new_presig = NULL;
+  PreSigScratch scratch = {0};
   size_t i = 0;
-  if (!ctx || !ctx->presigs) return kEpidBadArgErr;
+  if (!ctx) return kEpidBadArgErr;
 
   if (0 == number_presigs) return kEpidNoErr;
 
-  new_presigs =
-      (PreComputedSignature*)StackPushN(ctx->presigs, number_presigs, NULL);
-  if (!new_presigs) return kEpidMemAllocErr;
+  if (!RingGetFree(&ctx->presigs, number_presigs - 1)) {
+    sts = GrowPreSigPool(ctx, number_presigs);
+    if (kEpidNoErr != sts) return sts;
+  }
 
-  for (i = 0; i < number_presigs; i++) {
-    EpidStatus sts = MemberComputePreSig(ctx, &new_presigs[i]);
-    if (kEpidNoErr != sts) {
-      // roll back pre-computed-signature pool
-      StackPopN(ctx->presigs, number_presigs, 0);
-      return sts;
+  // free slots of the pool are clear, so no counter is set yet
+  if (ctx->parallel_for && number_presigs > 1) {
+    sts = AddPreSigsInParallel(ctx, number_presigs);
+  } else {
+    // the temporary values are shared by all pre-computed signatures of the
+    // batch
+    sts = NewPreSigScratch(ctx->epid2_params, &scratch);
+    for (i = 0; kEpidNoErr == sts && i < number_presigs; i++) {
+      sts = ComputePreSig(ctx, &scratch, RingGetFree(&ctx->presigs, i));
+    }
+    DeletePreSigScratch(&scratch);
+  }
+  if (kEpidNoErr != sts) {
+    // roll back pre-computed-signature pool, nothing has been added yet
+    for (i = 0; i < number_presigs; i++) {
+      new_presig = RingGetFree(&ctx->presigs, i);
+      if (new_presig->is_rf_ctr_set) {
+        (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, new_presig->rf_ctr,
+                                 ctx->f_handle);
+      }
+      RingWipe(new_presig, sizeof(*new_presig));
     }
+    return sts;
+  }
+  if (!RingPushN(&ctx->presigs, number_presigs)) {
+    return kEpidErr;
   }
 
   return kEpidNoErr;
 }
 
 size_t EPID_MEMBER_API EpidGetNumPreSigs(MemberCtx const* ctx) {
-  return (ctx && ctx->presigs) ? StackGetSize(ctx->presigs) : (size_t)0;
+  return ctx ? RingGetSize(&ctx->presigs) : (size_t)0;
+}
+
+EpidStatus EPID_MEMBER_API EpidSetPreSigWatermarks(MemberCtx* ctx,
+                                                   size_t low_watermark,
+                                                   size_t high_watermark) {
+  if (!ctx) return kEpidBadArgErr;
+  if (high_watermark <= low_watermark &&
+      !(0 == low_watermark && 0 == high_watermark)) {
+    return kEpidBadArgErr;
+  }
+  ctx->presig_low_watermark = low_watermark;
+  ctx->presig_high_watermark = high_watermark;
+  ctx->is_presig_refilling = false;
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidRefillPreSigs(MemberCtx* ctx,
+                                             size_t max_number_presigs) {
+  EpidStatus sts = kEpidErr;
+  size_t size = 0;
+  size_t number_presigs = 0;
+  if (!ctx) return kEpidBadArgErr;
+
+  if (0 == ctx->presig_high_watermark) return kEpidNoErr;
+
+  size = RingGetSize(&ctx->presigs);
+  if (size <= ctx->presig_low_watermark) {
+    ctx->is_presig_refilling = true;
+  }
+  if (!ctx->is_presig_refilling) return kEpidNoErr;
+  if (size >= ctx->presig_high_watermark) {
+    ctx->is_presig_refilling = false;
+    return kEpidNoErr;
+  }
+
+  number_presigs = ctx->presig_high_watermark - size;
+  if (max_number_presigs > 0 && max_number_presigs < number_presigs) {
+    number_presigs = max_number_presigs;
+  }
+  sts = EpidAddPreSigs(ctx, number_presigs);
+  if (kEpidNoErr != sts) return sts;
+
+  if (RingGetSize(&ctx->presigs) >= ctx->presig_high_watermark) {
+    ctx->is_presig_refilling = false;
+  }
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidGetPreSigStats(MemberCtx const* ctx,
+                                              size_t* hits, size_t* misses) {
+  if (!ctx || !hits || !misses) return kEpidBadArgErr;
+  *hits = ctx->presig_hits;
+  *misses = ctx->presig_misses;
+  return kEpidNoErr;
+}
+
+// Pre-computed signatures of a split member refer to commits held by the TPM,
+// which do not survive a restart, so they cannot be stored outside the
+// process.
+EpidStatus EPID_MEMBER_API EpidGetPreSigStoreSize(MemberCtx const* ctx,
+                                                  size_t number_presigs,
+                                                  size_t* store_size) {
+  (void)ctx;
+  (void)number_presigs;
+  (void)store_size;
+  return kEpidOperationNotSupportedErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidExportPreSigs(MemberCtx* ctx, void* store,
+                                             size_t store_size) {
+  (void)ctx;
+  (void)store;
+  (void)store_size;
+  return kEpidOperationNotSupportedErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidImportPreSigs(MemberCtx* ctx, void* store,
+                                             size_t store_size) {
+  (void)ctx;
+  (void)store;
+  (void)store_size;
+  return kEpidOperationNotSupportedErr;
+}
+
+// The pool of a split member is allocated on the heap and grows on demand.
+EpidStatus EPID_MEMBER_API EpidGetPreSigBufferSize(MemberCtx const* ctx,
+                                                   size_t number_presigs,
+                                                   size_t* buffer_size) {
+  (void)ctx;
+  (void)number_presigs;
+  (void)buffer_size;
+  return kEpidOperationNotSupportedErr;
 }
 
-EpidStatus MemberGetPreSig(MemberCtx* ctx, PreComputedSignature* presig) {
+EpidStatus EPID_MEMBER_API EpidMemberSetPreSigBuffer(MemberCtx* ctx,
+                                                     void* buffer,
+                                                     size_t buffer_size) {
+  (void)ctx;
+  (void)buffer;
+  (void)buffer_size;
+  return kEpidOperationNotSupportedErr;
+}
+
+EpidStatus MemberTopPreSig(MemberCtx* ctx, PreComputedSignature* scratch,
+                           PreComputedSignature** presig) {
+  EpidStatus sts = kEpidErr;
+  if (!ctx || !scratch || !presig) {
+    return kEpidBadArgErr;
+  }
+
+  // Use existing pre-computed signature in place
+  *presig = RingFront(&ctx->presigs);
+  if (*presig) {
+    ctx->presig_hits++;
+    return kEpidNoErr;
+  }
+  // the pool is empty, compute one outside of it so that the slots stay
+  // owned by the code adding pre-computed signatures
+  ctx->presig_misses++;
+  sts = MemberComputePreSig(ctx, scratch);
+  if (kEpidNoErr != sts) {
+    EpidZeroMemory(scratch, sizeof(*scratch));
+    return sts;
+  }
+  *presig = scratch;
+  return kEpidNoErr;
+}
+
+EpidStatus MemberPopPreSig(MemberCtx* ctx, PreComputedSignature* presig) {
   if (!ctx || !presig) {
     return kEpidBadArgErr;
   }
 
-  if (StackGetSize(ctx->presigs)) {
-    // Use existing pre-computed signature
-    if (!StackPopN(ctx->presigs, 1, presig)) {
-      return kEpidErr;
-    }
+  if (presig != RingFront(&ctx->presigs)) {
+    EpidZeroMemory(presig, sizeof(*presig));
     return kEpidNoErr;
   }
-  // generate a new pre-computed signature
-  return MemberComputePreSig(ctx, presig);
+  // popping clears the pool slot
+  if (!RingPop(&ctx->presigs)) {
+    return kEpidErr;
+  }
+  return kEpidNoErr;
 }
 
 /// Performs Pre-computation that can be used to speed up signing
 EpidStatus MemberComputePreSig(MemberCtx const* ctx,
                                PreComputedSignature* precompsig) {
   EpidStatus sts = kEpidErr;
+  PreSigScratch scratch = {0};
 
-  EcPoint* B = NULL;
-  EcPoint* k = NULL;
-  EcPoint* t = NULL;  // temporary, used for K, T, R1
-  EcPoint* e = NULL;
-
-  FfElement* R2 = NULL;
+  if (!ctx || !precompsig || !ctx->epid2_params) {
+    return kEpidBadArgErr;
+  }
 
-  FfElement* a = NULL;
-  FfElement* rx = NULL;  // reused for rf
-  FfElement* rb = NULL;  // reused for ra
+  sts = NewPreSigScratch(ctx->epid2_params, &scratch);
+  if (kEpidNoErr == sts) {
+    sts = ComputePreSig(ctx, &scratch, precompsig);
+  }
+  DeletePreSigScratch(&scratch);
+  return sts;
+}
 
-  FfElement* t1 = NULL;
-  FfElement* t2 = NULL;
-  BigNumStr t1_str = {0};
-  BigNumStr t2_str = {0};
-  struct {
-    uint32_t i;
-    BigNumStr bsn;
-  } p2x = {0};
-  FfElement* p2y = NULL;
+/// Allocates the temporary values used to compute pre-computed signatures
+static EpidStatus NewPreSigScratch(Epid2Params_ const* params,
+                                   PreSigScratch* scratch) {
+  EpidStatus sts = kEpidErr;
 
-  if (!ctx || !precompsig || !ctx->epid2_params) {
+  if (!params || !scratch) {
     return kEpidBadArgErr;
   }
 
   do {
-    // handy shorthands:
-    Tpm2Ctx* tpm = ctx->tpm2_ctx;
-    EcGroup* G1 = ctx->epid2_params->G1;
-    FiniteField* GT = ctx->epid2_params->GT;
-    FiniteField* Fp = ctx->epid2_params->Fp;
-    FiniteField* Fq = ctx->epid2_params->Fq;
-    EcPoint const* h2 = ctx->h2;
-    EcPoint const* A = ctx->A;
-    FfElement const* x = ctx->x;
-    PairingState* ps_ctx = ctx->epid2_params->pairing_state;
-    HashAlg hash_alg = Tpm2KeyHashAlg(ctx->f_handle);
+    EcGroup* G1 = params->G1;
+    FiniteField* GT = params->GT;
+    FiniteField* Fp = params->Fp;
+    FiniteField* Fq = params->Fq;
 
-    const BigNumStr kOne = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
-    // 1. The member expects the pre-computation is done (e12, e22, e2w,
-    //    ea2). Refer to Section 3.5 for the computation of these
-    //    values.
-
-    sts = NewFfElement(Fq, &p2y);
     // The following variables B, K, T, R1 (elements of G1), R2
     // (elements of GT), a, b, rx, rf, ra, rb, t1, t2 (256-bit
     // integers) are used.
+    sts = NewFfElement(Fq, &scratch->p2y);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &B);
+    sts = NewEcPoint(G1, &scratch->B);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &k);
+    sts = NewEcPoint(G1, &scratch->k);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &t);
+    sts = NewEcPoint(G1, &scratch->t);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewEcPoint(G1, &e);
+    sts = NewEcPoint(G1, &scratch->e);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(GT, &R2);
+    sts = NewFfElement(GT, &scratch->R2);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(Fp, &a);
+    sts = NewFfElement(Fp, &scratch->a);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(Fp, &rx);
+    sts = NewFfElement(Fp, &scratch->rx);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(Fp, &rb);
+    sts = NewFfElement(Fp, &scratch->rb);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(Fp, &t1);
+    sts = NewFfElement(Fp, &scratch->t1);
     BREAK_ON_EPID_ERROR(sts);
-    sts = NewFfElement(Fp, &t2);
+    sts = NewFfElement(Fp, &scratch->t2);
     BREAK_ON_EPID_ERROR(sts);
+    sts = NewExpWorkspace(4, &scratch->ws);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = kEpidNoErr;
+  } while (0);
+
+  if (kEpidNoErr != sts) {
+    DeletePreSigScratch(scratch);
+  }
+  return sts;
+}
+
+/// Frees the temporary values used to compute pre-computed signatures
+static void DeletePreSigScratch(PreSigScratch* scratch) {
+  DeleteFfElement(&scratch->p2y);
+  DeleteEcPoint(&scratch->B);
+  DeleteEcPoint(&scratch->k);
+  DeleteEcPoint(&scratch->t);
+  DeleteEcPoint(&scratch->e);
+  DeleteFfElement(&scratch->R2);
+  DeleteFfElement(&scratch->a);
+  DeleteFfElement(&scratch->rx);
+  DeleteFfElement(&scratch->rb);
+  DeleteFfElement(&scratch->t1);
+  DeleteFfElement(&scratch->t2);
+  DeleteExpWorkspace(&scratch->ws);
+}
+
+/// Makes the TPM commit of a pre-computed signature
+/*!
+ Computes B, K and R1. ETPM is written to e_str for FinishPreSig. If the
+ call fails, no counter is held.
+ */
+static EpidStatus CommitPreSig(MemberCtx const* ctx, PreSigScratch* scratch,
+                               G1ElemStr* e_str,
+                               PreComputedSignature* precompsig) {
+  EpidStatus sts = kEpidErr;
+
+  // handy shorthands for the temporary values:
+  EcPoint* B = scratch->B;
+  EcPoint* k = scratch->k;
+  EcPoint* t = scratch->t;  // temporary, used for L
+  EcPoint* e = scratch->e;
+  struct {
+    uint32_t i;
+    BigNumStr bsn;
+  } p2x = {0};
+  FfElement* p2y = scratch->p2y;
+
+  if (!ctx || !e_str || !precompsig || !ctx->epid2_params) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    // handy shorthands:
+    Tpm2Ctx* tpm = ctx->tpm2_ctx;
+    EcGroup* G1 = ctx->epid2_params->G1;
+    FiniteField* Fq = ctx->epid2_params->Fq;
+    HashAlg hash_alg = Tpm2KeyHashAlg(ctx->f_handle);
+
+    // 1. The member expects the pre-computation is done (e12, e22, e2w,
+    //    ea2). Refer to Section 3.5 for the computation of these
+    //    values.
 
     // 3. The member computes B = G1.getRandom().
     // 4.a. If bsn is not provided, the member chooses randomly an integer bsn
@@ -193,6 +468,66 @@ EpidStatus MemberComputePreSig(MemberCtx const* ctx,
     // 4.k. The member computes R1 = LTPM.
     sts = WriteEcPoint(G1, t, &precompsig->R1, sizeof(precompsig->R1));
     BREAK_ON_EPID_ERROR(sts);
+    sts = WriteEcPoint(G1, e, e_str, sizeof(*e_str));
+    BREAK_ON_EPID_ERROR(sts);
+
+    sts = kEpidNoErr;
+  } while (0);
+
+  if (sts != kEpidNoErr && precompsig->is_rf_ctr_set == true) {
+    (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, precompsig->rf_ctr, ctx->f_handle);
+    precompsig->is_rf_ctr_set = false;
+  }
+
+  EpidZeroMemory(&p2x, sizeof(p2x));
+
+  return sts;
+}
+
+/// Computes the values of a pre-computed signature that need no TPM
+/*!
+ Only uses the member context for its random number generator, so
+ pre-computed signatures can be finished concurrently as long as each
+ call has its own values and scratch.
+ */
+static EpidStatus FinishPreSig(MemberCtx const* ctx,
+                               PreSigValues const* values,
+                               PreSigScratch* scratch, G1ElemStr const* e_str,
+                               PreComputedSignature* precompsig) {
+  EpidStatus sts = kEpidErr;
+
+  // handy shorthands for the temporary values:
+  EcPoint* t = scratch->t;  // temporary, used for T
+  EcPoint* e = scratch->e;
+
+  FfElement* R2 = scratch->R2;
+
+  FfElement* a = scratch->a;
+  FfElement* rx = scratch->rx;  // reused for rf
+  FfElement* rb = scratch->rb;  // reused for ra
+
+  FfElement* t1 = scratch->t1;
+  FfElement* t2 = scratch->t2;
+  BigNumStr t1_str = {0};
+  BigNumStr t2_str = {0};
+
+  if (!ctx || !values || !e_str || !precompsig) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    // handy shorthands:
+    Epid2Params_ const* params = values->params;
+    EcGroup* G1 = params->G1;
+    FiniteField* GT = params->GT;
+    FiniteField* Fp = params->Fp;
+    EcPoint const* h2 = values->h2;
+    EcPoint const* A = values->A;
+    FfElement const* x = values->x;
+    PairingState* ps_ctx = params->pairing_state;
+
+    const BigNumStr kOne = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
 
     // 4.d. The member chooses randomly an integer a from [1, p-1].
     sts = FfGetRandom(Fp, &kOne, ctx->rnd_func, ctx->rnd_param, a);
@@ -200,7 +535,7 @@ EpidStatus MemberComputePreSig(MemberCtx const* ctx,
     sts = WriteFfElement(Fp, a, &precompsig->a, sizeof(precompsig->a));
     BREAK_ON_EPID_ERROR(sts);
     // 4.e. The member computes T = G1.sscmExp(h2, a).
-    sts = EcExp(G1, h2, (BigNumStr*)&precompsig->a, t);
+    sts = EcGlvSscmExp(params->G1_glv, h2, (BigNumStr*)&precompsig->a, t);
     BREAK_ON_EPID_ERROR(sts);
     // 4.k. The member computes T = G1.mul(T, A).
     sts = EcMul(G1, t, A, t);
@@ -246,7 +581,9 @@ EpidStatus MemberComputePreSig(MemberCtx const* ctx,
     BREAK_ON_EPID_ERROR(sts);
 
     // 4.l.i e12rf = pairing(ETPM, g2)
-    sts = Pairing(ps_ctx, e, ctx->epid2_params->g2, R2);
+    sts = ReadEcPoint(G1, e_str, sizeof(*e_str), e);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = PairingWithPrecomputedG2(ps_ctx, e, params->g2_lines, R2);
     BREAK_ON_EPID_ERROR(sts);
 
     // 4.l.ii. The member computes R2 = GT.sscmMultiExp(ea2, t1, e12rf, 1,
@@ -258,15 +595,16 @@ EpidStatus MemberComputePreSig(MemberCtx const* ctx,
     {
       FfElement const* points[4];
       BigNumStr const* exponents[4];
-      points[0] = ctx->ea2;
+      points[0] = values->ea2;
       points[1] = R2;
-      points[2] = ctx->e22;
-      points[3] = ctx->e2w;
+      points[2] = values->e22;
+      points[3] = values->e2w;
       exponents[0] = &t1_str;
       exponents[1] = &kOne;
       exponents[2] = &t2_str;
       exponents[3] = (BigNumStr*)&precompsig->ra;
-      sts = FfMultiExp(GT, points, exponents, COUNT_OF(points), R2);
+      sts = FfMultiExpWithWorkspace(GT, points, exponents, COUNT_OF(points),
+                                    scratch->ws, R2);
       BREAK_ON_EPID_ERROR(sts);
     }
 
@@ -276,26 +614,221 @@ EpidStatus MemberComputePreSig(MemberCtx const* ctx,
     sts = kEpidNoErr;
   } while (0);
 
+  EpidZeroMemory(&t1_str, sizeof(t1_str));
+  EpidZeroMemory(&t2_str, sizeof(t2_str));
+
+  return sts;
+}
+
+/// Computes a pre-computed signature using preallocated temporary values
+static EpidStatus ComputePreSig(MemberCtx const* ctx, PreSigScratch* scratch,
+                                PreComputedSignature* precompsig) {
+  EpidStatus sts = kEpidErr;
+  G1ElemStr e_str = {0};
+  PreSigValues values;
+
+  values.params = ctx->epid2_params;
+  values.h2 = ctx->h2;
+  values.A = ctx->A;
+  values.x = ctx->x;
+  values.ea2 = ctx->ea2;
+  values.e22 = ctx->e22;
+  values.e2w = ctx->e2w;
+
+  sts = CommitPreSig(ctx, scratch, &e_str, precompsig);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  sts = FinishPreSig(ctx, &values, scratch, &e_str, precompsig);
   if (sts != kEpidNoErr && precompsig->is_rf_ctr_set == true) {
     (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, precompsig->rf_ctr, ctx->f_handle);
     precompsig->is_rf_ctr_set = false;
   }
+  return sts;
+}
 
-  EpidZeroMemory(&t1_str, sizeof(t1_str));
-  EpidZeroMemory(&t2_str, sizeof(t2_str));
-  EpidZeroMemory(&p2x, sizeof(p2x));
+/// Creates the state of a task of a parallel EpidAddPreSigs
+static EpidStatus NewPreSigWorker(PreSigWorker** worker) {
+  EpidStatus sts = kEpidErr;
+  PreSigWorker* w = NULL;
+
+  w = SAFE_ALLOC(sizeof(*w));
+  if (!w) {
+    return kEpidMemAllocErr;
+  }
+  do {
+    sts = CreateEpid2Params(&w->params);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewPreSigScratch(w->params, &w->scratch);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewEcPoint(w->params->G1, &w->h2);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewEcPoint(w->params->G1, &w->A);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewFfElement(w->params->Fp, &w->x);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewFfElement(w->params->GT, &w->ea2);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewFfElement(w->params->GT, &w->e22);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = NewFfElement(w->params->GT, &w->e2w);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = kEpidNoErr;
+  } while (0);
 
-  DeleteFfElement(&p2y);
-  DeleteEcPoint(&B);
-  DeleteEcPoint(&k);
-  DeleteEcPoint(&t);
-  DeleteEcPoint(&e);
-  DeleteFfElement(&R2);
-  DeleteFfElement(&a);
-  DeleteFfElement(&rx);
-  DeleteFfElement(&rb);
-  DeleteFfElement(&t1);
-  DeleteFfElement(&t2);
+  if (kEpidNoErr != sts) {
+    DeletePreSigWorker(&w);
+    return sts;
+  }
+  *worker = w;
+  return kEpidNoErr;
+}
+
+void DeletePreSigWorker(PreSigWorker** worker) {
+  if (!worker || !*worker) {
+    return;
+  }
+  DeletePreSigScratch(&(*worker)->scratch);
+  DeleteEcPoint(&(*worker)->h2);
+  DeleteEcPoint(&(*worker)->A);
+  DeleteFfElement(&(*worker)->x);
+  DeleteFfElement(&(*worker)->ea2);
+  DeleteFfElement(&(*worker)->e22);
+  DeleteFfElement(&(*worker)->e2w);
+  DeleteEpid2Params(&(*worker)->params);
+  SAFE_FREE(*worker);
+}
+
+/// Reads the member values into the parameters of a task
+/*!
+ Only the serialized values of the member context are read, so tasks can
+ do this concurrently.
+ */
+static EpidStatus ReadPreSigValues(MemberCtx const* ctx, PreSigWorker* worker,
+                                   PreSigValues* values) {
+  EpidStatus sts = kEpidErr;
+  EcGroup* G1 = worker->params->G1;
+  FiniteField* Fp = worker->params->Fp;
+  FiniteField* GT = worker->params->GT;
+  MemberPrecomp const* precomp = &ctx->precomp;
+
+  do {
+    sts = ReadEcPoint(G1, &ctx->pub_key.h2, sizeof(ctx->pub_key.h2),
+                      worker->h2);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = ReadEcPoint(G1, &ctx->credential.A, sizeof(ctx->credential.A),
+                      worker->A);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = ReadFfElement(Fp, &ctx->credential.x, sizeof(ctx->credential.x),
+                        worker->x);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = ReadFfElement(GT, &precomp->ea2, sizeof(precomp->ea2), worker->ea2);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = ReadFfElement(GT, &precomp->e22, sizeof(precomp->e22), worker->e22);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = ReadFfElement(GT, &precomp->e2w, sizeof(precomp->e2w), worker->e2w);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = kEpidNoErr;
+  } while (0);
 
+  values->params = worker->params;
+  values->h2 = worker->h2;
+  values->A = worker->A;
+  values->x = worker->x;
+  values->ea2 = worker->ea2;
+  values->e22 = worker->e22;
+  values->e2w = worker->e2w;
   return sts;
 }
+
+/// Finishes the pre-computed signatures of one task
+static EpidStatus __STDCALL AddPreSigsTask(void* task_param, size_t index) {
+  AddPreSigsTaskParam const* param = (AddPreSigsTaskParam const*)task_param;
+  EpidStatus sts = kEpidErr;
+  PreSigWorker** worker = &param->workers[index];
+  PreSigValues values;
+  // number_presigs is far below SIZE_MAX / MAX_PRESIG_TASKS, as e holds
+  // that many entries
+  size_t first = index * param->number_presigs / param->number_tasks;
+  size_t end = (index + 1) * param->number_presigs / param->number_tasks;
+  size_t i = 0;
+
+  if (!*worker) {
+    sts = NewPreSigWorker(worker);
+    if (kEpidNoErr != sts) {
+      return sts;
+    }
+  }
+  sts = ReadPreSigValues(param->ctx, *worker, &values);
+  for (i = first; kEpidNoErr == sts && i < end; i++) {
+    sts = FinishPreSig(param->ctx, &values, &(*worker)->scratch, &param->e[i],
+                       RingGetFree(param->presigs, i));
+  }
+  return sts;
+}
+
+/// Computes pre-computed signatures using the parallel loop of the member
+/*!
+ The TPM runs one command at a time, so the commits are made in sequence
+ first. The rest of each pre-computed signature only needs ETPM from its
+ commit and is handed to the parallel loop in at most MAX_PRESIG_TASKS
+ tasks of about equal size.
+ */
+static EpidStatus AddPreSigsInParallel(MemberCtx* ctx,
+                                       size_t number_presigs) {
+  EpidStatus sts = kEpidErr;
+  PreSigScratch scratch = {0};
+  G1ElemStr* e = NULL;
+  size_t i = 0;
+
+  // the pool holds number_presigs larger elements, so this cannot overflow
+  e = SAFE_ALLOC(number_presigs * sizeof(*e));
+  if (!e) {
+    return kEpidMemAllocErr;
+  }
+  sts = NewPreSigScratch(ctx->epid2_params, &scratch);
+  for (i = 0; kEpidNoErr == sts && i < number_presigs; i++) {
+    sts = CommitPreSig(ctx, &scratch, &e[i], RingGetFree(&ctx->presigs, i));
+  }
+  DeletePreSigScratch(&scratch);
+  if (kEpidNoErr == sts) {
+    AddPreSigsTaskParam param;
+    param.ctx = ctx;
+    param.e = e;
+    param.presigs = &ctx->presigs;
+    param.number_presigs = number_presigs;
+    param.number_tasks = number_presigs < MAX_PRESIG_TASKS ? number_presigs
+                                                           : MAX_PRESIG_TASKS;
+    param.workers = ctx->presig_workers;
+    sts = ctx->parallel_for(AddPreSigsTask, &param, param.number_tasks,
+                            ctx->parallel_for_param);
+  }
+  EpidZeroMemory(e, number_presigs * sizeof(*e));
+  SAFE_FREE(e);
+  return sts;
+}
+
+/// Makes room in the pool for number_presigs more pre-computed signatures
+/*!
+ The pool is moved to a larger heap, which clears the slots it leaves.
+ */
+static EpidStatus GrowPreSigPool(MemberCtx* ctx, size_t number_presigs) {
+  size_t size = RingGetSize(&ctx->presigs);
+  size_t capacity = 0;
+  void* heap = NULL;
+  unsigned char* old_heap = ctx->presigs.buf;
+  if (number_presigs > SIZE_MAX / sizeof(PreComputedSignature) - size) {
+    return kEpidMemAllocErr;
+  }
+  capacity = size + number_presigs;
+  heap = SAFE_ALLOC(capacity * sizeof(PreComputedSignature));
+  if (!heap) {
+    return kEpidMemAllocErr;
+  }
+  if (!RingMove(&ctx->presigs, capacity, heap)) {
+    SAFE_FREE(heap);
+    return kEpidErr;
+  }
+  SAFE_FREE(old_heap);
+  return kEpidNoErr;
+}
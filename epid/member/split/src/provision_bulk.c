@@ -19,9 +19,12 @@
 #include <epid/member/api.h>
 
 #include <string.h>
+#include "common/epid2params.h"
 #include "common/gid_parser.h"
 #include "common/validate_privkey.h"
 #include "epid/member/split/context.h"
+#include "epid/member/split/precomp.h"
+#include "epid/member/split/split_grouppubkey.h"
 #include "epid/member/split/storage.h"
 #include "epid/member/split/tpm2/context.h"
 #include "epid/member/split/tpm2/flushcontext.h"
@@ -110,3 +113,70 @@ EpidStatus EPID_MEMBER_API EpidProvisionKey(MemberCtx* ctx,
 
   return sts;
 }
+
+EpidStatus EPID_MEMBER_API EpidPrepareProvisionKeys(GroupPubKey const* pub_key,
+                                                    PrivKey const* priv_keys,
+                                                    size_t count,
+                                                    MemberPrecomp* precomps,
+                                                    EpidStatus* results) {
+  EpidStatus sts = kEpidErr;
+  EpidStatus batch_sts = kEpidNoErr;
+  Epid2Params_* epid2_params = NULL;
+
+  if (!pub_key || !priv_keys || !precomps || !results) {
+    return kEpidBadArgErr;
+  }
+
+  do {
+    GroupPubKey split_pub_key = {0};
+    MemberPrecomp group_precomp = {0};
+    HashAlg hash_alg = kInvalidHashAlg;
+    size_t i = 0;
+
+    sts = EpidParseHashAlg(&pub_key->gid, &hash_alg);
+    BREAK_ON_EPID_ERROR(sts);
+    if (kSha256 != hash_alg && kSha384 != hash_alg && kSha512 != hash_alg &&
+        kSha512_256 != hash_alg) {
+      sts = kEpidHashAlgorithmNotSupported;
+      BREAK_ON_EPID_ERROR(sts);
+    }
+
+    sts = CreateEpid2Params(&epid2_params);
+    BREAK_ON_EPID_ERROR(sts);
+
+    // the member precomputation is done with the split group public key,
+    // see EpidMemberStartup
+    sts = EpidComputeSplitGroupPubKey(epid2_params->G1, pub_key, hash_alg,
+                                      &split_pub_key);
+    BREAK_ON_EPID_ERROR(sts);
+    sts = PrecomputeGroupPairing(epid2_params, &split_pub_key, &group_precomp);
+    BREAK_ON_EPID_ERROR(sts);
+
+    for (i = 0; i < count; i++) {
+      EpidStatus key_sts = kEpidErr;
+      if (memcmp(&pub_key->gid, &priv_keys[i].gid, sizeof(GroupId))) {
+        key_sts = kEpidKeyNotInGroupErr;
+      } else {
+        key_sts = EpidValidateSplitPrivateKeyWithParams(
+            epid2_params, &priv_keys[i], pub_key);
+      }
+      if (kEpidNoErr == key_sts) {
+        precomps[i] = group_precomp;
+        key_sts = PrecomputeMemberPairingA(epid2_params, &priv_keys[i].A,
+                                           &precomps[i]);
+      }
+      if (kEpidNoErr != key_sts) {
+        EpidZeroMemory(&precomps[i], sizeof(precomps[i]));
+        batch_sts = key_sts;
+      }
+      results[i] = key_sts;
+    }
+  } while (0);
+
+  DeleteEpid2Params(&epid2_params);
+
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  return batch_sts;
+}
@@ -33,6 +33,20 @@
     break;                       \
   }
 
+// Non-revoked proofs of a split member use the TPM, which runs one command
+// at a time and whose context must not be shared between threads, so
+// EpidSign computes them in sequence. The loop is used by EpidAddPreSigs.
+EpidStatus EPID_MEMBER_API EpidMemberSetParallelFor(MemberCtx* ctx,
+                                                    ParallelFor parallel_for,
+                                                    void* user_data) {
+  if (!ctx) {
+    return kEpidBadArgErr;
+  }
+  ctx->parallel_for = parallel_for;
+  ctx->parallel_for_param = user_data;
+  return kEpidNoErr;
+}
+
 EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
                                     size_t msg_len, void const* basename,
                                     size_t basename_len, EpidSignature* raw_sig,
@@ -75,8 +89,6 @@ EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
     sig->n2 = octstr32_0;
     return kEpidNoErr;
   } else {
-    uint32_t i = 0;
-    EpidStatus nr_prove_status = kEpidNoErr;
     // 13. If SigRL is provided as input, the member proceeds with
     //     the following steps:
     //   a. The member verifies that gid in public key and in SigRL
@@ -90,21 +102,20 @@ EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
     //      nrProve(f, B, K, B[i], K[i]). The details of nrProve()
     //      will be given in the next subsection.
     num_sig_rl = ntohl(ctx->sig_rl->n2);
-    for (i = 0; i < num_sig_rl; i++) {
+    if (num_sig_rl > 0) {
       if (basename) {
-        sts = EpidNrProve(ctx, msg, msg_len, basename, basename_len,
-                          &sig->sigma0, &ctx->sig_rl->bk[i], &sig->sigma[i]);
+        sts = EpidNrProveBatch(ctx, msg, msg_len, basename, basename_len,
+                               &sig->sigma0, ctx->sig_rl->bk, num_sig_rl,
+                               sig->sigma);
       } else {
-        sts = EpidNrProve(ctx, msg, msg_len, &rnd_bsn, sizeof(rnd_bsn),
-                          &sig->sigma0, &ctx->sig_rl->bk[i], &sig->sigma[i]);
+        sts = EpidNrProveBatch(ctx, msg, msg_len, &rnd_bsn, sizeof(rnd_bsn),
+                               &sig->sigma0, ctx->sig_rl->bk, num_sig_rl,
+                               sig->sigma);
       }
       if (kEpidNoErr != sts) {
-        nr_prove_status = sts;
+        return sts;
       }
     }
-    if (kEpidNoErr != nr_prove_status) {
-      return nr_prove_status;
-    }
   }
   //   d. The member outputs (sigma0, RLver, n2, sigma[0], ...,
   //      sigma[n2-1]).
@@ -112,3 +123,84 @@ EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
   //      member returns "revoked", otherwise returns "succeeded".
   return kEpidNoErr;
 }
+
+EpidStatus EPID_MEMBER_API EpidSignStream(MemberCtx const* ctx,
+                                          void const* msg, size_t msg_len,
+                                          void const* basename,
+                                          size_t basename_len, SigSink sink,
+                                          void* user_data) {
+  EpidStatus sts = kEpidErr;
+  EpidStatus nr_prove_status = kEpidNoErr;
+  OctStr32 octstr32_0 = {{0x00, 0x00, 0x00, 0x00}};
+  BigNumStr rnd_bsn = {0};
+  EpidSplitSignature sig;
+  SplitNrProof proof;
+  NrProveState* nr_prove_state = NULL;
+  uint32_t num_sig_rl = 0;
+  uint32_t i = 0;
+  if (!ctx || !sink) {
+    return kEpidBadArgErr;
+  }
+  if (!msg && (0 != msg_len)) {
+    // if message is non-empty it must have both length and content
+    return kEpidBadArgErr;
+  }
+  if (!basename && (0 != basename_len)) {
+    // if basename is non-empty it must have both length and content
+    return kEpidBadArgErr;
+  }
+  if (!ctx->is_provisioned) {
+    return kEpidOutOfSequenceError;
+  }
+
+  sts = EpidSplitSignBasic(ctx, msg, msg_len, basename, basename_len,
+                           &sig.sigma0, &rnd_bsn, &sig.nonce);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  if (ctx->sig_rl) {
+    sig.rl_ver = ctx->sig_rl->version;
+    sig.n2 = ctx->sig_rl->n2;
+    num_sig_rl = ntohl(ctx->sig_rl->n2);
+  } else {
+    sig.rl_ver = octstr32_0;
+    sig.n2 = octstr32_0;
+  }
+  // everything preceding the non-revoked proofs goes out first
+  sts = sink(&sig, EpidGetSigSize(NULL), user_data);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  if (0 == num_sig_rl) {
+    return kEpidNoErr;
+  }
+  // the per signature work of the proofs is done once, then each proof
+  // goes out as soon as it is computed without buffering the SigRl
+  if (basename) {
+    sts = NewNrProveState(ctx, msg, msg_len, basename, basename_len,
+                          &sig.sigma0, &nr_prove_state);
+  } else {
+    sts = NewNrProveState(ctx, msg, msg_len, &rnd_bsn, sizeof(rnd_bsn),
+                          &sig.sigma0, &nr_prove_state);
+  }
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  for (i = 0; i < num_sig_rl; i++) {
+    sts = EpidNrProveEntry(ctx, nr_prove_state, &ctx->sig_rl->bk[i], &proof);
+    if (kEpidSigRevokedInSigRl == sts) {
+      nr_prove_status = sts;
+    } else if (kEpidNoErr != sts) {
+      break;
+    }
+    sts = sink(&proof, sizeof(proof), user_data);
+    if (kEpidNoErr != sts) {
+      break;
+    }
+  }
+  DeleteNrProveState(&nr_prove_state);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  return nr_prove_status;
+}
@@ -92,7 +92,8 @@ EpidStatus EpidSplitSignBasic(MemberCtx const* ctx, void const* msg,
   FfElement* nk = NULL;  // split signature nonce
   FfElement* c = NULL;
 
-  PreComputedSignature curr_presig = {0};
+  PreComputedSignature scratch_presig = {0};
+  PreComputedSignature* curr_presig = NULL;
   SignBasicCommitValues commit_values = {0};
 
   if (!ctx || !sig || !nonce) {
@@ -168,22 +169,22 @@ EpidStatus EpidSplitSignBasic(MemberCtx const* ctx, void const* msg,
     sts = NewFfElement(Fp, &rb);
     BREAK_ON_EPID_ERROR(sts);
 
-    sts = MemberGetPreSig((MemberCtx*)ctx, &curr_presig);
+    sts = MemberTopPreSig((MemberCtx*)ctx, &scratch_presig, &curr_presig);
     BREAK_ON_EPID_ERROR(sts);
 
     // 3.  If the pre-computed signature pre-sigma exists, the member
     //     loads (B, K, T, a, b, rx, rf, ra, rb, R1, R2) from
     //     pre-sigma. Refer to Section 4.4 for the computation of
     //     these values.
-    sts = ReadFfElement(Fp, &curr_presig.a, sizeof(curr_presig.a), a);
+    sts = ReadFfElement(Fp, &curr_presig->a, sizeof(curr_presig->a), a);
     BREAK_ON_EPID_ERROR(sts);
-    sts = ReadFfElement(Fp, &curr_presig.b, sizeof(curr_presig.b), b);
+    sts = ReadFfElement(Fp, &curr_presig->b, sizeof(curr_presig->b), b);
     BREAK_ON_EPID_ERROR(sts);
-    sts = ReadFfElement(Fp, &curr_presig.rx, sizeof(curr_presig.rx), rx);
+    sts = ReadFfElement(Fp, &curr_presig->rx, sizeof(curr_presig->rx), rx);
     BREAK_ON_EPID_ERROR(sts);
-    sts = ReadFfElement(Fp, &curr_presig.ra, sizeof(curr_presig.ra), ra);
+    sts = ReadFfElement(Fp, &curr_presig->ra, sizeof(curr_presig->ra), ra);
     BREAK_ON_EPID_ERROR(sts);
-    sts = ReadFfElement(Fp, &curr_presig.rb, sizeof(curr_presig.rb), rb);
+    sts = ReadFfElement(Fp, &curr_presig->rb, sizeof(curr_presig->rb), rb);
     BREAK_ON_EPID_ERROR(sts);
 
     // If the basename is provided, use it, otherwise use presig B
@@ -215,7 +216,8 @@ EpidStatus EpidSplitSignBasic(MemberCtx const* ctx, void const* msg,
       sts = WriteEcPoint(G1, t, &commit_out.R1, sizeof(commit_out.R1));
       BREAK_ON_EPID_ERROR(sts);
       // c.ii. e12rf = pairing(ETPM, g2)
-      sts = Pairing(ps_ctx, e, ctx->epid2_params->g2, R2);
+      sts =
+          PairingWithPrecomputedG2(ps_ctx, e, ctx->epid2_params->g2_lines, R2);
       BREAK_ON_EPID_ERROR(sts);
       // c.iii. R2 = GT.sscmMultiExp(ea2, t1, e12rf, 1, e22, t2, e2w,ra).
       // 4.i. The member computes t1 = (- rx) mod p.
@@ -243,7 +245,7 @@ EpidStatus EpidSplitSignBasic(MemberCtx const* ctx, void const* msg,
         exponents[0] = &t1_str;
         exponents[1] = &kOne;
         exponents[2] = &t2_str;
-        exponents[3] = (BigNumStr*)&curr_presig.ra;
+        exponents[3] = (BigNumStr*)&curr_presig->ra;
         sts = FfMultiExp(GT, points, exponents, COUNT_OF(points), R2);
         BREAK_ON_EPID_ERROR(sts);
       }
@@ -256,19 +258,19 @@ EpidStatus EpidSplitSignBasic(MemberCtx const* ctx, void const* msg,
         sts = kEpidBadArgErr;
         break;
       }
-      sts = ReadEcPoint(G1, &curr_presig.B, sizeof(curr_presig.B), B);
+      sts = ReadEcPoint(G1, &curr_presig->B, sizeof(curr_presig->B), B);
       BREAK_ON_EPID_ERROR(sts);
-      commit_out.B = curr_presig.B;
-      commit_out.K = curr_presig.K;
-      commit_out.R1 = curr_presig.R1;
-      counter = curr_presig.rf_ctr;
-      curr_presig.is_rf_ctr_set = false;
+      commit_out.B = curr_presig->B;
+      commit_out.K = curr_presig->K;
+      commit_out.R1 = curr_presig->R1;
+      counter = curr_presig->rf_ctr;
+      curr_presig->is_rf_ctr_set = false;
       is_counter_set = true;
-      commit_out.R2 = curr_presig.R2;
-      *rnd_bsn = curr_presig.rnd_bsn;
+      commit_out.R2 = curr_presig->R2;
+      *rnd_bsn = curr_presig->rnd_bsn;
     }
 
-    commit_out.T = curr_presig.T;
+    commit_out.T = curr_presig->T;
 
     sts = HashSignCommitment(Fp, hash_alg, &ctx->pub_key, &commit_out, msg,
                              msg_len, &c_str);
@@ -276,7 +278,9 @@ EpidStatus EpidSplitSignBasic(MemberCtx const* ctx, void const* msg,
 
     digest_size = EpidGetHashSize(hash_alg);
     if (sizeof(commit_values.digest) < digest_size) {
-      return kEpidBadArgErr;
+      // break so that the pre-computed signature is still consumed
+      sts = kEpidBadArgErr;
+      break;
     }
     memcpy_S(commit_values.digest.digest + digest_size - sizeof(c_str),
              sizeof(c_str), &c_str, sizeof(c_str));
@@ -344,12 +348,15 @@ EpidStatus EpidSplitSignBasic(MemberCtx const* ctx, void const* msg,
   if (is_counter_set == true) {
     (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, counter, ctx->f_handle);
   }
-  if (curr_presig.is_rf_ctr_set == true) {
-    (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, curr_presig.rf_ctr, ctx->f_handle);
+  if (curr_presig) {
+    if (curr_presig->is_rf_ctr_set == true) {
+      (void)Tpm2ReleaseCounter(ctx->tpm2_ctx, curr_presig->rf_ctr,
+                               ctx->f_handle);
+    }
+    // the pre-computed signature is consumed even if signing failed
+    (void)MemberPopPreSig((MemberCtx*)ctx, curr_presig);
   }
 
-  EpidZeroMemory(&curr_presig, sizeof(curr_presig));
-
   DeleteEcPoint(&B);
   DeleteEcPoint(&k);
   DeleteEcPoint(&t);
@@ -29,21 +29,59 @@
     break;                       \
   }
 
+/// Doubles the commit table up to max_commits and adds new slots to the free
+/// list
+static EpidStatus GrowCommitTable(Tpm2Ctx* ctx) {
+  size_t new_capacity = 0;
+  size_t i = 0;
+  FfElement** commit_data = NULL;
+  uint16_t* free_commits = NULL;
+  if (ctx->commit_capacity >= ctx->max_commits) {
+    return kEpidMemAllocErr;
+  }
+  new_capacity = ctx->commit_capacity ? 2 * ctx->commit_capacity
+                                      : DEFAULT_COMMIT_COUNT;
+  if (new_capacity > ctx->max_commits) {
+    new_capacity = ctx->max_commits;
+  }
+  commit_data =
+      SAFE_REALLOC(ctx->commit_data, new_capacity * sizeof(*commit_data));
+  if (!commit_data) {
+    return kEpidMemAllocErr;
+  }
+  ctx->commit_data = commit_data;
+  free_commits =
+      SAFE_REALLOC(ctx->free_commits, new_capacity * sizeof(*free_commits));
+  if (!free_commits) {
+    return kEpidMemAllocErr;
+  }
+  ctx->free_commits = free_commits;
+  // push new slots in reverse order so lower counters are handed out first
+  for (i = new_capacity; i > ctx->commit_capacity; --i) {
+    ctx->commit_data[i - 1] = NULL;
+    ctx->free_commits[ctx->num_free_commits++] = (uint16_t)(i - 1);
+  }
+  ctx->commit_capacity = new_capacity;
+  return kEpidNoErr;
+}
+
 static EpidStatus CreateCommitNonce(Tpm2Ctx* ctx, FfElement** r,
                                     uint16_t* counter) {
   uint16_t index = 0;
   if (!ctx || !r || !*r || !counter) {
     return kEpidBadArgErr;
   }
-  for (index = 0; index < MAX_COMMIT_COUNT; ++index) {
-    if (!ctx->commit_data[index]) {
-      ctx->commit_data[index] = *r;
-      *r = NULL;
-      *counter = index + 1;  // counter == 0 should be invalid
-      return kEpidNoErr;
+  if (0 == ctx->num_free_commits) {
+    EpidStatus sts = GrowCommitTable(ctx);
+    if (kEpidNoErr != sts) {
+      return sts;
     }
   }
-  return kEpidMemAllocErr;
+  index = ctx->free_commits[--ctx->num_free_commits];
+  ctx->commit_data[index] = *r;
+  *r = NULL;
+  *counter = index + 1;  // counter == 0 should be invalid
+  return kEpidNoErr;
 }
 
 EpidStatus Tpm2Commit(Tpm2Ctx* ctx, Tpm2Key const* key, EcPoint const* p1,
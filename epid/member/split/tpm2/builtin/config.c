@@ -68,7 +68,22 @@ EpidMemberSetMaxAllowedBasenames(size_t n, MemberParams* config) {
 
 EpidStatus EPID_MEMBER_API
 EpidMemberSetMaxPrecomputedSigs(size_t n, MemberParams* config) {
-  UNUSED(n);
+  if (!config) return kEpidBadConfigErr;
+  // each precomputed signature holds a commit of the builtin TPM
+  config->max_precomp_sig = n;
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API
+EpidMemberSetFixedBaseCombTeeth(size_t teeth, MemberParams* config) {
+  UNUSED(teeth);
+  UNUSED(config);
+  return kEpidOperationNotSupportedErr;
+}
+
+EpidStatus EPID_MEMBER_API
+EpidMemberSetPreSigMultiExpTable(int enable, MemberParams* config) {
+  UNUSED(enable);
   UNUSED(config);
   return kEpidOperationNotSupportedErr;
 }
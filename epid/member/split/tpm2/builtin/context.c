@@ -79,7 +79,17 @@ EpidStatus Tpm2CreateContext(MemberParams const* params,
       tpm_ctx->nv[i].data_size = 0;
     }
 
-    EpidZeroMemory(tpm_ctx->commit_data, sizeof(tpm_ctx->commit_data));
+    // commit table is allocated on first use and grows on demand
+    tpm_ctx->commit_data = NULL;
+    tpm_ctx->free_commits = NULL;
+    tpm_ctx->num_free_commits = 0;
+    tpm_ctx->commit_capacity = 0;
+    tpm_ctx->max_commits = DEFAULT_COMMIT_COUNT;
+    if (params->max_precomp_sig > MAX_COMMIT_COUNT - DEFAULT_COMMIT_COUNT) {
+      tpm_ctx->max_commits = MAX_COMMIT_COUNT;
+    } else {
+      tpm_ctx->max_commits += params->max_precomp_sig;
+    }
 
     *ctx = tpm_ctx;
     sts = kEpidNoErr;
@@ -105,9 +115,13 @@ void Tpm2DeleteContext(Tpm2Ctx** ctx) {
     (*ctx)->max_keys = 0;
 
     DeleteFfElement(&(*ctx)->seed);
-    for (i = 0; i < MAX_COMMIT_COUNT; ++i) {
+    for (i = 0; i < (*ctx)->commit_capacity; ++i) {
       DeleteFfElement(&(*ctx)->commit_data[i]);
     }
+    SAFE_FREE((*ctx)->commit_data);
+    SAFE_FREE((*ctx)->free_commits);
+    (*ctx)->num_free_commits = 0;
+    (*ctx)->commit_capacity = 0;
     for (i = 0; i < MAX_NV_NUMBER; ++i) {
       (*ctx)->nv->nv_index = 0;
       SAFE_FREE((*ctx)->nv->data);
@@ -56,7 +56,7 @@ static EpidStatus GetCommitNonce(Tpm2Ctx* ctx, uint16_t counter,
   if (!ctx || counter == 0 || !r) {
     return kEpidBadArgErr;
   }
-  if (counter >= MAX_COMMIT_COUNT) {
+  if (counter > ctx->commit_capacity) {
     return kEpidBadArgErr;
   }
   *r = ctx->commit_data[counter - 1];
@@ -64,8 +64,10 @@ static EpidStatus GetCommitNonce(Tpm2Ctx* ctx, uint16_t counter,
 }
 
 static void ClearCommitNonce(Tpm2Ctx* ctx, uint16_t counter) {
-  if (ctx && counter > 0 && counter < MAX_COMMIT_COUNT) {
+  if (ctx && counter > 0 && counter <= ctx->commit_capacity &&
+      ctx->commit_data[counter - 1]) {
     DeleteFfElement(&ctx->commit_data[counter - 1]);
+    ctx->free_commits[ctx->num_free_commits++] = (uint16_t)(counter - 1);
   }
 }
 
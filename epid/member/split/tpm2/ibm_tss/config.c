@@ -59,3 +59,17 @@ EpidMemberSetMaxPrecomputedSigs(size_t n, MemberParams* config) {
   UNUSED(config);
   return kEpidOperationNotSupportedErr;
 }
+
+EpidStatus EPID_MEMBER_API
+EpidMemberSetFixedBaseCombTeeth(size_t teeth, MemberParams* config) {
+  UNUSED(teeth);
+  UNUSED(config);
+  return kEpidOperationNotSupportedErr;
+}
+
+EpidStatus EPID_MEMBER_API
+EpidMemberSetPreSigMultiExpTable(int enable, MemberParams* config) {
+  UNUSED(enable);
+  UNUSED(config);
+  return kEpidOperationNotSupportedErr;
+}
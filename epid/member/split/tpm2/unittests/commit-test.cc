@@ -24,10 +24,12 @@
 #include "testhelper/epid_params-testhelper.h"
 #include "testhelper/errors-testhelper.h"
 #include "testhelper/ffelement_wrapper-testhelper.h"
+#include "testhelper/mem_params-testhelper.h"
 #include "testhelper/prng-testhelper.h"
 
 extern "C" {
 #include "common/endian_convert.h"
+#include "epid/member/api.h"
 #include "epid/member/split/tpm2/commit.h"
 #include "epid/member/split/tpm2/context.h"
 #include "epid/member/split/tpm2/flushcontext.h"
@@ -239,6 +241,7 @@ TEST_F(EpidTpm2Test, CommitCanBeUsedTwice) {
   THROW_ON_EPIDERR(Tpm2ReleaseCounter(tpm, ctr1, f_handle));
   THROW_ON_EPIDERR(Tpm2ReleaseCounter(tpm, ctr2, f_handle));
 }
+
 TEST_F(EpidTpm2Test, CommitCanUseHashFromEcHashSha256) {
   HashAlg halg = kSha256;
   Prng prng;
@@ -300,6 +303,7 @@ TEST_F(EpidTpm2Test, CommitCanUseHashFromEcHashSha384) {
                                    digest.size(), y, k, l, e, &counter));
   Tpm2ReleaseCounter(tpm, counter, f_handle);
 }
+
 TEST_F(EpidTpm2Test, CommitCanUseHashFromEcHashSha512) {
   HashAlg halg = kSha512;
   Prng prng;
@@ -330,5 +334,97 @@ TEST_F(EpidTpm2Test, CommitCanUseHashFromEcHashSha512) {
                                    digest.size(), y, k, l, e, &counter));
   Tpm2ReleaseCounter(tpm, counter, f_handle);
 }
+
+TEST_F(EpidTpm2Test, CommitFailsIfDefaultCommitCountIsExhausted) {
+  Prng prng;
+  Epid2ParamsObj epid2params;
+  Epid20Params params;
+  FpElemStr f_str = this->kMemberFValue;
+  Tpm2Ctx* ctx = nullptr;
+  BitSupplier rnd_func = NULL;
+  void* rnd_param = NULL;
+  MemberParams mem_params = {0};
+  SetMemberParams(&Prng::Generate, &prng, &f_str, &mem_params);
+  const size_t kDefaultCommitCount = 100;
+  THROW_ON_EPIDERR(EpidMemberSetMaxPrecomputedSigs(0, &mem_params));
+  THROW_ON_EPIDERR(Tpm2CreateContext(&mem_params, epid2params, &rnd_func,
+                                     &rnd_param, &ctx));
+  Tpm2Key* f_handle = nullptr;
+  EcPointObj p1(&params.G1, this->kP1Str);
+  EcPointObj e(&params.G1);
+  uint16_t counter = 0;
+  size_t i = 0;
+  EpidStatus sts = Tpm2LoadExternal(ctx, kSha256, &f_str, &f_handle);
+  for (i = 0; kEpidNoErr == sts && i < kDefaultCommitCount; ++i) {
+    sts = Tpm2Commit(ctx, f_handle, p1, nullptr, 0, nullptr, nullptr, nullptr,
+                     e, &counter);
+  }
+  EXPECT_EQ(kEpidNoErr, sts);
+  EXPECT_EQ(kEpidMemAllocErr, Tpm2Commit(ctx, f_handle, p1, nullptr, 0,
+                                         nullptr, nullptr, nullptr, e,
+                                         &counter));
+  Tpm2DeleteContext(&ctx);
+}
+
+TEST_F(EpidTpm2Test, CommitCountGrowsWithMaxPrecomputedSigs) {
+  Prng prng;
+  Epid2ParamsObj epid2params;
+  Epid20Params params;
+  FpElemStr f_str = this->kMemberFValue;
+  Tpm2Ctx* ctx = nullptr;
+  BitSupplier rnd_func = NULL;
+  void* rnd_param = NULL;
+  MemberParams mem_params = {0};
+  SetMemberParams(&Prng::Generate, &prng, &f_str, &mem_params);
+  const size_t kMaxPrecomputedSigs = 250;
+  const size_t kDefaultCommitCount = 100;
+  THROW_ON_EPIDERR(
+      EpidMemberSetMaxPrecomputedSigs(kMaxPrecomputedSigs, &mem_params));
+  THROW_ON_EPIDERR(Tpm2CreateContext(&mem_params, epid2params, &rnd_func,
+                                     &rnd_param, &ctx));
+  Tpm2Key* f_handle = nullptr;
+  EcPointObj p1(&params.G1, this->kP1Str);
+  EcPointObj e(&params.G1);
+  uint16_t counter = 0;
+  size_t i = 0;
+  EpidStatus sts = Tpm2LoadExternal(ctx, kSha256, &f_str, &f_handle);
+  for (i = 0; kEpidNoErr == sts &&
+              i < kMaxPrecomputedSigs + kDefaultCommitCount;
+       ++i) {
+    sts = Tpm2Commit(ctx, f_handle, p1, nullptr, 0, nullptr, nullptr, nullptr,
+                     e, &counter);
+    EXPECT_EQ(i + 1, counter);
+  }
+  EXPECT_EQ(kEpidNoErr, sts);
+  EXPECT_EQ(kEpidMemAllocErr, Tpm2Commit(ctx, f_handle, p1, nullptr, 0,
+                                         nullptr, nullptr, nullptr, e,
+                                         &counter));
+  Tpm2DeleteContext(&ctx);
+}
+
+TEST_F(EpidTpm2Test, CommitReusesReleasedCounter) {
+  Prng prng;
+  Epid2ParamsObj epid2params;
+  Epid20Params params;
+  FpElemStr f_str = this->kMemberFValue;
+  Tpm2CtxObj tpm(&Prng::Generate, &prng, &f_str, epid2params);
+  Tpm2Key* f_handle;
+  THROW_ON_EPIDERR(Tpm2LoadExternal(tpm, kSha256, &f_str, &f_handle));
+  EcPointObj p1(&params.G1, this->kP1Str);
+  EcPointObj e(&params.G1);
+  uint16_t ctr1 = 0, ctr2 = 0, ctr3 = 0;
+
+  THROW_ON_EPIDERR(Tpm2Commit(tpm, f_handle, p1, nullptr, 0, nullptr, nullptr,
+                              nullptr, e, &ctr1));
+  THROW_ON_EPIDERR(Tpm2Commit(tpm, f_handle, p1, nullptr, 0, nullptr, nullptr,
+                              nullptr, e, &ctr2));
+  THROW_ON_EPIDERR(Tpm2ReleaseCounter(tpm, ctr1, f_handle));
+  EXPECT_EQ(kEpidNoErr, Tpm2Commit(tpm, f_handle, p1, nullptr, 0, nullptr,
+                                   nullptr, nullptr, e, &ctr3));
+  EXPECT_EQ(ctr1, ctr3);
+  EXPECT_NE(ctr2, ctr3);
+  THROW_ON_EPIDERR(Tpm2ReleaseCounter(tpm, ctr2, f_handle));
+  THROW_ON_EPIDERR(Tpm2ReleaseCounter(tpm, ctr3, f_handle));
+}
 #endif  // TPM_TSS
 }  // namespace
@@ -550,6 +550,111 @@ TEST_F(EpidSplitMemberTest, SetSigRlFailsIfNotProvisioned) {
             EpidMemberSetSigRl(member_ctx, sig_rl, sig_rl_size));
 }
 //////////////////////////////////////////////////////////////////////////
+// EpidMemberUpdateSigRl
+TEST_F(EpidSplitMemberTest, UpdateSigRlFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberUpdateSigRl(nullptr, sig_rl, sig_rl_size));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberUpdateSigRl(member_ctx, nullptr, sig_rl_size));
+}
+TEST_F(EpidSplitMemberTest, UpdateSigRlFailsIfNoSigRlSet) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  EXPECT_EQ(kEpidOutOfSequenceError,
+            EpidMemberUpdateSigRl(member_ctx, sig_rl, sig_rl_size));
+}
+TEST_F(EpidSplitMemberTest, UpdateSigRlFailsGivenSameVersion) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member_ctx, sig_rl, sig_rl_size));
+  EXPECT_EQ(kEpidVersionMismatchErr,
+            EpidMemberUpdateSigRl(member_ctx, sig_rl, sig_rl_size));
+}
+TEST_F(EpidSplitMemberTest, UpdateSigRlFailsGivenBadGroupId) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                          &Prng::Generate, &my_prng);
+  SigRl srl = {{{0}}, {{0}}, {{0}}, {{{{0}, {0}}, {{0}, {0}}}}};
+  srl.gid = this->kGrpXKey.gid;
+  THROW_ON_EPIDERR(
+      EpidMemberSetSigRl(member_ctx, &srl, sizeof(srl) - sizeof(srl.bk)));
+  srl.gid.data[0] = ~srl.gid.data[0];
+  srl.version = this->kOctStr32_1;
+  EXPECT_EQ(kEpidBadArgErr, EpidMemberUpdateSigRl(member_ctx, &srl,
+                                                  sizeof(srl) - sizeof(srl.bk)));
+}
+TEST_F(EpidSplitMemberTest, UpdateSigRlAppendsEntries) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                          &Prng::Generate, &my_prng);
+  auto base_raw = this->kGrpXSigRl;
+  SigRl* base = reinterpret_cast<SigRl*>(base_raw.data());
+  base->version = this->kOctStr32_1;
+  auto delta_raw = this->kGrpXSigRlMember3Sha256Bsn0Msg03EntriesFirstRevoked;
+  SigRl* delta = reinterpret_cast<SigRl*>(delta_raw.data());
+  delta->version.data[sizeof(delta->version) - 1] = 0x02;
+  uint32_t n2 = ntohl(base->n2) + ntohl(delta->n2);
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member_ctx, base, base_raw.size()));
+  EXPECT_EQ(kEpidNoErr,
+            EpidMemberUpdateSigRl(member_ctx, delta, delta_raw.size()));
+  // the list set by the caller is not modified
+  EXPECT_EQ(this->kGrpXSigRl.size(), base_raw.size());
+  EXPECT_EQ(0, memcmp(&this->kGrpXSigRl[sizeof(base->gid) + sizeof(base->version)],
+                      &base->n2, sizeof(base->n2)));
+
+  // an empty update only bumps the version
+  SigRl empty = {{{0}}, {{0}}, {{0}}, {{{{0}, {0}}, {{0}, {0}}}}};
+  empty.gid = this->kGrpXKey.gid;
+  empty.version.data[sizeof(empty.version) - 1] = 0x03;
+  EXPECT_EQ(kEpidNoErr, EpidMemberUpdateSigRl(member_ctx, &empty,
+                                              sizeof(empty) - sizeof(empty.bk)));
+
+  auto& msg = this->kMsg0;
+  auto& bsn = this->kBsn0;
+  THROW_ON_EPIDERR(EpidRegisterBasename(member_ctx, bsn.data(), bsn.size()));
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr) +
+                                n2 * sizeof(SplitNrProof));
+  EpidSplitSignature* sig =
+      reinterpret_cast<EpidSplitSignature*>(sig_data.data());
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidSign(member_ctx, msg.data(), msg.size(), bsn.data(), bsn.size(),
+                     reinterpret_cast<EpidSignature*>(sig), sig_data.size()));
+  EXPECT_EQ(n2, ntohl(sig->n2));
+  EXPECT_EQ(0, memcmp(&empty.version, &sig->rl_ver, sizeof(sig->rl_ver)));
+}
+//////////////////////////////////////////////////////////////////////////
+// EpidMemberSetSigRlByReference, EpidMemberSetSigRlBuffer
+TEST_F(EpidSplitMemberTest, SetSigRlByReferenceWorksGivenValidSigRl) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetSigRlByReference(nullptr, sig_rl, sig_rl_size));
+  EXPECT_EQ(kEpidNoErr,
+            EpidMemberSetSigRlByReference(member_ctx, sig_rl, sig_rl_size));
+}
+TEST_F(EpidSplitMemberTest, SetSigRlBufferIsNotSupported) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                          &Prng::Generate, &my_prng);
+  std::vector<uint8_t> buffer(this->kGrpXSigRl.size());
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidMemberSetSigRlBuffer(member_ctx, buffer.data(), buffer.size()));
+}
+//////////////////////////////////////////////////////////////////////////
 // EpidRegisterBasename
 TEST_F(EpidSplitMemberTest, RegisterBaseNameFailsGivenNullPtr) {
   Prng my_prng;
@@ -620,6 +725,19 @@ TEST_F(EpidSplitMemberTest,
                                              this->kData_0_255.size()));
 }
 //////////////////////////////////////////////////////////////////////////
+// EpidGetBasenameBufferSize, EpidMemberSetBasenameBuffer
+TEST_F(EpidSplitMemberTest, BasenameBufferIsNotSupported) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  std::vector<uint8_t> buffer(1024);
+  size_t buffer_size = 0;
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidGetBasenameBufferSize(member, 1, &buffer_size));
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidMemberSetBasenameBuffer(member, buffer.data(), buffer.size()));
+}
+//////////////////////////////////////////////////////////////////////////
 // EpidClearRegisteredBasenames
 TEST_F(EpidSplitMemberTest, EpidClearRegisteredBasenamesFailsGivenNullPtr) {
   EXPECT_EQ(kEpidBadArgErr, EpidClearRegisteredBasenames(nullptr));
@@ -19,6 +19,7 @@
  * \brief DecompressPrivKey unit tests.
  */
 #include <cstring>
+#include <vector>
 #include "member-testhelper.h"
 #include "gtest/gtest.h"
 #include "testhelper/epid_gtest-testhelper.h"
@@ -32,6 +33,14 @@ bool operator==(PrivKey const& lhs, PrivKey const& rhs) {
 }
 namespace {
 
+/// Compressed key of member 9 of group X and its decompressed key
+const CompressedPrivKey kGrpXMember9CompressedKeyData = {
+#include "testhelper/testdata/grp_x/cmember9/cmpprivkey.inc"
+};
+const PrivKey kGrpXMember9PrivKeyData = {
+#include "testhelper/testdata/grp_x/cmember9/mprivkey.inc"
+};
+
 TEST_F(EpidSplitMemberTest, DecompressPrivKeyFailsGivenNullParameters) {
   auto const& pub_key = this->kGrpXKey;
   auto const& compressed_privkey = this->kGrpXMember9CompressedKey;
@@ -95,4 +104,77 @@ TEST_F(EpidSplitMemberTest, DecompressPrivKeyFailsGivenInvalidCompressedKey) {
                                 &pub_key, &compressed_privkey_seed, &priv_key));
 }
 
+TEST_F(EpidSplitMemberTest, DecompressPrivKeysFailsGivenNullParameters) {
+  auto const& pub_key = this->kGrpXKey;
+  auto const& compressed_privkey = this->kGrpXMember9CompressedKey;
+  PrivKey priv_key = {};
+  EpidStatus result = kEpidErr;
+  EXPECT_EQ(kEpidBadArgErr, EpidDecompressPrivKeys(nullptr, &compressed_privkey,
+                                                   1, &priv_key, &result));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidDecompressPrivKeys(&pub_key, nullptr, 1, &priv_key, &result));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidDecompressPrivKeys(&pub_key, &compressed_privkey, 1,
+                                   nullptr, &result));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidDecompressPrivKeys(&pub_key, &compressed_privkey, 1,
+                                   &priv_key, nullptr));
+}
+
+TEST_F(EpidSplitMemberTest,
+       DecompressPrivKeysGivesSameKeysAsDecompressPrivKey) {
+  auto const& pub_key = this->kGrpXKey;
+  auto const& compressed_privkey = kGrpXMember9CompressedKeyData;
+  PrivKey expected_priv_key = {};
+  ASSERT_EQ(kEpidNoErr, EpidDecompressPrivKey(&pub_key, &compressed_privkey,
+                                              &expected_priv_key));
+  EXPECT_EQ(kGrpXMember9PrivKeyData, expected_priv_key);
+
+  std::vector<CompressedPrivKey> compressed_privkeys(3, compressed_privkey);
+  std::vector<PrivKey> priv_keys(compressed_privkeys.size());
+  std::vector<EpidStatus> results(compressed_privkeys.size(), kEpidErr);
+  EXPECT_EQ(kEpidNoErr,
+            EpidDecompressPrivKeys(&pub_key, compressed_privkeys.data(),
+                                   compressed_privkeys.size(),
+                                   priv_keys.data(), results.data()));
+  for (size_t i = 0; i < priv_keys.size(); i++) {
+    EXPECT_EQ(kEpidNoErr, results[i]);
+    EXPECT_EQ(expected_priv_key, priv_keys[i]);
+  }
+}
+
+TEST_F(EpidSplitMemberTest, DecompressPrivKeysReportsStatusOfEachKey) {
+  auto const& pub_key = this->kGrpXKey;
+  auto compressed_privkey_seed = kGrpXMember9CompressedKeyData;
+  compressed_privkey_seed.seed.data[0]++;
+  std::vector<CompressedPrivKey> compressed_privkeys = {
+      compressed_privkey_seed, kGrpXMember9CompressedKeyData,
+      compressed_privkey_seed};
+  std::vector<PrivKey> priv_keys(compressed_privkeys.size());
+  std::vector<EpidStatus> results(compressed_privkeys.size(), kEpidErr);
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidDecompressPrivKeys(&pub_key, compressed_privkeys.data(),
+                                   compressed_privkeys.size(),
+                                   priv_keys.data(), results.data()));
+  PrivKey const zero_priv_key = {};
+  EXPECT_EQ(kEpidBadArgErr, results[0]);
+  EXPECT_EQ(zero_priv_key, priv_keys[0]);
+  EXPECT_EQ(kEpidNoErr, results[1]);
+  EXPECT_EQ(kGrpXMember9PrivKeyData, priv_keys[1]);
+  EXPECT_EQ(kEpidBadArgErr, results[2]);
+  EXPECT_EQ(zero_priv_key, priv_keys[2]);
+}
+
+TEST_F(EpidSplitMemberTest, DecompressPrivKeysFailsGivenInvalidGroupKey) {
+  auto const& compressed_privkey = kGrpXMember9CompressedKeyData;
+  PrivKey priv_key = {};
+  EpidStatus result = kEpidErr;
+
+  auto pub_key_h1 = this->kGrpXKey;
+  pub_key_h1.h1.x.data.data[0]++;
+  EXPECT_EQ(kEpidBadArgErr, EpidDecompressPrivKeys(&pub_key_h1,
+                                                   &compressed_privkey, 1,
+                                                   &priv_key, &result));
+}
+
 }  // namespace
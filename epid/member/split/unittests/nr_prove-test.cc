@@ -17,10 +17,12 @@
 /*! \file */
 
 #include <cstring>
+#include <vector>
 #include "gtest/gtest.h"
 #include "testhelper/epid_gtest-testhelper.h"
 
 extern "C" {
+#include "common/endian_convert.h"
 #include "common/sig_types.h"
 #include "epid/member/split/nrprove.h"
 #include "epid/member/split/signbasic.h"
@@ -685,4 +687,224 @@ TEST_F(EpidSplitMemberTest, PROTECTED_GeneratesNrProofWithCredential_EPS0) {
                          &sig_rl->bk[0], &proof, sizeof(proof)));
 }
 
+TEST_F(EpidSplitMemberTest, NrProveBatchFailsGivenNullParameters) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  BasicSignature const* basic_sig =
+      &reinterpret_cast<EpidNonSplitSignature const*>(
+           this->kSplitSigGrpXMember3Sha256Basename1Test1WithSigRl.data())
+           ->sigma0;
+  auto& msg = this->kTest1Msg;
+  auto& bsn = this->kBsn0;
+  SigRl const* sig_rl = reinterpret_cast<const SigRl*>(this->kSigRlData.data());
+  SplitNrProof proofs[2];
+
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrProveBatch(nullptr, msg.data(), msg.size(), bsn.data(),
+                             bsn.size(), basic_sig, sig_rl->bk, 2, proofs));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrProveBatch(member, msg.data(), msg.size(), nullptr,
+                             bsn.size(), basic_sig, sig_rl->bk, 2, proofs));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrProveBatch(member, msg.data(), msg.size(), bsn.data(),
+                             bsn.size(), nullptr, sig_rl->bk, 2, proofs));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrProveBatch(member, msg.data(), msg.size(), bsn.data(),
+                             bsn.size(), basic_sig, nullptr, 2, proofs));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrProveBatch(member, msg.data(), msg.size(), bsn.data(),
+                             bsn.size(), basic_sig, sig_rl->bk, 2, nullptr));
+}
+
+TEST_F(EpidSplitMemberTest, NrProveBatchGivesSameProofAsNrProve) {
+  PrivKey mpriv_key = this->kGrpXMember3PrivKeySha256;
+  GroupPubKey pub_key = this->kGrpXKey;
+  auto otp_data = kOtpDataWithoutRfAndNonce;
+  otp_data.insert(otp_data.end(), kNoncek.begin(), kNoncek.end());
+  otp_data.insert(otp_data.end(), NrProveEntropy.begin(), NrProveEntropy.end());
+  OneTimePad single_prng(otp_data);
+  OneTimePad batch_prng(otp_data);
+  MemberCtxObj single(pub_key, mpriv_key, this->kMemberPrecomp,
+                      &OneTimePad::Generate, &single_prng);
+  MemberCtxObj batch(pub_key, mpriv_key, this->kMemberPrecomp,
+                     &OneTimePad::Generate, &batch_prng);
+
+  BasicSignature basic_sig;
+  auto msg = this->kTest1Msg;
+  SigRl const* sig_rl = reinterpret_cast<const SigRl*>(this->kSigRlData.data());
+  BigNumStr rnd_bsn = {0};
+  SplitNrProof expected;
+  SplitNrProof proof;
+  FpElemStr nonce_k;
+
+  THROW_ON_EPIDERR(EpidSplitSignBasic(single, msg.data(), msg.size(), nullptr,
+                                      0, &basic_sig, &rnd_bsn, &nonce_k));
+  THROW_ON_EPIDERR(EpidSplitSignBasic(batch, msg.data(), msg.size(), nullptr,
+                                      0, &basic_sig, &rnd_bsn, &nonce_k));
+  THROW_ON_EPIDERR(EpidNrProve(single, msg.data(), msg.size(), &rnd_bsn,
+                               sizeof(rnd_bsn), &basic_sig, &sig_rl->bk[0],
+                               &expected));
+  EXPECT_EQ(kEpidNoErr,
+            EpidNrProveBatch(batch, msg.data(), msg.size(), &rnd_bsn,
+                             sizeof(rnd_bsn), &basic_sig, &sig_rl->bk[0], 1,
+                             &proof));
+  EXPECT_EQ(expected, proof);
+}
+
+TEST_F(EpidSplitMemberTest, NrProveBatchGeneratesValidProofForEveryEntry) {
+  Prng my_prng;
+  GroupPubKey pub_key = this->kGrpXKey;
+  MemberCtxObj member(pub_key, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  BasicSignature basic_sig;
+  auto msg = this->kTest1Msg;
+  SigRl const* sig_rl =
+      reinterpret_cast<const SigRl*>(this->kSigRl5EntrySha256Data.data());
+  size_t num_entries = ntohl(sig_rl->n2);
+  BigNumStr rnd_bsn = {0};
+  FpElemStr nonce_k;
+  std::vector<SplitNrProof> proofs(num_entries);
+  ASSERT_LT((size_t)1, num_entries);
+
+  THROW_ON_EPIDERR(EpidSplitSignBasic(member, msg.data(), msg.size(), nullptr,
+                                      0, &basic_sig, &rnd_bsn, &nonce_k));
+  EXPECT_EQ(kEpidNoErr,
+            EpidNrProveBatch(member, msg.data(), msg.size(), &rnd_bsn,
+                             sizeof(rnd_bsn), &basic_sig, sig_rl->bk,
+                             num_entries, proofs.data()));
+
+  VerifierCtxObj verifier(pub_key);
+  for (size_t i = 0; i < num_entries; i++) {
+    EXPECT_EQ(kEpidSigValid,
+              EpidNrVerify(verifier, &basic_sig, msg.data(), msg.size(),
+                           &sig_rl->bk[i], &proofs[i], sizeof(proofs[i])));
+  }
+}
+
+TEST_F(EpidSplitMemberTest, NewNrProveStateFailsGivenNullParameters) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  BasicSignature const* basic_sig =
+      &reinterpret_cast<EpidNonSplitSignature const*>(
+           this->kSplitSigGrpXMember3Sha256Basename1Test1WithSigRl.data())
+           ->sigma0;
+  auto& msg = this->kTest1Msg;
+  auto& bsn = this->kBsn0;
+  NrProveState* state = nullptr;
+
+  EXPECT_EQ(kEpidBadArgErr,
+            NewNrProveState(nullptr, msg.data(), msg.size(), bsn.data(),
+                            bsn.size(), basic_sig, &state));
+  EXPECT_EQ(kEpidBadArgErr,
+            NewNrProveState(member, msg.data(), msg.size(), nullptr,
+                            bsn.size(), basic_sig, &state));
+  EXPECT_EQ(kEpidBadArgErr,
+            NewNrProveState(member, msg.data(), msg.size(), bsn.data(),
+                            bsn.size(), nullptr, &state));
+  EXPECT_EQ(kEpidBadArgErr,
+            NewNrProveState(member, msg.data(), msg.size(), bsn.data(),
+                            bsn.size(), basic_sig, nullptr));
+  EXPECT_EQ(nullptr, state);
+}
+
+TEST_F(EpidSplitMemberTest, NrProveEntryFailsGivenNullParameters) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  BasicSignature const* basic_sig =
+      &reinterpret_cast<EpidNonSplitSignature const*>(
+           this->kSplitSigGrpXMember3Sha256Basename1Test1WithSigRl.data())
+           ->sigma0;
+  auto& msg = this->kTest1Msg;
+  auto& bsn = this->kBsn0;
+  SigRl const* sig_rl = reinterpret_cast<const SigRl*>(this->kSigRlData.data());
+  NrProveState* state = nullptr;
+  SplitNrProof proof;
+  THROW_ON_EPIDERR(NewNrProveState(member, msg.data(), msg.size(), bsn.data(),
+                                   bsn.size(), basic_sig, &state));
+
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrProveEntry(nullptr, state, &sig_rl->bk[0], &proof));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrProveEntry(member, nullptr, &sig_rl->bk[0], &proof));
+  EXPECT_EQ(kEpidBadArgErr, EpidNrProveEntry(member, state, nullptr, &proof));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrProveEntry(member, state, &sig_rl->bk[0], nullptr));
+  DeleteNrProveState(&state);
+  EXPECT_EQ(nullptr, state);
+}
+
+TEST_F(EpidSplitMemberTest, NrProveEntryGivesSameProofAsNrProve) {
+  PrivKey mpriv_key = this->kGrpXMember3PrivKeySha256;
+  GroupPubKey pub_key = this->kGrpXKey;
+  auto otp_data = kOtpDataWithoutRfAndNonce;
+  otp_data.insert(otp_data.end(), kNoncek.begin(), kNoncek.end());
+  otp_data.insert(otp_data.end(), NrProveEntropy.begin(), NrProveEntropy.end());
+  OneTimePad single_prng(otp_data);
+  OneTimePad stream_prng(otp_data);
+  MemberCtxObj single(pub_key, mpriv_key, this->kMemberPrecomp,
+                      &OneTimePad::Generate, &single_prng);
+  MemberCtxObj stream(pub_key, mpriv_key, this->kMemberPrecomp,
+                      &OneTimePad::Generate, &stream_prng);
+
+  BasicSignature basic_sig;
+  auto msg = this->kTest1Msg;
+  SigRl const* sig_rl = reinterpret_cast<const SigRl*>(this->kSigRlData.data());
+  BigNumStr rnd_bsn = {0};
+  SplitNrProof expected;
+  SplitNrProof proof;
+  FpElemStr nonce_k;
+  NrProveState* state = nullptr;
+
+  THROW_ON_EPIDERR(EpidSplitSignBasic(single, msg.data(), msg.size(), nullptr,
+                                      0, &basic_sig, &rnd_bsn, &nonce_k));
+  THROW_ON_EPIDERR(EpidSplitSignBasic(stream, msg.data(), msg.size(), nullptr,
+                                      0, &basic_sig, &rnd_bsn, &nonce_k));
+  THROW_ON_EPIDERR(EpidNrProve(single, msg.data(), msg.size(), &rnd_bsn,
+                               sizeof(rnd_bsn), &basic_sig, &sig_rl->bk[0],
+                               &expected));
+  THROW_ON_EPIDERR(NewNrProveState(stream, msg.data(), msg.size(), &rnd_bsn,
+                                   sizeof(rnd_bsn), &basic_sig, &state));
+  EXPECT_EQ(kEpidNoErr,
+            EpidNrProveEntry(stream, state, &sig_rl->bk[0], &proof));
+  DeleteNrProveState(&state);
+  EXPECT_EQ(expected, proof);
+}
+
+TEST_F(EpidSplitMemberTest, NrProveEntryGeneratesValidProofForEveryEntry) {
+  Prng my_prng;
+  GroupPubKey pub_key = this->kGrpXKey;
+  MemberCtxObj member(pub_key, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  BasicSignature basic_sig;
+  auto msg = this->kTest1Msg;
+  SigRl const* sig_rl =
+      reinterpret_cast<const SigRl*>(this->kSigRl5EntrySha256Data.data());
+  size_t num_entries = ntohl(sig_rl->n2);
+  BigNumStr rnd_bsn = {0};
+  FpElemStr nonce_k;
+  NrProveState* state = nullptr;
+  std::vector<SplitNrProof> proofs(num_entries);
+  ASSERT_LT((size_t)1, num_entries);
+
+  THROW_ON_EPIDERR(EpidSplitSignBasic(member, msg.data(), msg.size(), nullptr,
+                                      0, &basic_sig, &rnd_bsn, &nonce_k));
+  THROW_ON_EPIDERR(NewNrProveState(member, msg.data(), msg.size(), &rnd_bsn,
+                                   sizeof(rnd_bsn), &basic_sig, &state));
+  for (size_t i = 0; i < num_entries; i++) {
+    EXPECT_EQ(kEpidNoErr,
+              EpidNrProveEntry(member, state, &sig_rl->bk[i], &proofs[i]));
+  }
+  DeleteNrProveState(&state);
+
+  VerifierCtxObj verifier(pub_key);
+  for (size_t i = 0; i < num_entries; i++) {
+    EXPECT_EQ(kEpidSigValid,
+              EpidNrVerify(verifier, &basic_sig, msg.data(), msg.size(),
+                           &sig_rl->bk[i], &proofs[i], sizeof(proofs[i])));
+  }
+}
+
 }  // namespace
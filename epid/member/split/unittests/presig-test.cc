@@ -21,6 +21,8 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -33,6 +35,7 @@ extern "C" {
 #include "member-testhelper.h"
 #include "testhelper/errors-testhelper.h"
 #include "testhelper/prng-testhelper.h"
+#include "testhelper/verifier_wrapper-testhelper.h"
 
 /// Count of elements in array
 #define COUNT_OF(A) (sizeof(A) / sizeof((A)[0]))
@@ -89,6 +92,143 @@ TEST_F(EpidSplitMemberTest,
   EXPECT_EQ(presigs1_added + presigs2_added, EpidGetNumPreSigs(member));
 }
 
+/// Runs the iterations in reverse order and counts the loops
+struct ReverseLoop {
+  size_t loops = 0;
+  size_t iterations = 0;
+  static EpidStatus __STDCALL Run(ParallelTask task, void* task_param,
+                                  size_t count, void* user_data) {
+    ReverseLoop* loop = static_cast<ReverseLoop*>(user_data);
+    EpidStatus result = kEpidNoErr;
+    loop->loops++;
+    for (size_t i = count; i > 0; i--) {
+      EpidStatus sts = task(task_param, i - 1);
+      loop->iterations++;
+      if (kEpidNoErr != sts) {
+        result = sts;
+      }
+    }
+    return result;
+  }
+};
+
+/// Runs every iteration on its own thread
+struct ThreadLoop {
+  static EpidStatus __STDCALL Run(ParallelTask task, void* task_param,
+                                  size_t count, void* user_data) {
+    (void)user_data;
+    std::vector<EpidStatus> results(count, kEpidErr);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < count; i++) {
+      threads.emplace_back([&results, task, task_param, i]() {
+        results[i] = task(task_param, i);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (auto result : results) {
+      if (kEpidNoErr != result) {
+        return result;
+      }
+    }
+    return kEpidNoErr;
+  }
+};
+
+/// Fails without running any iteration
+EpidStatus __STDCALL FailingLoop(ParallelTask task, void* task_param,
+                                 size_t count, void* user_data) {
+  (void)task;
+  (void)task_param;
+  (void)count;
+  (void)user_data;
+  return kEpidErr;
+}
+
+/// Random number generator that can be called from several threads
+struct LockedPrng {
+  Prng prng;
+  std::mutex mutex;
+  static int __STDCALL Generate(unsigned int* random_data, int num_bits,
+                                void* user_data) {
+    LockedPrng* locked = static_cast<LockedPrng*>(user_data);
+    std::lock_guard<std::mutex> lock(locked->mutex);
+    return Prng::Generate(random_data, num_bits, &locked->prng);
+  }
+};
+
+/// Signs with every pre-computed signature of the pool and verifies
+void ExpectPoolSignsValidSignatures(MemberCtx* member,
+                                    GroupPubKey const& pub_key,
+                                    std::vector<uint8_t> const& msg) {
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  VerifierCtxObj verifier(pub_key);
+  THROW_ON_EPIDERR(EpidVerifierSetHashAlg(verifier, kSha256));
+  while (EpidGetNumPreSigs(member) > 0) {
+    THROW_ON_EPIDERR(
+        EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+    EXPECT_EQ(kEpidSigValid,
+              EpidVerify(verifier, sig, sig_len, msg.data(), msg.size()));
+  }
+}
+
+TEST_F(EpidSplitMemberTest, AddPreSigsHandsComputationToParallelFor) {
+  Prng my_prng;
+  ReverseLoop loop;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  THROW_ON_EPIDERR(
+      EpidMemberSetParallelFor(member, &ReverseLoop::Run, &loop));
+
+  EXPECT_EQ(kEpidNoErr, EpidAddPreSigs(member, 9));
+  EXPECT_EQ((size_t)9, EpidGetNumPreSigs(member));
+  EXPECT_EQ((size_t)1, loop.loops);
+  EXPECT_LT((size_t)1, loop.iterations);
+  ExpectPoolSignsValidSignatures(member, this->kGrpXKey, this->kMsg0);
+}
+
+TEST_F(EpidSplitMemberTest, AddPreSigsUsesFewTasksAndReusesTheirState) {
+  Prng my_prng;
+  ReverseLoop loop;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  THROW_ON_EPIDERR(
+      EpidMemberSetParallelFor(member, &ReverseLoop::Run, &loop));
+
+  EXPECT_EQ(kEpidNoErr, EpidAddPreSigs(member, 20));
+  EXPECT_EQ((size_t)8, loop.iterations);
+  EXPECT_EQ(kEpidNoErr, EpidAddPreSigs(member, 3));
+  EXPECT_EQ((size_t)11, loop.iterations);
+  EXPECT_EQ((size_t)23, EpidGetNumPreSigs(member));
+  ExpectPoolSignsValidSignatures(member, this->kGrpXKey, this->kMsg0);
+}
+
+TEST_F(EpidSplitMemberTest, AddPreSigsComputesValidPreSigsOnThreads) {
+  LockedPrng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &LockedPrng::Generate, &my_prng);
+  THROW_ON_EPIDERR(EpidMemberSetParallelFor(member, &ThreadLoop::Run, nullptr));
+
+  EXPECT_EQ(kEpidNoErr, EpidAddPreSigs(member, 9));
+  EXPECT_EQ(kEpidNoErr, EpidAddPreSigs(member, 9));
+  EXPECT_EQ((size_t)18, EpidGetNumPreSigs(member));
+  ExpectPoolSignsValidSignatures(member, this->kGrpXKey, this->kMsg0);
+}
+
+TEST_F(EpidSplitMemberTest, AddPreSigsRollsBackIfParallelForFails) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(EpidMemberSetParallelFor(member, &FailingLoop, nullptr));
+
+  EXPECT_EQ(kEpidErr, EpidAddPreSigs(member, 5));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+}
+
 ///////////////////////////////////////////////////////////////////////
 // EpidGetNumPreSigs
 TEST_F(EpidSplitMemberTest, GetNumPreSigsReturnsZeroGivenNullptr) {
@@ -114,4 +254,148 @@ TEST_F(EpidSplitMemberTest, GetNumPreSigsReturnsNumberOfAddedPresigs) {
   EXPECT_EQ(presigs_added, EpidGetNumPreSigs(member));
 }
 
+///////////////////////////////////////////////////////////////////////
+// EpidSetPreSigWatermarks
+TEST_F(EpidSplitMemberTest, SetPreSigWatermarksFailsGivenNullPointer) {
+  EXPECT_EQ(kEpidBadArgErr, EpidSetPreSigWatermarks(nullptr, 1, 2));
+}
+
+TEST_F(EpidSplitMemberTest, SetPreSigWatermarksFailsGivenInvalidWatermarks) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  EXPECT_EQ(kEpidBadArgErr, EpidSetPreSigWatermarks(member, 2, 2));
+  EXPECT_EQ(kEpidBadArgErr, EpidSetPreSigWatermarks(member, 3, 1));
+  EXPECT_EQ(kEpidBadArgErr, EpidSetPreSigWatermarks(member, 1, 0));
+}
+
+TEST_F(EpidSplitMemberTest, SetPreSigWatermarksAcceptsZeroToDisable) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  EXPECT_EQ(kEpidNoErr, EpidSetPreSigWatermarks(member, 0, 0));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidRefillPreSigs
+TEST_F(EpidSplitMemberTest, RefillPreSigsFailsGivenNullPointer) {
+  EXPECT_EQ(kEpidBadArgErr, EpidRefillPreSigs(nullptr, 0));
+}
+
+TEST_F(EpidSplitMemberTest, RefillPreSigsDoesNothingByDefault) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidSplitMemberTest, RefillPreSigsFillsPoolToHighWatermark) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  THROW_ON_EPIDERR(EpidSetPreSigWatermarks(member, 1, 3));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)3, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidSplitMemberTest, RefillPreSigsAddsAtMostRequestedNumber) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  THROW_ON_EPIDERR(EpidSetPreSigWatermarks(member, 1, 3));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 1));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+  // refilling continues above the low watermark until the pool is full
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 1));
+  EXPECT_EQ((size_t)2, EpidGetNumPreSigs(member));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 5));
+  EXPECT_EQ((size_t)3, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidSplitMemberTest, RefillPreSigsWaitsForLowWatermark) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 2));
+  THROW_ON_EPIDERR(EpidSetPreSigWatermarks(member, 1, 3));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)2, EpidGetNumPreSigs(member));
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidGetPreSigStats
+TEST_F(EpidSplitMemberTest, GetPreSigStatsFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t hits = 0;
+  size_t misses = 0;
+
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigStats(nullptr, &hits, &misses));
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigStats(member, nullptr, &misses));
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigStats(member, &hits, nullptr));
+}
+
+TEST_F(EpidSplitMemberTest, GetPreSigStatsCountsPoolHitsAndMisses) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  size_t hits = 0;
+  size_t misses = 0;
+
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(
+      EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+  THROW_ON_EPIDERR(
+      EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+  EXPECT_EQ(kEpidNoErr, EpidGetPreSigStats(member, &hits, &misses));
+  EXPECT_EQ((size_t)1, hits);
+  EXPECT_EQ((size_t)1, misses);
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidGetPreSigStoreSize, EpidExportPreSigs, EpidImportPreSigs
+TEST_F(EpidSplitMemberTest, PreSigStoreIsNotSupported) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  std::vector<uint8_t> store(1024);
+  size_t store_size = 0;
+
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidGetPreSigStoreSize(member, 1, &store_size));
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidExportPreSigs(member, store.data(), store.size()));
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidImportPreSigs(member, store.data(), store.size()));
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidGetPreSigBufferSize, EpidMemberSetPreSigBuffer
+TEST_F(EpidSplitMemberTest, PreSigBufferIsNotSupported) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  std::vector<uint8_t> buffer(1024);
+  size_t buffer_size = 0;
+
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidGetPreSigBufferSize(member, 1, &buffer_size));
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+}
+
 }  // namespace
@@ -294,4 +294,86 @@ TEST_F(EpidSplitMemberTest,
   EXPECT_EQ(kEpidSigValid,
             EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
 }
+//////////////////////////////////////////////////////////////////////////
+// EpidPrepareProvisionKeys
+TEST_F(EpidSplitMemberTest, PrepareProvisionKeysFailsGivenNullParameters) {
+  GroupPubKey pub_key = this->kGrpXKey;
+  PrivKey priv_key = this->kGrpXMember3PrivKeySha256;
+  MemberPrecomp precomp;
+  EpidStatus result;
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidPrepareProvisionKeys(nullptr, &priv_key, 1, &precomp, &result));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidPrepareProvisionKeys(&pub_key, nullptr, 1, &precomp, &result));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidPrepareProvisionKeys(&pub_key, &priv_key, 1, nullptr, &result));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidPrepareProvisionKeys(&pub_key, &priv_key, 1, &precomp, nullptr));
+}
+
+TEST_F(EpidSplitMemberTest, PrepareProvisionKeysComputesMemberPrecomp) {
+  Prng prng;
+  GroupPubKey pub_key = this->kGrpXKey;
+  std::vector<PrivKey> priv_keys(2, this->kGrpXMember3PrivKeySha256);
+  std::vector<MemberPrecomp> precomps(priv_keys.size());
+  std::vector<EpidStatus> results(priv_keys.size(), kEpidErr);
+  EXPECT_EQ(kEpidNoErr,
+            EpidPrepareProvisionKeys(&pub_key, priv_keys.data(),
+                                     priv_keys.size(), precomps.data(),
+                                     results.data()));
+  for (size_t i = 0; i < priv_keys.size(); i++) {
+    EXPECT_EQ(kEpidNoErr, results[i]);
+    EXPECT_EQ(0, memcmp(&this->kMemberPrecomp, &precomps[i],
+                        sizeof(precomps[i])));
+  }
+
+  MemberParams params = {0};
+  SetMemberParams(&Prng::Generate, &prng, nullptr, &params);
+  MemberCtxObj member(&params);
+  THROW_ON_EPIDERR(ProvisionBulkAndStart(member, &pub_key, &priv_keys[1],
+                                         &precomps[1]));
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  EXPECT_EQ(kEpidNoErr,
+            EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+  VerifierCtxObj ctx(pub_key);
+  EXPECT_EQ(kEpidSigValid,
+            EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
+}
+
+TEST_F(EpidSplitMemberTest, PrepareProvisionKeysReportsStatusOfEachKey) {
+  GroupPubKey pub_key = this->kGrpXKey;
+  std::vector<PrivKey> priv_keys(4, this->kGrpXMember3PrivKeySha256);
+  priv_keys[1].A.x.data.data[0]++;
+  priv_keys[2].gid.data[0]++;
+  std::vector<MemberPrecomp> precomps(priv_keys.size());
+  std::vector<EpidStatus> results(priv_keys.size(), kEpidErr);
+  MemberPrecomp const zero_precomp = {0};
+  EXPECT_NE(kEpidNoErr,
+            EpidPrepareProvisionKeys(&pub_key, priv_keys.data(),
+                                     priv_keys.size(), precomps.data(),
+                                     results.data()));
+  EXPECT_EQ(kEpidNoErr, results[0]);
+  EXPECT_EQ(kEpidBadPrivKeyErr, results[1]);
+  EXPECT_EQ(kEpidKeyNotInGroupErr, results[2]);
+  EXPECT_EQ(kEpidNoErr, results[3]);
+  EXPECT_EQ(0, memcmp(&this->kMemberPrecomp, &precomps[0],
+                      sizeof(precomps[0])));
+  EXPECT_EQ(0, memcmp(&zero_precomp, &precomps[1], sizeof(precomps[1])));
+  EXPECT_EQ(0, memcmp(&zero_precomp, &precomps[2], sizeof(precomps[2])));
+  EXPECT_EQ(0, memcmp(&this->kMemberPrecomp, &precomps[3],
+                      sizeof(precomps[3])));
+}
+
+TEST_F(EpidSplitMemberTest, PrepareProvisionKeysFailsGivenUnsupportedHashAlg) {
+  GroupPubKey pub_key = this->kGrpXKey;
+  PrivKey priv_key = this->kGrpXMember3PrivKeySha256;
+  MemberPrecomp precomp;
+  EpidStatus result;
+  SetHashBitsInGid(0x4, &pub_key, &priv_key);
+  EXPECT_EQ(kEpidHashAlgorithmNotSupported,
+            EpidPrepareProvisionKeys(&pub_key, &priv_key, 1, &precomp, &result));
+}
 }  // namespace
@@ -268,4 +268,18 @@ TEST_F(EpidSplitMemberTest, SignConsumesPrecomputedSignaturesWithSigRl) {
 /////////////////////////////////////////////////////////////////////////
 // Variable messages
 
+/////////////////////////////////////////////////////////////////////////
+// EpidMemberSetParallelFor
+TEST_F(EpidSplitMemberTest, SetParallelForFailsGivenNullContext) {
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetParallelFor(nullptr, nullptr, nullptr));
+}
+
+TEST_F(EpidSplitMemberTest, SetParallelForAcceptsNullToDisable) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      &Prng::Generate, &my_prng);
+  EXPECT_EQ(kEpidNoErr, EpidMemberSetParallelFor(member, nullptr, nullptr));
+}
+
 }  // namespace
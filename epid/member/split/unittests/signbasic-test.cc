@@ -17,11 +17,14 @@
 /*! \file */
 
 #include <cstring>
+#include <vector>
 #include "gtest/gtest.h"
 #include "testhelper/epid_gtest-testhelper.h"
 
 extern "C" {
+#include "common/ring.h"
 #include "epid/member/api.h"
+#include "epid/member/split/context.h"
 #include "epid/member/split/signbasic.h"
 #include "epid/verifier.h"
 #include "verifybasic.h"
@@ -209,6 +212,26 @@ TEST_F(EpidSplitMemberTest, SignBasicConsumesPrecomputedSignatures) {
   EXPECT_EQ((size_t)2, EpidGetNumPreSigs(member));
 }
 
+TEST_F(EpidSplitMemberTest, SignBasicClearsPoolSlotOfConsumedPreSig) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGrpXKey, this->kGrpXMember3PrivKeySha256,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  MemberCtx* ctx = member;
+  uint8_t const* slot = static_cast<uint8_t*>(RingFront(&ctx->presigs));
+  ASSERT_NE(nullptr, slot);
+  auto& msg = this->kMsg0;
+  BasicSignature basic_sig;
+  BigNumStr rnd_bsn = {0};
+  FpElemStr nonce = {0};
+  ASSERT_EQ(kEpidNoErr,
+            EpidSplitSignBasic(member, msg.data(), msg.size(), nullptr, 0,
+                               &basic_sig, &rnd_bsn, &nonce));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+  std::vector<uint8_t> zero(sizeof(PreComputedSignature), 0);
+  EXPECT_EQ(0, std::memcmp(zero.data(), slot, zero.size()));
+}
+
 TEST_F(EpidSplitMemberTest,
        PROTECTED_SignBasicSucceedsUsingRndBasePrecompSigWithCredential_EPS0) {
   Prng my_prng;
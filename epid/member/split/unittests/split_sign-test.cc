@@ -1222,4 +1222,103 @@ TEST_F(EpidMemberSplitSignTest,
             EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
 }
 
+/////////////////////////////////////////////////////////////////////////
+// EpidSignStream
+
+/// Collects the pieces of a streamed signature
+struct SigCollector {
+  std::vector<uint8_t> sig;
+  size_t pieces = 0;
+  size_t max_pieces = (size_t)-1;
+  static EpidStatus __STDCALL Write(void const* data, size_t data_len,
+                                    void* user_data) {
+    SigCollector* collector = static_cast<SigCollector*>(user_data);
+    if (collector->pieces >= collector->max_pieces) {
+      return kEpidErr;
+    }
+    collector->pieces++;
+    auto bytes = static_cast<uint8_t const*>(data);
+    collector->sig.insert(collector->sig.end(), bytes, bytes + data_len);
+    return kEpidNoErr;
+  }
+};
+
+TEST_F(EpidMemberSplitSignTest, SignStreamFailsGivenNullParameters) {
+  Prng my_prng;
+  MemberCtxObj member(kGrpXKey, kGrpXMember3Sha256PrivKey,
+                      kMember3Sha256Precomp, &Prng::Generate, &my_prng);
+  auto& msg = kMsg0;
+  auto& bsn = kBsn0;
+  SigCollector collector;
+  THROW_ON_EPIDERR(EpidRegisterBasename(member, bsn.data(), bsn.size()));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidSignStream(nullptr, msg.data(), msg.size(), bsn.data(),
+                           bsn.size(), &SigCollector::Write, &collector));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidSignStream(member, nullptr, msg.size(), bsn.data(), bsn.size(),
+                           &SigCollector::Write, &collector));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidSignStream(member, msg.data(), msg.size(), nullptr, bsn.size(),
+                           &SigCollector::Write, &collector));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidSignStream(member, msg.data(), msg.size(), bsn.data(),
+                           bsn.size(), nullptr, &collector));
+  EXPECT_EQ((size_t)0, collector.pieces);
+}
+
+TEST_F(EpidMemberSplitSignTest, SignStreamWritesSameSignatureAsSign) {
+  SigRl const* srl =
+      reinterpret_cast<SigRl const*>(kSigRl5EntrySha256Data.data());
+  size_t srl_size = kSigRl5EntrySha256Data.size() * sizeof(uint8_t);
+  auto otp_data = kOtpDataWithoutRfAndNonce;
+  otp_data.insert(otp_data.end(), kNoncek.begin(), kNoncek.end());
+  for (uint32_t i = 0; i < ntohl(srl->n2); ++i) {
+    otp_data.insert(otp_data.end(), NrProveEntropy.begin(),
+                    NrProveEntropy.end());
+  }
+  OneTimePad sign_prng(otp_data);
+  OneTimePad stream_prng(otp_data);
+  MemberCtxObj sign_member(kGrpXKey, kGrpXMember3Sha256PrivKey,
+                           kMember3Sha256Precomp, &OneTimePad::Generate,
+                           &sign_prng);
+  MemberCtxObj stream_member(kGrpXKey, kGrpXMember3Sha256PrivKey,
+                             kMember3Sha256Precomp, &OneTimePad::Generate,
+                             &stream_prng);
+  auto& msg = kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(srl));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  SigCollector collector;
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(sign_member, srl, srl_size));
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(stream_member, srl, srl_size));
+  THROW_ON_EPIDERR(EpidSign(sign_member, msg.data(), msg.size(), nullptr, 0,
+                            sig, sig_data.size()));
+  EXPECT_EQ(kEpidNoErr,
+            EpidSignStream(stream_member, msg.data(), msg.size(), nullptr, 0,
+                           &SigCollector::Write, &collector));
+  EXPECT_EQ(sig_data, collector.sig);
+  VerifierCtxObj ctx(kGrpXKey);
+  THROW_ON_EPIDERR(EpidVerifierSetSigRl(ctx, srl, srl_size));
+  EXPECT_EQ(kEpidSigValid,
+            EpidVerify(ctx, (EpidSignature*)collector.sig.data(),
+                       collector.sig.size(), msg.data(), msg.size()));
+}
+
+TEST_F(EpidMemberSplitSignTest, SignStreamStopsIfSinkFails) {
+  Prng my_prng;
+  MemberCtxObj member(kGrpXKey, kGrpXMember3Sha256PrivKey,
+                      kMember3Sha256Precomp, &Prng::Generate, &my_prng);
+  SigRl const* srl =
+      reinterpret_cast<SigRl const*>(kSigRl5EntrySha256Data.data());
+  size_t srl_size = kSigRl5EntrySha256Data.size() * sizeof(uint8_t);
+  auto& msg = kMsg0;
+  SigCollector collector;
+  collector.max_pieces = 1;
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member, srl, srl_size));
+  EXPECT_EQ(kEpidErr,
+            EpidSignStream(member, msg.data(), msg.size(), nullptr, 0,
+                           &SigCollector::Write, &collector));
+  EXPECT_EQ((size_t)1, collector.pieces);
+  EXPECT_EQ(EpidGetSigSize(nullptr), collector.sig.size());
+}
+
 }  // namespace
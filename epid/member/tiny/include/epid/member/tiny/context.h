@@ -17,10 +17,11 @@
 /*! \file */
 #ifndef EPID_MEMBER_TINY_SRC_CONTEXT_H_
 #define EPID_MEMBER_TINY_SRC_CONTEXT_H_
+#include "common/ring.h"
 #include "epid/bitsupplier.h"
+#include "epid/member/api.h"
 #include "epid/member/tiny/allowed_basenames.h"
 #include "epid/member/tiny/native_types.h"
-#include "epid/member/tiny/stack.h"
 #include "epid/types.h"
 #include "tinymath/mathtypes.h"
 
@@ -34,18 +35,29 @@ typedef struct MemberCtx {
   MembershipCredential credential;  ///< Membership credential
   FpElem f;                         ///< secret f value
   NativeMemberPrecomp precomp;      ///< Precomputed pairing values
-  PairingState pairing_state;       ///< pairing state
   int f_is_set;                     ///< f initialized
   int is_provisioned;    ///< member fully provisioned with key material
   BitSupplier rnd_func;  ///< Pseudo random number generation function
-  Stack presigs;         ///< Container of pre-computed signature
+  Ring presigs;          ///< Container of pre-computed signature
   void* rnd_param;       ///< Pointer to user context for rnd_func
   AllowedBasenames* allowed_basenames;  ///< Allowed basenames
   SigRl* sig_rl;             ///< Pointer to Signature based revocation list
+  SigRl* sig_rl_buf;         ///< Storage for a SigRl copied by value
   size_t max_sigrl_entries;  ///< Maximum number of possible entries in SigRl
                              /// copied by value
   size_t max_allowed_basenames;  ///< Maximum number of allowed base names
   size_t max_precomp_sig;        ///< Maximum number of precomputed signatures
+  size_t presig_low_watermark;   ///< Pool size at which refilling starts
+  size_t presig_high_watermark;  ///< Pool size at which refilling stops
+  int is_presig_refilling;       ///< Pool is being refilled
+  size_t presig_hits;    ///< Number of presigs taken from the pool
+  size_t presig_misses;  ///< Number of presigs computed on an empty pool
+  uint32_t comb_teeth;           ///< Teeth of the comb table of h2, 0 if none
+  EccPointFq* h2_comb;           ///< Comb table of h2 in the heap
+  Fq12MultiExpTable* presig_table;  ///< Products of the precomputed
+                                    ///  pairings in the heap, can be NULL
+  ParallelFor parallel_for;      ///< Runs non-revoked proofs, can be NULL
+  void* parallel_for_param;      ///< Pointer to user context for parallel_for
   unsigned char heap[1];         ///< Bulk storage space (flexible array)
 } MemberCtx;
 
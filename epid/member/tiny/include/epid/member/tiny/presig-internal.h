@@ -45,19 +45,24 @@ typedef struct PreComputedSignatureData PreComputedSignatureData;
   \param[in] ctx
   The member context.
 
+  \param[out] scratch
+  Storage for a pre-computed signature computed because the pool is
+  empty.
+
   \param[out] presig
-  The pre-computed signature removed from members's pool
+  The oldest pre-computed signature in members's pool, or scratch
 
   \returns ::EpidStatus
 
   \see MemberPopPreSig
  */
-EpidStatus MemberTopPreSig(MemberCtx* ctx, PreComputedSignatureData** presig);
+EpidStatus MemberTopPreSig(MemberCtx* ctx, PreComputedSignatureData* scratch,
+                           PreComputedSignatureData** presig);
 
 /// Provides a precomputed signature
 /*!
 
-  Removes a pre-computed signature from a member context.
+  Removes a pre-computed signature from a member context and clears it.
 
   \warning
   Pre-computed signatures must not be accessed outside of the secure
@@ -66,9 +71,12 @@ EpidStatus MemberTopPreSig(MemberCtx* ctx, PreComputedSignatureData** presig);
   \param[in,out] ctx
   The member context.
 
+  \param[in,out] presig
+  The pre-computed signature provided by MemberTopPreSig()
+
   \returns ::EpidStatus
 
  */
-EpidStatus MemberPopPreSig(MemberCtx* ctx);
+EpidStatus MemberPopPreSig(MemberCtx* ctx, PreComputedSignatureData* presig);
 
 #endif  // EPID_MEMBER_TINY_SRC_PRESIG_INTERNAL_H_
@@ -44,6 +44,14 @@ typedef struct PreComputedSignatureData {
   FpElem rb;      ///< an integer between [0, p-1]
 } PreComputedSignatureData;
 
+/// Prepares signature pre-computation after the member is provisioned
+/*!
+ Fills the table of products of the precomputed pairings used by
+ EpidMemberComputePreSig and the comb table of h2 if the member was
+ configured with them.
+ */
+void EpidMemberInitPreSigCompute(MemberCtx* ctx);
+
 /// Performs signature pre-computation
 EpidStatus EpidMemberComputePreSig(MemberCtx const* ctx,
                                    PreComputedSignatureData* presig);
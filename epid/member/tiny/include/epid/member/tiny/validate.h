@@ -29,8 +29,6 @@ typedef struct NativePrivKey NativePrivKey;
 
 typedef struct MembershipCredential MembershipCredential;
 typedef struct NativeMembershipCredential NativeMembershipCredential;
-
-typedef struct PairingState PairingState;
 /// \endcond
 
 /// Test if the elements of a Group Public Key are in appropriate ranges.
@@ -54,14 +52,12 @@ int MembershipCredentialIsInRange(NativeMembershipCredential const* input);
 \param[in] input the value to test.
 \param[in] f the f value.
 \param[in] pubkey the group key.
-\param[in] pairing_state previously computed pairing state.
 \returns A value different from zero (i.e., true) if indeed
          it is in the group. Zero (i.e., false) otherwise.
 */
 int MembershipCredentialIsInGroup(NativeMembershipCredential const* input,
                                   FpElem const* f,
-                                  NativeGroupPubKey const* pubkey,
-                                  PairingState const* pairing_state);
+                                  NativeGroupPubKey const* pubkey);
 
 /// Test if the elements of a Private Key are in appropriate ranges.
 /*!
@@ -75,12 +71,10 @@ int PrivKeyIsInRange(NativePrivKey const* input);
 /*!
 \param[in] input the value to test.
 \param[in] pubkey the group key.
-\param[in] pairing_state previously computed pairing state.
 \returns A value different from zero (i.e., true) if indeed
          it is in the group. Zero (i.e., false) otherwise.
 */
 int PrivKeyIsInGroup(NativePrivKey const* input,
-                     NativeGroupPubKey const* pubkey,
-                     PairingState const* pairing_state);
+                     NativeGroupPubKey const* pubkey);
 
 #endif  // EPID_MEMBER_TINY_SRC_VALIDATE_H_
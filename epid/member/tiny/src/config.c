@@ -17,6 +17,7 @@
 /*! \file */
 #define EXPORT_EPID_APIS
 #include "epid/member/api.h"
+#include "tinymath/efq.h"
 
 #define UNUSED(x) (void)(x)
 
@@ -73,3 +74,18 @@ EpidMemberSetMaxPrecomputedSigs(size_t n, MemberParams* config) {
   config->max_precomp_sig = n;
   return kEpidNoErr;
 }
+
+EpidStatus EPID_MEMBER_API
+EpidMemberSetFixedBaseCombTeeth(size_t teeth, MemberParams* config) {
+  if (!config) return kEpidBadConfigErr;
+  if (teeth > EFQ_COMB_MAX_TEETH) return kEpidBadArgErr;
+  config->comb_teeth = teeth;
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API
+EpidMemberSetPreSigMultiExpTable(int enable, MemberParams* config) {
+  if (!config) return kEpidBadConfigErr;
+  config->presig_multiexp_table = enable ? 1 : 0;
+  return kEpidNoErr;
+}
@@ -27,3 +27,14 @@ EpidStatus EPID_MEMBER_API EpidDecompressPrivKey(
   (void)priv_key;
   return kEpidNotImpl;
 }
+
+EpidStatus EPID_MEMBER_API EpidDecompressPrivKeys(
+    GroupPubKey const* pub_key, CompressedPrivKey const* compressed_privkeys,
+    size_t count, PrivKey* priv_keys, EpidStatus* results) {
+  (void)pub_key;
+  (void)compressed_privkeys;
+  (void)count;
+  (void)priv_keys;
+  (void)results;
+  return kEpidNotImpl;
+}
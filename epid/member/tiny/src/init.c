@@ -20,19 +20,31 @@
 #include <epid/member/api.h>
 
 #include <stdint.h>
+#include "common/ring.h"
 #include "epid/member/tiny/context.h"
 #include "epid/member/tiny/presig_compute.h"
 #include "epid/member/tiny/serialize.h"
-#include "epid/member/tiny/stack.h"
 #include "epid/types.h"
+#include "tinymath/efq.h"
 #include "tinymath/fp.h"
 #include "tinymath/mathtypes.h"
-#include "tinymath/pairing.h"
 #include "tinymath/serialize.h"
 #include "tinystdlib/tiny_stdlib.h"
 
 static size_t SigrlGetSize(size_t num_sigrls) {
+#ifdef USE_SIGRL_BY_REFERENCE
+  // the SigRl is used in place and never copied to the heap
+  (void)num_sigrls;
+  return 0;
+#else
   return MIN_SIGRL_SIZE + num_sigrls * sizeof(SigRlEntry);
+#endif
+}
+static size_t CombTableGetSize(size_t teeth) {
+  return teeth ? EFQ_COMB_TABLE_SIZE(teeth) * sizeof(EccPointFq) : 0;
+}
+static size_t PreSigTableGetSize(int presig_multiexp_table) {
+  return presig_multiexp_table ? sizeof(Fq12MultiExpTable) : 0;
 }
 EpidStatus EPID_MEMBER_API EpidMemberGetSize(MemberParams const* params,
                                              size_t* context_size) {
@@ -41,9 +53,14 @@ EpidStatus EPID_MEMBER_API EpidMemberGetSize(MemberParams const* params,
   if (!params || !context_size) {
     return kEpidBadArgErr;
   }
+  if (params->comb_teeth > EFQ_COMB_MAX_TEETH) {
+    return kEpidBadArgErr;
+  }
   *context_size = kMinContextSize + SigrlGetSize(params->max_sigrl_entries) +
                   BasenamesGetSize(params->max_allowed_basenames) +
-                  sizeof(PreComputedSignatureData) * params->max_precomp_sig;
+                  sizeof(PreComputedSignatureData) * params->max_precomp_sig +
+                  CombTableGetSize(params->comb_teeth) +
+                  PreSigTableGetSize(params->presig_multiexp_table);
   return kEpidNoErr;
 }
 
@@ -68,6 +85,10 @@ EpidStatus EPID_MEMBER_API EpidMemberInit(MemberParams const* params,
   // set the default hash algorithm to sha512
   ctx->hash_alg = kSha512;
 
+#ifndef USE_SIGRL_BY_REFERENCE
+  // the SigRl is copied to the start of the heap
+  ctx->sig_rl_buf = (SigRl*)ctx->heap;
+#endif
   // set allowed basenames pointer to the heap
   ctx->allowed_basenames =
       (AllowedBasenames*)&ctx->heap[SigrlGetSize(params->max_sigrl_entries)];
@@ -77,9 +98,27 @@ EpidStatus EPID_MEMBER_API EpidMemberInit(MemberParams const* params,
   if (!params->max_precomp_sig) {
     return kEpidBadArgErr;
   }
-  InitPreSigStack(&ctx->presigs, params->max_precomp_sig,
-                  &ctx->heap[SigrlGetSize(params->max_sigrl_entries) +
-                             BasenamesGetSize(params->max_allowed_basenames)]);
+  InitRing(&ctx->presigs, sizeof(PreComputedSignatureData),
+           params->max_precomp_sig,
+           &ctx->heap[SigrlGetSize(params->max_sigrl_entries) +
+                      BasenamesGetSize(params->max_allowed_basenames)]);
+  // set comb table pointer to the heap, it is filled when provisioned
+  if (params->comb_teeth) {
+    size_t offset = SigrlGetSize(params->max_sigrl_entries) +
+                    BasenamesGetSize(params->max_allowed_basenames) +
+                    sizeof(PreComputedSignatureData) * params->max_precomp_sig;
+    ctx->comb_teeth = (uint32_t)params->comb_teeth;
+    ctx->h2_comb = (EccPointFq*)&ctx->heap[offset];
+  }
+  // set pairing product table pointer to the heap, it is filled when
+  // provisioned
+  if (params->presig_multiexp_table) {
+    size_t offset = SigrlGetSize(params->max_sigrl_entries) +
+                    BasenamesGetSize(params->max_allowed_basenames) +
+                    sizeof(PreComputedSignatureData) * params->max_precomp_sig +
+                    CombTableGetSize(params->comb_teeth);
+    ctx->presig_table = (Fq12MultiExpTable*)&ctx->heap[offset];
+  }
   if (params->f) {
     FpDeserialize(&ctx->f, params->f);
     if (!FpInField(&ctx->f)) {
@@ -93,7 +132,6 @@ EpidStatus EPID_MEMBER_API EpidMemberInit(MemberParams const* params,
   ctx->max_sigrl_entries = params->max_sigrl_entries;
   ctx->max_allowed_basenames = params->max_allowed_basenames;
   ctx->max_precomp_sig = params->max_precomp_sig;
-  PairingInit(&ctx->pairing_state);
   return kEpidNoErr;
 }
 
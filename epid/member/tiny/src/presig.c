@@ -18,64 +18,183 @@
 
 #define EXPORT_EPID_APIS
 #include <epid/member/api.h>
+
+#include <stdint.h>
+#include "common/ring.h"
 #include "epid/member/tiny/context.h"
 #include "epid/member/tiny/presig_compute.h"
-#include "epid/member/tiny/stack.h"
+#include "epid/member/tiny/presig-internal.h"
+#include "tinystdlib/tiny_stdlib.h"
 
 EpidStatus EPID_MEMBER_API EpidAddPreSigs(MemberCtx* ctx,
                                           size_t number_presigs) {
-  PreComputedSignatureData* new_presigs = NULL;
+  PreComputedSignatureData* new_presig = NULL;
   size_t i = 0;
   if (!ctx) return kEpidBadArgErr;
 
   if (0 == number_presigs) return kEpidNoErr;
 
-  new_presigs = StackPushN(&ctx->presigs, number_presigs, NULL);
-  if (!new_presigs) return kEpidBadArgErr;
+  // the pool must have room for all of them before any is computed
+  if (!RingGetFree(&ctx->presigs, number_presigs - 1)) {
+    return kEpidBadArgErr;
+  }
 
   for (i = 0; i < number_presigs; i++) {
-    EpidStatus sts = EpidMemberComputePreSig(ctx, &new_presigs[i]);
+    EpidStatus sts = kEpidErr;
+    new_presig = RingGetFree(&ctx->presigs, i);
+    sts = EpidMemberComputePreSig(ctx, new_presig);
     if (kEpidNoErr != sts) {
-      // roll back pre-computed-signature pool
-      StackPopN(&ctx->presigs, number_presigs);
+      // roll back pre-computed-signature pool, nothing has been added yet
+      size_t j = 0;
+      for (j = 0; j <= i; j++) {
+        RingWipe(RingGetFree(&ctx->presigs, j), sizeof(*new_presig));
+      }
       return sts;
     }
   }
+  // the new pre-computed signatures become visible to signing at once
+  if (!RingPushN(&ctx->presigs, number_presigs)) {
+    return kEpidErr;
+  }
 
   return kEpidNoErr;
 }
 
 size_t EPID_MEMBER_API EpidGetNumPreSigs(MemberCtx const* ctx) {
-  return ctx ? StackGetSize(&ctx->presigs) : (size_t)0;
+  return ctx ? RingGetSize(&ctx->presigs) : (size_t)0;
 }
 
-EpidStatus MemberTopPreSig(MemberCtx* ctx, PreComputedSignatureData** presig) {
-  if (!ctx || !presig) {
+EpidStatus EPID_MEMBER_API EpidSetPreSigWatermarks(MemberCtx* ctx,
+                                                   size_t low_watermark,
+                                                   size_t high_watermark) {
+  if (!ctx) return kEpidBadArgErr;
+  if (high_watermark <= low_watermark &&
+      !(0 == low_watermark && 0 == high_watermark)) {
     return kEpidBadArgErr;
   }
+  ctx->presig_low_watermark = low_watermark;
+  ctx->presig_high_watermark = high_watermark;
+  ctx->is_presig_refilling = 0;
+  return kEpidNoErr;
+}
 
-  if (!StackGetSize(&ctx->presigs)) {
-    // if there is no presig, add one to heap so that it can be referenced from
-    // StackTop()
-    EpidStatus sts = EpidAddPreSigs(ctx, 1);
-    if (kEpidNoErr != sts) {
-      return sts;
-    }
+EpidStatus EPID_MEMBER_API EpidRefillPreSigs(MemberCtx* ctx,
+                                             size_t max_number_presigs) {
+  EpidStatus sts = kEpidErr;
+  size_t size = 0;
+  size_t number_presigs = 0;
+  if (!ctx) return kEpidBadArgErr;
+
+  if (0 == ctx->presig_high_watermark) return kEpidNoErr;
+
+  // only the producer side adds, so the pool cannot grow behind our back
+  size = RingGetSize(&ctx->presigs);
+  if (size <= ctx->presig_low_watermark) {
+    ctx->is_presig_refilling = 1;
+  }
+  if (!ctx->is_presig_refilling) return kEpidNoErr;
+  if (size >= ctx->presig_high_watermark) {
+    ctx->is_presig_refilling = 0;
+    return kEpidNoErr;
+  }
+
+  number_presigs = ctx->presig_high_watermark - size;
+  if (max_number_presigs > 0 && max_number_presigs < number_presigs) {
+    number_presigs = max_number_presigs;
+  }
+  // the pool has a fixed capacity, a high watermark above it fills it
+  if (number_presigs > ctx->presigs.capacity - size) {
+    number_presigs = ctx->presigs.capacity - size;
+  }
+  sts = EpidAddPreSigs(ctx, number_presigs);
+  if (kEpidNoErr != sts) return sts;
+
+  if (size + number_presigs >= ctx->presig_high_watermark ||
+      size + number_presigs >= ctx->presigs.capacity) {
+    ctx->is_presig_refilling = 0;
+  }
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidGetPreSigStats(MemberCtx const* ctx,
+                                              size_t* hits, size_t* misses) {
+  if (!ctx || !hits || !misses) return kEpidBadArgErr;
+  *hits = ctx->presig_hits;
+  *misses = ctx->presig_misses;
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidGetPreSigBufferSize(MemberCtx const* ctx,
+                                                   size_t number_presigs,
+                                                   size_t* buffer_size) {
+  if (!ctx || !buffer_size) {
+    return kEpidBadArgErr;
+  }
+  if (number_presigs > SIZE_MAX / sizeof(PreComputedSignatureData)) {
+    return kEpidBadArgErr;
+  }
+  *buffer_size = number_presigs * sizeof(PreComputedSignatureData);
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidMemberSetPreSigBuffer(MemberCtx* ctx,
+                                                     void* buffer,
+                                                     size_t buffer_size) {
+  size_t max_presigs = 0;
+  size_t num_presigs = 0;
+  if (!ctx || !buffer) {
+    return kEpidBadArgErr;
+  }
+  max_presigs = buffer_size / sizeof(PreComputedSignatureData);
+  num_presigs = RingGetSize(&ctx->presigs);
+  // There must be space at least for one presig
+  if (!max_presigs || num_presigs > max_presigs) {
+    return kEpidBadArgErr;
   }
+  // moving clears the previous storage of the secret values, slots in
+  // use cannot be rearranged in place
+  if (!RingMove(&ctx->presigs, max_presigs, buffer)) {
+    return kEpidBadArgErr;
+  }
+  ctx->max_precomp_sig = max_presigs;
+  return kEpidNoErr;
+}
+
+EpidStatus MemberTopPreSig(MemberCtx* ctx, PreComputedSignatureData* scratch,
+                           PreComputedSignatureData** presig) {
+  EpidStatus sts = kEpidErr;
+  if (!ctx || !scratch || !presig) {
+    return kEpidBadArgErr;
+  }
+
   // Use existing pre-computed signature
-  *presig = StackTop(&ctx->presigs);
-  if (!*presig) {
-    return kEpidErr;
+  *presig = RingFront(&ctx->presigs);
+  if (*presig) {
+    ctx->presig_hits++;
+    return kEpidNoErr;
   }
+  ctx->presig_misses++;
+  // the pool is empty, compute one outside of it so that the slots stay
+  // owned by the thread adding pre-computed signatures
+  sts = EpidMemberComputePreSig(ctx, scratch);
+  if (kEpidNoErr != sts) {
+    RingWipe(scratch, sizeof(*scratch));
+    return sts;
+  }
+  *presig = scratch;
   return kEpidNoErr;
 }
 
-EpidStatus MemberPopPreSig(MemberCtx* ctx) {
-  if (!ctx) {
+EpidStatus MemberPopPreSig(MemberCtx* ctx, PreComputedSignatureData* presig) {
+  if (!ctx || !presig) {
     return kEpidBadArgErr;
   }
 
-  if (!StackPopN(&ctx->presigs, 1)) {
+  if (presig != RingFront(&ctx->presigs)) {
+    RingWipe(presig, sizeof(*presig));
+    return kEpidNoErr;
+  }
+  if (!RingPop(&ctx->presigs)) {
     return kEpidErr;
   }
   return kEpidNoErr;
@@ -33,6 +33,22 @@ static const FpElem epid20_p = {{0xD10B500D, 0xF62D536C, 0x1299921A, 0x0CDC65FB,
                                  0xEE71A49E, 0x46E5F25E, 0xFFFCF0CD,
                                  0xFFFFFFFF}};
 
+void EpidMemberInitPreSigCompute(MemberCtx* ctx) {
+  EccPointFq h2;
+  if (ctx->presig_table) {
+    Fq12MultiExpTableInit(ctx->presig_table, &ctx->precomp.ea2,
+                          &ctx->precomp.e12, &ctx->precomp.e22,
+                          &ctx->precomp.e2w);
+  }
+  if (ctx->comb_teeth) {
+    EFqDeserialize(&h2, &ctx->pub_key.h2);
+    if (!EFqCombTableInit(ctx->h2_comb, &h2, ctx->comb_teeth)) {
+      // h2 has been validated, but never use a partial table
+      ctx->comb_teeth = 0;
+    }
+  }
+}
+
 EpidStatus EpidMemberComputePreSig(MemberCtx const* ctx,
                                    PreComputedSignatureData* presig) {
   /* B and K are not computed by this precomputation.
@@ -53,9 +69,13 @@ EpidStatus EpidMemberComputePreSig(MemberCtx const* ctx,
     }
 
     // T = A * h2^a
-    EFqDeserialize(&t, &ctx->pub_key.h2);
-    EFqFromAffine(&tmp1, &t);
-    EFqMulSSCM(&tmp2, &tmp1, &presig->a);
+    if (ctx->comb_teeth) {
+      EFqCombMulSSCM(&tmp2, ctx->h2_comb, ctx->comb_teeth, &presig->a);
+    } else {
+      EFqDeserialize(&t, &ctx->pub_key.h2);
+      EFqFromAffine(&tmp1, &t);
+      EFqMulSSCM(&tmp2, &tmp1, &presig->a);
+    }
     EFqDeserialize(&t, &ctx->credential.A);
     EFqFromAffine(&tmp1, &t);
     EFqAdd(&tmp2, &tmp2, &tmp1);
@@ -84,9 +104,14 @@ EpidStatus EpidMemberComputePreSig(MemberCtx const* ctx,
     FpSub((FpElem*)&t.y, &presig->rb, (FpElem*)&t.y);
 
     // R2 = ea2^&t.x * e12^rf * e22 ^ &t.y * e2w ^ ra
-    Fq12MultiExp(&presig->R2, &ctx->precomp.ea2, &t.x.limbs, &ctx->precomp.e12,
-                 &presig->rf.limbs, &ctx->precomp.e22, &t.y.limbs,
-                 &ctx->precomp.e2w, &presig->ra.limbs);
+    if (ctx->presig_table) {
+      Fq12MultiExpCyc(&presig->R2, ctx->presig_table, &t.x.limbs,
+                      &presig->rf.limbs, &t.y.limbs, &presig->ra.limbs);
+    } else {
+      Fq12MultiExp(&presig->R2, &ctx->precomp.ea2, &t.x.limbs,
+                   &ctx->precomp.e12, &presig->rf.limbs, &ctx->precomp.e22,
+                   &t.y.limbs, &ctx->precomp.e2w, &presig->ra.limbs);
+    }
     sts = kEpidNoErr;
   } while (0);
 
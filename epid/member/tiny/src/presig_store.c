@@ -0,0 +1,355 @@
+/*############################################################################
+  # Copyright 2017-2020 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+/// Pre-computed signature store implementation.
+/*! \file */
+
+#define EXPORT_EPID_APIS
+#include <epid/member/api.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "common/ring.h"
+#include "epid/member/tiny/context.h"
+#include "epid/member/tiny/presig_compute.h"
+#include "epid/types.h"
+#include "tinymath/serialize.h"
+#include "tinymath/sha256.h"
+#include "tinystdlib/endian.h"
+#include "tinystdlib/tiny_stdlib.h"
+
+/// Identifies a pre-computed signature store ("EPSS")
+#define PRESIG_STORE_MAGIC 0x53535045
+/// Layout version of the pre-computed signature store
+#define PRESIG_STORE_VERSION 3
+
+/// Header of a pre-computed signature store
+/*!
+ The header is followed by the used bitmap, padded to a multiple of 4
+ bytes, and then by the entries. All fields are byte strings, so the
+ store can be at any address.
+ */
+typedef struct PreSigStoreHeader {
+  OctStr32 magic;                   ///< PRESIG_STORE_MAGIC
+  OctStr32 version;                 ///< PRESIG_STORE_VERSION
+  OctStr32 entry_size;              ///< Size of a pre-computed signature
+  OctStr32 num_entries;             ///< Number of entries in the store
+  GroupId gid;                      ///< Group of the pre-computed signatures
+  OctStr128 id;                     ///< Random identifier of the store
+  uint8_t tag[SHA256_DIGEST_SIZE];  ///< HMAC of the fields above
+} PreSigStoreHeader;
+
+/// Entry of a pre-computed signature store
+typedef struct PreSigStoreEntry {
+  /// pre-computed signature encrypted with the entry key stream
+  uint8_t presig[sizeof(PreComputedSignatureData)];
+  /// HMAC of store id, index and encrypted presig
+  uint8_t tag[SHA256_DIGEST_SIZE];
+} PreSigStoreEntry;
+
+/// Message authenticated for an entry and expanded into its key stream
+typedef struct PreSigStoreNonce {
+  OctStr128 id;      ///< Random identifier of the store
+  OctStr32 index;    ///< Index of the entry
+  OctStr32 counter;  ///< Key stream block, not part of the entry tag
+} PreSigStoreNonce;
+
+/// Keys protecting a store
+typedef struct PreSigStoreKeys {
+  uint8_t enc[SHA256_DIGEST_SIZE];  ///< key of the entry key streams
+  uint8_t mac[SHA256_DIGEST_SIZE];  ///< key of the header and entry tags
+} PreSigStoreKeys;
+
+static size_t UsedBitmapSize(size_t num_entries) {
+  return ((num_entries + 31) / 32) * sizeof(uint32_t);
+}
+
+/// Computes the size of a store with num_entries entries
+/*!
+ \returns the size in bytes, or 0 if it does not fit into a size_t
+ */
+static size_t PreSigStoreSize(size_t num_entries) {
+  size_t fixed_size = 0;
+  // the bitmap needs no more than one byte per entry
+  if (num_entries > ((size_t)-1 - sizeof(PreSigStoreHeader) - 3) /
+                        (sizeof(PreSigStoreEntry) + 1)) {
+    return 0;
+  }
+  fixed_size = sizeof(PreSigStoreHeader) + UsedBitmapSize(num_entries);
+  return fixed_size + num_entries * sizeof(PreSigStoreEntry);
+}
+
+/// Computes HMAC-SHA256 of the concatenation of two messages
+static void StoreHmac(uint8_t const key[SHA256_DIGEST_SIZE], void const* msg1,
+                      size_t msg1_len, void const* msg2, size_t msg2_len,
+                      uint8_t tag[SHA256_DIGEST_SIZE]) {
+  uint8_t pad[SHA256_BLOCK_SIZE];
+  uint8_t inner[SHA256_DIGEST_SIZE];
+  sha256_state s;
+  size_t i = 0;
+
+  for (i = 0; i < sizeof(pad); i++) {
+    pad[i] = (uint8_t)((i < SHA256_DIGEST_SIZE ? key[i] : 0) ^ 0x36);
+  }
+  tc_sha256_init(&s);
+  tc_sha256_update(&s, pad, sizeof(pad));
+  tc_sha256_update(&s, msg1, msg1_len);
+  if (msg2) {
+    tc_sha256_update(&s, msg2, msg2_len);
+  }
+  tc_sha256_final(inner, &s);
+
+  for (i = 0; i < sizeof(pad); i++) {
+    pad[i] = (uint8_t)((i < SHA256_DIGEST_SIZE ? key[i] : 0) ^ 0x5c);
+  }
+  tc_sha256_init(&s);
+  tc_sha256_update(&s, pad, sizeof(pad));
+  tc_sha256_update(&s, inner, sizeof(inner));
+  tc_sha256_final(tag, &s);
+
+  memset(pad, 0, sizeof(pad));
+  memset(&s, 0, sizeof(s));
+}
+
+/// Derives one key of a store from the member secret
+/*!
+ HKDF-Expand (RFC 5869) of one block with f as the pseudorandom key and
+ the label as info. f is uniformly random, so the extract step is not
+ needed.
+ */
+static void DeriveStoreKey(MemberCtx const* ctx, char const* label,
+                           size_t label_len, uint8_t key[SHA256_DIGEST_SIZE]) {
+  static const uint8_t kBlock = 0x01;
+  FpElemStr f_str;
+  FpSerialize(&f_str, &ctx->f);
+  StoreHmac((uint8_t const*)&f_str, label, label_len, &kBlock, sizeof(kBlock),
+            key);
+  memset(&f_str, 0, sizeof(f_str));
+}
+
+/// Derives the encryption and authentication keys of a store
+static void DeriveStoreKeys(MemberCtx const* ctx, PreSigStoreKeys* keys) {
+  static const char kEncLabel[] = "EPID presig store enc";
+  static const char kMacLabel[] = "EPID presig store mac";
+  DeriveStoreKey(ctx, kEncLabel, sizeof(kEncLabel) - 1, keys->enc);
+  DeriveStoreKey(ctx, kMacLabel, sizeof(kMacLabel) - 1, keys->mac);
+}
+
+/// Compares two tags in constant time
+static int TagsEqual(uint8_t const* a, uint8_t const* b) {
+  uint8_t diff = 0;
+  size_t i = 0;
+  for (i = 0; i < SHA256_DIGEST_SIZE; i++) {
+    diff |= a[i] ^ b[i];
+  }
+  return 0 == diff;
+}
+
+/// Computes the tag of entry index of the store with the given header
+static void EntryHmac(uint8_t const key[SHA256_DIGEST_SIZE],
+                      PreSigStoreHeader const* header, uint32_t index,
+                      PreSigStoreEntry const* entry,
+                      uint8_t tag[SHA256_DIGEST_SIZE]) {
+  PreSigStoreNonce nonce;
+  nonce.id = header->id;
+  Uint32Serialize(&nonce.index, index);
+  StoreHmac(key, &nonce, offsetof(PreSigStoreNonce, counter), entry->presig,
+            sizeof(entry->presig), tag);
+}
+
+/// XORs the key stream of entry index into a pre-computed signature
+/*!
+ The key stream is HMAC-SHA256 of store id, index and block counter. The
+ store id is random for each export, so a key stream is never reused.
+ */
+static void EntryCrypt(uint8_t const key[SHA256_DIGEST_SIZE],
+                       PreSigStoreHeader const* header, uint32_t index,
+                       uint8_t const* in, uint8_t* out) {
+  PreSigStoreNonce nonce;
+  uint8_t block[SHA256_DIGEST_SIZE];
+  uint32_t counter = 0;
+  size_t i = 0;
+  nonce.id = header->id;
+  Uint32Serialize(&nonce.index, index);
+  for (i = 0; i < sizeof(PreComputedSignatureData); i++) {
+    if (0 == i % sizeof(block)) {
+      Uint32Serialize(&nonce.counter, counter);
+      StoreHmac(key, &nonce, sizeof(nonce), NULL, 0, block);
+      counter++;
+    }
+    out[i] = in[i] ^ block[i % sizeof(block)];
+  }
+  memset(block, 0, sizeof(block));
+}
+
+EpidStatus EPID_MEMBER_API EpidGetPreSigStoreSize(MemberCtx const* ctx,
+                                                  size_t number_presigs,
+                                                  size_t* store_size) {
+  size_t size = 0;
+  if (!ctx || !store_size) {
+    return kEpidBadArgErr;
+  }
+  if (number_presigs > UINT32_MAX) {
+    return kEpidBadArgErr;
+  }
+  size = PreSigStoreSize(number_presigs);
+  if (0 == size) {
+    return kEpidBadArgErr;
+  }
+  *store_size = size;
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidExportPreSigs(MemberCtx* ctx, void* store,
+                                             size_t store_size) {
+  PreSigStoreKeys keys;
+  PreSigStoreHeader header;
+  PreSigStoreEntry entry;
+  uint8_t* bitmap = NULL;
+  PreSigStoreEntry* entries = NULL;
+  size_t num_presigs = 0;
+  size_t size = 0;
+  size_t i = 0;
+
+  if (!ctx || !store) {
+    return kEpidBadArgErr;
+  }
+  if (!ctx->is_provisioned) {
+    return kEpidOutOfSequenceError;
+  }
+  num_presigs = RingGetSize(&ctx->presigs);
+  size = PreSigStoreSize(num_presigs);
+  if (0 == size || store_size < size) {
+    return kEpidBadArgErr;
+  }
+
+  memset(&header, 0, sizeof(header));
+  Uint32Serialize(&header.magic, PRESIG_STORE_MAGIC);
+  Uint32Serialize(&header.version, PRESIG_STORE_VERSION);
+  Uint32Serialize(&header.entry_size,
+                  (uint32_t)sizeof(PreComputedSignatureData));
+  Uint32Serialize(&header.num_entries, (uint32_t)num_presigs);
+  header.gid = ctx->pub_key.gid;
+  if (!ctx->rnd_func ||
+      0 != ctx->rnd_func((unsigned int*)&header.id, sizeof(header.id) * 8,
+                         ctx->rnd_param)) {
+    return kEpidBitSupplierErr;
+  }
+
+  DeriveStoreKeys(ctx, &keys);
+  StoreHmac(keys.mac, &header, offsetof(PreSigStoreHeader, tag), NULL, 0,
+            header.tag);
+
+  bitmap = (uint8_t*)store + sizeof(header);
+  entries = (PreSigStoreEntry*)(bitmap + UsedBitmapSize(num_presigs));
+  memset(bitmap, 0, UsedBitmapSize(num_presigs));
+  // the store now owns the exported pre-computed signatures, popping
+  // clears them from the pool
+  for (i = 0; i < num_presigs; i++) {
+    EntryCrypt(keys.enc, &header, (uint32_t)i,
+               (uint8_t const*)RingFront(&ctx->presigs), entry.presig);
+    (void)RingPop(&ctx->presigs);
+    EntryHmac(keys.mac, &header, (uint32_t)i, &entry, entry.tag);
+    entries[i] = entry;
+  }
+  *(PreSigStoreHeader*)store = header;
+
+  memset(&keys, 0, sizeof(keys));
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidImportPreSigs(MemberCtx* ctx, void* store,
+                                             size_t store_size) {
+  EpidStatus sts = kEpidErr;
+  PreSigStoreKeys keys;
+  uint8_t tag[SHA256_DIGEST_SIZE];
+  PreSigStoreHeader header;
+  PreSigStoreEntry entry;
+  PreComputedSignatureData* slot = NULL;
+  uint8_t* bitmap = NULL;
+  PreSigStoreEntry const* entries = NULL;
+  uint32_t num_entries = 0;
+  size_t size = 0;
+  size_t i = 0;
+
+  if (!ctx || !store) {
+    return kEpidBadArgErr;
+  }
+  if (!ctx->is_provisioned) {
+    return kEpidOutOfSequenceError;
+  }
+  if (store_size < sizeof(header)) {
+    return kEpidBadArgErr;
+  }
+  header = *(PreSigStoreHeader const*)store;
+  if (PRESIG_STORE_MAGIC != be32toh(header.magic) ||
+      PRESIG_STORE_VERSION != be32toh(header.version) ||
+      sizeof(PreComputedSignatureData) != be32toh(header.entry_size)) {
+    return kEpidSchemaNotSupportedErr;
+  }
+  num_entries = be32toh(header.num_entries);
+  size = PreSigStoreSize(num_entries);
+  if (0 == size || store_size < size) {
+    return kEpidBadArgErr;
+  }
+  if (0 != memcmp(&header.gid, &ctx->pub_key.gid, sizeof(header.gid))) {
+    return kEpidGroupIdMismatchErr;
+  }
+
+  do {
+    DeriveStoreKeys(ctx, &keys);
+    StoreHmac(keys.mac, &header, offsetof(PreSigStoreHeader, tag), NULL, 0,
+              tag);
+    if (!TagsEqual(tag, header.tag)) {
+      sts = kEpidBadArgErr;
+      break;
+    }
+
+    bitmap = (uint8_t*)store + sizeof(header);
+    entries =
+        (PreSigStoreEntry const*)(bitmap + UsedBitmapSize(num_entries));
+    sts = kEpidNoErr;
+    for (i = 0; i < num_entries; i++) {
+      uint8_t mask = (uint8_t)(1u << (i % 8));
+      slot = RingGetFree(&ctx->presigs, 0);
+      if (!slot) {
+        break;
+      }
+      if (bitmap[i / 8] & mask) {
+        continue;
+      }
+      // mark the entry used before it can be consumed so that it is never
+      // handed out again, even if the caller crashes before the store is
+      // written back
+      bitmap[i / 8] |= mask;
+      entry = entries[i];
+      EntryHmac(keys.mac, &header, (uint32_t)i, &entry, tag);
+      if (!TagsEqual(tag, entry.tag)) {
+        continue;
+      }
+      // decrypt straight into the ring
+      EntryCrypt(keys.enc, &header, (uint32_t)i, entry.presig,
+                 (uint8_t*)slot);
+      if (!RingPushN(&ctx->presigs, 1)) {
+        sts = kEpidErr;
+        break;
+      }
+    }
+  } while (0);
+
+  memset(&keys, 0, sizeof(keys));
+  return sts;
+}
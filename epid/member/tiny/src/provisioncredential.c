@@ -21,6 +21,7 @@
 #include "epid/member/tiny/context.h"
 #include "epid/member/tiny/gid_parser.h"
 #include "epid/member/tiny/native_types.h"
+#include "epid/member/tiny/presig_compute.h"
 #include "epid/member/tiny/serialize.h"
 #include "epid/member/tiny/validate.h"
 #include "tinymath/efq.h"
@@ -75,8 +76,7 @@ EpidStatus EPID_MEMBER_API EpidProvisionCredential(
   }
   if (!GroupPubKeyIsInRange(&native_pub_key) ||
       !MembershipCredentialIsInRange(&native_cred) ||
-      !MembershipCredentialIsInGroup(&native_cred, &ctx->f, &native_pub_key,
-                                     &ctx->pairing_state)) {
+      !MembershipCredentialIsInGroup(&native_cred, &ctx->f, &native_pub_key)) {
     return kEpidBadArgErr;
   }
 
@@ -88,14 +88,11 @@ EpidStatus EPID_MEMBER_API EpidProvisionCredential(
   if (precomp_str) {
     PreCompDeserialize(&ctx->precomp, precomp_str);
   } else {
-    PairingCompute(&ctx->precomp.ea2, &native_cred.A, &epid20_g2,
-                   &ctx->pairing_state);
-    PairingCompute(&ctx->precomp.e12, &native_pub_key.h1, &epid20_g2,
-                   &ctx->pairing_state);
-    PairingCompute(&ctx->precomp.e22, &native_pub_key.h2, &epid20_g2,
-                   &ctx->pairing_state);
-    PairingCompute(&ctx->precomp.e2w, &native_pub_key.h2, &native_pub_key.w,
-                   &ctx->pairing_state);
+    PairingCompute(&ctx->precomp.ea2, &native_cred.A, &epid20_g2);
+    PairingCompute(&ctx->precomp.e12, &native_pub_key.h1, &epid20_g2);
+    PairingCompute(&ctx->precomp.e22, &native_pub_key.h2, &epid20_g2);
+    PairingCompute(&ctx->precomp.e2w, &native_pub_key.h2, &native_pub_key.w);
   }
+  EpidMemberInitPreSigCompute(ctx);
   return kEpidNoErr;
 }
@@ -21,6 +21,7 @@
 #include "epid/member/tiny/context.h"
 #include "epid/member/tiny/gid_parser.h"
 #include "epid/member/tiny/native_types.h"
+#include "epid/member/tiny/presig_compute.h"
 #include "epid/member/tiny/serialize.h"
 #include "epid/member/tiny/validate.h"
 #include "tinymath/efq.h"
@@ -72,8 +73,7 @@ EpidStatus EPID_MEMBER_API EpidProvisionKey(MemberCtx* ctx,
 
   PrivKeyDeserialize(&native_priv_key, priv_key);
   if (!PrivKeyIsInRange(&native_priv_key) ||
-      !PrivKeyIsInGroup(&native_priv_key, &native_pub_key,
-                        &ctx->pairing_state)) {
+      !PrivKeyIsInGroup(&native_priv_key, &native_pub_key)) {
     memset(&native_priv_key.f, 0, sizeof(native_priv_key.f));
     return kEpidBadArgErr;
   }
@@ -92,14 +92,26 @@ EpidStatus EPID_MEMBER_API EpidProvisionKey(MemberCtx* ctx,
   if (precomp_str) {
     PreCompDeserialize(&ctx->precomp, precomp_str);
   } else {
-    PairingCompute(&ctx->precomp.ea2, &native_priv_key.cred.A, &epid20_g2,
-                   &ctx->pairing_state);
-    PairingCompute(&ctx->precomp.e12, &native_pub_key.h1, &epid20_g2,
-                   &ctx->pairing_state);
-    PairingCompute(&ctx->precomp.e22, &native_pub_key.h2, &epid20_g2,
-                   &ctx->pairing_state);
-    PairingCompute(&ctx->precomp.e2w, &native_pub_key.h2, &native_pub_key.w,
-                   &ctx->pairing_state);
+    PairingCompute(&ctx->precomp.ea2, &native_priv_key.cred.A, &epid20_g2);
+    PairingCompute(&ctx->precomp.e12, &native_pub_key.h1, &epid20_g2);
+    PairingCompute(&ctx->precomp.e22, &native_pub_key.h2, &epid20_g2);
+    PairingCompute(&ctx->precomp.e2w, &native_pub_key.h2, &native_pub_key.w);
   }
+  EpidMemberInitPreSigCompute(ctx);
   return sts;
 }
+
+// Batches are prepared on the provisioning host with the full member, the
+// tiny member only provisions itself.
+EpidStatus EPID_MEMBER_API EpidPrepareProvisionKeys(GroupPubKey const* pub_key,
+                                                    PrivKey const* priv_keys,
+                                                    size_t count,
+                                                    MemberPrecomp* precomps,
+                                                    EpidStatus* results) {
+  (void)pub_key;
+  (void)priv_keys;
+  (void)count;
+  (void)precomps;
+  (void)results;
+  return kEpidOperationNotSupportedErr;
+}
@@ -18,6 +18,8 @@
 
 #define EXPORT_EPID_APIS
 #include "epid/member/api.h"
+
+#include <stdint.h>
 #include "epid/member/tiny/allowed_basenames.h"
 #include "epid/member/tiny/context.h"
 
@@ -46,3 +48,45 @@ EpidStatus EPID_MEMBER_API EpidClearRegisteredBasenames(MemberCtx* ctx) {
   InitBasenames(ctx->allowed_basenames, ctx->max_allowed_basenames);
   return kEpidNoErr;
 }
+
+EpidStatus EPID_MEMBER_API EpidGetBasenameBufferSize(MemberCtx const* ctx,
+                                                     size_t number_basenames,
+                                                     size_t* buffer_size) {
+  if (!ctx || !buffer_size) {
+    return kEpidBadArgErr;
+  }
+  if (number_basenames >
+      (SIZE_MAX - BasenamesGetSize(0)) / sizeof(sha_digest)) {
+    return kEpidBadArgErr;
+  }
+  *buffer_size = BasenamesGetSize(number_basenames);
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidMemberSetBasenameBuffer(MemberCtx* ctx,
+                                                       void* buffer,
+                                                       size_t buffer_size) {
+  AllowedBasenames* basenames = (AllowedBasenames*)buffer;
+  size_t max_basenames = 0;
+  size_t num_basenames = 0;
+  size_t i = 0;
+  if (!ctx || !buffer || buffer_size < BasenamesGetSize(0)) {
+    return kEpidBadArgErr;
+  }
+  max_basenames = (buffer_size - BasenamesGetSize(0)) / sizeof(sha_digest);
+  num_basenames = ctx->allowed_basenames->current_bsn_number;
+  if (num_basenames > max_basenames) {
+    return kEpidBadArgErr;
+  }
+  if (basenames != ctx->allowed_basenames) {
+    basenames->current_bsn_number = num_basenames;
+    for (i = 0; i < num_basenames; i++) {
+      basenames->basename_digest[i] =
+          ctx->allowed_basenames->basename_digest[i];
+    }
+    ctx->allowed_basenames = basenames;
+  }
+  basenames->max_bsn_number = max_basenames;
+  ctx->max_allowed_basenames = max_basenames;
+  return kEpidNoErr;
+}
@@ -19,16 +19,15 @@
 #define EXPORT_EPID_APIS
 #include <epid/member/api.h>
 
+#include <stdint.h>
 #include "epid/member/tiny/context.h"
 #include "tinystdlib/endian.h"
 #include "tinystdlib/tiny_stdlib.h"
 
-EpidStatus EPID_MEMBER_API EpidMemberSetSigRl(MemberCtx* ctx,
-                                              SigRl const* sig_rl,
-                                              size_t sig_rl_size) {
+/// Checks that sig_rl can be set as the SigRl of the member
+static EpidStatus CheckSigRl(MemberCtx const* ctx, SigRl const* sig_rl,
+                             size_t sig_rl_size, size_t max_entries) {
   uint32_t n2_in = 0;
-  size_t calculated_sig_rl_size = 0;
-  uint32_t i = 0;
   if (!ctx || !sig_rl) {
     return kEpidBadArgErr;
   }
@@ -40,11 +39,12 @@ EpidStatus EPID_MEMBER_API EpidMemberSetSigRl(MemberCtx* ctx,
   n2_in = be32toh(sig_rl->n2);
 
   // sanity check SigRl size
-  if (n2_in > ctx->max_sigrl_entries) {
+  if (n2_in > max_entries) {
     return kEpidBadArgErr;
   }
-  calculated_sig_rl_size = MIN_SIGRL_SIZE + n2_in * sizeof(sig_rl->bk[0]);
-  if (calculated_sig_rl_size != sig_rl_size) {
+  if (sig_rl_size < MIN_SIGRL_SIZE ||
+      (sig_rl_size - MIN_SIGRL_SIZE) % sizeof(sig_rl->bk[0]) ||
+      (sig_rl_size - MIN_SIGRL_SIZE) / sizeof(sig_rl->bk[0]) != n2_in) {
     return kEpidBadArgErr;
   }
   // verify that gid given and gid in SigRl match
@@ -60,21 +60,156 @@ EpidStatus EPID_MEMBER_API EpidMemberSetSigRl(MemberCtx* ctx,
       return kEpidVersionMismatchErr;
     }
   }
+  return kEpidNoErr;
+}
 
+EpidStatus EPID_MEMBER_API EpidMemberSetSigRl(MemberCtx* ctx,
+                                              SigRl const* sig_rl,
+                                              size_t sig_rl_size) {
 #ifdef USE_SIGRL_BY_REFERENCE
-  ctx->sig_rl = (SigRl*)sig_rl;
-  (void)i;
+  // the member keeps no copy of the list
+  return EpidMemberSetSigRlByReference(ctx, sig_rl, sig_rl_size);
 #else
-  if (!ctx->sig_rl) {
-    ctx->sig_rl = (SigRl*)ctx->heap;
+  EpidStatus sts = kEpidErr;
+  uint32_t n2_in = 0;
+  uint32_t i = 0;
+  if (!ctx) {
+    return kEpidBadArgErr;
   }
+  sts = CheckSigRl(ctx, sig_rl, sig_rl_size, ctx->max_sigrl_entries);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  n2_in = be32toh(sig_rl->n2);
+
+  ctx->sig_rl = ctx->sig_rl_buf;
+  ctx->sig_rl->gid = sig_rl->gid;
   ctx->sig_rl->version = sig_rl->version;
   ctx->sig_rl->n2 = sig_rl->n2;
-  memset(ctx->sig_rl->bk, 0, ctx->max_sigrl_entries * sizeof(*ctx->sig_rl->bk));
-
+  // entries past n2 are never read, so only the list itself is copied
   for (i = 0; i < n2_in; i++) {
     ctx->sig_rl->bk[i] = sig_rl->bk[i];
   }
+  return kEpidNoErr;
 #endif
+}
+
+EpidStatus EPID_MEMBER_API EpidMemberSetSigRlByReference(MemberCtx* ctx,
+                                                         SigRl const* sig_rl,
+                                                         size_t sig_rl_size) {
+  EpidStatus sts = kEpidErr;
+  if (!ctx) {
+    return kEpidBadArgErr;
+  }
+  // the list is not copied, so it is not bound by max_sigrl_entries
+  sts = CheckSigRl(ctx, sig_rl, sig_rl_size, UINT32_MAX);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  ctx->sig_rl = (SigRl*)sig_rl;
   return kEpidNoErr;
 }
+
+EpidStatus EPID_MEMBER_API EpidMemberSetSigRlBuffer(MemberCtx* ctx,
+                                                    void* buffer,
+                                                    size_t buffer_size) {
+#ifdef USE_SIGRL_BY_REFERENCE
+  // lists are always used in place
+  (void)ctx;
+  (void)buffer;
+  (void)buffer_size;
+  return kEpidOperationNotSupportedErr;
+#else
+  SigRl* sig_rl = (SigRl*)buffer;
+  size_t max_entries = 0;
+  uint32_t i = 0;
+  if (!ctx || !buffer || buffer_size < MIN_SIGRL_SIZE) {
+    return kEpidBadArgErr;
+  }
+  max_entries = (buffer_size - MIN_SIGRL_SIZE) / sizeof(SigRlEntry);
+  if (max_entries > UINT32_MAX) {
+    max_entries = UINT32_MAX;
+  }
+  // move a list copied by value, a referenced list stays where it is
+  if (ctx->sig_rl && ctx->sig_rl == ctx->sig_rl_buf) {
+    uint32_t n2 = be32toh(ctx->sig_rl->n2);
+    if (n2 > max_entries) {
+      return kEpidBadArgErr;
+    }
+    if (sig_rl != ctx->sig_rl) {
+      sig_rl->gid = ctx->sig_rl->gid;
+      sig_rl->version = ctx->sig_rl->version;
+      sig_rl->n2 = ctx->sig_rl->n2;
+      for (i = 0; i < n2; i++) {
+        sig_rl->bk[i] = ctx->sig_rl->bk[i];
+      }
+    }
+    ctx->sig_rl = sig_rl;
+  }
+  ctx->sig_rl_buf = sig_rl;
+  ctx->max_sigrl_entries = max_entries;
+  return kEpidNoErr;
+#endif
+}
+
+EpidStatus EPID_MEMBER_API EpidMemberUpdateSigRl(MemberCtx* ctx,
+                                                 SigRl const* sig_rl_delta,
+                                                 size_t sig_rl_delta_size) {
+#ifdef USE_SIGRL_BY_REFERENCE
+  // the list belongs to the caller and cannot be grown in place
+  (void)ctx;
+  (void)sig_rl_delta;
+  (void)sig_rl_delta_size;
+  return kEpidOperationNotSupportedErr;
+#else
+  uint32_t current_n2 = 0;
+  uint32_t delta_n2 = 0;
+  uint32_t i = 0;
+  if (!ctx || !sig_rl_delta) {
+    return kEpidBadArgErr;
+  }
+
+  if (!ctx->is_provisioned || !ctx->sig_rl) {
+    return kEpidOutOfSequenceError;
+  }
+  // a list set by reference belongs to the caller
+  if (ctx->sig_rl != ctx->sig_rl_buf) {
+    return kEpidOperationNotSupportedErr;
+  }
+
+  delta_n2 = be32toh(sig_rl_delta->n2);
+  current_n2 = be32toh(ctx->sig_rl->n2);
+
+  // sanity check SigRl size
+  if (delta_n2 > ctx->max_sigrl_entries) {
+    return kEpidBadArgErr;
+  }
+  if (MIN_SIGRL_SIZE + delta_n2 * sizeof(sig_rl_delta->bk[0]) !=
+      sig_rl_delta_size) {
+    return kEpidBadArgErr;
+  }
+  // verify that gid given and gid in SigRl match
+  if (0 != memcmp(&ctx->pub_key.gid, &sig_rl_delta->gid,
+                  sizeof(sig_rl_delta->gid))) {
+    return kEpidBadArgErr;
+  }
+
+  // an update must move to a newer version
+  if (be32toh(sig_rl_delta->version) <= be32toh(ctx->sig_rl->version)) {
+    return kEpidVersionMismatchErr;
+  }
+
+  // the updated list must still fit
+  if (delta_n2 > ctx->max_sigrl_entries - current_n2) {
+    return kEpidBadArgErr;
+  }
+
+  // entries already held by the member are not copied again
+  for (i = 0; i < delta_n2; i++) {
+    ctx->sig_rl->bk[current_n2 + i] = sig_rl_delta->bk[i];
+  }
+  ctx->sig_rl->version = sig_rl_delta->version;
+  *((uint32_t*)(&ctx->sig_rl->n2)) = htobe32(current_n2 + delta_n2);
+  return kEpidNoErr;
+#endif
+}
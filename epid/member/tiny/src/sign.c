@@ -43,17 +43,108 @@ size_t EPID_MEMBER_API EpidGetSigSize(SigRl const* sig_rl) {
   }
 }
 
-EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
-                                    size_t msg_len, void const* basename,
-                                    size_t basename_len, EpidSignature* raw_sig,
-                                    size_t sig_len) {
-  EpidNonSplitSignature* sig = (EpidNonSplitSignature*)raw_sig;
+/// Maximum number of non-revoked proofs handed to one ::ParallelFor
+/*!
+ Bounds the statuses kept on the stack while the proofs run.
+ */
+#define MAX_NR_PROVE_TASKS 32
+
+/// Data shared by the non-revoked proof computations of a signature
+typedef struct NrProveTaskParam {
+  MemberCtx const* ctx;                   ///< member context
+  void const* msg;                        ///< message to sign
+  size_t msg_len;                         ///< length of msg
+  NativeBasicSignature const* sigma0;     ///< basic signature
+  EpidNonSplitSignature* sig;             ///< signature receiving the proofs
+  uint32_t first;                         ///< SigRl entry of iteration 0
+  EpidStatus status[MAX_NR_PROVE_TASKS];  ///< status of each iteration
+} NrProveTaskParam;
+
+/// Computes the non-revoked proof for SigRl entry first + index
+static EpidStatus __STDCALL NrProveTask(void* task_param, size_t index) {
+  NrProveTaskParam* param = (NrProveTaskParam*)task_param;
+  size_t entry = param->first + index;
+  param->status[index] =
+      EpidNrProve(param->ctx, param->msg, param->msg_len, param->sigma0,
+                  &param->ctx->sig_rl->bk[entry], &param->sig->sigma[entry]);
+  return param->status[index];
+}
+
+/// Checks if a non-revoked proof could not be computed
+static int IsNrProveError(EpidStatus sts) {
+  return kEpidNoErr != sts && kEpidSigRevokedInSigRl != sts;
+}
+
+/// Adds the status of the next non-revoked proof to the status so far
+/*!
+ A failed computation takes precedence over a revoked member, so the
+ first failure in SigRl order is reported.
+ */
+static EpidStatus AddNrProveStatus(EpidStatus nr_prove_status,
+                                   EpidStatus sts) {
+  if (IsNrProveError(nr_prove_status)) {
+    return nr_prove_status;
+  }
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  return nr_prove_status;
+}
+
+/// Computes the non-revoked proofs of a signature with the ::ParallelFor
+static EpidStatus NrProveInParallel(MemberCtx const* ctx, void const* msg,
+                                    size_t msg_len,
+                                    NativeBasicSignature const* sigma0,
+                                    EpidNonSplitSignature* sig,
+                                    uint32_t num_sig_rl) {
   EpidStatus sts = kEpidErr;
-  OctStr32 octstr32_0 = {{0x00, 0x00, 0x00, 0x00}};
-  NativeBasicSignature sigma0;
-  if (!ctx || !sig) {
+  EpidStatus nr_prove_status = kEpidNoErr;
+  NrProveTaskParam param;
+  uint32_t count = 0;
+  uint32_t i = 0;
+  param.ctx = ctx;
+  param.msg = msg;
+  param.msg_len = msg_len;
+  param.sigma0 = sigma0;
+  param.sig = sig;
+  for (param.first = 0; param.first < num_sig_rl; param.first += count) {
+    count = num_sig_rl - param.first;
+    if (count > MAX_NR_PROVE_TASKS) {
+      count = MAX_NR_PROVE_TASKS;
+    }
+    // an iteration the loop did not run counts as failed
+    for (i = 0; i < count; i++) {
+      param.status[i] = kEpidErr;
+    }
+    sts = ctx->parallel_for(NrProveTask, &param, count,
+                            ctx->parallel_for_param);
+    for (i = 0; i < count; i++) {
+      nr_prove_status = AddNrProveStatus(nr_prove_status, param.status[i]);
+    }
+    // a failure of the loop itself is reported like one of an iteration
+    nr_prove_status = AddNrProveStatus(nr_prove_status, sts);
+    if (IsNrProveError(nr_prove_status)) {
+      break;
+    }
+  }
+  return nr_prove_status;
+}
+
+EpidStatus EPID_MEMBER_API EpidMemberSetParallelFor(MemberCtx* ctx,
+                                                    ParallelFor parallel_for,
+                                                    void* user_data) {
+  if (!ctx) {
     return kEpidBadArgErr;
   }
+  ctx->parallel_for = parallel_for;
+  ctx->parallel_for_param = user_data;
+  return kEpidNoErr;
+}
+
+/// Checks the arguments EpidSign and EpidSignStream have in common
+static EpidStatus CheckSignArgs(MemberCtx const* ctx, void const* msg,
+                                size_t msg_len, void const* basename,
+                                size_t basename_len) {
   if (!msg && (0 != msg_len)) {
     // if message is non-empty it must have both length and content
     return kEpidBadArgErr;
@@ -65,20 +156,24 @@ EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
     // if basename is non-empty it must have both length and content
     return kEpidBadArgErr;
   }
-  if (EpidGetSigSize(ctx->sig_rl) > sig_len) {
-    return kEpidBadArgErr;
-  }
+  return kEpidNoErr;
+}
 
+/// Computes the basic signature and the part of sig preceding the proofs
+static EpidStatus SignHeader(MemberCtx const* ctx, void const* msg,
+                             size_t msg_len, void const* basename,
+                             size_t basename_len, NativeBasicSignature* sigma0,
+                             EpidNonSplitSignature* sig,
+                             uint32_t* num_sig_rl) {
+  EpidStatus sts = kEpidErr;
+  OctStr32 octstr32_0 = {{0x00, 0x00, 0x00, 0x00}};
   // 11. The member sets sigma0 = (B, K, T, c, sx, sf, sa, sb).
-  sts = EpidSignBasic(ctx, msg, msg_len, basename, basename_len, &sigma0);
+  sts = EpidSignBasic(ctx, msg, msg_len, basename, basename_len, sigma0);
   if (kEpidNoErr != sts) {
     return sts;
   }
-  BasicSignatureSerialize(&sig->sigma0, &sigma0);
+  BasicSignatureSerialize(&sig->sigma0, sigma0);
   if (ctx->sig_rl) {
-    uint32_t i = 0;
-    uint32_t num_sig_rl = 0;
-    EpidStatus nr_prove_status = kEpidNoErr;
     // 13. If SigRL is provided as input, the member proceeds with
     //     the following steps:
     //   a. The member verifies that gid in public key and in SigRL
@@ -88,30 +183,108 @@ EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
     //      signature.
     sig->rl_ver = ctx->sig_rl->version;
     sig->n2 = ctx->sig_rl->n2;
-    //   c. For i = 0, ..., n2-1, the member computes sigma[i] =
-    //      nrProve(f, B, K, B[i], K[i]). The details of nrProve()
-    //      will be given in the next subsection.
-    num_sig_rl = be32toh(ctx->sig_rl->n2);
-    for (i = 0; i < num_sig_rl; i++) {
-      sts = EpidNrProve(ctx, msg, msg_len, &sigma0, &ctx->sig_rl->bk[i],
-                        &sig->sigma[i]);
-      if (kEpidNoErr != sts) {
-        nr_prove_status = sts;
-      }
-    }
-    if (kEpidNoErr != nr_prove_status) {
-      return nr_prove_status;
-    }
+    *num_sig_rl = be32toh(ctx->sig_rl->n2);
   } else {
     // 12. If SigRL is not provided as input,
     //   a. The member sets RLver = 0 and n2 = 0.
     //   b. The member outputs (sigma0, RLver, n2) and returns "succeeded".
     sig->rl_ver = octstr32_0;
     sig->n2 = octstr32_0;
+    *num_sig_rl = 0;
+  }
+  return kEpidNoErr;
+}
+
+EpidStatus EPID_MEMBER_API EpidSign(MemberCtx const* ctx, void const* msg,
+                                    size_t msg_len, void const* basename,
+                                    size_t basename_len, EpidSignature* raw_sig,
+                                    size_t sig_len) {
+  EpidNonSplitSignature* sig = (EpidNonSplitSignature*)raw_sig;
+  EpidStatus sts = kEpidErr;
+  EpidStatus nr_prove_status = kEpidNoErr;
+  NativeBasicSignature sigma0;
+  uint32_t i = 0;
+  uint32_t num_sig_rl = 0;
+  if (!ctx || !sig) {
+    return kEpidBadArgErr;
+  }
+  sts = CheckSignArgs(ctx, msg, msg_len, basename, basename_len);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  if (EpidGetSigSize(ctx->sig_rl) > sig_len) {
+    return kEpidBadArgErr;
+  }
+
+  sts = SignHeader(ctx, msg, msg_len, basename, basename_len, &sigma0, sig,
+                   &num_sig_rl);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  //   c. For i = 0, ..., n2-1, the member computes sigma[i] =
+  //      nrProve(f, B, K, B[i], K[i]). The details of nrProve()
+  //      will be given in the next subsection.
+  if (ctx->parallel_for && num_sig_rl > 1) {
+    nr_prove_status =
+        NrProveInParallel(ctx, msg, msg_len, &sigma0, sig, num_sig_rl);
+  } else {
+    for (i = 0; i < num_sig_rl; i++) {
+      sts = EpidNrProve(ctx, msg, msg_len, &sigma0, &ctx->sig_rl->bk[i],
+                        &sig->sigma[i]);
+      nr_prove_status = AddNrProveStatus(nr_prove_status, sts);
+      if (IsNrProveError(nr_prove_status)) {
+        break;
+      }
+    }
   }
   //   d. The member outputs (sigma0, RLver, n2, sigma[0], ...,
   //      sigma[n2-1]).
   //   e. If any of the nrProve() functions outputs "failed", the
-  //      member returns "revoked", otherwise returns "succeeded".
-  return kEpidNoErr;
+  //      member returns "revoked", otherwise returns "succeeded". An
+  //      error computing a proof is returned instead of "revoked".
+  return nr_prove_status;
+}
+
+EpidStatus EPID_MEMBER_API EpidSignStream(MemberCtx const* ctx,
+                                          void const* msg, size_t msg_len,
+                                          void const* basename,
+                                          size_t basename_len, SigSink sink,
+                                          void* user_data) {
+  EpidStatus sts = kEpidErr;
+  EpidStatus nr_prove_status = kEpidNoErr;
+  NativeBasicSignature sigma0;
+  EpidNonSplitSignature sig;
+  NrProof proof;
+  uint32_t i = 0;
+  uint32_t num_sig_rl = 0;
+  if (!ctx || !sink) {
+    return kEpidBadArgErr;
+  }
+  sts = CheckSignArgs(ctx, msg, msg_len, basename, basename_len);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+
+  sts = SignHeader(ctx, msg, msg_len, basename, basename_len, &sigma0, &sig,
+                   &num_sig_rl);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  // everything preceding the non-revoked proofs goes out first
+  sts = sink(&sig, EpidGetSigSize(NULL), user_data);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  for (i = 0; i < num_sig_rl; i++) {
+    sts = EpidNrProve(ctx, msg, msg_len, &sigma0, &ctx->sig_rl->bk[i], &proof);
+    nr_prove_status = AddNrProveStatus(nr_prove_status, sts);
+    if (IsNrProveError(nr_prove_status)) {
+      return nr_prove_status;
+    }
+    sts = sink(&proof, sizeof(proof), user_data);
+    if (kEpidNoErr != sts) {
+      return sts;
+    }
+  }
+  return nr_prove_status;
 }
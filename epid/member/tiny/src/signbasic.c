@@ -21,6 +21,7 @@
 #include "epid/member/tiny/context.h"
 #include "epid/member/tiny/native_types.h"
 #include "epid/member/tiny/presig-internal.h"
+#include "epid/member/tiny/presig_compute.h"
 #include "epid/types.h"
 #include "tinymath/efq.h"
 #include "tinymath/fp.h"
@@ -60,6 +61,7 @@ EpidStatus EpidSignBasic(MemberCtx const* ctx, void const* msg, size_t msg_len,
                          NativeBasicSignature* sig) {
   EpidStatus sts = kEpidErr;
   PreComputedSignatureData* presig = NULL;
+  PreComputedSignatureData scratch;
   tiny_sha sha_state;
   sha_digest digest;
   G1ElemStr g1_str;
@@ -73,7 +75,7 @@ EpidStatus EpidSignBasic(MemberCtx const* ctx, void const* msg, size_t msg_len,
 
   FpDeserialize(&x, &ctx->credential.x);
   do {
-    sts = MemberTopPreSig((MemberCtx*)ctx, &presig);
+    sts = MemberTopPreSig((MemberCtx*)ctx, &scratch, &presig);
     if (kEpidNoErr != sts) {
       break;
     }
@@ -156,6 +158,8 @@ EpidStatus EpidSignBasic(MemberCtx const* ctx, void const* msg, size_t msg_len,
     sts = kEpidNoErr;
   } while (0);
   // remove once used presig from member's pool to prevent reusing it
-  MemberPopPreSig((MemberCtx*)ctx);
+  if (presig) {
+    MemberPopPreSig((MemberCtx*)ctx, presig);
+  }
   return sts;
 }
@@ -53,8 +53,7 @@ int MembershipCredentialIsInRange(NativeMembershipCredential const* input) {
 
 int MembershipCredentialIsInGroup(NativeMembershipCredential const* input,
                                   FpElem const* f,
-                                  NativeGroupPubKey const* pubkey,
-                                  PairingState const* pairing_state) {
+                                  NativeGroupPubKey const* pubkey) {
   EccPointJacobiFq g1;
   EccPointJacobiFq t2;
   EccPointFq t2_affine;
@@ -75,12 +74,12 @@ int MembershipCredentialIsInGroup(NativeMembershipCredential const* input,
   EFq2MulSSCM(t1, t1, &input->x);
   EFq2Add(t1, t1, w);
   EFq2ToAffine(t1_affine, t1);
-  PairingCompute(&t3, &input->A, t1_affine, pairing_state);
+  PairingCompute(&t3, &input->A, t1_affine);
   EFqFromAffine(&t2, &pubkey->h1);
   EFqMulSSCM(&t2, &t2, f);
   EFqAdd(&t2, &t2, &g1);
   EFqToAffine(&t2_affine, &t2);
-  PairingCompute(&t4, &t2_affine, &epid20_g2, pairing_state);
+  PairingCompute(&t4, &t2_affine, &epid20_g2);
   result = Fq12Eq(&t3, &t4);
   memset(&t2, 0, sizeof(t2));
   memset(&t2_affine, 0, sizeof(t2_affine));
@@ -94,8 +93,6 @@ int PrivKeyIsInRange(NativePrivKey const* input) {
 }
 
 int PrivKeyIsInGroup(NativePrivKey const* input,
-                     NativeGroupPubKey const* pubkey,
-                     PairingState const* pairing_state) {
-  return MembershipCredentialIsInGroup(&input->cred, &input->f, pubkey,
-                                       pairing_state);
+                     NativeGroupPubKey const* pubkey) {
+  return MembershipCredentialIsInGroup(&input->cred, &input->f, pubkey);
 }
@@ -46,7 +46,6 @@ EpidStatus EPID_MEMBER_API EpidMemberWritePrecomp(
   EpidStatus sts = kEpidErr;
   NativeGroupPubKey native_pub_key;
   EccPointFq A;
-  PairingState pairing;
   Fq12Elem res;
 
   if (!pub_key || !credential || !precomp_str) {
@@ -64,14 +63,13 @@ EpidStatus EPID_MEMBER_API EpidMemberWritePrecomp(
       break;
     }
 
-    PairingInit(&pairing);
-    PairingCompute(&res, &A, &epid20_g2, &pairing);
+    PairingCompute(&res, &A, &epid20_g2);
     Fq12Serialize((Fq12ElemStr*)&precomp_str->ea2, &res);
-    PairingCompute(&res, &native_pub_key.h1, &epid20_g2, &pairing);
+    PairingCompute(&res, &native_pub_key.h1, &epid20_g2);
     Fq12Serialize((Fq12ElemStr*)&precomp_str->e12, &res);
-    PairingCompute(&res, &native_pub_key.h2, &epid20_g2, &pairing);
+    PairingCompute(&res, &native_pub_key.h2, &epid20_g2);
     Fq12Serialize((Fq12ElemStr*)&precomp_str->e22, &res);
-    PairingCompute(&res, &native_pub_key.h2, &native_pub_key.w, &pairing);
+    PairingCompute(&res, &native_pub_key.h2, &native_pub_key.w);
     Fq12Serialize((Fq12ElemStr*)&precomp_str->e2w, &res);
     sts = kEpidNoErr;
   } while (0);
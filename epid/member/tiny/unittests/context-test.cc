@@ -19,6 +19,7 @@
  * \brief Member unit tests.
  */
 #include <cstring>
+#include <limits>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -67,6 +68,52 @@ TEST_F(EpidMemberTest, GetSizeWorksGivenValidParams) {
   EXPECT_EQ(kEpidNoErr, EpidMemberGetSize(&params, &ctx_size));
 }
 
+TEST_F(EpidMemberTest, GetSizeIncludesCombTable) {
+  size_t ctx_size = 0;
+  size_t comb_ctx_size = 0;
+  Prng my_prng;
+  MemberParams params = {0};
+  SetMemberParams(&Prng::Generate, &my_prng, nullptr, &params);
+  EXPECT_EQ(kEpidNoErr, EpidMemberGetSize(&params, &ctx_size));
+  EXPECT_EQ(kEpidNoErr, EpidMemberSetFixedBaseCombTeeth(6, &params));
+  EXPECT_EQ(kEpidNoErr, EpidMemberGetSize(&params, &comb_ctx_size));
+  EXPECT_EQ(ctx_size + 32 * sizeof(G1ElemStr), comb_ctx_size);
+}
+
+TEST_F(EpidMemberTest, GetSizeIncludesPreSigTableOnlyIfEnabled) {
+  size_t ctx_size = 0;
+  size_t table_ctx_size = 0;
+  Prng my_prng;
+  MemberParams params = {0};
+  SetMemberParams(&Prng::Generate, &my_prng, nullptr, &params);
+  EXPECT_EQ(kEpidNoErr, EpidMemberGetSize(&params, &ctx_size));
+  EXPECT_EQ(kEpidNoErr, EpidMemberSetPreSigMultiExpTable(1, &params));
+  EXPECT_EQ(kEpidNoErr, EpidMemberGetSize(&params, &table_ctx_size));
+  EXPECT_EQ(ctx_size + 16 * sizeof(Fq12ElemStr), table_ctx_size);
+  EXPECT_EQ(kEpidNoErr, EpidMemberSetPreSigMultiExpTable(0, &params));
+  EXPECT_EQ(kEpidNoErr, EpidMemberGetSize(&params, &table_ctx_size));
+  EXPECT_EQ(ctx_size, table_ctx_size);
+}
+
+TEST_F(EpidMemberTest, GetSizeFailsGivenTooManyCombTeeth) {
+  size_t ctx_size = 0;
+  Prng my_prng;
+  MemberParams params = {0};
+  SetMemberParams(&Prng::Generate, &my_prng, nullptr, &params);
+  params.comb_teeth = 9;
+  EXPECT_EQ(kEpidBadArgErr, EpidMemberGetSize(&params, &ctx_size));
+}
+
+TEST_F(EpidMemberTest, SetFixedBaseCombTeethFailsGivenInvalidParameters) {
+  MemberParams params = {0};
+  EXPECT_EQ(kEpidBadConfigErr, EpidMemberSetFixedBaseCombTeeth(4, nullptr));
+  EXPECT_EQ(kEpidBadArgErr, EpidMemberSetFixedBaseCombTeeth(9, &params));
+}
+
+TEST_F(EpidMemberTest, SetPreSigMultiExpTableFailsGivenNullConfig) {
+  EXPECT_EQ(kEpidBadConfigErr, EpidMemberSetPreSigMultiExpTable(1, nullptr));
+}
+
 //////////////////////////////////////////////////////////////////////////
 // EpidMemberInit Tests
 TEST_F(EpidMemberTest, InitFailsGivenNullParameters) {
@@ -428,6 +475,233 @@ TEST_F(EpidMemberTest, SetSigRlWorksGivenSigRlWithOneEntry) {
   EXPECT_EQ(kEpidNoErr, EpidMemberSetSigRl(member_ctx, sig_rl, sig_rl_size));
 }
 //////////////////////////////////////////////////////////////////////////
+// EpidMemberUpdateSigRl
+TEST_F(EpidMemberTest, UpdateSigRlFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberUpdateSigRl(nullptr, sig_rl, sig_rl_size));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberUpdateSigRl(member_ctx, nullptr, sig_rl_size));
+}
+TEST_F(EpidMemberTest, UpdateSigRlFailsIfNoSigRlSet) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  EXPECT_EQ(kEpidOutOfSequenceError,
+            EpidMemberUpdateSigRl(member_ctx, sig_rl, sig_rl_size));
+}
+TEST_F(EpidMemberTest, UpdateSigRlFailsGivenSameVersion) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member_ctx, sig_rl, sig_rl_size));
+  EXPECT_EQ(kEpidVersionMismatchErr,
+            EpidMemberUpdateSigRl(member_ctx, sig_rl, sig_rl_size));
+}
+TEST_F(EpidMemberTest, UpdateSigRlFailsGivenBadGroupId) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl srl = {{{0}}, {{0}}, {{0}}, {{{{0}, {0}}, {{0}, {0}}}}};
+  srl.gid = this->kGrpXKey.gid;
+  THROW_ON_EPIDERR(
+      EpidMemberSetSigRl(member_ctx, &srl, sizeof(srl) - sizeof(srl.bk)));
+  srl.gid.data[0] = ~srl.gid.data[0];
+  srl.version = this->kOctStr32_1;
+  EXPECT_EQ(kEpidBadArgErr, EpidMemberUpdateSigRl(member_ctx, &srl,
+                                                  sizeof(srl) - sizeof(srl.bk)));
+}
+TEST_F(EpidMemberTest, UpdateSigRlAppendsEntries) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXSigrevokedMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  // the update adds all entries of kGrpXSigRl to an empty list
+  SigRl srl = {{{0}}, {{0}}, {{0}}, {{{{0}, {0}}, {{0}, {0}}}}};
+  srl.gid = this->kGrpXKey.gid;
+  srl.version = this->kOctStr32_1;
+  SigRl const* delta = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t delta_size = this->kGrpXSigRl.size();
+  THROW_ON_EPIDERR(
+      EpidMemberSetSigRl(member_ctx, &srl, sizeof(srl) - sizeof(srl.bk)));
+  EXPECT_EQ(kEpidNoErr, EpidMemberUpdateSigRl(member_ctx, delta, delta_size));
+
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(delta));
+  EpidNonSplitSignature* sig =
+      reinterpret_cast<EpidNonSplitSignature*>(sig_data.data());
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidSign(member_ctx, msg.data(), msg.size(), nullptr, 0,
+                     reinterpret_cast<EpidSignature*>(sig), sig_data.size()));
+  EXPECT_EQ(0, memcmp(&delta->version, &sig->rl_ver, sizeof(sig->rl_ver)));
+  EXPECT_EQ(0, memcmp(&delta->n2, &sig->n2, sizeof(sig->n2)));
+}
+TEST_F(EpidMemberTest, UpdateSigRlPreservesRlOnFailure) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXSigrevokedMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member_ctx, sig_rl, sig_rl_size));
+  // size does not match n2
+  SigRl srl = {{{0}}, {{0}}, {{0}}, {{{{0}, {0}}, {{0}, {0}}}}};
+  srl.gid = this->kGrpXKey.gid;
+  srl.version.data[3] = 0x04;
+  srl.n2 = this->kOctStr32_1;
+  EXPECT_EQ(kEpidBadArgErr, EpidMemberUpdateSigRl(member_ctx, &srl,
+                                                  sizeof(srl) - sizeof(srl.bk)));
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(sig_rl));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidSign(member_ctx, msg.data(), msg.size(), nullptr, 0, sig,
+                     sig_data.size()));
+}
+//////////////////////////////////////////////////////////////////////////
+// EpidMemberSetSigRlByReference
+TEST_F(EpidMemberTest, SetSigRlByReferenceFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetSigRlByReference(nullptr, sig_rl, sig_rl_size));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetSigRlByReference(member_ctx, nullptr, sig_rl_size));
+}
+TEST_F(EpidMemberTest, SetSigRlByReferenceFailsGivenN2TooBigForSize) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size() - sizeof(sig_rl->bk[0]);
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetSigRlByReference(member_ctx, sig_rl, sig_rl_size));
+}
+TEST_F(EpidMemberTest, SetSigRlByReferenceWorksGivenListLargerThanMaximum) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXSigrevokedMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  // the member holds at most 5 entries, the list has 6
+  std::vector<uint8_t> sig_rl_data(this->kGrpXSigRl);
+  size_t header_size = sizeof(SigRl) - sizeof(SigRlEntry);
+  sig_rl_data.insert(sig_rl_data.end(), this->kGrpXSigRl.begin() + header_size,
+                     this->kGrpXSigRl.end());
+  SigRl* sig_rl = reinterpret_cast<SigRl*>(sig_rl_data.data());
+  sig_rl->n2.data[3] = 0x06;
+  THROW_ON_EPIDERR(EpidMemberSetSigRlByReference(member_ctx, sig_rl,
+                                                 sig_rl_data.size()));
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(sig_rl));
+  EpidNonSplitSignature* sig =
+      reinterpret_cast<EpidNonSplitSignature*>(sig_data.data());
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidSign(member_ctx, msg.data(), msg.size(), nullptr, 0,
+                     reinterpret_cast<EpidSignature*>(sig), sig_data.size()));
+  EXPECT_EQ(0, memcmp(&sig_rl->n2, &sig->n2, sizeof(sig->n2)));
+}
+TEST_F(EpidMemberTest, SetSigRlByReferenceWorksWithoutSigRlStorage) {
+  Prng my_prng;
+  MemberParams params = {0};
+  SetMemberParams(&Prng::Generate, &my_prng,
+                  &this->kGrpXSigrevokedMember0PrivKey.f, &params);
+  params.max_sigrl_entries = 0;
+  MemberCtxObj member_ctx(&params);
+  THROW_ON_EPIDERR(EpidProvisionKey(member_ctx, &this->kGrpXKey,
+                                    &this->kGrpXSigrevokedMember0PrivKey,
+                                    nullptr));
+  THROW_ON_EPIDERR(EpidMemberStartup(member_ctx));
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  size_t sig_rl_size = this->kGrpXSigRl.size();
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetSigRl(member_ctx, sig_rl, sig_rl_size));
+  EXPECT_EQ(kEpidNoErr,
+            EpidMemberSetSigRlByReference(member_ctx, sig_rl, sig_rl_size));
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(sig_rl));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidSign(member_ctx, msg.data(), msg.size(), nullptr, 0, sig,
+                     sig_data.size()));
+}
+TEST_F(EpidMemberTest, UpdateSigRlIsNotSupportedForSigRlSetByReference) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl srl = {{{0}}, {{0}}, {{0}}, {{{{0}, {0}}, {{0}, {0}}}}};
+  srl.gid = this->kGrpXKey.gid;
+  THROW_ON_EPIDERR(EpidMemberSetSigRlByReference(
+      member_ctx, &srl, sizeof(srl) - sizeof(srl.bk)));
+  SigRl const* delta = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidMemberUpdateSigRl(member_ctx, delta, this->kGrpXSigRl.size()));
+}
+//////////////////////////////////////////////////////////////////////////
+// EpidMemberSetSigRlBuffer
+TEST_F(EpidMemberTest, SetSigRlBufferFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  std::vector<uint8_t> buffer(sizeof(SigRl));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetSigRlBuffer(nullptr, buffer.data(), buffer.size()));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetSigRlBuffer(member_ctx, nullptr, buffer.size()));
+}
+TEST_F(EpidMemberTest, SetSigRlBufferFailsGivenBufferTooSmallForList) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  THROW_ON_EPIDERR(
+      EpidMemberSetSigRl(member_ctx, sig_rl, this->kGrpXSigRl.size()));
+  std::vector<uint8_t> buffer(this->kGrpXSigRl.size() - 1);
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetSigRlBuffer(member_ctx, buffer.data(), buffer.size()));
+}
+TEST_F(EpidMemberTest, SetSigRlBufferLetsUpdateSigRlGrowListBeyondMaximum) {
+  Prng my_prng;
+  MemberCtxObj member_ctx(this->kGrpXKey, this->kGrpXSigrevokedMember0PrivKey,
+                          &Prng::Generate, &my_prng);
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kGrpXSigRl.data());
+  THROW_ON_EPIDERR(
+      EpidMemberSetSigRl(member_ctx, sig_rl, this->kGrpXSigRl.size()));
+  // a newer version of the list adds the same 3 entries again
+  std::vector<uint8_t> delta_data(this->kGrpXSigRl);
+  SigRl* delta = reinterpret_cast<SigRl*>(delta_data.data());
+  delta->version.data[3]++;
+  // the member holds at most 5 entries
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberUpdateSigRl(member_ctx, delta, delta_data.size()));
+
+  std::vector<SigRlEntry> buffer(1 + 6);
+  ASSERT_EQ(kEpidNoErr,
+            EpidMemberSetSigRlBuffer(member_ctx, buffer.data(),
+                                     buffer.size() * sizeof(SigRlEntry)));
+  EXPECT_EQ(kEpidNoErr,
+            EpidMemberUpdateSigRl(member_ctx, delta, delta_data.size()));
+
+  auto& msg = this->kMsg0;
+  SigRl srl = *delta;
+  srl.n2.data[3] = 0x06;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(&srl));
+  EpidNonSplitSignature* sig =
+      reinterpret_cast<EpidNonSplitSignature*>(sig_data.data());
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidSign(member_ctx, msg.data(), msg.size(), nullptr, 0,
+                     reinterpret_cast<EpidSignature*>(sig), sig_data.size()));
+  EXPECT_EQ(0, memcmp(&srl.version, &sig->rl_ver, sizeof(sig->rl_ver)));
+  EXPECT_EQ(0, memcmp(&srl.n2, &sig->n2, sizeof(sig->n2)));
+}
+//////////////////////////////////////////////////////////////////////////
 // EpidRegisterBasename
 TEST_F(EpidMemberTest, RegisterBaseNameFailsGivenNullPtr) {
   Prng my_prng;
@@ -497,6 +771,101 @@ TEST_F(EpidMemberTest,
                                              this->kData_0_255.size()));
 }
 //////////////////////////////////////////////////////////////////////////
+// EpidGetBasenameBufferSize
+TEST_F(EpidMemberTest, GetBasenameBufferSizeFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidGetBasenameBufferSize(nullptr, 1, &buffer_size));
+  EXPECT_EQ(kEpidBadArgErr, EpidGetBasenameBufferSize(member, 1, nullptr));
+}
+TEST_F(EpidMemberTest, GetBasenameBufferSizeFailsGivenHugeNumberOfBasenames) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidGetBasenameBufferSize(
+                member, std::numeric_limits<size_t>::max(), &buffer_size));
+}
+//////////////////////////////////////////////////////////////////////////
+// EpidMemberSetBasenameBuffer
+TEST_F(EpidMemberTest, SetBasenameBufferFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetBasenameBufferSize(member, 1, &buffer_size));
+  std::vector<uint64_t> buffer((buffer_size + 7) / 8);
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetBasenameBuffer(nullptr, buffer.data(), buffer_size));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetBasenameBuffer(member, nullptr, buffer_size));
+}
+TEST_F(EpidMemberTest, SetBasenameBufferFailsGivenBufferTooSmallForBasenames) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  for (int i = 0; i < 3; ++i) {
+    THROW_ON_EPIDERR(EpidRegisterBasename(member, &i, sizeof(i)));
+  }
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetBasenameBufferSize(member, 2, &buffer_size));
+  std::vector<uint64_t> buffer((buffer_size + 7) / 8);
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetBasenameBuffer(member, buffer.data(), buffer_size));
+}
+TEST_F(EpidMemberTest, SetBasenameBufferKeepsRegisteredBasenames) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  auto& bsn = this->kBsn0;
+  THROW_ON_EPIDERR(EpidRegisterBasename(member, bsn.data(), bsn.size()));
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetBasenameBufferSize(member, 1, &buffer_size));
+  std::vector<uint64_t> buffer((buffer_size + 7) / 8);
+  ASSERT_EQ(kEpidNoErr,
+            EpidMemberSetBasenameBuffer(member, buffer.data(), buffer_size));
+  EXPECT_EQ(kEpidDuplicateErr,
+            EpidRegisterBasename(member, bsn.data(), bsn.size()));
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  EXPECT_EQ(kEpidNoErr, EpidSign(member, msg.data(), msg.size(), bsn.data(),
+                                 bsn.size(), sig, sig_data.size()));
+}
+TEST_F(EpidMemberTest, SetBasenameBufferLetsMoreBasenamesRegister) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  // the member registers at most 5 basenames
+  for (int i = 0; i < 5; ++i) {
+    THROW_ON_EPIDERR(EpidRegisterBasename(member, &i, sizeof(i)));
+  }
+  int i = 5;
+  EXPECT_EQ(kEpidNoMemErr, EpidRegisterBasename(member, &i, sizeof(i)));
+
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetBasenameBufferSize(member, 8, &buffer_size));
+  std::vector<uint64_t> buffer((buffer_size + 7) / 8);
+  ASSERT_EQ(kEpidNoErr,
+            EpidMemberSetBasenameBuffer(member, buffer.data(), buffer_size));
+  for (i = 5; i < 8; ++i) {
+    EXPECT_EQ(kEpidNoErr, EpidRegisterBasename(member, &i, sizeof(i)));
+  }
+  EXPECT_EQ(kEpidNoMemErr, EpidRegisterBasename(member, &i, sizeof(i)));
+  for (i = 0; i < 8; ++i) {
+    EXPECT_EQ(kEpidDuplicateErr, EpidRegisterBasename(member, &i, sizeof(i)));
+  }
+  // clearing keeps the new capacity
+  THROW_ON_EPIDERR(EpidClearRegisteredBasenames(member));
+  for (i = 0; i < 8; ++i) {
+    EXPECT_EQ(kEpidNoErr, EpidRegisterBasename(member, &i, sizeof(i)));
+  }
+}
+//////////////////////////////////////////////////////////////////////////
 // EpidClearRegisteredBasenames
 TEST_F(EpidMemberTest, EpidClearRegisteredBasenamesFailsGivenNullPtr) {
   EXPECT_EQ(kEpidBadArgErr, EpidClearRegisteredBasenames(nullptr));
@@ -96,4 +96,13 @@ TEST_F(EpidMemberTest,
                                 &pub_key, &compressed_privkey_seed, &priv_key));
 }
 
+TEST_F(EpidMemberTest, DecompressPrivKeysIsNotImplemented) {
+  auto const& pub_key = this->kGrpXKey;
+  auto const& compressed_privkey = this->kGrpXMember9CompressedKey;
+  PrivKey priv_key = {};
+  EpidStatus result = kEpidErr;
+  EXPECT_EQ(kEpidNotImpl, EpidDecompressPrivKeys(&pub_key, &compressed_privkey,
+                                                 1, &priv_key, &result));
+}
+
 }  // namespace
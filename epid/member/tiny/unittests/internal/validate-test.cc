@@ -34,7 +34,6 @@ extern "C" {
 #include "epid/member/tiny/native_types.h"
 #include "epid/member/tiny/validate.h"
 #include "epid/types.h"
-#include "tinymath/pairing.h"
 }
 
 namespace {
@@ -119,8 +118,6 @@ TEST_F(EpidMemberTest, MembershipCredentialIsInRangeFails) {
 //////////////////////////////////////////////////////////////////////////
 // MembershipCredentialIsInGroup Tests
 TEST_F(EpidMemberTest, MembershipCredentialIsInGroupPasses) {
-  PairingState pairing_state;
-  PairingInit(&pairing_state);
   NativeMembershipCredential const input = {
       {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
        0x00, 0x00, 0x00, 0x01},  // group id
@@ -152,13 +149,10 @@ TEST_F(EpidMemberTest, MembershipCredentialIsInGroupPasses) {
            0xbc077230, 0xe8b3c725, 0x9021a7e0}}},
         {{{0xee1140a9, 0x837d3e31, 0x8e25c6ad, 0xba6bf0da, 0x1f3deaa2,
            0x5d0a88db, 0x1bb6f705, 0x79516936}}}}}};
-  EXPECT_TRUE(
-      MembershipCredentialIsInGroup(&input, &f, &pubkey, &pairing_state));
+  EXPECT_TRUE(MembershipCredentialIsInGroup(&input, &f, &pubkey));
 }
 
 TEST_F(EpidMemberTest, MembershipCredentialIsInGroupFails) {
-  PairingState pairing_state;
-  PairingInit(&pairing_state);
   NativeMembershipCredential const input = {
       {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
        0x00, 0x00, 0x00, 0x02},  // group id
@@ -190,8 +184,7 @@ TEST_F(EpidMemberTest, MembershipCredentialIsInGroupFails) {
            0xbc077230, 0xe8b3c725, 0x9021a7e0}}},
         {{{0xee1140a9, 0x837d3e31, 0x8e25c6ad, 0xba6bf0da, 0x1f3deaa2,
            0x5d0a88db, 0x1bb6f705, 0x79516936}}}}}};
-  EXPECT_FALSE(
-      MembershipCredentialIsInGroup(&input, &f, &pubkey, &pairing_state));
+  EXPECT_FALSE(MembershipCredentialIsInGroup(&input, &f, &pubkey));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -235,8 +228,6 @@ TEST_F(EpidMemberTest, PrivKeyIsInRangeRangeFails) {
 //////////////////////////////////////////////////////////////////////////
 // PrivKeyIsInGroup Tests
 TEST_F(EpidMemberTest, PrivKeyIsInGroupPasses) {
-  PairingState pairing_state;
-  PairingInit(&pairing_state);
   NativePrivKey const input = {
       {
           {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -270,12 +261,10 @@ TEST_F(EpidMemberTest, PrivKeyIsInGroupPasses) {
            0xbc077230, 0xe8b3c725, 0x9021a7e0}}},
         {{{0xee1140a9, 0x837d3e31, 0x8e25c6ad, 0xba6bf0da, 0x1f3deaa2,
            0x5d0a88db, 0x1bb6f705, 0x79516936}}}}}};
-  EXPECT_TRUE(PrivKeyIsInGroup(&input, &pubkey, &pairing_state));
+  EXPECT_TRUE(PrivKeyIsInGroup(&input, &pubkey));
 }
 
 TEST_F(EpidMemberTest, PrivKeyIsInGroupFails) {
-  PairingState pairing_state;
-  PairingInit(&pairing_state);
   NativePrivKey const input = {
       {
           {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -309,7 +298,7 @@ TEST_F(EpidMemberTest, PrivKeyIsInGroupFails) {
            0xbc077230, 0xe8b3c725, 0x9021a7e0}}},
         {{{0xee1140a9, 0x837d3e31, 0x8e25c6ad, 0xba6bf0da, 0x1f3deaa2,
            0x5d0a88db, 0x1bb6f705, 0x79516936}}}}}};
-  EXPECT_FALSE(PrivKeyIsInGroup(&input, &pubkey, &pairing_state));
+  EXPECT_FALSE(PrivKeyIsInGroup(&input, &pubkey));
 }
 
 }  // namespace
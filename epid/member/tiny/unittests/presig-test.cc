@@ -21,6 +21,8 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -28,11 +30,13 @@
 
 extern "C" {
 #include "epid/member/api.h"
+#include "epid/verifier.h"
 }
 
 #include "member-testhelper.h"
 #include "testhelper/errors-testhelper.h"
 #include "testhelper/prng-testhelper.h"
+#include "testhelper/verifier_wrapper-testhelper.h"
 
 /// Count of elements in array
 #define COUNT_OF(A) (sizeof(A) / sizeof((A)[0]))
@@ -116,4 +120,331 @@ TEST_F(EpidMemberTest, GetNumPreSigsReturnsNumberOfAddedPresigs) {
   EXPECT_EQ(presigs_added, EpidGetNumPreSigs(member));
 }
 
+///////////////////////////////////////////////////////////////////////
+// EpidGetPreSigBufferSize
+TEST_F(EpidMemberTest, GetPreSigBufferSizeFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigBufferSize(nullptr, 1, &buffer_size));
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigBufferSize(member, 1, nullptr));
+}
+
+TEST_F(EpidMemberTest, GetPreSigBufferSizeFailsGivenHugeNumberOfPreSigs) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidGetPreSigBufferSize(
+                member, std::numeric_limits<size_t>::max(), &buffer_size));
+}
+
+TEST_F(EpidMemberTest, GetPreSigBufferSizeGrowsWithNumberOfPreSigs) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t size1 = 0;
+  size_t size3 = 0;
+  ASSERT_EQ(kEpidNoErr, EpidGetPreSigBufferSize(member, 1, &size1));
+  ASSERT_EQ(kEpidNoErr, EpidGetPreSigBufferSize(member, 3, &size3));
+  EXPECT_LT((size_t)0, size1);
+  EXPECT_EQ(3 * size1, size3);
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidMemberSetPreSigBuffer
+TEST_F(EpidMemberTest, SetPreSigBufferFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 1, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size);
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetPreSigBuffer(nullptr, buffer.data(), buffer.size()));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetPreSigBuffer(member, nullptr, buffer.size()));
+}
+
+TEST_F(EpidMemberTest, SetPreSigBufferFailsGivenBufferTooSmallForOnePreSig) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 1, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size - 1);
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+}
+
+TEST_F(EpidMemberTest, SetPreSigBufferFailsGivenBufferTooSmallForPool) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 3, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size);
+  THROW_ON_EPIDERR(
+      EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 3));
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 2, &buffer_size));
+  std::vector<uint8_t> small_buffer(buffer_size);
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetPreSigBuffer(member, small_buffer.data(),
+                                      small_buffer.size()));
+  EXPECT_EQ((size_t)3, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, SetPreSigBufferGrowsPool) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 3, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size);
+  ASSERT_EQ(kEpidNoErr,
+            EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+  EXPECT_EQ(kEpidNoErr, EpidAddPreSigs(member, 2));
+  EXPECT_EQ((size_t)3, EpidGetNumPreSigs(member));
+  EXPECT_EQ(kEpidBadArgErr, EpidAddPreSigs(member, 1));
+}
+
+TEST_F(EpidMemberTest, SignConsumesPreSigsMovedToNewBuffer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  SigRl srl = {{{0}}, {{0}}, {{0}}, {{{{0}, {0}}, {{0}, {0}}}}};
+  srl.gid = this->kGroupPublicKey.gid;
+  std::vector<uint8_t> sig(EpidGetSigSize(&srl));
+  THROW_ON_EPIDERR(
+      EpidMemberSetSigRl(member, &srl, sizeof(srl) - sizeof(srl.bk)));
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 2, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size);
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(
+      EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  EXPECT_EQ(kEpidNoErr, EpidSign(member, msg.data(), msg.size(), nullptr, 0,
+                                 (EpidSignature*)sig.data(), sig.size()));
+  EXPECT_EQ(kEpidNoErr, EpidSign(member, msg.data(), msg.size(), nullptr, 0,
+                                 (EpidSignature*)sig.data(), sig.size()));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidSetPreSigWatermarks
+TEST_F(EpidMemberTest, SetPreSigWatermarksFailsGivenNullPointer) {
+  EXPECT_EQ(kEpidBadArgErr, EpidSetPreSigWatermarks(nullptr, 1, 2));
+}
+
+TEST_F(EpidMemberTest, SetPreSigWatermarksFailsGivenInvalidWatermarks) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  EXPECT_EQ(kEpidBadArgErr, EpidSetPreSigWatermarks(member, 2, 2));
+  EXPECT_EQ(kEpidBadArgErr, EpidSetPreSigWatermarks(member, 3, 1));
+  EXPECT_EQ(kEpidBadArgErr, EpidSetPreSigWatermarks(member, 1, 0));
+}
+
+TEST_F(EpidMemberTest, SetPreSigWatermarksAcceptsZeroToDisable) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  EXPECT_EQ(kEpidNoErr, EpidSetPreSigWatermarks(member, 0, 0));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidRefillPreSigs
+TEST_F(EpidMemberTest, RefillPreSigsFailsGivenNullPointer) {
+  EXPECT_EQ(kEpidBadArgErr, EpidRefillPreSigs(nullptr, 0));
+}
+
+TEST_F(EpidMemberTest, RefillPreSigsDoesNothingByDefault) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, RefillPreSigsFillsPoolToHighWatermark) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 4, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size);
+  THROW_ON_EPIDERR(
+      EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+
+  THROW_ON_EPIDERR(EpidSetPreSigWatermarks(member, 1, 3));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)3, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, RefillPreSigsStopsWhenPoolIsFull) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  // by default the pool holds one pre-computed signature
+  THROW_ON_EPIDERR(EpidSetPreSigWatermarks(member, 1, 3));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, RefillPreSigsAddsAtMostRequestedNumber) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 3, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size);
+  THROW_ON_EPIDERR(
+      EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+
+  THROW_ON_EPIDERR(EpidSetPreSigWatermarks(member, 1, 3));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 1));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+  // refilling continues above the low watermark until the pool is full
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 1));
+  EXPECT_EQ((size_t)2, EpidGetNumPreSigs(member));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 5));
+  EXPECT_EQ((size_t)3, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, RefillPreSigsWaitsForLowWatermark) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 3, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size);
+  THROW_ON_EPIDERR(
+      EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 2));
+  THROW_ON_EPIDERR(EpidSetPreSigWatermarks(member, 1, 3));
+  EXPECT_EQ(kEpidNoErr, EpidRefillPreSigs(member, 0));
+  EXPECT_EQ((size_t)2, EpidGetNumPreSigs(member));
+}
+
+/// Random number generator that can be called from several threads
+struct LockedPrng {
+  Prng prng;
+  std::mutex mutex;
+  static int __STDCALL Generate(unsigned int* random_data, int num_bits,
+                                void* user_data) {
+    LockedPrng* locked = static_cast<LockedPrng*>(user_data);
+    std::lock_guard<std::mutex> lock(locked->mutex);
+    return Prng::Generate(random_data, num_bits, &locked->prng);
+  }
+};
+
+TEST_F(EpidMemberTest, RefillPreSigsCanRunWhileSigning) {
+  const size_t kSignatures = 12;
+  LockedPrng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &LockedPrng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  size_t buffer_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 4, &buffer_size));
+  std::vector<uint8_t> buffer(buffer_size);
+  THROW_ON_EPIDERR(
+      EpidMemberSetPreSigBuffer(member, buffer.data(), buffer.size()));
+  THROW_ON_EPIDERR(EpidSetPreSigWatermarks(member, 2, 4));
+
+  std::vector<std::vector<uint8_t>> sigs(
+      kSignatures, std::vector<uint8_t>(EpidGetSigSize(nullptr)));
+  EpidStatus refill_sts = kEpidNoErr;
+  bool done = false;
+  std::mutex done_mutex;
+  MemberCtx* ctx = member;
+  std::thread refiller([ctx, &refill_sts, &done, &done_mutex]() {
+    for (;;) {
+      {
+        std::lock_guard<std::mutex> lock(done_mutex);
+        if (done) break;
+      }
+      EpidStatus sts = EpidRefillPreSigs(ctx, 1);
+      if (kEpidNoErr != sts) {
+        refill_sts = sts;
+        break;
+      }
+      std::this_thread::yield();
+    }
+  });
+  std::vector<EpidStatus> sign_sts(kSignatures, kEpidErr);
+  for (size_t i = 0; i < kSignatures; i++) {
+    sign_sts[i] = EpidSign(member, msg.data(), msg.size(), nullptr, 0,
+                           (EpidSignature*)sigs[i].data(), sigs[i].size());
+  }
+  {
+    std::lock_guard<std::mutex> lock(done_mutex);
+    done = true;
+  }
+  refiller.join();
+
+  EXPECT_EQ(kEpidNoErr, refill_sts);
+  size_t hits = 0;
+  size_t misses = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigStats(member, &hits, &misses));
+  EXPECT_EQ(kSignatures, hits + misses);
+  VerifierCtxObj verifier(this->kGroupPublicKey);
+  for (size_t i = 0; i < kSignatures; i++) {
+    ASSERT_EQ(kEpidNoErr, sign_sts[i]);
+    EXPECT_EQ(kEpidSigValid,
+              EpidVerify(verifier, (EpidSignature*)sigs[i].data(),
+                         sigs[i].size(), msg.data(), msg.size()));
+  }
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidGetPreSigStats
+TEST_F(EpidMemberTest, GetPreSigStatsFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t hits = 0;
+  size_t misses = 0;
+
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigStats(nullptr, &hits, &misses));
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigStats(member, nullptr, &misses));
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigStats(member, &hits, nullptr));
+}
+
+TEST_F(EpidMemberTest, GetPreSigStatsCountsPoolHitsAndMisses) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  size_t hits = 0;
+  size_t misses = 0;
+
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(
+      EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+  THROW_ON_EPIDERR(
+      EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+  EXPECT_EQ(kEpidNoErr, EpidGetPreSigStats(member, &hits, &misses));
+  EXPECT_EQ((size_t)1, hits);
+  EXPECT_EQ((size_t)1, misses);
+}
+
 }  // namespace
@@ -0,0 +1,251 @@
+/*############################################################################
+  # Copyright 2016-2020 Intel Corporation
+  #
+  # Licensed under the Apache License, Version 2.0 (the "License");
+  # you may not use this file except in compliance with the License.
+  # You may obtain a copy of the License at
+  #
+  #     http://www.apache.org/licenses/LICENSE-2.0
+  #
+  # Unless required by applicable law or agreed to in writing, software
+  # distributed under the License is distributed on an "AS IS" BASIS,
+  # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  # See the License for the specific language governing permissions and
+  # limitations under the License.
+  ############################################################################*/
+
+/*!
+ * \file
+ * \brief Pre-computed signature store unit tests.
+ */
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "testhelper/epid_gtest-testhelper.h"
+
+extern "C" {
+#include "epid/member/api.h"
+#include "epid/verifier.h"
+}
+
+#include "member-testhelper.h"
+#include "testhelper/errors-testhelper.h"
+#include "testhelper/prng-testhelper.h"
+#include "testhelper/verifier_wrapper-testhelper.h"
+
+namespace {
+
+///////////////////////////////////////////////////////////////////////
+// EpidGetPreSigStoreSize
+TEST_F(EpidMemberTest, GetPreSigStoreSizeFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t store_size = 0;
+
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigStoreSize(nullptr, 1, &store_size));
+  EXPECT_EQ(kEpidBadArgErr, EpidGetPreSigStoreSize(member, 1, nullptr));
+}
+
+TEST_F(EpidMemberTest, GetPreSigStoreSizeGrowsWithNumberOfPreSigs) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t empty_size = 0;
+  size_t one_size = 0;
+
+  EXPECT_EQ(kEpidNoErr, EpidGetPreSigStoreSize(member, 0, &empty_size));
+  EXPECT_EQ(kEpidNoErr, EpidGetPreSigStoreSize(member, 1, &one_size));
+  EXPECT_LT(empty_size, one_size);
+}
+
+TEST_F(EpidMemberTest, GetPreSigStoreSizeFailsGivenTooManyPreSigs) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t store_size = 0;
+
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidGetPreSigStoreSize(member, (size_t)-1, &store_size));
+  EXPECT_EQ((size_t)0, store_size);
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidExportPreSigs
+TEST_F(EpidMemberTest, ExportPreSigsFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  std::vector<uint8_t> store(1024);
+
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidExportPreSigs(nullptr, store.data(), store.size()));
+  EXPECT_EQ(kEpidBadArgErr, EpidExportPreSigs(member, nullptr, store.size()));
+}
+
+TEST_F(EpidMemberTest, ExportPreSigsFailsGivenTooSmallStore) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t store_size = 0;
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(EpidGetPreSigStoreSize(member, 1, &store_size));
+  std::vector<uint8_t> store(store_size - 1);
+
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidExportPreSigs(member, store.data(), store.size()));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, ExportPreSigsEmptiesPool) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t store_size = 0;
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(EpidGetPreSigStoreSize(member, 1, &store_size));
+  std::vector<uint8_t> store(store_size);
+
+  EXPECT_EQ(kEpidNoErr, EpidExportPreSigs(member, store.data(), store.size()));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, ExportPreSigsDoesNotRevealPreSigs) {
+  const size_t kWindow = 16;
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t buffer_size = 0;
+  size_t store_size = 0;
+  THROW_ON_EPIDERR(EpidGetPreSigBufferSize(member, 1, &buffer_size));
+  std::vector<uint64_t> buffer(buffer_size / sizeof(uint64_t) + 1);
+  THROW_ON_EPIDERR(
+      EpidMemberSetPreSigBuffer(member, buffer.data(), buffer_size));
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  uint8_t const* pool = reinterpret_cast<uint8_t const*>(buffer.data());
+  std::vector<uint8_t> presig(pool, pool + buffer_size);
+  THROW_ON_EPIDERR(EpidGetPreSigStoreSize(member, 1, &store_size));
+  std::vector<uint8_t> store(store_size);
+
+  ASSERT_EQ(kEpidNoErr, EpidExportPreSigs(member, store.data(), store.size()));
+  ASSERT_GE(presig.size(), kWindow);
+  for (size_t i = 0; i + kWindow <= presig.size(); i++) {
+    auto window = presig.begin() + i;
+    if (std::all_of(window, window + kWindow,
+                    [](uint8_t byte) { return 0 == byte; })) {
+      continue;
+    }
+    EXPECT_EQ(store.end(), std::search(store.begin(), store.end(), window,
+                                       window + kWindow))
+        << "pre-computed signature bytes " << i << " to " << i + kWindow
+        << " found in store";
+  }
+}
+
+///////////////////////////////////////////////////////////////////////
+// EpidImportPreSigs
+TEST_F(EpidMemberTest, ImportPreSigsFailsGivenNullPointer) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  std::vector<uint8_t> store(1024);
+
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidImportPreSigs(nullptr, store.data(), store.size()));
+  EXPECT_EQ(kEpidBadArgErr, EpidImportPreSigs(member, nullptr, store.size()));
+}
+
+TEST_F(EpidMemberTest, ImportPreSigsRestoresExportedPreSigs) {
+  Prng my_prng;
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  size_t store_size = 0;
+  std::vector<uint8_t> store;
+  {
+    MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                        this->kMemberPrecomp, &Prng::Generate, &my_prng);
+    THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+    THROW_ON_EPIDERR(EpidGetPreSigStoreSize(member, 1, &store_size));
+    store.resize(store_size);
+    THROW_ON_EPIDERR(EpidExportPreSigs(member, store.data(), store.size()));
+  }
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  EXPECT_EQ(kEpidNoErr, EpidImportPreSigs(member, store.data(), store.size()));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+  EXPECT_EQ(kEpidNoErr,
+            EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+  VerifierCtxObj ctx(this->kGroupPublicKey);
+  EXPECT_EQ(kEpidSigValid,
+            EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
+}
+
+TEST_F(EpidMemberTest, ImportPreSigsRestoresStoreAtUnalignedAddress) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t store_size = 0;
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(EpidGetPreSigStoreSize(member, 1, &store_size));
+  std::vector<uint8_t> buffer(store_size + 1);
+  uint8_t* store = buffer.data() + 1;
+  THROW_ON_EPIDERR(EpidExportPreSigs(member, store, store_size));
+
+  EXPECT_EQ(kEpidNoErr, EpidImportPreSigs(member, store, store_size));
+  EXPECT_EQ((size_t)1, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, ImportPreSigsNeverImportsEntryTwice) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t store_size = 0;
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(EpidGetPreSigStoreSize(member, 1, &store_size));
+  std::vector<uint8_t> store(store_size);
+  THROW_ON_EPIDERR(EpidExportPreSigs(member, store.data(), store.size()));
+  THROW_ON_EPIDERR(EpidImportPreSigs(member, store.data(), store.size()));
+  MemberCtxObj restarted(this->kGroupPublicKey, this->kMemberPrivateKey,
+                         this->kMemberPrecomp, &Prng::Generate, &my_prng);
+
+  EXPECT_EQ(kEpidNoErr,
+            EpidImportPreSigs(restarted, store.data(), store.size()));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(restarted));
+}
+
+TEST_F(EpidMemberTest, ImportPreSigsSkipsTamperedEntry) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t store_size = 0;
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(EpidGetPreSigStoreSize(member, 1, &store_size));
+  std::vector<uint8_t> store(store_size);
+  THROW_ON_EPIDERR(EpidExportPreSigs(member, store.data(), store.size()));
+  store.back() ^= 0x01;
+
+  EXPECT_EQ(kEpidNoErr, EpidImportPreSigs(member, store.data(), store.size()));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+}
+
+TEST_F(EpidMemberTest, ImportPreSigsFailsGivenStoreOfUnknownFormat) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  size_t store_size = 0;
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 1));
+  THROW_ON_EPIDERR(EpidGetPreSigStoreSize(member, 1, &store_size));
+  std::vector<uint8_t> store(store_size);
+  THROW_ON_EPIDERR(EpidExportPreSigs(member, store.data(), store.size()));
+  store.front() ^= 0x01;
+
+  EXPECT_EQ(kEpidSchemaNotSupportedErr,
+            EpidImportPreSigs(member, store.data(), store.size()));
+  EXPECT_EQ((size_t)0, EpidGetNumPreSigs(member));
+}
+
+}  // namespace
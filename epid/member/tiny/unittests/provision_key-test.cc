@@ -285,4 +285,14 @@ TEST_F(EpidMemberTest, CanProvisionAfterCreatingJoinRequestForDifferentGroup) {
   EXPECT_EQ(kEpidSigValid,
             EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
 }
+//////////////////////////////////////////////////////////////////////////
+// EpidPrepareProvisionKeys
+TEST_F(EpidMemberTest, PrepareProvisionKeysIsNotSupported) {
+  GroupPubKey pub_key = this->kGroupPublicKey;
+  PrivKey priv_key = this->kMemberPrivateKey;
+  MemberPrecomp precomp;
+  EpidStatus result;
+  EXPECT_EQ(kEpidOperationNotSupportedErr,
+            EpidPrepareProvisionKeys(&pub_key, &priv_key, 1, &precomp, &result));
+}
 }  // namespace
@@ -30,6 +30,7 @@ extern "C" {
 
 #include "member-testhelper.h"
 #include "testhelper/errors-testhelper.h"
+#include "testhelper/mem_params-testhelper.h"
 #include "testhelper/prng-testhelper.h"
 #include "testhelper/verifier_wrapper-testhelper.h"
 namespace {
@@ -872,6 +873,59 @@ TEST_F(EpidMemberTest, SignsMessageWithPrecomputedSignaturesNoSigRl) {
             EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
 }
 
+TEST_F(EpidMemberTest, SignsMessageWithPrecomputedSignaturesGivenPreSigTable) {
+  Prng my_prng;
+  MemberParams params = {0};
+  SetMemberParams(&Prng::Generate, &my_prng, &this->kMemberPrivateKey.f,
+                  &params);
+  params.max_precomp_sig = 2;
+  THROW_ON_EPIDERR(EpidMemberSetPreSigMultiExpTable(1, &params));
+  THROW_ON_EPIDERR(EpidMemberSetFixedBaseCombTeeth(5, &params));
+  MemberCtxObj member(&params);
+  THROW_ON_EPIDERR(EpidProvisionKey(member, &this->kGroupPublicKey,
+                                    &this->kMemberPrivateKey,
+                                    &this->kMemberPrecomp));
+  THROW_ON_EPIDERR(EpidMemberStartup(member));
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 2));
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  VerifierCtxObj ctx(this->kGroupPublicKey);
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(kEpidNoErr, EpidSign(member, msg.data(), msg.size(), nullptr, 0,
+                                   sig, sig_len));
+    EXPECT_EQ(kEpidSigValid,
+              EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
+  }
+}
+
+TEST_F(EpidMemberTest, SignsMessageWithPrecomputedSignaturesGivenCombTable) {
+  Prng my_prng;
+  MemberParams params = {0};
+  SetMemberParams(&Prng::Generate, &my_prng, &this->kMemberPrivateKey.f,
+                  &params);
+  params.max_precomp_sig = 2;
+  THROW_ON_EPIDERR(EpidMemberSetFixedBaseCombTeeth(5, &params));
+  MemberCtxObj member(&params);
+  THROW_ON_EPIDERR(EpidProvisionKey(member, &this->kGroupPublicKey,
+                                    &this->kMemberPrivateKey,
+                                    &this->kMemberPrecomp));
+  THROW_ON_EPIDERR(EpidMemberStartup(member));
+  THROW_ON_EPIDERR(EpidAddPreSigs(member, 2));
+  auto& msg = this->kMsg0;
+  std::vector<uint8_t> sig_data(EpidGetSigSize(nullptr));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  VerifierCtxObj ctx(this->kGroupPublicKey);
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(kEpidNoErr, EpidSign(member, msg.data(), msg.size(), nullptr, 0,
+                                   sig, sig_len));
+    EXPECT_EQ(kEpidSigValid,
+              EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
+  }
+}
+
 TEST_F(EpidMemberTest, SignsMessageWithPrecomputedSignaturesWithSigRl) {
   Prng my_prng;
   MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
@@ -1091,4 +1145,283 @@ TEST_F(EpidMemberTest, SignsMsgContainingAllPossibleBytesNoSigRl) {
             EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
 }
 
+/////////////////////////////////////////////////////////////////////////
+// EpidMemberSetParallelFor
+
+/// Runs the iterations in reverse order and counts the loops
+struct ReverseLoop {
+  size_t loops = 0;
+  size_t iterations = 0;
+  static EpidStatus __STDCALL Run(ParallelTask task, void* task_param,
+                                  size_t count, void* user_data) {
+    ReverseLoop* loop = static_cast<ReverseLoop*>(user_data);
+    EpidStatus result = kEpidNoErr;
+    loop->loops++;
+    for (size_t i = count; i > 0; i--) {
+      EpidStatus sts = task(task_param, i - 1);
+      loop->iterations++;
+      if (kEpidNoErr != sts) {
+        result = sts;
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(EpidMemberTest, SetParallelForFailsGivenNullContext) {
+  ReverseLoop loop;
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidMemberSetParallelFor(nullptr, &ReverseLoop::Run, &loop));
+}
+
+TEST_F(EpidMemberTest, SignsMessageWithSigRlUsingParallelFor) {
+  Prng my_prng;
+  ReverseLoop loop;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  SigRl const* srl =
+      reinterpret_cast<SigRl const*>(this->kSigRl5EntryData.data());
+  size_t srl_size = this->kSigRl5EntryData.size() * sizeof(uint8_t);
+  std::vector<uint8_t> sig_data(EpidGetSigSize(srl));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member, srl, srl_size));
+  THROW_ON_EPIDERR(
+      EpidMemberSetParallelFor(member, &ReverseLoop::Run, &loop));
+  EXPECT_EQ(kEpidNoErr,
+            EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+  EXPECT_EQ((size_t)1, loop.loops);
+  EXPECT_EQ((size_t)5, loop.iterations);
+  VerifierCtxObj ctx(this->kGroupPublicKey);
+  THROW_ON_EPIDERR(EpidVerifierSetSigRl(ctx, srl, srl_size));
+  EXPECT_EQ(kEpidSigValid,
+            EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
+}
+
+TEST_F(EpidMemberTest, SignUsingParallelForReportsIfMemberRevoked) {
+  auto& pub_key = this->kGrpXKey;
+  auto& priv_key = this->kGrpXMember0PrivKey;
+  auto& msg = this->kMsg0;
+  Prng my_prng;
+  ReverseLoop loop;
+  MemberCtxObj member(pub_key, priv_key, &Prng::Generate, &my_prng);
+  const std::vector<uint8_t> kGrpXSigRlMember0Sha512Rndbase0Msg0MiddleEntry = {
+#include "testhelper/testdata/grp_x/sigrl_member0_sig_sha512_rndbase_msg0_revoked_middle_entry.inc"
+  };
+  auto srl = reinterpret_cast<SigRl const*>(
+      kGrpXSigRlMember0Sha512Rndbase0Msg0MiddleEntry.data());
+  size_t srl_size = kGrpXSigRlMember0Sha512Rndbase0Msg0MiddleEntry.size();
+
+  std::vector<uint8_t> sig_data(EpidGetSigSize(srl));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  size_t sig_len = sig_data.size() * sizeof(uint8_t);
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member, srl, srl_size));
+  THROW_ON_EPIDERR(
+      EpidMemberSetParallelFor(member, &ReverseLoop::Run, &loop));
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidSign(member, msg.data(), msg.size(), nullptr, 0, sig, sig_len));
+  EXPECT_EQ((size_t)1, loop.loops);
+
+  VerifierCtxObj ctx(pub_key);
+  THROW_ON_EPIDERR(EpidVerifierSetSigRl(ctx, srl, srl_size));
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidVerify(ctx, sig, sig_len, msg.data(), msg.size()));
+}
+
+/// Makes a SigRl entry invalid, its non-revoked proof cannot be computed
+void CorruptSigRlEntry(std::vector<uint8_t>* sig_rl_data, uint32_t entry) {
+  SigRl* sig_rl = reinterpret_cast<SigRl*>(sig_rl_data->data());
+  // (0, 0) is not on the curve
+  memset(&sig_rl->bk[entry].b, 0, sizeof(sig_rl->bk[entry].b));
+}
+
+TEST_F(EpidMemberTest, SignReportsErrorBeforeRevocation) {
+  auto& pub_key = this->kGrpXKey;
+  auto& priv_key = this->kGrpXMember0PrivKey;
+  auto& msg = this->kMsg0;
+  Prng my_prng;
+  MemberCtxObj member(pub_key, priv_key, &Prng::Generate, &my_prng);
+  std::vector<uint8_t> srl_data = {
+#include "testhelper/testdata/grp_x/sigrl_member0_sig_sha512_rndbase_msg0_revoked_middle_entry.inc"
+  };
+  // the revoked entry comes after the broken one
+  CorruptSigRlEntry(&srl_data, 0);
+  auto srl = reinterpret_cast<SigRl const*>(srl_data.data());
+  std::vector<uint8_t> sig_data(EpidGetSigSize(srl));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member, srl, srl_data.size()));
+  EXPECT_EQ(kEpidBadArgErr, EpidSign(member, msg.data(), msg.size(), nullptr,
+                                     0, sig, sig_data.size()));
+}
+
+TEST_F(EpidMemberTest, SignUsingParallelForReportsErrorBeforeRevocation) {
+  auto& pub_key = this->kGrpXKey;
+  auto& priv_key = this->kGrpXMember0PrivKey;
+  auto& msg = this->kMsg0;
+  Prng my_prng;
+  ReverseLoop loop;
+  MemberCtxObj member(pub_key, priv_key, &Prng::Generate, &my_prng);
+  std::vector<uint8_t> srl_data = {
+#include "testhelper/testdata/grp_x/sigrl_member0_sig_sha512_rndbase_msg0_revoked_middle_entry.inc"
+  };
+  auto srl = reinterpret_cast<SigRl const*>(srl_data.data());
+  uint32_t n2 = (uint32_t)((srl_data.size() + sizeof(SigRlEntry) -
+                            sizeof(SigRl)) /
+                           sizeof(SigRlEntry));
+  // the loop runs backwards, so the broken last entry is computed before
+  // the revoked one and its status is not the last one seen
+  CorruptSigRlEntry(&srl_data, n2 - 1);
+  std::vector<uint8_t> sig_data(EpidGetSigSize(srl));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member, srl, srl_data.size()));
+  THROW_ON_EPIDERR(
+      EpidMemberSetParallelFor(member, &ReverseLoop::Run, &loop));
+  EXPECT_EQ(kEpidBadArgErr, EpidSign(member, msg.data(), msg.size(), nullptr,
+                                     0, sig, sig_data.size()));
+  EXPECT_EQ((size_t)n2, loop.iterations);
+}
+
+TEST_F(EpidMemberTest, SignUsingParallelForRunsLongSigRlInBoundedLoops) {
+  Prng my_prng;
+  ReverseLoop loop;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  SigRl const* srl =
+      reinterpret_cast<SigRl const*>(this->kSigRl5EntryData.data());
+  const uint32_t kEntries = 70;
+  std::vector<uint8_t> srl_data(sizeof(SigRl) +
+                                (kEntries - 1) * sizeof(SigRlEntry));
+  SigRl* long_srl = reinterpret_cast<SigRl*>(srl_data.data());
+  long_srl->gid = srl->gid;
+  long_srl->version = srl->version;
+  long_srl->n2.data[3] = (uint8_t)kEntries;
+  for (uint32_t i = 0; i < kEntries; i++) {
+    long_srl->bk[i] = srl->bk[i % 5];
+  }
+  std::vector<uint8_t> sig_data(EpidGetSigSize(long_srl));
+  EpidSignature* sig = reinterpret_cast<EpidSignature*>(sig_data.data());
+  THROW_ON_EPIDERR(
+      EpidMemberSetSigRlByReference(member, long_srl, srl_data.size()));
+  THROW_ON_EPIDERR(
+      EpidMemberSetParallelFor(member, &ReverseLoop::Run, &loop));
+  EXPECT_EQ(kEpidNoErr, EpidSign(member, msg.data(), msg.size(), nullptr, 0,
+                                 sig, sig_data.size()));
+  EXPECT_EQ((size_t)3, loop.loops);
+  EXPECT_EQ((size_t)kEntries, loop.iterations);
+  VerifierCtxObj ctx(this->kGroupPublicKey);
+  THROW_ON_EPIDERR(
+      EpidVerifierSetSigRl(ctx, long_srl, srl_data.size()));
+  EXPECT_EQ(kEpidSigValid, EpidVerify(ctx, sig, sig_data.size(), msg.data(),
+                                      msg.size()));
+}
+
+/////////////////////////////////////////////////////////////////////////
+// EpidSignStream
+
+/// Collects the pieces of a streamed signature
+struct SigCollector {
+  std::vector<uint8_t> sig;
+  size_t pieces = 0;
+  size_t max_pieces = (size_t)-1;
+  static EpidStatus __STDCALL Write(void const* data, size_t data_len,
+                                    void* user_data) {
+    SigCollector* collector = static_cast<SigCollector*>(user_data);
+    if (collector->pieces >= collector->max_pieces) {
+      return kEpidErr;
+    }
+    collector->pieces++;
+    auto bytes = static_cast<uint8_t const*>(data);
+    collector->sig.insert(collector->sig.end(), bytes, bytes + data_len);
+    return kEpidNoErr;
+  }
+};
+
+TEST_F(EpidMemberTest, SignStreamFailsGivenNullParameters) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  auto& bsn = this->kBsn0;
+  SigCollector collector;
+  THROW_ON_EPIDERR(EpidRegisterBasename(member, bsn.data(), bsn.size()));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidSignStream(nullptr, msg.data(), msg.size(), bsn.data(),
+                           bsn.size(), &SigCollector::Write, &collector));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidSignStream(member, nullptr, msg.size(), bsn.data(), bsn.size(),
+                           &SigCollector::Write, &collector));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidSignStream(member, msg.data(), msg.size(), nullptr, bsn.size(),
+                           &SigCollector::Write, &collector));
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidSignStream(member, msg.data(), msg.size(), bsn.data(),
+                           bsn.size(), nullptr, &collector));
+  EXPECT_EQ((size_t)0, collector.pieces);
+}
+
+TEST_F(EpidMemberTest, SignStreamWritesProofsOneAtATime) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  SigRl const* srl =
+      reinterpret_cast<SigRl const*>(this->kSigRl5EntryData.data());
+  size_t srl_size = this->kSigRl5EntryData.size() * sizeof(uint8_t);
+  SigCollector collector;
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member, srl, srl_size));
+  EXPECT_EQ(kEpidNoErr, EpidSignStream(member, msg.data(), msg.size(), nullptr,
+                                       0, &SigCollector::Write, &collector));
+  EXPECT_EQ((size_t)6, collector.pieces);
+  ASSERT_EQ(EpidGetSigSize(srl), collector.sig.size());
+  VerifierCtxObj ctx(this->kGroupPublicKey);
+  THROW_ON_EPIDERR(EpidVerifierSetSigRl(ctx, srl, srl_size));
+  EXPECT_EQ(kEpidSigValid,
+            EpidVerify(ctx, (EpidSignature*)collector.sig.data(),
+                       collector.sig.size(), msg.data(), msg.size()));
+}
+
+TEST_F(EpidMemberTest, SignStreamReportsIfMemberRevoked) {
+  auto& pub_key = this->kGrpXKey;
+  auto& priv_key = this->kGrpXMember0PrivKey;
+  auto& msg = this->kMsg0;
+  Prng my_prng;
+  MemberCtxObj member(pub_key, priv_key, &Prng::Generate, &my_prng);
+  const std::vector<uint8_t> kGrpXSigRlMember0Sha512Rndbase0Msg0MiddleEntry = {
+#include "testhelper/testdata/grp_x/sigrl_member0_sig_sha512_rndbase_msg0_revoked_middle_entry.inc"
+  };
+  auto srl = reinterpret_cast<SigRl const*>(
+      kGrpXSigRlMember0Sha512Rndbase0Msg0MiddleEntry.data());
+  size_t srl_size = kGrpXSigRlMember0Sha512Rndbase0Msg0MiddleEntry.size();
+  SigCollector collector;
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member, srl, srl_size));
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidSignStream(member, msg.data(), msg.size(), nullptr, 0,
+                           &SigCollector::Write, &collector));
+  ASSERT_EQ(EpidGetSigSize(srl), collector.sig.size());
+
+  VerifierCtxObj ctx(pub_key);
+  THROW_ON_EPIDERR(EpidVerifierSetSigRl(ctx, srl, srl_size));
+  EXPECT_EQ(kEpidSigRevokedInSigRl,
+            EpidVerify(ctx, (EpidSignature*)collector.sig.data(),
+                       collector.sig.size(), msg.data(), msg.size()));
+}
+
+TEST_F(EpidMemberTest, SignStreamStopsIfSinkFails) {
+  Prng my_prng;
+  MemberCtxObj member(this->kGroupPublicKey, this->kMemberPrivateKey,
+                      this->kMemberPrecomp, &Prng::Generate, &my_prng);
+  auto& msg = this->kMsg0;
+  SigRl const* srl =
+      reinterpret_cast<SigRl const*>(this->kSigRl5EntryData.data());
+  size_t srl_size = this->kSigRl5EntryData.size() * sizeof(uint8_t);
+  SigCollector collector;
+  collector.max_pieces = 2;
+  THROW_ON_EPIDERR(EpidMemberSetSigRl(member, srl, srl_size));
+  EXPECT_EQ(kEpidErr, EpidSignStream(member, msg.data(), msg.size(), nullptr,
+                                     0, &SigCollector::Write, &collector));
+  EXPECT_EQ((size_t)2, collector.pieces);
+}
+
 }  // namespace
@@ -24,6 +24,17 @@
 #include "ippmath/ecgroup.h"
 #include "ippmath/finitefield.h"
 
+/// Number of basename hashes remembered by a verifier context
+#define EPID_VERIFIER_BASENAME_CACHE_SIZE 16
+
+/// Basename and its hash remembered by a verifier context
+typedef struct BasenameCacheEntry {
+  uint8_t* basename;    ///< Basename (NULL = unused entry)
+  size_t basename_len;  ///< Number of bytes in basename
+  HashAlg hash_alg;     ///< Hash algorithm used to hash the basename
+  G1ElemStr hash;       ///< EcHash of the basename
+} BasenameCacheEntry;
+
 /// Verifier context definition
 struct VerifierCtx {
   GroupPubKey_* pub_key;  ///< group public key
@@ -43,5 +54,8 @@ struct VerifierCtx {
   EcPoint* basename_hash;      ///< EcHash of the basename (NULL = random base)
   uint8_t* basename;           ///< Basename to use
   size_t basename_len;         ///< Number of bytes in basename
+  /// Recently used basenames and their hashes
+  BasenameCacheEntry basename_cache[EPID_VERIFIER_BASENAME_CACHE_SIZE];
+  size_t basename_cache_next;  ///< Next basename cache entry to replace
 };
 #endif  // EPID_VERIFIER_SRC_CONTEXT_H_
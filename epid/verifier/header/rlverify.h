@@ -26,6 +26,7 @@ typedef struct VerifierCtx VerifierCtx;
 typedef struct BasicSignature BasicSignature;
 typedef struct SigRlEntry SigRlEntry;
 typedef struct FpElemStr FpElemStr;
+typedef struct ExpWorkspace ExpWorkspace;
 /// \endcond
 
 /// Verifies the non-revoked proof for a single signature based revocation list
@@ -73,6 +74,41 @@ EpidStatus EpidNrVerify(VerifierCtx const* ctx, BasicSignature const* sig,
                         SigRlEntry const* sigrl_entry, void const* nr_proof,
                         size_t nr_proof_len);
 
+/// Verifies a non-revoked proof using an exponentiation workspace.
+/*!
+ Same as EpidNrVerify(), but takes its temporary exponentiation state from
+ ws, so that the proofs of a signature can be verified without allocating
+ it for each SigRl entry.
+
+ \param[in] ctx
+ The verifier context.
+ \param[in] sig
+ The basic signature.
+ \param[in] msg
+ The message that was signed.
+ \param[in] msg_len
+ The size of msg in bytes.
+ \param[in] sigrl_entry
+ The signature based revocation list entry.
+ \param[in] nr_proof
+ The non-revoked proof.
+ \param[in] nr_proof_len
+ The size of non-revoked proof in bytes.
+ \param[in,out] ws
+ Workspace for multi-exponentiations of up to 3 bases.
+
+ \returns ::EpidStatus
+
+ \see EpidNrVerify
+ \see NewExpWorkspace
+ */
+EpidStatus EpidNrVerifyWithWorkspace(VerifierCtx const* ctx,
+                                     BasicSignature const* sig,
+                                     void const* msg, size_t msg_len,
+                                     SigRlEntry const* sigrl_entry,
+                                     void const* nr_proof, size_t nr_proof_len,
+                                     ExpWorkspace* ws);
+
 /// Verifies a signature has not been revoked in the private key based
 /// revocation list.
 /*!
@@ -25,6 +25,7 @@
 typedef struct VerifierCtx VerifierCtx;
 typedef struct BasicSignature BasicSignature;
 typedef struct FpElemStr FpElemStr;
+typedef struct ExpWorkspace ExpWorkspace;
 /// \endcond
 
 /// Verifies a member signature without revocation checks.
@@ -93,4 +94,35 @@ EpidStatus EpidVerifyBasicSplitSig(VerifierCtx const* ctx,
                                    FpElemStr const* nk, void const* msg,
                                    size_t msg_len);
 
+/// Verifies a basic signature using an exponentiation workspace.
+/*!
+Same as EpidVerifyBasicSplitSig(), but takes its temporary exponentiation
+state from ws, which can then be reused by the revocation checks of the
+same signature.
+
+\param[in] ctx
+The verifier context.
+\param[in] sig
+The basic signature.
+\param[in] nk
+Split signature nonce. If NULL verify sig as non-split signature.
+\param[in] msg
+The message that was signed.
+\param[in] msg_len
+The size of msg in bytes.
+\param[in,out] ws
+Workspace for multi-exponentiations of up to 4 bases.
+
+\returns ::EpidStatus
+
+\see EpidVerifyBasicSplitSig
+\see NewExpWorkspace
+*/
+EpidStatus EpidVerifyBasicSplitSigWithWorkspace(VerifierCtx const* ctx,
+                                                BasicSignature const* sig,
+                                                FpElemStr const* nk,
+                                                void const* msg,
+                                                size_t msg_len,
+                                                ExpWorkspace* ws);
+
 #endif  // EPID_VERIFIER_SRC_VERIFYBASIC_H_
@@ -433,6 +433,10 @@ EpidStatus EPID_VERIFIER_API EpidVerifierSetHashAlg(VerifierCtx* ctx,
 /// Sets the basename to be used by a verifier.
 /*!
 
+  The verifier remembers the hashes of the most recently used basenames,
+  so switching back and forth between a small set of basenames does not
+  require hashing them again.
+
   \note
   A successful call to this function will clear the current verifier
   blacklist.
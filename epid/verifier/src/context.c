@@ -49,6 +49,68 @@ static EpidStatus DoPrecomputation(VerifierCtx* ctx);
 static EpidStatus ReadPrecomputation(VerifierPrecomp const* precomp_str,
                                      VerifierCtx* ctx);
 
+/// Forget all basenames remembered by the verifier
+static void ClearBasenameCache(VerifierCtx* ctx) {
+  size_t i = 0;
+  for (i = 0; i < EPID_VERIFIER_BASENAME_CACHE_SIZE; i++) {
+    SAFE_FREE(ctx->basename_cache[i].basename);
+    ctx->basename_cache[i].basename_len = 0;
+  }
+  ctx->basename_cache_next = 0;
+}
+
+/// Look up the hash of a basename remembered by the verifier
+static BasenameCacheEntry const* FindCachedBasename(VerifierCtx const* ctx,
+                                                    void const* basename,
+                                                    size_t basename_len,
+                                                    HashAlg hash_alg) {
+  size_t i = 0;
+  for (i = 0; i < EPID_VERIFIER_BASENAME_CACHE_SIZE; i++) {
+    BasenameCacheEntry const* entry = &ctx->basename_cache[i];
+    if (entry->basename && entry->hash_alg == hash_alg &&
+        entry->basename_len == basename_len &&
+        (0 == basename_len ||
+         0 == memcmp(entry->basename, basename, basename_len))) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+/// Remember the hash of a basename, replacing the oldest entry if full
+static EpidStatus CacheBasename(VerifierCtx* ctx, void const* basename,
+                                size_t basename_len, HashAlg hash_alg,
+                                EcPoint const* basename_hash) {
+  EpidStatus sts = kEpidErr;
+  BasenameCacheEntry* entry = &ctx->basename_cache[ctx->basename_cache_next];
+  // keep room for a non-NULL pointer to an empty basename
+  uint8_t* buffer = SAFE_ALLOC(basename_len > 0 ? basename_len : 1);
+  if (!buffer) {
+    return kEpidMemAllocErr;
+  }
+  sts = WriteEcPoint(ctx->epid2_params->G1, basename_hash, &entry->hash,
+                     sizeof(entry->hash));
+  if (kEpidNoErr != sts) {
+    SAFE_FREE(buffer);
+    SAFE_FREE(entry->basename);
+    return sts;
+  }
+  if (basename_len > 0) {
+    if (0 != memcpy_S(buffer, basename_len, basename, basename_len)) {
+      SAFE_FREE(buffer);
+      SAFE_FREE(entry->basename);
+      return kEpidErr;
+    }
+  }
+  SAFE_FREE(entry->basename);
+  entry->basename = buffer;
+  entry->basename_len = basename_len;
+  entry->hash_alg = hash_alg;
+  ctx->basename_cache_next =
+      (ctx->basename_cache_next + 1) % EPID_VERIFIER_BASENAME_CACHE_SIZE;
+  return kEpidNoErr;
+}
+
 /// Internal function to prove if group based revocation list is valid
 static bool IsGroupRlValid(GroupRl const* group_rl, size_t grp_rl_size) {
   const size_t kMinGroupRlSize = sizeof(GroupRl) - sizeof(GroupId);
@@ -187,6 +249,9 @@ EpidStatus EPID_VERIFIER_API EpidVerifierInit(GroupRl const* grp_rl,
     return kEpidBadCtxErr;
   }
 
+  memset(ctx->basename_cache, 0, sizeof(ctx->basename_cache));
+  ctx->basename_cache_next = 0;
+
   do {
     // Internal representation of Epid2Params
     sts = CreateEpid2Params(&ctx->epid2_params);
@@ -253,6 +318,8 @@ void EPID_VERIFIER_API EpidVerifierDeinit(VerifierCtx* ctx) {
   DeleteEcPoint(&ctx->basename_hash);
   SAFE_FREE(ctx->basename);
   ctx->basename_len = 0;
+
+  ClearBasenameCache(ctx);
 }
 
 EpidStatus EPID_VERIFIER_API EpidVerifierCreate(GroupPubKey const* pubkey,
@@ -698,15 +765,30 @@ EpidStatus EPID_VERIFIER_API EpidVerifierSetBasename(VerifierCtx* ctx,
   do {
     size_t i = 0;
     EcGroup* G1 = ctx->epid2_params->G1;
+    BasenameCacheEntry const* cached = NULL;
     result = NewEcPoint(G1, &basename_hash);
     if (kEpidNoErr != result) {
       break;
     }
 
-    result =
-        EcHash(G1, basename, basename_len, ctx->hash_alg, basename_hash, NULL);
-    if (kEpidNoErr != result) {
-      break;
+    cached = FindCachedBasename(ctx, basename, basename_len, ctx->hash_alg);
+    if (cached) {
+      result = ReadEcPoint(G1, &cached->hash, sizeof(cached->hash),
+                           basename_hash);
+      if (kEpidNoErr != result) {
+        break;
+      }
+    } else {
+      result = EcHash(G1, basename, basename_len, ctx->hash_alg, basename_hash,
+                      NULL);
+      if (kEpidNoErr != result) {
+        break;
+      }
+      result = CacheBasename(ctx, basename, basename_len, ctx->hash_alg,
+                             basename_hash);
+      if (kEpidNoErr != result) {
+        break;
+      }
     }
 
     if (basename_len > 0) {
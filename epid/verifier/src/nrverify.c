@@ -18,8 +18,11 @@
 #define EXPORT_EPID_APIS
 #include "common/hashsize.h"
 #include "epid/verifier.h"
+#include "ippmath/ecglv.h"
+#include "ippmath/expworkspace.h"
 #include "ippmath/memory.h"
 #include "context.h"
+#include "rlverify.h"
 
 /// Handle SDK Error with Break
 #define BREAK_ON_EPID_ERROR(ret) \
@@ -56,12 +59,33 @@ typedef struct EpidNrVerifyCommitValuesNoncekDigest {
 } EpidNrVerifyCommitValuesNoncekDigest;
 #pragma pack()
 
+/// Number of bases of the largest multi-exponentiation of EpidNrVerify
+#define NR_VERIFY_MAX_BASES 3
+
 EpidStatus EPID_VERIFIER_API EpidNrVerify(VerifierCtx const* ctx,
                                           BasicSignature const* sig,
                                           void const* msg, size_t msg_len,
                                           SigRlEntry const* sigrl_entry,
                                           void const* nr_proof,
                                           size_t nr_proof_len) {
+  EpidStatus sts = kEpidErr;
+  ExpWorkspace* ws = NULL;
+  sts = NewExpWorkspace(NR_VERIFY_MAX_BASES, &ws);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  sts = EpidNrVerifyWithWorkspace(ctx, sig, msg, msg_len, sigrl_entry,
+                                  nr_proof, nr_proof_len, ws);
+  DeleteExpWorkspace(&ws);
+  return sts;
+}
+
+EpidStatus EpidNrVerifyWithWorkspace(VerifierCtx const* ctx,
+                                     BasicSignature const* sig,
+                                     void const* msg, size_t msg_len,
+                                     SigRlEntry const* sigrl_entry,
+                                     void const* nr_proof, size_t nr_proof_len,
+                                     ExpWorkspace* ws) {
   size_t const cv_header_len = sizeof(NrVerifyCommitValues) - sizeof(uint8_t);
   EpidStatus sts = kEpidErr;
   NrVerifyCommitValues* commit_values = NULL;
@@ -97,8 +121,12 @@ EpidStatus EPID_VERIFIER_API EpidNrVerify(VerifierCtx const* ctx,
                     nr_proof_len != sizeof(SplitNrProof))) {
     return kEpidBadNrProofErr;
   }
+  if (!ws) {
+    return kEpidBadArgErr;
+  }
   do {
     EcGroup* G1 = ctx->epid2_params->G1;
+    EcGlvState* G1_glv = ctx->epid2_params->G1_glv;
     FiniteField* Fp = ctx->epid2_params->Fp;
     G1ElemStr const* b = &sig->B;
     G1ElemStr const* k = &sig->K;
@@ -236,7 +264,8 @@ EpidStatus EPID_VERIFIER_API EpidNrVerify(VerifierCtx const* ctx,
     r1p[1] = b_pt;
     r1b[0] = &proof->smu;
     r1b[1] = &proof->snu;
-    sts = EcMultiExp(G1, r1p, (const BigNumStr**)r1b, 2, r1_pt);
+    sts = EcGlvMultiExpWithWorkspace(G1_glv, r1p, (const BigNumStr**)r1b, 2,
+                                     ws, r1_pt);
     BREAK_ON_EPID_ERROR(sts);
 
     // 6. The verifier computes R2 = G1.multiExp(K', smu, B', snu, T, nc).
@@ -256,7 +285,8 @@ EpidStatus EPID_VERIFIER_API EpidNrVerify(VerifierCtx const* ctx,
     r2b[0] = &proof->smu;
     r2b[1] = &proof->snu;
     r2b[2] = &nc_str;
-    sts = EcMultiExp(G1, r2p, (const BigNumStr**)r2b, 3, r2_pt);
+    sts = EcGlvMultiExpWithWorkspace(G1_glv, r2p, (const BigNumStr**)r2b, 3,
+                                     ws, r2_pt);
     BREAK_ON_EPID_ERROR(sts);
 
     // 7. The verifier verifies c = Fp.hash(p || g1 || B || K ||
@@ -21,6 +21,7 @@
 #include "common/endian_convert.h"
 #include "common/sig_types.h"
 #include "epid/verifier.h"
+#include "ippmath/expworkspace.h"
 #include "context.h"
 #include "rlverify.h"
 #include "verifybasic.h"
@@ -59,11 +60,14 @@ static size_t EpidGetVerifierRlCount(VerifierRl const* rl) {
     return ntohl(rl->n4);
 }
 
+/// Number of bases of the largest multi-exponentiation of a verify
+#define VERIFY_MAX_BASES 4
+
 // implements section 4.1.2 "Verify algorithm" from Intel(R) EPID 2.0 Spec
-EpidStatus EpidVerifyNonSplitSig(VerifierCtx const* ctx,
-                                 EpidNonSplitSignature const* sig,
-                                 size_t sig_len, void const* msg,
-                                 size_t msg_len) {
+static EpidStatus VerifyNonSplitSig(VerifierCtx const* ctx,
+                                    EpidNonSplitSignature const* sig,
+                                    size_t sig_len, void const* msg,
+                                    size_t msg_len, ExpWorkspace* ws) {
   // Step 1. Setup
   size_t const sig_header_len =
       (sizeof(EpidNonSplitSignature) - sizeof(NrProof));
@@ -89,7 +93,8 @@ EpidStatus EpidVerifyNonSplitSig(VerifierCtx const* ctx,
     return kEpidBadSignatureErr;
   }
   // Step 2. The verifier verifies the basic signature Sigma0 as follows:
-  sts = EpidVerifyBasicSig(ctx, &sig->sigma0, msg, msg_len);
+  sts = EpidVerifyBasicSplitSigWithWorkspace(ctx, &sig->sigma0, NULL, msg,
+                                             msg_len, ws);
   if (sts != kEpidNoErr) {
     // p. If any of the above verifications fails, the verifier aborts and
     // outputs 1
@@ -157,8 +162,9 @@ EpidStatus EpidVerifyNonSplitSig(VerifierCtx const* ctx,
     // K[i], Sigma[i]) = true. The details of nrVerify() will be given in the
     // next subsection.
     for (i = 0; i < sigrl_count; ++i) {
-      sts = EpidNrVerify(ctx, &sig->sigma0, msg, msg_len, &ctx->sig_rl->bk[i],
-                         &sig->sigma[i], sizeof(sig->sigma[i]));
+      sts = EpidNrVerifyWithWorkspace(ctx, &sig->sigma0, msg, msg_len,
+                                      &ctx->sig_rl->bk[i], &sig->sigma[i],
+                                      sizeof(sig->sigma[i]), ws);
       if (sts != kEpidNoErr) {
         // e. If the above step fails, the verifier aborts and output 4.
         return kEpidSigRevokedInSigRl;
@@ -195,9 +201,10 @@ EpidStatus EpidVerifyNonSplitSig(VerifierCtx const* ctx,
   return kEpidSigValid;
 }
 
-EpidStatus EpidVerifySplitSig(VerifierCtx const* ctx,
-                              EpidSplitSignature const* sig, size_t sig_len,
-                              void const* msg, size_t msg_len) {
+static EpidStatus VerifySplitSig(VerifierCtx const* ctx,
+                                 EpidSplitSignature const* sig, size_t sig_len,
+                                 void const* msg, size_t msg_len,
+                                 ExpWorkspace* ws) {
   // Step 1. Setup
   size_t const sig_header_len =
       (sizeof(EpidSplitSignature) - sizeof(SplitNrProof));
@@ -223,7 +230,8 @@ EpidStatus EpidVerifySplitSig(VerifierCtx const* ctx,
     return kEpidBadSignatureErr;
   }
   // Step 2. The verifier verifies the basic signature Sigma0 as follows:
-  sts = EpidVerifyBasicSplitSig(ctx, &sig->sigma0, &sig->nonce, msg, msg_len);
+  sts = EpidVerifyBasicSplitSigWithWorkspace(ctx, &sig->sigma0, &sig->nonce,
+                                             msg, msg_len, ws);
   if (sts != kEpidNoErr) {
     // p. If any of the above verifications fails, the verifier aborts and
     // outputs 1
@@ -292,8 +300,9 @@ EpidStatus EpidVerifySplitSig(VerifierCtx const* ctx,
     // K[i], Sigma[i]) = true. The details of nrVerify() will be given in the
     // next subsection.
     for (i = 0; i < sigrl_count; ++i) {
-      sts = EpidNrVerify(ctx, &sig->sigma0, msg, msg_len, &ctx->sig_rl->bk[i],
-                         &sig->sigma[i], sizeof(sig->sigma[i]));
+      sts = EpidNrVerifyWithWorkspace(ctx, &sig->sigma0, msg, msg_len,
+                                      &ctx->sig_rl->bk[i], &sig->sigma[i],
+                                      sizeof(sig->sigma[i]), ws);
       if (sts != kEpidNoErr) {
         // e. If the above step fails, the verifier aborts and output 4.
         return kEpidSigRevokedInSigRl;
@@ -330,6 +339,35 @@ EpidStatus EpidVerifySplitSig(VerifierCtx const* ctx,
   return kEpidSigValid;
 }
 
+EpidStatus EpidVerifyNonSplitSig(VerifierCtx const* ctx,
+                                 EpidNonSplitSignature const* sig,
+                                 size_t sig_len, void const* msg,
+                                 size_t msg_len) {
+  EpidStatus sts = kEpidErr;
+  ExpWorkspace* ws = NULL;
+  sts = NewExpWorkspace(VERIFY_MAX_BASES, &ws);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  sts = VerifyNonSplitSig(ctx, sig, sig_len, msg, msg_len, ws);
+  DeleteExpWorkspace(&ws);
+  return sts;
+}
+
+EpidStatus EpidVerifySplitSig(VerifierCtx const* ctx,
+                              EpidSplitSignature const* sig, size_t sig_len,
+                              void const* msg, size_t msg_len) {
+  EpidStatus sts = kEpidErr;
+  ExpWorkspace* ws = NULL;
+  sts = NewExpWorkspace(VERIFY_MAX_BASES, &ws);
+  if (kEpidNoErr != sts) {
+    return sts;
+  }
+  sts = VerifySplitSig(ctx, sig, sig_len, msg, msg_len, ws);
+  DeleteExpWorkspace(&ws);
+  return sts;
+}
+
 EpidStatus EPID_VERIFIER_API EpidVerify(VerifierCtx const* ctx, void const* sig,
                                         size_t sig_len, void const* msg,
                                         size_t msg_len) {
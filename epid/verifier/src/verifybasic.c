@@ -20,6 +20,8 @@
 #include "verifybasic.h"
 #include "common/hashsize.h"
 #include "epid/verifier.h"
+#include "ippmath/ecglv.h"
+#include "ippmath/expworkspace.h"
 #include "ippmath/memory.h"
 #include "ippmath/pairing.h"
 #include "context.h"
@@ -48,10 +50,30 @@ typedef struct VerifyBasicCommitValues {
 /// Count of elements in array
 #define COUNT_OF(A) (sizeof(A) / sizeof((A)[0]))
 
+/// Number of bases of the largest multi-exponentiation of a basic verify
+#define VERIFY_BASIC_MAX_BASES 4
+
 EpidStatus EpidVerifyBasicSplitSig(VerifierCtx const* ctx,
                                    BasicSignature const* sig,
                                    FpElemStr const* nk, void const* msg,
                                    size_t msg_len) {
+  EpidStatus res = kEpidErr;
+  ExpWorkspace* ws = NULL;
+  res = NewExpWorkspace(VERIFY_BASIC_MAX_BASES, &ws);
+  if (kEpidNoErr != res) {
+    return res;
+  }
+  res = EpidVerifyBasicSplitSigWithWorkspace(ctx, sig, nk, msg, msg_len, ws);
+  DeleteExpWorkspace(&ws);
+  return res;
+}
+
+EpidStatus EpidVerifyBasicSplitSigWithWorkspace(VerifierCtx const* ctx,
+                                                BasicSignature const* sig,
+                                                FpElemStr const* nk,
+                                                void const* msg,
+                                                size_t msg_len,
+                                                ExpWorkspace* ws) {
   EpidStatus res = kEpidNotImpl;
 
   EcPoint* B = NULL;
@@ -85,6 +107,9 @@ EpidStatus EpidVerifyBasicSplitSig(VerifierCtx const* ctx,
     // if message is non-empty it must have both length and content
     return kEpidBadMessageErr;
   }
+  if (!ws) {
+    return kEpidBadArgErr;
+  }
   do {
     bool cmp_result = false;
     BigNumStr c_str = {0};
@@ -98,6 +123,8 @@ EpidStatus EpidVerifyBasicSplitSig(VerifierCtx const* ctx,
     // handy shorthands:
     EcGroup* G1 = ctx->epid2_params->G1;
     EcGroup* G2 = ctx->epid2_params->G2;
+    EcGlvState* G1_glv = ctx->epid2_params->G1_glv;
+    EcGlvState* G2_glv = ctx->epid2_params->G2_glv;
     FiniteField* GT = ctx->epid2_params->GT;
     FiniteField* Fp = ctx->epid2_params->Fp;
     EcPoint* g1 = ctx->epid2_params->g1;
@@ -264,7 +291,8 @@ EpidStatus EpidVerifyBasicSplitSig(VerifierCtx const* ctx,
       points[1] = K;
       exponents[0] = &sf_str;
       exponents[1] = &nc_str;
-      res = EcMultiExp(G1, points, exponents, COUNT_OF(points), R1);
+      res = EcGlvMultiExpWithWorkspace(G1_glv, points, exponents,
+                                       COUNT_OF(points), ws, R1);
       BREAK_ON_EPID_ERROR(res);
     }
     //   j. The verifier computes t1 = G2.multiExp(g2, nsx, w, nc).
@@ -277,7 +305,8 @@ EpidStatus EpidVerifyBasicSplitSig(VerifierCtx const* ctx,
       points[1] = w;
       exponents[0] = &nsx_str;
       exponents[1] = &nc_str;
-      res = EcMultiExp(G2, points, exponents, COUNT_OF(points), t1);
+      res = EcGlvMultiExpWithWorkspace(G2_glv, points, exponents,
+                                       COUNT_OF(points), ws, t1);
       BREAK_ON_EPID_ERROR(res);
     }
     //   k. The verifier computes R2 = pairing(T, t1).
@@ -306,7 +335,8 @@ EpidStatus EpidVerifyBasicSplitSig(VerifierCtx const* ctx,
       exponents[1] = &sb_str;
       exponents[2] = &sa_str;
       exponents[3] = &c_str;
-      res = FfMultiExp(GT, points, exponents, COUNT_OF(points), t2);
+      res = FfMultiExpWithWorkspace(GT, points, exponents, COUNT_OF(points),
+                                    ws, t2);
       BREAK_ON_EPID_ERROR(res);
     }
     //   m. The verifier compute R2 = GT.mul(R2, t2).
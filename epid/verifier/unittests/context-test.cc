@@ -1149,6 +1149,132 @@ TEST_F(EpidVerifierTest, SetBasenameAcceptsBsnContainingAllPossibleBytes) {
             EpidVerifierSetBasename(ctx, basename.data(), basename.size()));
 }
 
+TEST_F(EpidVerifierTest, SetBasenameGivesSameHashWhenSwitchingBack) {
+  VerifierCtxObj verifier(this->kPubKeyStr, this->kVerifierPrecompStr);
+  VerifierCtx* ctx = verifier;
+  EcGroup* G1 = ctx->epid2_params->G1;
+  G1ElemStr first = {0};
+  G1ElemStr again = {0};
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                           this->kBasename.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &first, sizeof(first)));
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename1.data(),
+                                           this->kBasename1.size()));
+  EXPECT_EQ(kEpidNoErr, EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                                this->kBasename.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &again, sizeof(again)));
+  EXPECT_EQ(first, again);
+}
+
+TEST_F(EpidVerifierTest, SetBasenameGivesSameHashAfterManyOtherBasenames) {
+  VerifierCtxObj verifier(this->kPubKeyStr, this->kVerifierPrecompStr);
+  VerifierCtx* ctx = verifier;
+  EcGroup* G1 = ctx->epid2_params->G1;
+  G1ElemStr first = {0};
+  G1ElemStr again = {0};
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                           this->kBasename.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &first, sizeof(first)));
+  for (uint8_t i = 0; i < 2 * EPID_VERIFIER_BASENAME_CACHE_SIZE; i++) {
+    THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, &i, sizeof(i)));
+  }
+  EXPECT_EQ(kEpidNoErr, EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                                this->kBasename.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &again, sizeof(again)));
+  EXPECT_EQ(first, again);
+}
+
+/// Gets the basename cache entry remembering basename or nullptr
+BasenameCacheEntry* FindBasenameCacheEntry(VerifierCtx* ctx,
+                                           std::vector<uint8_t> const& bsn) {
+  for (size_t i = 0; i < EPID_VERIFIER_BASENAME_CACHE_SIZE; i++) {
+    BasenameCacheEntry* entry = &ctx->basename_cache[i];
+    if (entry->basename && entry->basename_len == bsn.size() &&
+        0 == memcmp(entry->basename, bsn.data(), bsn.size())) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+TEST_F(EpidVerifierTest, SetBasenameUsesRememberedHash) {
+  VerifierCtxObj verifier(this->kPubKeyStr, this->kVerifierPrecompStr);
+  VerifierCtx* ctx = verifier;
+  EcGroup* G1 = ctx->epid2_params->G1;
+  G1ElemStr other = {0};
+  G1ElemStr again = {0};
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename1.data(),
+                                           this->kBasename1.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &other, sizeof(other)));
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                           this->kBasename.size()));
+  BasenameCacheEntry* entry = FindBasenameCacheEntry(ctx, this->kBasename);
+  ASSERT_NE(nullptr, entry);
+  // a hash that is not taken from the cache would not match this one
+  entry->hash = other;
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename1.data(),
+                                           this->kBasename1.size()));
+  EXPECT_EQ(kEpidNoErr, EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                                this->kBasename.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &again, sizeof(again)));
+  EXPECT_EQ(other, again);
+}
+
+TEST_F(EpidVerifierTest, SetBasenameHashesAgainAfterEviction) {
+  VerifierCtxObj verifier(this->kPubKeyStr, this->kVerifierPrecompStr);
+  VerifierCtx* ctx = verifier;
+  EcGroup* G1 = ctx->epid2_params->G1;
+  G1ElemStr first = {0};
+  G1ElemStr other = {0};
+  G1ElemStr again = {0};
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename1.data(),
+                                           this->kBasename1.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &other, sizeof(other)));
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                           this->kBasename.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &first, sizeof(first)));
+  BasenameCacheEntry* entry = FindBasenameCacheEntry(ctx, this->kBasename);
+  ASSERT_NE(nullptr, entry);
+  // only a stale entry would give this hash back
+  entry->hash = other;
+  for (uint8_t i = 0; i < EPID_VERIFIER_BASENAME_CACHE_SIZE; i++) {
+    THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, &i, sizeof(i)));
+  }
+  EXPECT_EQ(nullptr, FindBasenameCacheEntry(ctx, this->kBasename));
+  EXPECT_EQ(kEpidNoErr, EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                                this->kBasename.size()));
+  THROW_ON_EPIDERR(
+      WriteEcPoint(G1, ctx->basename_hash, &again, sizeof(again)));
+  EXPECT_EQ(first, again);
+  EXPECT_NE(nullptr, FindBasenameCacheEntry(ctx, this->kBasename));
+}
+
+TEST_F(EpidVerifierTest, SetBasenameHashesAgainAfterHashAlgChange) {
+  GroupPubKey pubkey = this->kPubKeyStr;
+  pubkey.gid.data[1] = 0x00;  // sha256
+  VerifierCtxObj verifier(pubkey, this->kVerifierPrecompStr);
+  VerifierCtx* ctx = verifier;
+  EcGroup* G1 = ctx->epid2_params->G1;
+  G1ElemStr sha256_hash = {0};
+  G1ElemStr sha512_hash = {0};
+  THROW_ON_EPIDERR(EpidVerifierSetBasename(ctx, this->kBasename.data(),
+                                           this->kBasename.size()));
+  THROW_ON_EPIDERR(WriteEcPoint(G1, ctx->basename_hash, &sha256_hash,
+                                sizeof(sha256_hash)));
+  THROW_ON_EPIDERR(EpidVerifierSetHashAlg(ctx, kSha512));
+  THROW_ON_EPIDERR(WriteEcPoint(G1, ctx->basename_hash, &sha512_hash,
+                                sizeof(sha512_hash)));
+  EXPECT_FALSE(sha256_hash == sha512_hash);
+}
+
 TEST_F(EpidVerifierTest, EpidVerifierSetHashAlgOverridesDefaultHashAlgorithm) {
   GroupPubKey pubkey = this->kPubKeyStr;
   pubkey.gid.data[1] = 0x00;  // sha256
@@ -22,8 +22,10 @@
 #include "gtest/gtest.h"
 #include "testhelper/epid_gtest-testhelper.h"
 
+#include "common/endian_convert.h"
 #include "epid/verifier.h"
 extern "C" {
+#include "ippmath/expworkspace.h"
 #include "rlverify.h"
 }
 
@@ -287,4 +289,38 @@ TEST_F(EpidVerifierTest, NrVerifyAcceptsMsgContainingAllPossibleBytes) {
                    &epid_signature->sigma[0], sizeof(NrProof)));
 }
 
+
+TEST_F(EpidVerifierTest, NrVerifyWithWorkspaceFailsGivenNullWorkspace) {
+  VerifierCtxObj verifier(this->kGrp01Key);
+  auto epid_signature = reinterpret_cast<EpidNonSplitSignature const*>(
+      this->kSigGrp01Member0Sha256RandombaseTest0.data());
+  SigRl const* sig_rl =
+      reinterpret_cast<SigRl const*>(this->kGrp01SigRl.data());
+  EXPECT_EQ(kEpidBadArgErr,
+            EpidNrVerifyWithWorkspace(
+                verifier, &epid_signature->sigma0, this->kTest0.data(),
+                this->kTest0.size(), &sig_rl->bk[0], &epid_signature->sigma[0],
+                sizeof(NrProof), nullptr));
+}
+
+TEST_F(EpidVerifierTest, NrVerifyWithWorkspaceAcceptsEveryProofOfSig) {
+  VerifierCtxObj verifier(this->kPubKeyIkgfStr);
+  auto epid_signature = reinterpret_cast<EpidNonSplitSignature const*>(
+      this->kSigMember0Sha256RandombaseMsg0Ikgf.data());
+  SigRl const* sig_rl = reinterpret_cast<SigRl const*>(this->kSigRlIkgf.data());
+  ExpWorkspace* ws = nullptr;
+  THROW_ON_EPIDERR(NewExpWorkspace(3, &ws));
+  uint32_t n2 = ntohl(sig_rl->n2);
+  ASSERT_LT(1u, n2);
+  for (uint32_t i = 0; i < n2; i++) {
+    EXPECT_EQ(kEpidSigValid,
+              EpidNrVerifyWithWorkspace(
+                  verifier, &epid_signature->sigma0, this->kMsg0.data(),
+                  this->kMsg0.size(), &sig_rl->bk[i], &epid_signature->sigma[i],
+                  sizeof(NrProof), ws))
+        << "entry " << i;
+  }
+  DeleteExpWorkspace(&ws);
+}
+
 }  // namespace